@@ -0,0 +1,126 @@
+// Stress test of the data buffer with one producer and two readers on their own threads (like the
+// capture thread and the plots). The producer fills every frame with its version, the readers check
+// that a view never changes while it is held, never shows a partly written frame and that versions
+// don't go back. One reader holds two views at times, which makes the buffer add a frame. Build it
+// with the thread sanitizer to check the synchronization of the frames.
+//
+// build (from GuiFramework): g++ -std=c++20 -O1 -g -fsanitize=thread -DGUI_HEADLESS -IInclude
+//   Benchmark/DataBufferStress.cpp Source/Common/DataBuffer.cpp -o DataBufferStress
+// run: ./DataBufferStress [--frames 200000]
+
+#include "Gui.h"
+#include "Common/DataBuffer.h"
+
+#include <thread>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define STRESS_SIZE 1024
+#define STRESS_FRAMES 200000
+
+// value of all samples of a frame (exact as float)
+static float getValue(unsigned long long version) {
+
+	return (float)(version % 1000000);
+}
+
+// checks that all samples of a view belong to its version
+static bool checkView(DataView& view) {
+
+	float* p_data = view.getData();
+	float value = getValue(view.getVersion());
+
+	for (int i = 0; i < view.getSize(); ++i) {
+		if (p_data[i] != value) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// reads the latest frame until the producer is done (false on the first error)
+static bool readFrames(DataBuffer* p_buffer, std::atomic<bool>* p_done, bool holdTwo, long long* p_nReads) {
+
+	unsigned long long lastVersion = 0;
+	long long nReads = 0;
+
+	while (!p_done->load(std::memory_order_acquire)) {
+
+		DataView view = p_buffer->read();
+
+		if (view.getSize() != STRESS_SIZE || view.getVersion() < lastVersion || !checkView(view)) {
+			printf("reader: frame %llu is corrupt or older than %llu\n", view.getVersion(), lastVersion);
+			return false;
+		}
+
+		lastVersion = view.getVersion();
+
+		// hold a second (newer) view while the first one is still held
+		if (holdTwo && nReads % 16 == 0) {
+
+			std::this_thread::yield();
+
+			DataView second = p_buffer->read();
+
+			if (second.getVersion() < lastVersion || !checkView(second) || !checkView(view)) {
+				printf("reader: frame %llu changed while it was held\n", view.getVersion());
+				return false;
+			}
+
+			lastVersion = second.getVersion();
+		}
+
+		++nReads;
+	}
+
+	*p_nReads = nReads;
+	return true;
+}
+
+int main(int argc, char** argv) {
+
+	int nFrames = STRESS_FRAMES;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			nFrames = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	DataBuffer buffer(STRESS_SIZE);
+	std::atomic<bool> done(false);
+
+	bool a_passed[2] = { false, false };
+	long long a_nReads[2] = { 0, 0 };
+
+	std::thread first([&] { a_passed[0] = readFrames(&buffer, &done, false, &a_nReads[0]); });
+	std::thread second([&] { a_passed[1] = readFrames(&buffer, &done, true, &a_nReads[1]); });
+
+	// produce frames with their version in every sample
+	for (int f = 0; f < nFrames; ++f) {
+
+		float* p_data = buffer.beginWrite();
+		float value = getValue(buffer.getVersion() + 1);
+
+		for (int i = 0; i < STRESS_SIZE; ++i) {
+			p_data[i] = value;
+		}
+
+		buffer.publish();
+	}
+
+	done.store(true, std::memory_order_release);
+
+	first.join();
+	second.join();
+
+	bool passed = a_passed[0] && a_passed[1] && buffer.getVersion() == (unsigned long long)nFrames;
+
+	printf("%d frames published, %lld and %lld reads\n", nFrames, a_nReads[0], a_nReads[1]);
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
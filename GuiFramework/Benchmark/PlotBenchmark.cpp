@@ -0,0 +1,134 @@
+// Paint cost of a plot in rolling mode (an oscilloscope trace that moves every tick) on the
+// headless backend. By default the axes stay, so only the trace is painted on top of the cached
+// static layer. With --scroll the x bounds move every tick, which repaints the static layer too.
+//
+// build (from GuiFramework): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude Benchmark/PlotBenchmark.cpp
+//   $(find Source -name '*.cpp' ! -path '*/Win32/*') -o PlotBenchmark
+// run: ./PlotBenchmark --frames 300 [--scroll] [--png plot.png]
+
+#include "Gui.h"
+#include "Core/Application.h"
+#include "Core/MainWindow.h"
+#include "Core/IFunctional.h"
+#include "Widgets/LinearLayout.h"
+#include "Widgets/Plot.h"
+#include "Widgets/PlotSeries1D.h"
+#include "Style/Palette.h"
+
+#include <vector>
+#include <math.h>
+#include <string.h>
+
+#define BENCHMARK_SAMPLE_RATE 48000
+#define BENCHMARK_RECORD_SIZE 48000 // one second is shown
+
+// writes a sine into a ring buffer, like the capture of the oscilloscope
+class RollingSource : public IFunctional {
+
+private:
+	std::vector<float> m_data;
+	long long m_count;
+
+	PlotSeries1D* mp_series;
+	Plot* mp_plot;
+
+	bool m_scroll;
+
+public:
+	RollingSource(bool scroll) : m_data(BENCHMARK_RECORD_SIZE, 0.0f), m_count(0), mp_series(nullptr), mp_plot(nullptr), m_scroll(scroll) { }
+
+	IMPLEMENT_LOADSAVE(RollingSource)
+
+public:
+	void setPlot(Plot* p_plot, PlotSeries1D* p_series) {
+
+		mp_plot = p_plot;
+		mp_series = p_series;
+	}
+
+	float* getData() {
+
+		return m_data.data();
+	}
+
+private:
+	void onTick(float deltaTime) {
+
+		// append the samples of this tick
+		int nSamples = (int)(deltaTime * BENCHMARK_SAMPLE_RATE);
+
+		for (int i = 0; i < nSamples; ++i, ++m_count) {
+			m_data[m_count % BENCHMARK_RECORD_SIZE] = sinf(2.0f * 3.14159265f * 50.0f * m_count / BENCHMARK_SAMPLE_RATE);
+		}
+
+		if (mp_series == nullptr) {
+			return;
+		}
+
+		mp_series->setHead(m_count % BENCHMARK_RECORD_SIZE);
+		mp_series->onUpdate();
+
+		// move the axis with the time (repaints the static layer)
+		if (m_scroll) {
+
+			float time = (float)m_count / BENCHMARK_SAMPLE_RATE;
+
+			mp_series->setBounds(time - 1.0f, time);
+			mp_plot->setPlotXBounds(time - 1.0f, time);
+		}
+	}
+
+	void onBegin() { }
+	void onClose() { }
+};
+
+class PlotBenchmark : public Application {
+
+private:
+	RollingSource* mp_source;
+
+public:
+	PlotBenchmark(int argc, char** argv) : Application(argc, argv) {
+
+		bool scroll = false;
+		for (int i = 1; i < argc; ++i) {
+			scroll = scroll || strcmp(argv[i], "--scroll") == 0;
+		}
+
+		mp_source = new RollingSource(scroll);
+		REGISTER_FUNCTIONAL(mp_source);
+	}
+
+private:
+	void initUI() {
+
+		MainWindow* p_window = MainWindow::create(L"Plot Benchmark");
+		setMainWindow(p_window);
+
+		Plot* p_plot = new Plot(p_window, L"Time", L"Voltage");
+		p_plot->setFillMode(FillMode::Expand);
+		p_plot->setPlotXBounds(0.0f, 1.0f);
+		p_plot->setPlotYBounds(1.2f, -1.2f);
+
+		PlotSeries1D* p_series = new PlotSeries1D(p_plot, mp_source->getData(), 0.0f, 1.0f, BENCHMARK_RECORD_SIZE, Palette::Plot(0));
+		p_plot->addPlotSeries(p_series);
+
+		mp_source->setPlot(p_plot, p_series);
+
+		LinearLayout* p_layout = new LinearLayout(p_window, Orientation::Vertical);
+		p_layout->addFrame(p_plot);
+
+		p_window->setLayout(p_layout);
+	}
+
+	std::wstring getApplicationName() {
+
+		return L"PlotBenchmark";
+	}
+};
+
+int main(int argc, char** argv) {
+
+	PlotBenchmark benchmark(argc, argv);
+	return benchmark.exec();
+}
\ No newline at end of file
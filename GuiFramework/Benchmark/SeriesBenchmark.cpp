@@ -0,0 +1,151 @@
+// Update and paint cost of a plot series by point count (measured at 1k, 64k and 1M points) on
+// the headless backend. By default every sample changes every tick, so each update rebuilds the
+// geometry of the series (a changed span still rebuilds the whole geometry, there is no partial
+// vertex update). With --static the data stays, which shows the cost of an update without changes.
+//
+// build (from GuiFramework): g++ -std=c++20 -O2 -DGUI_HEADLESS -DGUI_PROFILE -IInclude Benchmark/SeriesBenchmark.cpp
+//   $(find Source -name '*.cpp' ! -path '*/Win32/*') -o SeriesBenchmark
+// run: ./SeriesBenchmark --frames 100 --points 1024 (65536, 1048576) [--static] [--png series.png]
+
+#include "Gui.h"
+#include "Core/Application.h"
+#include "Core/MainWindow.h"
+#include "Core/IFunctional.h"
+#include "Widgets/LinearLayout.h"
+#include "Widgets/Plot.h"
+#include "Widgets/PlotSeries1D.h"
+#include "Style/Palette.h"
+
+#include <vector>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define BENCHMARK_POINTS 65536
+#define BENCHMARK_PERIODS 20 // periods of the sine shown
+
+// writes a moving sine into the whole array every tick (or once with static data)
+class SeriesSource : public IFunctional {
+
+private:
+	std::vector<float> m_data;
+	float m_phase;
+
+	PlotSeries1D* mp_series;
+
+	bool m_static;
+
+public:
+	SeriesSource(int nPoints, bool isStatic) : m_data(nPoints, 0.0f), m_phase(0.0f), mp_series(nullptr), m_static(isStatic) {
+
+		generate();
+	}
+
+	IMPLEMENT_LOADSAVE(SeriesSource)
+
+public:
+	void setSeries(PlotSeries1D* p_series) {
+
+		mp_series = p_series;
+	}
+
+	float* getData() {
+
+		return m_data.data();
+	}
+
+	int getSize() {
+
+		return m_data.size();
+	}
+
+private:
+	void generate() {
+
+		int size = m_data.size();
+
+		for (int i = 0; i < size; ++i) {
+			m_data[i] = sinf(2.0f * 3.14159265f * BENCHMARK_PERIODS * i / size + m_phase);
+		}
+	}
+
+	void onTick(float deltaTime) {
+
+		if (mp_series == nullptr) {
+			return;
+		}
+
+		// every sample changes
+		if (!m_static) {
+
+			m_phase += deltaTime;
+			generate();
+		}
+
+		mp_series->onUpdate();
+	}
+
+	void onBegin() { }
+	void onClose() { }
+};
+
+class SeriesBenchmark : public Application {
+
+private:
+	SeriesSource* mp_source;
+
+public:
+	SeriesBenchmark(int argc, char** argv) : Application(argc, argv) {
+
+		int nPoints = BENCHMARK_POINTS;
+		bool isStatic = false;
+
+		for (int i = 1; i < argc; ++i) {
+
+			if (strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+				nPoints = max(atoi(argv[++i]), 2);
+			}
+			else if (strcmp(argv[i], "--static") == 0) {
+				isStatic = true;
+			}
+		}
+
+		printf("%d points, %s data\n", nPoints, isStatic ? "static" : "changing");
+
+		mp_source = new SeriesSource(nPoints, isStatic);
+		REGISTER_FUNCTIONAL(mp_source);
+	}
+
+private:
+	void initUI() {
+
+		MainWindow* p_window = MainWindow::create(L"Series Benchmark");
+		setMainWindow(p_window);
+
+		Plot* p_plot = new Plot(p_window, L"Time", L"Voltage");
+		p_plot->setFillMode(FillMode::Expand);
+		p_plot->setPlotXBounds(0.0f, 1.0f);
+		p_plot->setPlotYBounds(1.2f, -1.2f);
+
+		PlotSeries1D* p_series = new PlotSeries1D(p_plot, mp_source->getData(), 0.0f, 1.0f, mp_source->getSize(), Palette::Plot(0));
+		p_plot->addPlotSeries(p_series);
+
+		mp_source->setSeries(p_series);
+
+		LinearLayout* p_layout = new LinearLayout(p_window, Orientation::Vertical);
+		p_layout->addFrame(p_plot);
+
+		p_window->setLayout(p_layout);
+	}
+
+	std::wstring getApplicationName() {
+
+		return L"SeriesBenchmark";
+	}
+};
+
+int main(int argc, char** argv) {
+
+	SeriesBenchmark benchmark(argc, argv);
+	return benchmark.exec();
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include "Gui.h"
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+// frame of a data buffer, readers hold it through a data view
+struct DataFrame {
+
+	std::vector<float> data;
+	unsigned long long version;
+
+	std::atomic<int> nViews; // number of views holding the frame (it isn't written while there are any)
+};
+
+// reference counted view of a published frame, the data stays unchanged as long as the view exists
+class GUI_API DataView {
+
+private:
+	DataFrame* mp_frame;
+
+public:
+	DataView();
+	DataView(DataFrame* p_frame);
+	DataView(const DataView& other);
+	~DataView();
+
+	DataView& operator=(const DataView& other);
+
+public:
+	float* getData();
+	int getSize();
+	unsigned long long getVersion();
+
+	bool isValid();
+};
+
+// Triple buffered frames of float data shared between a producer and its readers.
+// The producer writes a frame no view holds and publishes it once it is complete,
+// readers take a view of the latest published frame. Neither side copies the data
+// and a view never sees a partly written frame, that way the producer can run on
+// another thread than the readers.
+class GUI_API DataBuffer {
+
+private:
+	std::vector<DataFrame*> mp_frames; // three frames (more only if readers hold several views)
+
+	DataFrame* mp_published;
+	DataFrame* mp_writing;
+
+	int m_size;
+	unsigned long long m_version;
+
+	std::mutex m_mutex;
+
+public:
+	DataBuffer(int size);
+	~DataBuffer();
+
+	DataBuffer(const DataBuffer&) = delete;
+	DataBuffer& operator=(const DataBuffer&) = delete;
+
+public:
+	float* beginWrite();
+	void publish();
+
+	DataView read();
+
+	int getSize();
+	unsigned long long getVersion();
+};
\ No newline at end of file
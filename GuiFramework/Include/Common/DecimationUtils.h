@@ -0,0 +1,20 @@
+#pragma once
+#include "Gui.h"
+
+#include <vector>
+
+#define PLOTSERIES_POINTS_PER_COLUMN 4 // first, min, max and last point of a pixel column (M4)
+
+// Reduction of plot points to the pixel columns of a plot, shared by the plot series. The first,
+// minimum, maximum and last point of a column cover the same pixels as all of its points (M4).
+// X values are in axis space, y values that can't be shown are NaN and skipped.
+
+// finds the visible points including the nearest point on both sides (end is exclusive) and the first
+// point of every pixel column, the columns stay empty if the points are passed as they are
+// (there are only a few of them or the x values aren't ascending)
+GUI_API void findColumns(float* pa_x, int size, bool sorted, float left, float right, int nColumns, int& begin, int& end,
+	std::vector<int>& columns);
+
+// appends the reduced visible points (all visible points if there are no columns)
+GUI_API void decimateM4(float* pa_x, float* pa_y, int begin, int end, std::vector<int>& columns, std::vector<float>& pointsX,
+	std::vector<float>& pointsY);
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+#include "Gui.h"
+#include <string>
+
+// writes premultiplied 0xAARRGGBB pixels (first row is the top) to a png file,
+// the image data is stored without compression, that way no zlib is needed
+GUI_API bool writePNG(std::wstring path, unsigned int* pa_pixels, int width, int height);
\ No newline at end of file
@@ -15,4 +15,5 @@ namespace Math {
 	Rect maxRect(Rect& a, Rect& b);
 
 	bool pointInRect(Rect rect, Point2D point);
+	bool rectsOverlap(Rect a, Rect b);
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include "Gui.h"
+
+// profiler (define GUI_PROFILE to record timings, otherwise all macros are empty)
+#ifdef GUI_PROFILE
+
+	#include <atomic>
+	#include <chrono>
+	#include <string>
+	#include <vector>
+
+	#define PROFILER_CAPACITY 65536 // number of events kept in the ring (power of two)
+
+	// helper macros
+	#define PROFILE_CONCAT_INNER(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+	// define profiler macros
+	#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(__profileScope, __LINE__)(name, nullptr);
+	#define PROFILE_SCOPE_OBJECT(name, p_object) ProfileScope PROFILE_CONCAT(__profileScope, __LINE__)(name, p_object);
+	#define PROFILE_FRAME() Profiler::getInstance().nextFrame();
+	#define PROFILE_PRINT_SUMMARY() Profiler::getInstance().printSummary();
+	#define PROFILE_SAVE_TRACE(path) Profiler::getInstance().saveTrace(path);
+
+#else
+
+	// define profiler macros as empty
+	#define PROFILE_SCOPE(name)
+	#define PROFILE_SCOPE_OBJECT(name, p_object)
+	#define PROFILE_FRAME()
+	#define PROFILE_PRINT_SUMMARY()
+	#define PROFILE_SAVE_TRACE(path)
+
+#endif
+
+#ifdef GUI_PROFILE
+
+// timing of a scope (copied out of the ring)
+struct ProfileEvent {
+
+	const char* name; // string literal
+	const void* p_object; // widget or functional the scope belongs to (nullptr if not given)
+
+	long long begin; // in ns since the profiler was created
+	long long end;
+
+	int frame;
+	int thread;
+};
+
+// slot of the ring, the sequence is 0 while the event is written
+struct ProfileSlot {
+
+	ProfileEvent event;
+	std::atomic<unsigned long long> sequence; // index + 1 of the event held
+};
+
+// Records scoped timings of all threads into a fixed ring. Writers only take an index
+// with an atomic increment, so recording never locks. Old events are overwritten, the
+// statistics and the trace cover the last PROFILER_CAPACITY events.
+class GUI_API Profiler {
+
+private:
+	ProfileSlot* mpa_slots;
+
+	std::atomic<unsigned long long> m_next;
+	std::atomic<int> m_frame;
+	std::atomic<int> m_nThreads;
+
+	std::chrono::time_point<std::chrono::steady_clock> m_start;
+
+public:
+	Profiler();
+	~Profiler();
+
+public:
+	static Profiler& getInstance();
+
+	long long getTime();
+	void record(const char* name, const void* p_object, long long begin, long long end);
+
+	void nextFrame();
+
+	std::vector<ProfileEvent> getEvents();
+	float getPercentile(const char* name, float percentile);
+
+	void printSummary();
+	bool saveTrace(std::wstring path);
+
+private:
+	int getThread();
+};
+
+// records the time between construction and destruction
+class GUI_API ProfileScope {
+
+private:
+	const char* m_name;
+	const void* mp_object;
+
+	long long m_begin;
+
+public:
+	ProfileScope(const char* name, const void* p_object);
+	~ProfileScope();
+};
+
+#endif
\ No newline at end of file
@@ -15,7 +15,9 @@ namespace Math {
 		Rect();
 		Rect(float left, float right, float top, float bottom);
 		Rect(Point2D& topLeft, Point2D& bottomRight);
+#ifdef WIN32
 		Rect(RECT& rect);
+#endif
 
 	public:
 		float& left();
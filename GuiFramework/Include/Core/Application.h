@@ -1,6 +1,9 @@
 #pragma once
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessApplication.h"
+	using Application = HeadlessApplication;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32Application.h"
 	using Application = Win32Application;
 #endif
\ No newline at end of file
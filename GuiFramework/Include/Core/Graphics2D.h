@@ -1,6 +1,9 @@
 #pragma once
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessGraphics2D.h"
+	using Graphics2D = HeadlessGraphics2D;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32Graphics2D.h"
 	using Graphics2D = Win32Graphics2D;
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Core/MainWindow.h"
 #include "Core/Graphics2D.h"
 #include "Core/IFunctional.h"
+#include "Core/Scheduler.h"
 
 #include <vector>
 
@@ -10,12 +11,12 @@
 
 class GUI_API IApplication {
 
-private:
-	MainWindow* mp_mainWindow;
-
 protected:
+	MainWindow* mp_mainWindow;
 	std::vector<IFunctional*> mp_functionals;
 
+	Scheduler m_scheduler;
+
 public:
 	IApplication(int argc, char** argv);
 
@@ -24,8 +25,14 @@ public:
 
 	void setMainWindow(MainWindow* p_mainWindow);
 
+	void setTickRate(float rate);
+	void setRenderRate(float rate);
+
 protected:
+	bool onSchedule(double time);
+
 	void onTick(float deltaTime);
+	void onRender(float deltaTime);
 
 	virtual void onBegin();
 	virtual void onClose();
@@ -1,6 +1,7 @@
 #pragma once
 #include "Gui.h"
 #include "Common/Reflection/Internal.h"
+#include "Core/Scheduler.h"
 
 #include <string>
 
@@ -13,10 +14,19 @@ class GUI_API IFunctional {
 
 	USE_REFLECTION()
 
+private:
+	Scheduler* mp_scheduler; // set by the application
+
+public:
+	IFunctional();
+
 public:
 	virtual void loadMembers(std::wstring path) = 0;
 	virtual void saveMembers(std::wstring path) = 0;
 
+protected:
+	void requestWakeup(float delay);
+
 private:
 	virtual void onTick(float deltaTime) = 0;
 	virtual void onBegin() = 0;
@@ -4,6 +4,8 @@
 class GUI_API IGraphics {
 
 public:
+	virtual ~IGraphics() { };
+
 	virtual void createGraphicsAssets() = 0;
 	virtual void discardGraphicsAssets() = 0;
 
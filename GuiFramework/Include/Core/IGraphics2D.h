@@ -1,11 +1,14 @@
 #pragma once
 #include "Core/IGraphics.h"
-
-enum Alignment;
+#include "Common/MathUtils.h"
 
 class GUI_API IGraphics2D : public IGraphics {
 
 public:
 	virtual void beginPaint() = 0;
 	virtual void endPaint() = 0;
+
+	// restrict painting to a rect (used to repaint dirty regions only)
+	virtual void pushClip(Math::Rect rect) = 0;
+	virtual void popClip() = 0;
 };
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include "Common/EventUtils.h"
 #include "Core/Graphics2D.h"
 
+#include <vector>
+
+#define WINDOW_MAX_DIRTY_RECTS 8 // more regions per tick are painted as their bounding box
+#define WINDOW_DIRTY_MERGE_RATIO 1.25f // regions are merged if their bounding box isn't larger than this times both areas
+
 // forward declare layout
 class Layout;
 class DropDown;
@@ -19,6 +24,13 @@ protected:
 	bool m_layoutMouseHover;
 	bool m_dropDownMouseHover;
 
+	std::vector<Math::Rect> m_dirtyRects; // regions requested since the last tick
+	std::vector<Math::Rect> m_paintRects; // regions painted in the current tick
+
+	// repaint statistics of the last tick (area in device independent pixels)
+	float m_repaintedArea;
+	int m_nRepaintedRects;
+
 public:
 	IWindow();
 	
@@ -33,6 +45,11 @@ public:
 
 	Graphics2D* getGraphics();
 
+	void invalidateRect(Math::Rect rect);
+
+	float getRepaintedArea();
+	int getRepaintedRectCount();
+
 protected:
 	void onTick(float deltaTime);
 
@@ -50,6 +67,9 @@ protected:
 	void onKeyDown(char key);
 
 private:
+	void paintDirtyRects();
+	void coalesceDirtyRects();
+
 	virtual void initialize(std::wstring title) = 0;
 
 
@@ -1,6 +1,9 @@
 #pragma once
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessMainWindow.h"
+	using MainWindow = HeadlessMainWindow;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32MainWindow.h"
 	using MainWindow = Win32MainWindow;
 #endif
\ No newline at end of file
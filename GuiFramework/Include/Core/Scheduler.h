@@ -0,0 +1,43 @@
+#pragma once
+#include "Gui.h"
+
+#define SCHEDULER_TICK_RATE 30.0f // functional ticks per second
+#define SCHEDULER_RENDER_RATE 60.0f // window ticks per second (backends use the display refresh rate if known)
+
+// Decides when the application has to wake up. Functionals and the window are ticked
+// at separate rates and functionals can request earlier ticks. Times are given in seconds
+// by the backend, that way any clock can be used (the headless backend uses a virtual one).
+class GUI_API Scheduler {
+
+private:
+	double m_time; // time of the last call to setTime
+
+	double m_tickInterval;
+	double m_renderInterval;
+
+	double m_nextTick;
+	double m_nextRender;
+
+	double m_lastTick;
+	double m_lastRender;
+
+public:
+	Scheduler();
+
+public:
+	void start(double time);
+	void setTime(double time);
+
+	void setTickRate(float rate);
+	void setRenderRate(float rate);
+
+	void requestWakeup(float delay);
+
+	bool isTickDue(float& deltaTime);
+	bool isRenderDue(float& deltaTime);
+
+	double getTimeout();
+
+private:
+	void advance(double& next, double interval);
+};
\ No newline at end of file
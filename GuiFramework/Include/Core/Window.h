@@ -1,6 +1,9 @@
 #pragma once
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessWindow.h"
+	using Window = HeadlessWindow;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32Window.h"
 	using Window = Win32Window;
 #endif
\ No newline at end of file
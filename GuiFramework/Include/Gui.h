@@ -18,10 +18,19 @@
 	#define HInstance() GetModuleHandle(NULL)
 	#define MAX_STRING_SIZE 64
 
+#else
+
+	// windows.h defines min and max as macros
+	#include <algorithm>
+	using std::min;
+	using std::max;
+
 #endif
 
-// dll import export macro
-#ifdef BUILD_DLL
+// dll import export macro (other platforms export all symbols)
+#ifndef _WIN32
+	#define GUI_API
+#elif defined(BUILD_DLL)
 	#define GUI_API __declspec(dllexport)
 #else
 	#define GUI_API __declspec(dllimport)
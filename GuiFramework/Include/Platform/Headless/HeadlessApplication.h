@@ -0,0 +1,28 @@
+#pragma once
+#include "Core/IApplication.h"
+
+#define HEADLESS_FRAMES 300 // number of frames if not given with --frames
+#define HEADLESS_FRAME_RATE 30.0f // frames per second, fixed that way runs are comparable
+
+// Runs a fixed number of frames and reports the time per frame. The scheduler runs on a
+// virtual clock that jumps to the next deadline (as fast as possible), or on the real clock
+// with --realtime (sleeps between deadlines like the other backends),
+// arguments: --frames <number of frames> --png <path of a screenshot after the last frame> --realtime
+// --trace <path of a chrome trace of the profiled scopes, only if built with GUI_PROFILE>
+class GUI_API HeadlessApplication : public IApplication {
+
+private:
+	int m_nFrames;
+	std::wstring m_pngPath;
+	std::wstring m_tracePath;
+	bool m_realtime;
+
+public:
+	HeadlessApplication(int argc, char** argv);
+
+public:
+	int exec();
+
+protected:
+	std::wstring getIniPath();
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "Widgets/AButtonImpl.h"
+
+class GUI_API HeadlessButtonImpl : public AButtonImpl {
+
+private:
+	Math::Rect m_rect;
+
+public:
+	HeadlessButtonImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onPaint(WidgetState widgetState) override;
+	void onResize(Math::Rect hitboxRect) override;
+};
\ No newline at end of file
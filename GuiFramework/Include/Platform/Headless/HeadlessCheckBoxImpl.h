@@ -0,0 +1,16 @@
+#pragma once
+#include "Widgets/ACheckBoxImpl.h"
+
+class GUI_API HeadlessCheckBoxImpl : public ACheckBoxImpl {
+
+private:
+	Math::Rect m_textRect;
+	Math::Rect m_boxRect;
+
+public:
+	HeadlessCheckBoxImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onResize(Math::Rect textRect, Math::Rect boxRect) override;
+	void onPaint(std::wstring text, WidgetState widgetState) override;
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include "Widgets/AFrameImpl.h"
+
+class GUI_API HeadlessFrameImpl : public AFrameImpl {
+
+private:
+	Math::Rect m_usedRect;
+	Math::Rect m_hitboxRect;
+	Math::Rect m_contentRect;
+
+public:
+	HeadlessFrameImpl(Graphics2D* p_graphics);
+
+public:
+	void onPaint() override;
+	void onResize(Math::Rect usedRect, Math::Rect hitboxRect, Math::Rect contentRect) override;
+};
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+#include "Core/IGraphics2D.h"
+#include "Common/MathUtils.h"
+#include "Common/WidgetUtils.h"
+#include "Style/Color.h"
+
+#include <vector>
+#include <string>
+
+#define HEADLESS_GLYPH_ADVANCE 0.55f // advance of a glyph relative to the font size
+#define HEADLESS_GLYPH_HEIGHT 0.5f // height of a glyph box relative to the font size
+#define HEADLESS_LINE_HEIGHT 1.2f // height of a line of text relative to the font size
+
+// Software renderer into an in-memory framebuffer of premultiplied 0xAARRGGBB pixels
+// (first row is the top). Shapes are sampled at pixel centers without antialiasing,
+// that way every frame is reproducible bit by bit. There are no fonts, text is drawn
+// as one box per glyph with a fixed advance, which keeps the layout close to real text.
+class GUI_API HeadlessGraphics2D : public IGraphics2D {
+
+private:
+	int m_width; // canvas size in pixels
+	int m_height;
+	float m_dpiScale; // pixels per device independent pixel
+
+	std::vector<unsigned int> m_pixels;
+
+	std::vector<Math::Rect> m_clipRects; // clip rectangles in pixels (the last one is active)
+
+	std::vector<unsigned int>* mp_layer; // layer painted into, its pixels are swapped with the framebuffer (nullptr if none)
+	std::vector<Math::Rect> m_windowClipRects; // clips of the framebuffer while a layer is painted
+
+	// transform of the drawing space to device independent pixels
+	float m_scaleX;
+	float m_scaleY;
+	float m_dx;
+	float m_dy;
+
+	long long m_nPixels; // pixels written since the frame began (to compare paint costs)
+
+	std::vector<float> m_crossings; // edge crossings of the current row while filling polygons
+
+public:
+	HeadlessGraphics2D(int width, int height, float dpiScale = 1.0f);
+	~HeadlessGraphics2D();
+
+public:
+	void beginPaint();
+	void endPaint();
+
+	void createGraphicsAssets();
+	void discardGraphicsAssets();
+
+	void resizeCanvas();
+	void setCanvasSize(int width, int height);
+
+	Math::Rect getDPISize();
+	float getDPIScale();
+
+	// drawing functions (coordinates in device independent pixels, line widths aren't transformed)
+	void fillRect(Math::Rect rect, Color color);
+	void drawRect(Math::Rect rect, Color color, float thickness);
+
+	void fillRoundedRect(Math::Rect rect, float topLeftRadius, float topRightRadius, float bottomLeftRadius, float bottomRightRadius, Color color);
+	void drawRoundedRect(Math::Rect rect, float topLeftRadius, float topRightRadius, float bottomLeftRadius, float bottomRightRadius, Color color, float thickness);
+
+	void drawLine(Math::Point2D a, Math::Point2D b, Color color, float thickness);
+	void drawPolyline(float* pa_x, float* pa_y, int size, Color color, float thickness);
+	void fillPolygon(float* pa_x, float* pa_y, int size, Color color);
+
+	void drawText(std::wstring text, Math::Rect rect, Alignment alignment, float fontSize, Color color);
+	void drawImage(unsigned int* pa_pixels, int width, int height, Math::Rect sourceRect, Math::Rect destinationRect);
+
+	void pushClip(Math::Rect rect);
+	void popClip();
+
+	void setTransform(float scaleX, float scaleY, float dx, float dy);
+	void resetTransform();
+
+	// offscreen layers have the size of the canvas, that way coordinates are the same as in the window
+	void beginLayer(std::vector<unsigned int>& layer, Math::Rect rect);
+	void endLayer();
+	void drawLayer(std::vector<unsigned int>& layer, Math::Rect rect);
+
+	// framebuffer access
+	unsigned int* getPixels();
+	int getWidth();
+	int getHeight();
+	long long getPixelCount();
+
+	bool savePNG(std::wstring path);
+
+private:
+	float toPixelX(float x);
+	float toPixelY(float y);
+	Math::Rect toPixelRect(Math::Rect rect);
+
+	bool getSpan(int y, float left, float right, int& first, int& last);
+	void fillSpan(int y, float left, float right, unsigned int color);
+	void fillRoundedSpans(Math::Rect rect, float* pa_radii, float* pa_innerRadii, Math::Rect* p_innerRect, unsigned int color);
+	void fillPixelPolygon(float* pa_x, float* pa_y, int size, unsigned int color);
+
+	static unsigned int premultiply(Color color);
+	static unsigned int blend(unsigned int dst, unsigned int src);
+};
\ No newline at end of file
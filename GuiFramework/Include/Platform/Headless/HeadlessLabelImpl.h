@@ -0,0 +1,15 @@
+#pragma once
+#include "Widgets/ALabelImpl.h"
+
+class GUI_API HeadlessLabelImpl : public ALabelImpl {
+
+private:
+	Math::Rect m_rect;
+
+public:
+	HeadlessLabelImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onPaint(std::wstring text) override;
+	void onResize(Math::Rect contentRect) override;
+};
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "Widgets/ALayoutImpl.h"
+
+class GUI_API HeadlessLayoutImpl : public ALayoutImpl {
+
+public:
+	HeadlessLayoutImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onPaint(Math::Rect usedRect) override;
+};
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+#include "Platform/Headless/HeadlessWindow.h"
+
+class GUI_API HeadlessMainWindow : public HeadlessWindow {
+
+public:
+	static HeadlessMainWindow* create(std::wstring title);
+};
\ No newline at end of file
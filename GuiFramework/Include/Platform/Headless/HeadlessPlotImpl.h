@@ -0,0 +1,28 @@
+#pragma once
+#include "Widgets/APlotImpl.h"
+
+#include <vector>
+
+class GUI_API HeadlessPlotImpl : public APlotImpl {
+
+private:
+	std::vector<unsigned int> m_layer; // pixels of the static layer
+
+public:
+	HeadlessPlotImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onResize(Math::Rect plotRect, Math::Rect legendRect);
+
+	bool beginStaticLayer(Math::Rect rect);
+	void endStaticLayer();
+	void drawStaticLayer();
+
+	void onPaintAxis(std::wstring xAxisText, std::wstring yAxisText);
+
+	void onPaintHorizontalTicks(float value, std::wstring text);
+	void onPaintVerticalTicks(float value, std::wstring text);
+
+private:
+	void drawArrow(Math::Point2D a, Math::Point2D b, float size);
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include "Widgets/APlotSeries1DImpl.h"
+#include <vector>
+
+class GUI_API HeadlessPlotSeries1DImpl : public APlotSeries1DImpl {
+
+private:
+	std::vector<float> m_x; // points in axis space
+	std::vector<float> m_y;
+
+public:
+	HeadlessPlotSeries1DImpl(Graphics2D* p_graphics, Color color);
+
+public:
+	void onUpdate(float* pa_x, float* pa_y, int size) override;
+
+	void onPaint(Math::Rect availableRect, Math::Rect plotBounds, bool fillArea) override;
+
+	void setColor(Color color) override;
+};
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include "Widgets/APlotSeriesImageImpl.h"
+#include <vector>
+
+class GUI_API HeadlessPlotSeriesImageImpl : public APlotSeriesImageImpl {
+
+private:
+	std::vector<unsigned int> m_pixels; // copy of the image (premultiplied 0xAARRGGBB)
+
+	int m_width;
+	int m_height;
+
+public:
+	HeadlessPlotSeriesImageImpl(Graphics2D* p_graphics);
+
+public:
+	void onUpdate(unsigned int* pa_pixels, int width, int height) override;
+	void onUpdateColumns(unsigned int* pa_pixels, int width, int height, int first, int count) override;
+
+	void onPaint(Math::Rect availableRect, Math::Rect imageRect, int offset) override;
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "Widgets/ASliderImpl.h"
+
+class GUI_API HeadlessSliderImpl : public ASliderImpl {
+
+private:
+	Math::Rect m_rect;
+
+public:
+	HeadlessSliderImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onPaint(Math::Rect sliderRect, WidgetState widgetState) override;
+	void onResize(Math::Rect hitboxRect) override;
+};
\ No newline at end of file
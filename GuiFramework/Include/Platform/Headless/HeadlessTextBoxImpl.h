@@ -0,0 +1,28 @@
+#pragma once
+#include "Widgets/ATextBoxImpl.h"
+
+// Text is laid out with the fixed glyph advance of the headless graphics,
+// that way hit tests and cursors match the drawn glyph boxes.
+class GUI_API HeadlessTextBoxImpl : public ATextBoxImpl {
+
+protected:
+	std::wstring m_text;
+	Math::Rect m_rect;
+	Math::Rect m_hitboxRect;
+
+public:
+	HeadlessTextBoxImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onResize(Math::Rect hitboxRect, Math::Rect contentRect) override;
+	void onPaint(WidgetState widgetState) override;
+	void onPaintCursor(int firstIndex, int lastIndex, bool dragFirstCursor, bool cursor) override;
+
+	void setText(std::wstring text) override;
+
+	int getMousePosition(Math::Point2D point);
+	Math::Rect getCursorPosition(int cursor, bool trailing = false);
+
+private:
+	Math::Point2D getTextOrigin();
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "Widgets/AWidgetImpl.h"
+
+class GUI_API HeadlessWidgetImpl : public AWidgetImpl {
+
+private:
+	Math::Rect m_rect;
+
+public:
+	HeadlessWidgetImpl(Graphics2D* p_graphics, WidgetStyle style);
+
+public:
+	void onPaint() override;
+	void onResize(Math::Rect availableRect) override;
+};
\ No newline at end of file
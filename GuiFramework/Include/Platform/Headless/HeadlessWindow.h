@@ -0,0 +1,31 @@
+#pragma once
+#include "Core/IWindow.h"
+
+#define HEADLESS_WINDOW_WIDTH 1280 // default canvas size in pixels
+#define HEADLESS_WINDOW_HEIGHT 720
+
+// Window without a window system, it paints into the framebuffer of the headless
+// graphics. Input is injected by the caller (e.g. tests and benchmarks).
+class GUI_API HeadlessWindow : public IWindow {
+
+public:
+	HeadlessWindow();
+	~HeadlessWindow();
+
+public:
+	void injectMouseMove(Math::Point2D point);
+	void injectMouseDown(bool doubleClk, Math::Point2D point);
+	void injectMouseRelease(Math::Point2D point);
+	void injectMouseScroll(bool up, bool shift, bool ctr);
+
+	void injectKeyDown(Key key);
+	void injectKeyDown(char key);
+
+	void resize(int width, int height);
+	void paint();
+
+	bool savePNG(std::wstring path);
+
+private:
+	void initialize(std::wstring title) override;
+};
\ No newline at end of file
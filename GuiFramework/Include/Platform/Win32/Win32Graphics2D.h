@@ -12,6 +12,7 @@ protected:
 	IDWriteFactory* mp_writeFactory;
 
 	ID2D1HwndRenderTarget* mp_renderTarget;
+	ID2D1RenderTarget* mp_layerTarget; // offscreen target painted into instead of the window (nullptr if none)
 
 	PAINTSTRUCT m_ps;
 
@@ -23,18 +24,24 @@ public:
 	void beginPaint();
 	void endPaint();
 
+	void pushClip(Math::Rect rect);
+	void popClip();
+
 	void createGraphicsAssets();
 	void discardGraphicsAssets();
 
 	void resizeCanvas();
 	
 	Math::Rect getDPISize();
+	float getDPIScale();
 
 private:
 	void initGraphicsAssets();
 
 	ID2D1Factory1* get2DFactory();
-	ID2D1HwndRenderTarget* getRenderTarget();
+	ID2D1RenderTarget* getRenderTarget();
+	ID2D1HwndRenderTarget* getWindowRenderTarget();
+	void setLayerTarget(ID2D1RenderTarget* p_layerTarget);
 	IDWriteFactory* getWriteFactory();
 
 	// make widget implementations a friend
@@ -48,5 +55,5 @@ private:
 	friend class Win32SliderImpl;
 	friend class Win32PlotImpl;
 	friend class Win32PlotSeries1DImpl;
-	friend class Win32PlotSeries1DImpl;
+	friend class Win32PlotSeriesImageImpl;
 };
\ No newline at end of file
@@ -1,6 +1,12 @@
 #pragma once
 #include "Widgets/APlotImpl.h"
 
+#include <unordered_map>
+
+#define PLOTIMPL_MAX_TEXT_LAYOUTS 128 // cached layouts per kind of label, all are released if there are more
+
+using TextLayoutCache = std::unordered_map<std::wstring, IDWriteTextLayout*>;
+
 class GUI_API Win32PlotImpl : public APlotImpl {
 
 private:
@@ -15,6 +21,16 @@ private:
 
 	ID2D1PathGeometry* mp_pathGeometry;	
 
+	// layouts of the labels keyed by their text (the text only changes with value, unit or prefix)
+	TextLayoutCache m_axisTextLayouts;
+	TextLayoutCache m_xTextLayouts;
+	TextLayoutCache m_yTextLayouts;
+
+	// static layer, created from the window render target (recreated if the window target changes)
+	ID2D1BitmapRenderTarget* mp_layerTarget;
+	ID2D1HwndRenderTarget* mp_layerParent;
+	bool m_layerPainting;
+
 public:
 	Win32PlotImpl(Graphics2D* p_graphics, WidgetStyle style);
 	~Win32PlotImpl();
@@ -22,6 +38,10 @@ public:
 public:
 	void onResize(Math::Rect plotRect, Math::Rect legendRect);
 
+	bool beginStaticLayer(Math::Rect rect);
+	void endStaticLayer();
+	void drawStaticLayer();
+
 	void onPaintAxis(std::wstring xAxisText, std::wstring yAxisText);
 
 	void onPaintHorizontalTicks(float value, std::wstring text);
@@ -31,6 +51,9 @@ public:
 
 private:
 	void drawArrow(Math::Point2D a, Math::Point2D b, float size);
+	void drawText(TextLayoutCache& layouts, std::wstring& text, IDWriteTextFormat* p_format, Math::Rect rect);
+
+	void releaseTextLayouts(TextLayoutCache& layouts);
 
 	void initGraphicsResources();
 };
\ No newline at end of file
@@ -2,6 +2,10 @@
 #include "Widgets/APlotSeries1DImpl.h"
 #include <vector>
 
+// Retains the points of the series, that way an update only copies the span of points
+// that changed and an update without changes keeps the geometry. Direct2D geometries
+// can't be modified, so a change rebuilds one geometry (shared by stroke and fill)
+// with a single batched call.
 class GUI_API Win32PlotSeries1DImpl : public APlotSeries1DImpl {
 
 private:
@@ -10,15 +14,17 @@ private:
 
 	ID2D1StrokeStyle1* mp_strokeStyle;
 
-	ID2D1PathGeometry* mp_edgePathGeometry;
-	ID2D1PathGeometry* mp_fillPathGeometry;
+	ID2D1PathGeometry* mp_pathGeometry; // open figure (the fill closes it implicitly)
+
+	std::vector<D2D1_POINT_2F> m_points; // points of the geometry in axis space
+	bool m_geometryValid;
 
 public:
 	Win32PlotSeries1DImpl(Graphics2D* p_graphics, Color color);
 	~Win32PlotSeries1DImpl();
 
 public:
-	void onUpdate(float* pa_data, int size, int head, float lowerBound, float upperBound) override;
+	void onUpdate(float* pa_x, float* pa_y, int size) override;
 
 	void onPaint(Math::Rect availableRect, Math::Rect plotBounds, bool fillArea) override;
 
@@ -26,4 +32,5 @@ public:
 
 private:
 	void initGraphicsResources();
+	void createGeometry();
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include "Widgets/APlotSeriesImageImpl.h"
+
+class GUI_API Win32PlotSeriesImageImpl : public APlotSeriesImageImpl {
+
+private:
+	ID2D1Bitmap* mp_bitmap;
+
+	int m_width;
+	int m_height;
+
+public:
+	Win32PlotSeriesImageImpl(Graphics2D* p_graphics);
+	~Win32PlotSeriesImageImpl();
+
+public:
+	void onUpdate(unsigned int* pa_pixels, int width, int height) override;
+	void onUpdateColumns(unsigned int* pa_pixels, int width, int height, int first, int count) override;
+
+	void onPaint(Math::Rect availableRect, Math::Rect imageRect, int offset) override;
+};
\ No newline at end of file
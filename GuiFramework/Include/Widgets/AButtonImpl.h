@@ -12,6 +12,7 @@ protected:
 
 public:
 	AButtonImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~AButtonImpl() { };
 
 public:
 	virtual void onResize(Math::Rect hitboxRect) = 0;
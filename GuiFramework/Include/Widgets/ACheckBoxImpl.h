@@ -12,6 +12,7 @@ protected:
 
 public:
 	ACheckBoxImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~ACheckBoxImpl() { };
 
 public:
 	virtual void onResize(Math::Rect contentRect, Math::Rect boxRect) = 0;
@@ -10,6 +10,7 @@ protected:
 
 public:
 	AFrameImpl(Graphics2D* p_graphics) : mp_graphics(p_graphics) { };
+	virtual ~AFrameImpl() { };
 
 public:
 	virtual void onResize(Math::Rect usedRect, Math::Rect hitboxRect, Math::Rect contentRect) = 0;
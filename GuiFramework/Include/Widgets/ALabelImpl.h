@@ -12,6 +12,7 @@ protected:
 
 public:
 	ALabelImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~ALabelImpl() { };
 
 public:
 	virtual void onResize(Math::Rect contentRect) = 0;
@@ -12,6 +12,7 @@ protected:
 
 public:
 	ALayoutImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~ALayoutImpl() { };
 
 public:
 	virtual void onPaint(Math::Rect usedRect) = 0;
@@ -14,10 +14,22 @@ protected:
 	WidgetStyle m_style;
 	Graphics2D* mp_graphics;
 
+	// static layer (background, axes and ticks), painted once and composited below the plot series
+	Math::Rect m_layerRect;
+	bool m_layerValid;
+
 public:
-	APlotImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	APlotImpl(Graphics2D* p_graphics, WidgetStyle style) : m_style(style), mp_graphics(p_graphics), m_layerValid(false) { };
+	virtual ~APlotImpl() { };
 
 public:
+	// returns true if the layer has to be painted (everything painted until endStaticLayer goes into it)
+	virtual bool beginStaticLayer(Math::Rect rect) = 0;
+	virtual void endStaticLayer() = 0;
+	virtual void drawStaticLayer() = 0;
+
+	void invalidateStaticLayer() { m_layerValid = false; };
+
 	virtual void onResize(Math::Rect plotRect, Math::Rect legendRect) = 0;
 
 	virtual void onPaintAxis(std::wstring xAxisText, std::wstring yAxisText) = 0;
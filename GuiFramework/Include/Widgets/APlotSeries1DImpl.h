@@ -14,9 +14,11 @@ protected:
 
 public:
 	APlotSeries1DImpl(Graphics2D* p_graphics, Color color) : mp_graphics(p_graphics), m_color(color) { };
+	virtual ~APlotSeries1DImpl() { };
 
 public:
-	virtual void onUpdate(float* pa_data, int size, int head, float lowerBound, float upperBound) = 0;
+	// points are given in axis space
+	virtual void onUpdate(float* pa_x, float* pa_y, int size) = 0;
 
 	virtual void onPaint(Math::Rect availableRect, Math::Rect plotBounds, bool fillArea) = 0;
 
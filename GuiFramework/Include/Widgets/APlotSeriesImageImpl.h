@@ -0,0 +1,20 @@
+#pragma once
+#include "Gui.h"
+#include "Common/MathUtils.h"
+#include "Core/Graphics2D.h"
+
+class GUI_API APlotSeriesImageImpl {
+
+protected:
+	Graphics2D* mp_graphics;
+
+public:
+	APlotSeriesImageImpl(Graphics2D* p_graphics) : mp_graphics(p_graphics) { };
+	virtual ~APlotSeriesImageImpl() { };
+
+public:
+	virtual void onUpdate(unsigned int* pa_pixels, int width, int height) = 0;
+	virtual void onUpdateColumns(unsigned int* pa_pixels, int width, int height, int first, int count) = 0;
+
+	virtual void onPaint(Math::Rect availableRect, Math::Rect imageRect, int offset) = 0;
+};
\ No newline at end of file
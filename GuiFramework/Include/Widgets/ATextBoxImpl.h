@@ -12,6 +12,7 @@ protected:
 
 public:
 	ATextBoxImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~ATextBoxImpl() { };
 
 public:
 	virtual void onResize(Math::Rect hitboxRect, Math::Rect contentRect) = 0;
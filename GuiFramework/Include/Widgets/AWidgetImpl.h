@@ -12,6 +12,7 @@ protected:
 
 public:
 	AWidgetImpl(Graphics2D* p_graphics, WidgetStyle style) : mp_graphics(p_graphics), m_style(style) { };
+	virtual ~AWidgetImpl() { };
 
 public:
 	virtual void onResize(Math::Rect availableRect) = 0;
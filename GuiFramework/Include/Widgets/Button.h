@@ -2,7 +2,10 @@
 #include "Widgets/Label.h"
 #include "Common/Signal.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessButtonImpl.h"
+	using ButtonImpl = HeadlessButtonImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32ButtonImpl.h"
 	using ButtonImpl = Win32ButtonImpl;
 #endif
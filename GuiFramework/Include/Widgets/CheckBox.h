@@ -2,7 +2,10 @@
 #include "Widgets/Widget.h"
 #include "Common/Signal.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessCheckBoxImpl.h"
+	using CheckBoxImpl = HeadlessCheckBoxImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32CheckBoxImpl.h"
 	using CheckBoxImpl = Win32CheckBoxImpl;
 #endif
@@ -4,7 +4,10 @@
 #include "Core/Graphics2D.h"
 #include "Common/WidgetUtils.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessFrameImpl.h"
+	using FrameImpl = HeadlessFrameImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32FrameImpl.h"
 	using FrameImpl = Win32FrameImpl;
 #endif
@@ -36,8 +39,10 @@ protected:
 
 public:
 	Frame(Window* p_parent);
+	virtual ~Frame() { };
 
 	virtual void onPaint();
+	virtual void onPaintRegion(Math::Rect& region);
 	virtual void onTick(float deltaTime) = 0;
 
 	virtual void onResize(Math::Rect availableRect);
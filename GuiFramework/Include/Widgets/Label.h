@@ -1,7 +1,10 @@
 #pragma once
 #include "Widgets/Widget.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessLabelImpl.h"
+	using LabelImpl = HeadlessLabelImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32LabelImpl.h"
 	using LabelImpl = Win32LabelImpl;
 #endif
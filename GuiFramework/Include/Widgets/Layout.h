@@ -3,7 +3,10 @@
 #include "Style/Style.h"
 #include <vector>
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessLayoutImpl.h"
+	using LayoutImpl = HeadlessLayoutImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32LayoutImpl.h"
 	using LayoutImpl = Win32LayoutImpl;
 #endif
@@ -16,6 +16,7 @@ public:
 
 public:
 	void onPaint() override;
+	void onPaintRegion(Math::Rect& region) override;
 	void onResize(Math::Rect availableRect) override;
 	void onTick(float deltaTime) override;
 
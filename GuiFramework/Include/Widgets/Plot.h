@@ -5,7 +5,10 @@
 
 #include <vector>
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessPlotImpl.h"
+	using PlotImpl = HeadlessPlotImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32PlotImpl.h"
 	using PlotImpl = Win32PlotImpl;
 #endif
@@ -26,12 +29,23 @@ enum Unit {
 
 	Volts = 7,
 	Hertz = 8,
-	Radians = 9
+	Radians = 9,
+	Decibel = 10,
+	Degree = 11
 };
 
-const std::wstring unit_symbols[10] = { L"s", L"m", L"g", L"A", L"K", L"mol", L"cd", L"V", L"Hz", L"rad" };
+const std::wstring unit_symbols[12] = { L"s", L"m", L"g", L"A", L"K", L"mol", L"cd", L"V", L"Hz", L"rad", L"dB", L"\u00B0" };
 const wchar_t unit_prefixes[8] = { L'n', L'\u00B5', L'm', L' ', L'k', L'M', L'G', L'T' };
 
+#define PLOT_NO_PREFIX 3 // index of the empty prefix in unit_prefixes
+
+// tick of an axis with its formatted label
+struct PlotTick {
+
+	float value; // in axis space
+	std::wstring label;
+};
+
 
 class GUI_API Plot : public Widget {
 
@@ -50,6 +64,13 @@ private:
 
 	std::vector<PlotSeries*> mp_series;
 
+	// ticks and axis labels, only recalculated if bounds, scales or units change
+	std::vector<PlotTick> m_xTicks;
+	std::vector<PlotTick> m_yTicks;
+	std::wstring m_xAxisLabel;
+	std::wstring m_yAxisLabel;
+	bool m_ticksValid;
+
 	bool m_lockXZoom;
 	bool m_lockYZoom;
 
@@ -72,6 +93,9 @@ public:
 	void setXAxisScale(AxisScale scale);
 	void setYAxisScale(AxisScale scale);
 
+	AxisScale getXAxisScale();
+	AxisScale getYAxisScale();
+
 	void setXUnit(Unit unit);
 	void setYUnit(Unit unit);
 
@@ -85,14 +109,27 @@ public:
 
 	Math::Point2D plotToScreenSpace(Math::Point2D point);
 
+	float toAxisX(float x);
+	float toAxisY(float y);
+	float fromAxisX(float x);
+	float fromAxisY(float y);
+
 	Math::Point2D screenToPlotSpace(Math::Point2D point);
 	Math::Point2D relativeScreenToPlotSpace(Math::Point2D point);
 
 	Signal<Math::Size> onZoom;
 
 private:
+	void invalidateTicks();
+	void calculateTicks();
+
+	void calculateLinearTicks(float lower, float upper, Unit unit, std::vector<PlotTick>& ticks, int& prefix);
+	void calculateLogTicks(float lower, float upper, Unit unit, std::vector<PlotTick>& ticks);
 	float calculateTickStep(float width, int prefDivs, int base, float prefactor);
 
+	int getUnitPrefix(float value, Unit unit);
+	std::wstring formatTickLabel(float value, int prefix);
+
 	// make PlotSeries a friend
 	friend class PlotSeries;
 };
@@ -13,6 +13,7 @@ protected:
 	Graphics2D* mp_graphics;
 
 	bool m_fillArea;
+	bool m_visible;
 
 public:
 	PlotSeries(Plot* p_parent);
@@ -26,4 +27,9 @@ public:
 
 	void setFillArea(bool fillArea);
 
+	void setVisible(bool visible);
+	bool isVisible();
+
+protected:
+	void requestRedraw();
 };
\ No newline at end of file
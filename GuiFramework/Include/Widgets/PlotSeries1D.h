@@ -1,7 +1,15 @@
 #pragma once
 #include "Widgets/PlotSeries.h"
+#include "Widgets/Plot.h"
+#include "Common/DataBuffer.h"
+#include "Common/DecimationUtils.h"
 
-#ifdef WIN32
+#include <vector>
+
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessPlotSeries1DImpl.h"
+	using PlotSeries1DImpl = HeadlessPlotSeries1DImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32PlotSeries1DImpl.h"
 	using PlotSeries1DImpl = Win32PlotSeries1DImpl;
 #endif
@@ -10,6 +18,10 @@ class GUI_API PlotSeries1D : public PlotSeries {
 
 private:
 	float* mpa_data;
+	float* mpa_xData; // x value of every point (nullptr if the points are spaced evenly between the bounds)
+
+	DataBuffer* mp_buffer; // data is read from the latest published frame (nullptr if mpa_data is used)
+	unsigned long long m_version; // version of the frame the points were calculated from
 
 	float m_lowerBound;
 	float m_upperBound;
@@ -17,11 +29,34 @@ private:
 	int m_size;
 	int m_head;
 
+	// x of every point in axis space, only recalculated if bounds, x data or axis scale change
+	std::vector<float> m_axisX;
+	AxisScale m_axisXScale;
+	bool m_axisXSorted;
+	bool m_axisXValid;
+
+	// points that can be shown in axis space (ring unwrapped, points without a valid value removed)
+	std::vector<float> m_validX;
+	std::vector<float> m_validY;
+	AxisScale m_axisYScale;
+
+	// points passed to the implementation (reduced to the pixel columns of the plot),
+	// only recalculated if the data, the x bounds or the number of columns change
+	std::vector<int> m_columns; // first point of every pixel column
+	std::vector<float> m_pointsX;
+	std::vector<float> m_pointsY;
+	float m_decimatedLeft;
+	float m_decimatedRight;
+	int m_decimatedColumns;
+	bool m_decimationValid;
+
 protected:
 	PlotSeries1DImpl m_plotSeries1DImpl;
 
 public:
 	PlotSeries1D(Plot* p_parent, float* pa_data, float lower, float upper, int size, Color color);
+	PlotSeries1D(Plot* p_parent, float* pa_xData, float* pa_data, int size, Color color);
+	PlotSeries1D(Plot* p_parent, DataBuffer* p_buffer, float lower, float upper, Color color);
 
 public:
 	void onUpdate() override;
@@ -32,5 +67,13 @@ public:
 
 	void setBounds(float lower, float upper);
 
+	void setData(float* pa_data, int size);
+	void setData(float* pa_xData, float* pa_data, int size);
+	void invalidateXData();
+
 	void setHead(int head);
+
+private:
+	void calculateAxisX();
+	void decimate(float left, float right, int nColumns);
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "Widgets/PlotSeries.h"
+#include "Widgets/PlotSeries1D.h"
+#include "Widgets/Plot.h"
+
+#include <vector>
+
+// Plot series of several channels sharing one array of x values (e.g. the channels of a scope
+// or a family of curves over the same frequencies). The x values can be spaced arbitrarily,
+// they are transformed to axis space once for all channels and the points of all channels are
+// stored structure-of-arrays. If the x values aren't ascending (e.g. another signal in XY mode)
+// the points are drawn in the order given.
+class GUI_API PlotSeries2D : public PlotSeries {
+
+private:
+	float* mpa_xData;
+	std::vector<float*> mpa_yData; // y values of every channel
+
+	int m_size;
+
+	// points with a valid x in axis space (e.g. not left of zero on a logarithmic axis),
+	// only recalculated if the x data or the axis scale change
+	std::vector<float> m_validX;
+	std::vector<int> m_validIndices; // index of every valid point in the data
+	AxisScale m_axisXScale;
+	bool m_axisXSorted;
+	bool m_axisXValid;
+
+	// y of the valid points in axis space, all channels one after the other
+	// (a y without a valid value is NaN and skipped per channel)
+	std::vector<float> m_validY;
+	AxisScale m_axisYScale;
+
+	// visible points including the nearest point on both sides and the first point of every
+	// pixel column (shared by all channels, empty if the points are passed as they are),
+	// only recalculated if the x data, the x bounds or the number of columns change
+	int m_begin;
+	int m_end;
+	std::vector<int> m_columns;
+	float m_decimatedLeft;
+	float m_decimatedRight;
+	int m_decimatedColumns;
+	bool m_columnsValid;
+	bool m_decimationValid;
+
+	// points passed to the implementation of the current channel
+	std::vector<float> m_pointsX;
+	std::vector<float> m_pointsY;
+
+protected:
+	std::vector<PlotSeries1DImpl*> mp_channelImpls;
+
+public:
+	PlotSeries2D(Plot* p_parent, float* pa_xData, int size);
+	~PlotSeries2D();
+
+public:
+	void onUpdate() override;
+
+	void onPaint(Math::Rect& available) override;
+
+	void setColor(Color color) override;
+	void setColor(int channel, Color color);
+
+	int addChannel(float* pa_yData, Color color);
+	int getChannelCount();
+
+	void setXData(float* pa_xData, int size);
+	void setYData(int channel, float* pa_yData);
+	void invalidateXData();
+
+private:
+	void calculateAxisX();
+	void calculateAxisY(int channel);
+	void calculateColumns(float left, float right, int nColumns);
+	void decimate(int channel);
+};
\ No newline at end of file
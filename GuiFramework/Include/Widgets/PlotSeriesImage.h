@@ -0,0 +1,46 @@
+#pragma once
+#include "Widgets/PlotSeries.h"
+
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessPlotSeriesImageImpl.h"
+	using PlotSeriesImageImpl = HeadlessPlotSeriesImageImpl;
+#elif defined(WIN32)
+	#include "Platform/Win32/Win32PlotSeriesImageImpl.h"
+	using PlotSeriesImageImpl = Win32PlotSeriesImageImpl;
+#endif
+
+// Plot series that draws an image (e.g. an intensity graded map) into a rectangle of plot space.
+// The columns of the image can be a ring (e.g. a scrolling spectrogram), the column at the
+// offset is drawn at the left edge, that way scrolling only needs the new columns uploaded.
+class GUI_API PlotSeriesImage : public PlotSeries {
+
+private:
+	unsigned int* mpa_pixels; // premultiplied 0xAARRGGBB, first row is the top of the image
+
+	int m_width;
+	int m_height;
+	int m_offset; // column drawn at the left edge
+
+	Math::Rect m_bounds; // plot space rectangle covered by the image
+
+protected:
+	PlotSeriesImageImpl m_plotSeriesImageImpl;
+
+public:
+	PlotSeriesImage(Plot* p_parent, unsigned int* pa_pixels, int width, int height, Math::Rect bounds);
+
+public:
+	void onUpdate() override;
+
+	void onPaint(Math::Rect& available) override;
+
+	void setColor(Color color) override;
+
+	void updateColumns(int first, int count);
+
+	void setPixels(unsigned int* pa_pixels, int width, int height);
+	void setOffset(int offset);
+
+	void setBounds(Math::Rect bounds);
+	void setXBounds(float left, float right);
+};
\ No newline at end of file
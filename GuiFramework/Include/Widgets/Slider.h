@@ -1,7 +1,10 @@
 #pragma once
 #include "Widgets/TextBox.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessSliderImpl.h"
+	using SliderImpl = HeadlessSliderImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32SliderImpl.h"
 	using SliderImpl = Win32SliderImpl;
 #endif
@@ -2,7 +2,10 @@
 #include "Widgets/Widget.h"
 #include "Common/Signal.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessTextBoxImpl.h"
+	using TextBoxImpl = HeadlessTextBoxImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32TextBoxImpl.h"
 	using TextBoxImpl = Win32TextBoxImpl;
 #endif
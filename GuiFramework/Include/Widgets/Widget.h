@@ -7,7 +7,10 @@
 #include "Style/WidgetStyle.h"
 #include "Style/Style.h"
 
-#ifdef WIN32
+#if defined(GUI_HEADLESS)
+	#include "Platform/Headless/HeadlessWidgetImpl.h"
+	using WidgetImpl = HeadlessWidgetImpl;
+#elif defined(WIN32)
 	#include "Platform/Win32/Win32WidgetImpl.h"
 	using WidgetImpl = Win32WidgetImpl;
 #endif
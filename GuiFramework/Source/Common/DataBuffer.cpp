@@ -0,0 +1,145 @@
+#include "Gui.h"
+#include "Common/DataBuffer.h"
+
+DataView::DataView() : mp_frame(nullptr) { }
+
+DataView::DataView(DataFrame* p_frame) : mp_frame(p_frame) {
+
+	if (mp_frame != nullptr) {
+		mp_frame->nViews.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+DataView::DataView(const DataView& other) : DataView(other.mp_frame) { }
+
+DataView::~DataView() {
+
+	// release, that way all reads of the frame happen before the producer writes it again
+	if (mp_frame != nullptr) {
+		mp_frame->nViews.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+DataView& DataView::operator=(const DataView& other) {
+
+	if (other.mp_frame != nullptr) {
+		other.mp_frame->nViews.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (mp_frame != nullptr) {
+		mp_frame->nViews.fetch_sub(1, std::memory_order_release);
+	}
+
+	mp_frame = other.mp_frame;
+	return *this;
+}
+
+float* DataView::getData() {
+
+	return mp_frame != nullptr ? mp_frame->data.data() : nullptr;
+}
+
+int DataView::getSize() {
+
+	return mp_frame != nullptr ? mp_frame->data.size() : 0;
+}
+
+unsigned long long DataView::getVersion() {
+
+	return mp_frame != nullptr ? mp_frame->version : 0;
+}
+
+bool DataView::isValid() {
+
+	return mp_frame != nullptr;
+}
+
+DataBuffer::DataBuffer(int size) : mp_writing(nullptr), m_size(size), m_version(0) {
+
+	for (int i = 0; i < 3; ++i) {
+
+		DataFrame* p_frame = new DataFrame();
+		p_frame->data.resize(m_size, 0.0f);
+		p_frame->version = 0;
+		p_frame->nViews = 0;
+
+		mp_frames.push_back(p_frame);
+	}
+
+	// readers always get a frame (zeros until the first one is published)
+	mp_published = mp_frames[0];
+}
+
+DataBuffer::~DataBuffer() {
+
+	// all views have to be released before the buffer
+	for (DataFrame* p_frame : mp_frames) {
+		delete p_frame;
+	}
+}
+
+float* DataBuffer::beginWrite() {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (mp_writing != nullptr) {
+		return mp_writing->data.data();
+	}
+
+	// take a frame that is neither published nor held by a view
+	// (acquire, that way the reads of the last view are finished)
+	for (DataFrame* p_frame : mp_frames) {
+
+		if (p_frame != mp_published && p_frame->nViews.load(std::memory_order_acquire) == 0) {
+			mp_writing = p_frame;
+			break;
+		}
+	}
+
+	// only happens if readers hold views of more than one old frame
+	if (mp_writing == nullptr) {
+
+		mp_writing = new DataFrame();
+		mp_writing->data.resize(m_size, 0.0f);
+		mp_writing->nViews = 0;
+
+		mp_frames.push_back(mp_writing);
+	}
+
+	mp_writing->version = m_version + 1;
+	return mp_writing->data.data();
+}
+
+void DataBuffer::publish() {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (mp_writing == nullptr) {
+		return;
+	}
+
+	m_version = mp_writing->version;
+
+	mp_published = mp_writing;
+	mp_writing = nullptr;
+}
+
+DataView DataBuffer::read() {
+
+	// the view is created while locked, that way the producer can't take the frame in between
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return DataView(mp_published);
+}
+
+int DataBuffer::getSize() {
+
+	return m_size;
+}
+
+unsigned long long DataBuffer::getVersion() {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_version;
+}
\ No newline at end of file
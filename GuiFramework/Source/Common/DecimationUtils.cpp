@@ -0,0 +1,161 @@
+#include "Gui.h"
+#include "Common/DecimationUtils.h"
+
+#include <algorithm>
+#include <math.h>
+#include <immintrin.h>
+
+// minimum and maximum of an array four values at a time (NaN values are ignored, the first value must be valid)
+static void getMinMax(float* pa_data, int size, float& minValue, float& maxValue) {
+
+	__m128 minimum = _mm_set1_ps(pa_data[0]);
+	__m128 maximum = minimum;
+
+	int i = 0;
+	for (; i + 4 <= size; i += 4) {
+
+		// the second operand is returned if one of them is NaN
+		__m128 x = _mm_loadu_ps(pa_data + i);
+		minimum = _mm_min_ps(x, minimum);
+		maximum = _mm_max_ps(x, maximum);
+	}
+
+	// reduce the four lanes
+	minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+	minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+	maximum = _mm_max_ps(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(1, 0, 3, 2)));
+	maximum = _mm_max_ps(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	minValue = _mm_cvtss_f32(minimum);
+	maxValue = _mm_cvtss_f32(maximum);
+
+	// remaining values (comparisons with NaN are false)
+	for (; i < size; ++i) {
+
+		if (pa_data[i] < minValue) {
+			minValue = pa_data[i];
+		}
+		if (pa_data[i] > maxValue) {
+			maxValue = pa_data[i];
+		}
+	}
+}
+
+// appends all valid points between first and last
+static void addPoints(float* pa_x, float* pa_y, int first, int last, std::vector<float>& pointsX, std::vector<float>& pointsY) {
+
+	for (int i = first; i < last; ++i) {
+		if (!isnan(pa_y[i])) {
+			pointsX.push_back(pa_x[i]);
+			pointsY.push_back(pa_y[i]);
+		}
+	}
+}
+
+// appends the first, minimum, maximum and last valid point of a pixel column
+static void addColumn(float* pa_x, float* pa_y, int first, int last, std::vector<float>& pointsX, std::vector<float>& pointsY) {
+
+	// columns with up to four points are passed as they are
+	if (last - first <= PLOTSERIES_POINTS_PER_COLUMN) {
+		addPoints(pa_x, pa_y, first, last, pointsX, pointsY);
+		return;
+	}
+
+	// first and last valid point (a column without one adds nothing)
+	while (first < last && isnan(pa_y[first])) {
+		++first;
+	}
+	while (last > first && isnan(pa_y[last - 1])) {
+		--last;
+	}
+
+	if (first == last) {
+		return;
+	}
+
+	float minY;
+	float maxY;
+	getMinMax(pa_y + first, last - first, minY, maxY);
+
+	float firstY = pa_y[first];
+	float lastY = pa_y[last - 1];
+
+	// go to the nearer extreme first, all points lie within the same pixel column
+	bool minFirst = fabsf(firstY - minY) < fabsf(firstY - maxY);
+
+	pointsX.push_back(pa_x[first]);
+	pointsY.push_back(firstY);
+
+	pointsX.push_back(pa_x[first]);
+	pointsY.push_back(minFirst ? minY : maxY);
+
+	pointsX.push_back(pa_x[last - 1]);
+	pointsY.push_back(minFirst ? maxY : minY);
+
+	pointsX.push_back(pa_x[last - 1]);
+	pointsY.push_back(lastY);
+}
+
+void findColumns(float* pa_x, int size, bool sorted, float left, float right, int nColumns, int& begin, int& end,
+	std::vector<int>& columns) {
+
+	columns.clear();
+
+	// visible points including the nearest point on both sides, that way lines leave the plot correctly
+	begin = 0;
+	end = size;
+
+	if (sorted) {
+		begin = max((int)(std::lower_bound(pa_x, pa_x + size, left) - pa_x) - 1, 0);
+		end = min((int)(std::upper_bound(pa_x, pa_x + size, right) - pa_x) + 1, size);
+	}
+
+	// columns are only used if there are more points than pixels
+	if (!sorted || end - begin <= PLOTSERIES_POINTS_PER_COLUMN * nColumns || right <= left) {
+		return;
+	}
+
+	int i = begin;
+
+	// point left of the plot
+	if (pa_x[i] < left) {
+		++i;
+	}
+
+	columns.push_back(i);
+
+	// a point belongs to the column it is mapped to (the same mapping as the transform of the plot)
+	float scale = nColumns / (right - left);
+
+	for (int c = 0; c < nColumns && i < end; ++c) {
+
+		// points of this column end at the first point mapped right of it (the last column includes the right edge)
+		i = std::partition_point(pa_x + i, pa_x + end, [&](float x) {
+			return x <= right && (c == nColumns - 1 || (int)((x - left) * scale) <= c);
+		}) - pa_x;
+
+		columns.push_back(i);
+	}
+}
+
+void decimateM4(float* pa_x, float* pa_y, int begin, int end, std::vector<int>& columns, std::vector<float>& pointsX,
+	std::vector<float>& pointsY) {
+
+	// few points (or points that aren't sorted) are passed as they are
+	if (columns.empty()) {
+		addPoints(pa_x, pa_y, begin, end, pointsX, pointsY);
+		return;
+	}
+
+	// point left of the plot
+	addPoints(pa_x, pa_y, begin, columns.front(), pointsX, pointsY);
+
+	for (int c = 0; c + 1 < (int)columns.size(); ++c) {
+		addColumn(pa_x, pa_y, columns[c], columns[c + 1], pointsX, pointsY);
+	}
+
+	// point right of the plot
+	if (columns.back() < end) {
+		addPoints(pa_x, pa_y, end - 1, end, pointsX, pointsY);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "Gui.h"
+#include "Common/ImageUtils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+static unsigned int crc32(unsigned char* pa_data, size_t size, unsigned int crc) {
+
+	// table of all byte values (reflected polynomial 0xEDB88320)
+	static unsigned int s_table[256] = { };
+
+	if (s_table[1] == 0) {
+		for (unsigned int n = 0; n < 256; ++n) {
+
+			unsigned int c = n;
+			for (int k = 0; k < 8; ++k) {
+				c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			}
+
+			s_table[n] = c;
+		}
+	}
+
+	for (size_t i = 0; i < size; ++i) {
+		crc = s_table[(crc ^ pa_data[i]) & 0xFF] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+static void appendBigEndian(std::vector<unsigned char>& data, unsigned int value) {
+
+	data.push_back(value >> 24);
+	data.push_back(value >> 16);
+	data.push_back(value >> 8);
+	data.push_back(value);
+}
+
+static void writeChunk(std::ofstream& file, const char* p_type, std::vector<unsigned char>& data) {
+
+	// length, type, data and crc of type and data
+	std::vector<unsigned char> chunk;
+	appendBigEndian(chunk, data.size());
+	chunk.insert(chunk.end(), p_type, p_type + 4);
+	chunk.insert(chunk.end(), data.begin(), data.end());
+
+	unsigned int crc = crc32(chunk.data() + 4, chunk.size() - 4, 0xFFFFFFFF) ^ 0xFFFFFFFF;
+	appendBigEndian(chunk, crc);
+
+	file.write((char*)chunk.data(), chunk.size());
+}
+
+bool writePNG(std::wstring path, unsigned int* pa_pixels, int width, int height) {
+
+	std::ofstream file(std::filesystem::path(path), std::ios::binary);
+
+	if (!file) {
+		return false;
+	}
+
+	// signature
+	const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	file.write((char*)signature, 8);
+
+	// header (8 bit rgba, no interlacing)
+	std::vector<unsigned char> header;
+	appendBigEndian(header, width);
+	appendBigEndian(header, height);
+	header.insert(header.end(), { 8, 6, 0, 0, 0 });
+
+	writeChunk(file, "IHDR", header);
+
+	// rows of straight rgba, every one starts with filter type 0
+	std::vector<unsigned char> raw;
+	raw.reserve((size_t)height * (4 * width + 1));
+
+	for (int r = 0; r < height; ++r) {
+
+		raw.push_back(0);
+
+		for (int c = 0; c < width; ++c) {
+
+			unsigned int pixel = pa_pixels[r * width + c];
+			unsigned int alpha = pixel >> 24;
+
+			// undo premultiplication
+			for (int shift = 16; shift >= 0; shift -= 8) {
+				unsigned int value = (pixel >> shift) & 0xFF;
+				raw.push_back(alpha == 0 ? 0 : min(value * 255 / alpha, 255u));
+			}
+
+			raw.push_back(alpha);
+		}
+	}
+
+	// zlib stream of stored deflate blocks (at most 65535 bytes each)
+	std::vector<unsigned char> image = { 0x78, 0x01 };
+
+	size_t first = 0;
+	do {
+
+		unsigned int size = min(raw.size() - first, (size_t)65535);
+		bool last = first + size == raw.size();
+
+		image.push_back(last ? 1 : 0);
+		image.push_back(size & 0xFF);
+		image.push_back(size >> 8);
+		image.push_back(~size & 0xFF);
+		image.push_back((~size >> 8) & 0xFF);
+		image.insert(image.end(), raw.begin() + first, raw.begin() + first + size);
+
+		first += size;
+
+	} while (first < raw.size());
+
+	// adler-32 checksum of the uncompressed data
+	unsigned int a = 1, b = 0;
+	for (unsigned char value : raw) {
+		a = (a + value) % 65521;
+		b = (b + a) % 65521;
+	}
+
+	appendBigEndian(image, (b << 16) | a);
+
+	writeChunk(file, "IDAT", image);
+
+	std::vector<unsigned char> end;
+	writeChunk(file, "IEND", end);
+
+	return file.good();
+}
\ No newline at end of file
@@ -22,3 +22,8 @@ bool Math::pointInRect(Rect rect, Point2D point) {
 
 	return rect.left() < point.x() && rect.right() > point.x() && rect.top() < point.y() && rect.bottom() > point.y();
 }
+
+bool Math::rectsOverlap(Rect a, Rect b) {
+
+	return a.left() < b.right() && b.left() < a.right() && a.top() < b.bottom() && b.top() < a.bottom();
+}
\ No newline at end of file
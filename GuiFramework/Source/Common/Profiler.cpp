@@ -0,0 +1,202 @@
+#include "Gui.h"
+
+#ifdef GUI_PROFILE
+
+#include "Common/Profiler.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+Profiler::Profiler() : m_next(0), m_frame(0), m_nThreads(0), m_start(std::chrono::steady_clock::now()) {
+
+	mpa_slots = new ProfileSlot[PROFILER_CAPACITY];
+
+	for (int i = 0; i < PROFILER_CAPACITY; ++i) {
+		mpa_slots[i].sequence.store(0, std::memory_order_relaxed);
+	}
+}
+
+Profiler::~Profiler() {
+
+	delete[] mpa_slots;
+}
+
+Profiler& Profiler::getInstance() {
+
+	static Profiler profiler;
+	return profiler;
+}
+
+long long Profiler::getTime() {
+
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void Profiler::record(const char* name, const void* p_object, long long begin, long long end) {
+
+	// take the next slot (overwrites the oldest event)
+	unsigned long long index = m_next.fetch_add(1, std::memory_order_relaxed);
+	ProfileSlot& slot = mpa_slots[index & (PROFILER_CAPACITY - 1)];
+
+	// mark as written, that way readers skip the slot
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.event.name = name;
+	slot.event.p_object = p_object;
+	slot.event.begin = begin;
+	slot.event.end = end;
+	slot.event.frame = m_frame.load(std::memory_order_relaxed);
+	slot.event.thread = getThread();
+
+	// publish
+	slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::nextFrame() {
+
+	m_frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<ProfileEvent> Profiler::getEvents() {
+
+	std::vector<ProfileEvent> events;
+	events.reserve(PROFILER_CAPACITY);
+
+	for (int i = 0; i < PROFILER_CAPACITY; ++i) {
+
+		ProfileSlot& slot = mpa_slots[i];
+
+		unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence == 0) {
+			continue;
+		}
+
+		ProfileEvent event = slot.event;
+
+		// skip events overwritten while copying
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+			events.push_back(event);
+		}
+	}
+
+	// sort by time, that way the trace is in order
+	std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b) { return a.begin < b.begin; });
+
+	return events;
+}
+
+float Profiler::getPercentile(const char* name, float percentile) {
+
+	// collect durations of all events with this name (in ms)
+	std::vector<float> durations;
+
+	for (ProfileEvent& event : getEvents()) {
+		if (strcmp(event.name, name) == 0) {
+			durations.push_back((event.end - event.begin) / 1e6f);
+		}
+	}
+
+	if (durations.empty()) {
+		return 0.0f;
+	}
+
+	// nearest rank
+	int rank = (int)ceilf(min(max(percentile, 0.0f), 100.0f) / 100.0f * durations.size());
+	int index = min(max(rank - 1, 0), (int)durations.size() - 1);
+
+	std::nth_element(durations.begin(), durations.begin() + index, durations.end());
+	return durations[index];
+}
+
+void Profiler::printSummary() {
+
+	std::vector<ProfileEvent> events = getEvents();
+
+	// collect names in order of appearance
+	std::vector<const char*> names;
+
+	for (ProfileEvent& event : events) {
+
+		bool found = false;
+		for (const char* name : names) {
+			found = found || strcmp(name, event.name) == 0;
+		}
+
+		if (!found) {
+			names.push_back(event.name);
+		}
+	}
+
+	printf("%-40s %8s %10s %10s %10s %10s\n", "scope", "count", "p50 ms", "p95 ms", "p99 ms", "max ms");
+
+	for (const char* name : names) {
+
+		int count = 0;
+		for (ProfileEvent& event : events) {
+			count += strcmp(event.name, name) == 0;
+		}
+
+		printf("%-40s %8d %10.3f %10.3f %10.3f %10.3f\n", name, count,
+			getPercentile(name, 50.0f), getPercentile(name, 95.0f), getPercentile(name, 99.0f), getPercentile(name, 100.0f));
+	}
+}
+
+bool Profiler::saveTrace(std::wstring path) {
+
+	// write chrome trace event format (open with chrome://tracing or perfetto)
+	std::ofstream file{ std::filesystem::path(path) };
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	file << "{\"traceEvents\":[";
+
+	bool first = true;
+	char line[512];
+
+	for (ProfileEvent& event : getEvents()) {
+
+		// complete events with time stamps in us
+		snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"object\":\"%p\",\"frame\":%d}}",
+			first ? "" : ",", event.name, event.begin / 1e3, (event.end - event.begin) / 1e3, event.thread, event.p_object, event.frame);
+
+		file << line;
+		first = false;
+	}
+
+	file << "\n]}\n";
+
+	return true;
+}
+
+int Profiler::getThread() {
+
+	// number threads in order of their first event
+	thread_local int thread = -1;
+
+	if (thread < 0) {
+		thread = m_nThreads.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return thread;
+}
+
+ProfileScope::ProfileScope(const char* name, const void* p_object) : m_name(name), mp_object(p_object) {
+
+	m_begin = Profiler::getInstance().getTime();
+}
+
+ProfileScope::~ProfileScope() {
+
+	Profiler& profiler = Profiler::getInstance();
+	profiler.record(m_name, mp_object, m_begin, profiler.getTime());
+}
+
+#endif
\ No newline at end of file
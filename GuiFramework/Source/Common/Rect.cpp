@@ -7,7 +7,9 @@ Math::Rect::Rect(float left, float right, float top, float bottom) : m_topLeft(M
 
 Math::Rect::Rect(Point2D& topLeft, Point2D& bottomRight) : m_topLeft(topLeft), m_bottomRight(bottomRight) { }
 
+#ifdef WIN32
 Math::Rect::Rect(RECT& rect) : Rect(rect.left, rect.right, rect.top, rect.bottom) { }
+#endif
 
 float& Math::Rect::left() {
 	return m_topLeft.x();
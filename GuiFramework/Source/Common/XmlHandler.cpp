@@ -2,6 +2,7 @@
 #include "Common/XmlHandler.h"
 
 #include <sstream>
+#include <filesystem>
 #include <stdexcept>
 
 
@@ -14,7 +15,7 @@ XmlHandler::XmlHandler(std::wstring path) : m_path(path), mp_root(new Element{ .
 void XmlHandler::readXml() {
 
 	// open file
-	std::ifstream file(m_path);
+	std::ifstream file{ std::filesystem::path(m_path) };
 
 	// return if file is empty
 	if (file.peek() == EOF) { return; }
@@ -31,7 +32,7 @@ void XmlHandler::readXml() {
 void XmlHandler::writeXml() {
 
 	// create ofstream
-	std::ofstream file(m_path);
+	std::ofstream file{ std::filesystem::path(m_path) };
 
 	// write header
 	file << XML_HEADER << '\n';
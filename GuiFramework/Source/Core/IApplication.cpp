@@ -1,23 +1,53 @@
 #include "Gui.h"
 #include "Core/IApplication.h"
+#include "Common/Profiler.h"
 
 IApplication::IApplication(int argc, char** argv) : mp_mainWindow(nullptr) { }
 
-void IApplication::onTick(float deltaTime) {
+bool IApplication::onSchedule(double time) {
 
-	if (mp_mainWindow != nullptr) {
-		mp_mainWindow->onTick(deltaTime);
+	m_scheduler.setTime(time);
+
+	float deltaTime;
+
+	// tick functionals first, that way their updates are shown in the same frame
+	if (m_scheduler.isTickDue(deltaTime)) {
+		onTick(deltaTime);
+	}
+
+	if (m_scheduler.isRenderDue(deltaTime)) {
+		onRender(deltaTime);
+		return true;
 	}
 
+	return false;
+}
+
+void IApplication::onTick(float deltaTime) {
+
+	PROFILE_SCOPE("IApplication::onTick")
+
 	for (IFunctional* p_functional : mp_functionals) {
+		PROFILE_SCOPE_OBJECT("IFunctional::onTick", p_functional)
 		p_functional->onTick(deltaTime);
 	}
 }
 
+void IApplication::onRender(float deltaTime) {
+
+	PROFILE_FRAME()
+	PROFILE_SCOPE("IApplication::onRender")
+
+	if (mp_mainWindow != nullptr) {
+		mp_mainWindow->onTick(deltaTime);
+	}
+}
+
 void IApplication::onBegin() {
 	
 	// load all members of functional classes
 	for (IFunctional* p_functional : mp_functionals) {
+		p_functional->mp_scheduler = &m_scheduler;
 		p_functional->loadMembers(getIniPath());
 		p_functional->onBegin();
 	}
@@ -39,3 +69,13 @@ void IApplication::setMainWindow(MainWindow* p_mainWindow) {
 
 	mp_mainWindow = p_mainWindow;
 }
+
+void IApplication::setTickRate(float rate) {
+
+	m_scheduler.setTickRate(rate);
+}
+
+void IApplication::setRenderRate(float rate) {
+
+	m_scheduler.setRenderRate(rate);
+}
@@ -1,2 +1,12 @@
 #include "Gui.h"
-#include "Core/IFunctional.h"
\ No newline at end of file
+#include "Core/IFunctional.h"
+
+IFunctional::IFunctional() : mp_scheduler(nullptr) { }
+
+void IFunctional::requestWakeup(float delay) {
+
+	// ask for a tick in delay seconds (e.g. before an audio buffer runs empty)
+	if (mp_scheduler != nullptr) {
+		mp_scheduler->requestWakeup(delay);
+	}
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Core/MainWindow.h"
 #include "Core/Graphics2D.h"
+#include "Common/Profiler.h"
 
 #include "Widgets/Layout.h"
 #include "Widgets/DropDown.h"
@@ -12,12 +13,15 @@
 // define all types that should be able to be created
 template MainWindow* IWindow::create(std::wstring title);
 
-IWindow::IWindow() : mp_graphics(nullptr), mp_layout(nullptr), m_rect(Math::Rect(0.f, 0.f, 0.f, 0.f)), m_layoutMouseHover(false), m_dropDownMouseHover(false) { }
+IWindow::IWindow() : mp_graphics(nullptr), m_rect(Math::Rect(0.f, 0.f, 0.f, 0.f)), mp_layout(nullptr), mp_dropDown(nullptr), m_layoutMouseHover(false), m_dropDownMouseHover(false),
+	m_repaintedArea(0.0f), m_nRepaintedRects(0) { }
 
 void IWindow::setLayout(Layout* p_layout) {
 
 	mp_layout = p_layout;
 	mp_layout->onResize(m_rect);
+
+	invalidateRect(m_rect);
 }
 
 void IWindow::registerDropDown(DropDown* p_dropDown) {
@@ -27,6 +31,7 @@ void IWindow::registerDropDown(DropDown* p_dropDown) {
 
 	// add new dropdown
 	mp_dropDown = p_dropDown;
+	invalidateRect(mp_dropDown->getHitbox());
 }
 
 Graphics2D* IWindow::getGraphics() {
@@ -34,23 +39,41 @@ Graphics2D* IWindow::getGraphics() {
 	return mp_graphics;
 }
 
+void IWindow::invalidateRect(Math::Rect rect) {
+
+	// only the visible part has to be painted
+	rect = Math::minRect(rect, m_rect);
+
+	if (rect.getWidth() > 0.0f && rect.getHeight() > 0.0f) {
+		m_dirtyRects.push_back(rect);
+	}
+}
+
+float IWindow::getRepaintedArea() {
+
+	return m_repaintedArea;
+}
+
+int IWindow::getRepaintedRectCount() {
+
+	return m_nRepaintedRects;
+}
+
 void IWindow::onTick(float deltaTime) {
 
-	// begin painting
-	mp_graphics->beginPaint();
+	PROFILE_SCOPE("IWindow::onTick")
 
-	// update layout
+	// update layout and dropdown (frames request the regions to repaint)
 	if (mp_layout != nullptr) {
 		mp_layout->onTick(deltaTime);
 	}
 
-	// draw dropdown
 	if (mp_dropDown != nullptr) {
-		mp_dropDown->onPaint();
+		mp_dropDown->onTick(deltaTime);
 	}
 
-	// end painting
-	mp_graphics->endPaint();
+	// paint requested regions only
+	paintDirtyRects();
 }
 
 void IWindow::onBegin() {
@@ -65,6 +88,12 @@ void IWindow::onBegin() {
 
 void IWindow::onPaint() {
 
+	// everything is painted, so no region is left
+	m_dirtyRects.clear();
+
+	m_repaintedArea = m_rect.getWidth() * m_rect.getHeight();
+	m_nRepaintedRects = 1;
+
 	// begin painting
 	mp_graphics->beginPaint();
 
@@ -102,6 +131,9 @@ void IWindow::onResize(Math::Rect rect) {
 
 	// delete dropdown if it exists
 	unregisterDropDown();
+
+	// everything moved
+	invalidateRect(m_rect);
 }
 
 void IWindow::onMouseMove(Math::Point2D point) {
@@ -227,11 +259,97 @@ void IWindow::onKeyDown(char key) {
 void IWindow::unregisterDropDown() {
 
 	if (mp_dropDown != nullptr) {
+
+		// repaint what was below the dropdown
+		invalidateRect(mp_dropDown->getHitbox());
+
 		delete mp_dropDown;
 		mp_dropDown = nullptr;
+	}
+}
+
+void IWindow::paintDirtyRects() {
+
+	PROFILE_SCOPE("IWindow::paintDirtyRects")
+
+	coalesceDirtyRects();
+
+	// take the regions, that way frames can request regions for the next tick while painting
+	m_paintRects.swap(m_dirtyRects);
+	m_dirtyRects.clear();
+
+	m_repaintedArea = 0.0f;
+	m_nRepaintedRects = m_paintRects.size();
+
+	// nothing changed, the last frame is still valid
+	if (m_paintRects.empty()) {
+		return;
+	}
+
+	// begin painting
+	mp_graphics->beginPaint();
+
+	for (Math::Rect& rect : m_paintRects) {
+
+		// only frames intersecting the region are painted (clipped to it)
+		mp_graphics->pushClip(rect);
+
+		if (mp_layout != nullptr) {
+			mp_layout->onPaintRegion(rect);
+		}
+
+		if (mp_dropDown != nullptr) {
+			mp_dropDown->onPaintRegion(rect);
+		}
+
+		mp_graphics->popClip();
+
+		m_repaintedArea += rect.getWidth() * rect.getHeight();
+	}
+
+	// end painting
+	mp_graphics->endPaint();
+}
+
+void IWindow::coalesceDirtyRects() {
+
+	// merge regions whose bounding box isn't much larger than both of them (e.g. requests
+	// of the same frame or of neighbouring frames), that way they are painted once
+	bool merged = true;
+
+	while (merged) {
+
+		merged = false;
+
+		for (int i = 0; i < (int)m_dirtyRects.size() && !merged; ++i) {
+			for (int j = i + 1; j < (int)m_dirtyRects.size() && !merged; ++j) {
+
+				Math::Rect& a = m_dirtyRects[i];
+				Math::Rect& b = m_dirtyRects[j];
+				Math::Rect bounds = Math::maxRect(a, b);
+
+				float area = a.getWidth() * a.getHeight() + b.getWidth() * b.getHeight();
+
+				if (bounds.getWidth() * bounds.getHeight() <= WINDOW_DIRTY_MERGE_RATIO * area) {
+
+					a = bounds;
+					m_dirtyRects.erase(m_dirtyRects.begin() + j);
+					merged = true;
+				}
+			}
+		}
+	}
+
+	// many small regions cost more than their bounding box
+	if (m_dirtyRects.size() > WINDOW_MAX_DIRTY_RECTS) {
+
+		Math::Rect bounds = m_dirtyRects[0];
+
+		for (Math::Rect& rect : m_dirtyRects) {
+			bounds = Math::maxRect(bounds, rect);
+		}
 
-		// repaint all
-		onPaint();
+		m_dirtyRects.assign(1, bounds);
 	}
 }
 
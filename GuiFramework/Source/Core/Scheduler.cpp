@@ -0,0 +1,81 @@
+#include "Gui.h"
+#include "Core/Scheduler.h"
+
+Scheduler::Scheduler() : m_time(0.0), m_tickInterval(1.0 / SCHEDULER_TICK_RATE), m_renderInterval(1.0 / SCHEDULER_RENDER_RATE),
+	m_nextTick(0.0), m_nextRender(0.0), m_lastTick(0.0), m_lastRender(0.0) { }
+
+void Scheduler::start(double time) {
+
+	// tick and render immediately
+	m_time = time;
+
+	m_nextTick = time;
+	m_nextRender = time;
+
+	m_lastTick = time;
+	m_lastRender = time;
+}
+
+void Scheduler::setTime(double time) {
+
+	m_time = time;
+}
+
+void Scheduler::setTickRate(float rate) {
+
+	m_tickInterval = 1.0 / max(rate, 1.0f);
+}
+
+void Scheduler::setRenderRate(float rate) {
+
+	m_renderInterval = 1.0 / max(rate, 1.0f);
+}
+
+void Scheduler::requestWakeup(float delay) {
+
+	// tick earlier than planned (later requests are covered by the regular ticks)
+	m_nextTick = min(m_nextTick, m_time + max(delay, 0.0f));
+}
+
+bool Scheduler::isTickDue(float& deltaTime) {
+
+	if (m_time < m_nextTick) {
+		return false;
+	}
+
+	deltaTime = (float)(m_time - m_lastTick);
+	m_lastTick = m_time;
+
+	advance(m_nextTick, m_tickInterval);
+	return true;
+}
+
+bool Scheduler::isRenderDue(float& deltaTime) {
+
+	if (m_time < m_nextRender) {
+		return false;
+	}
+
+	deltaTime = (float)(m_time - m_lastRender);
+	m_lastRender = m_time;
+
+	advance(m_nextRender, m_renderInterval);
+	return true;
+}
+
+double Scheduler::getTimeout() {
+
+	// time until the next tick or frame
+	return max(min(m_nextTick, m_nextRender) - m_time, 0.0);
+}
+
+void Scheduler::advance(double& next, double interval) {
+
+	// keep the phase, that way the rate doesn't drift with late wakeups
+	next += interval;
+
+	// skip missed deadlines instead of catching up with a burst
+	if (next <= m_time) {
+		next = m_time + interval;
+	}
+}
\ No newline at end of file
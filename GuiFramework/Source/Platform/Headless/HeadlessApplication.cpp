@@ -0,0 +1,124 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessApplication.h"
+#include "Common/Profiler.h"
+
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+HeadlessApplication::HeadlessApplication(int argc, char** argv) : IApplication(argc, argv), m_nFrames(HEADLESS_FRAMES), m_realtime(false) {
+
+	setRenderRate(HEADLESS_FRAME_RATE);
+
+	// read arguments
+	for (int i = 1; i < argc; ++i) {
+
+		if (strcmp(argv[i], "--realtime") == 0) {
+			m_realtime = true;
+		}
+		else if (i + 1 == argc) {
+			break;
+		}
+		else if (strcmp(argv[i], "--frames") == 0) {
+			m_nFrames = max(atoi(argv[++i]), 0);
+		}
+		else if (strcmp(argv[i], "--png") == 0) {
+
+			// paths are expected to be ascii
+			char* p_path = argv[++i];
+			m_pngPath = std::wstring(p_path, p_path + strlen(p_path));
+		}
+		else if (strcmp(argv[i], "--trace") == 0) {
+
+			char* p_path = argv[++i];
+			m_tracePath = std::wstring(p_path, p_path + strlen(p_path));
+		}
+	}
+}
+
+int HeadlessApplication::exec() {
+
+	// call onBegin
+	onBegin();
+
+	// run the scheduler and measure the time
+	long long nPixels = 0;
+	double repaintedArea = 0.0;
+	std::chrono::time_point<std::chrono::steady_clock> begin = std::chrono::steady_clock::now();
+
+	double time = 0.0;
+	m_scheduler.start(time);
+
+	clock_t beginCPU = clock();
+
+	for (int i = 0; i < m_nFrames;) {
+
+		// ticks of the functionals only don't count as a frame
+		if (onSchedule(time)) {
+
+			++i;
+
+			if (mp_mainWindow != nullptr) {
+
+				repaintedArea += mp_mainWindow->getRepaintedArea();
+
+				// the pixel count is only reset if the window painted something
+				if (mp_mainWindow->getRepaintedRectCount() > 0) {
+					nPixels += mp_mainWindow->getGraphics()->getPixelCount();
+				}
+			}
+		}
+
+		// wait for the next deadline
+		if (m_realtime) {
+
+			std::this_thread::sleep_for(std::chrono::duration<double>(m_scheduler.getTimeout()));
+
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+			time = elapsed.count();
+		}
+		else {
+			time += m_scheduler.getTimeout();
+		}
+	}
+
+	std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - begin;
+	double durationCPU = 1000.0 * (clock() - beginCPU) / CLOCKS_PER_SEC;
+
+	// report paint costs (cpu time is lower than the time per frame if the scheduler slept)
+	if (m_nFrames > 0) {
+		printf("%d frames, %.3f ms per frame, %.3f ms cpu per frame, %lld pixels per frame, %.0f repainted area per frame\n",
+			m_nFrames, duration.count() / m_nFrames, durationCPU / m_nFrames, nPixels / m_nFrames, repaintedArea / m_nFrames);
+	}
+
+	// report timings of the profiled scopes
+	PROFILE_PRINT_SUMMARY()
+
+	if (!m_tracePath.empty()) {
+		PROFILE_SAVE_TRACE(m_tracePath)
+	}
+
+	// save screenshot
+	if (mp_mainWindow != nullptr && !m_pngPath.empty()) {
+		mp_mainWindow->savePNG(m_pngPath);
+	}
+
+	// call onClose
+	onClose();
+
+	return 0;
+}
+
+std::wstring HeadlessApplication::getIniPath() {
+
+	// keep settings in the working directory, that way runs don't touch the settings of the user
+	return getApplicationName() + L".ini";
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessButtonImpl.h"
+
+HeadlessButtonImpl::HeadlessButtonImpl(Graphics2D* p_graphics, WidgetStyle style) : AButtonImpl(p_graphics, style) { }
+
+void HeadlessButtonImpl::onPaint(WidgetState widgetState) {
+
+	// draw background
+	mp_graphics->fillRoundedRect(m_rect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getFillColor(widgetState));
+	mp_graphics->drawRoundedRect(m_rect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getEdgeColor(), m_style.getEdgeThickness());
+}
+
+void HeadlessButtonImpl::onResize(Math::Rect hitboxRect) {
+
+	m_rect = hitboxRect;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessCheckBoxImpl.h"
+
+HeadlessCheckBoxImpl::HeadlessCheckBoxImpl(Graphics2D* p_graphics, WidgetStyle style) : ACheckBoxImpl(p_graphics, style) { }
+
+void HeadlessCheckBoxImpl::onResize(Math::Rect textRect, Math::Rect boxRect) {
+
+	m_textRect = textRect;
+	m_boxRect = boxRect;
+}
+
+void HeadlessCheckBoxImpl::onPaint(std::wstring text, WidgetState widgetState) {
+
+	// draw box
+	mp_graphics->fillRoundedRect(m_boxRect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getFillColor(widgetState));
+	mp_graphics->drawRoundedRect(m_boxRect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getEdgeColor(), m_style.getEdgeThickness());
+
+	// draw text
+	mp_graphics->drawText(text, m_textRect, m_style.getTextAlignment(), m_style.getFontSize(), m_style.getTextColor());
+}
+
+#endif
\ No newline at end of file
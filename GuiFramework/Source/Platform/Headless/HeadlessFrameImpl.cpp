@@ -0,0 +1,25 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessFrameImpl.h"
+#include "Style/Palette.h"
+
+HeadlessFrameImpl::HeadlessFrameImpl(Graphics2D* p_graphics) : AFrameImpl(p_graphics) { }
+
+void HeadlessFrameImpl::onPaint() {
+
+	// draw debug rectangles
+	mp_graphics->drawRect(m_usedRect, Palette::Debug1(), 1.0f);
+	mp_graphics->drawRect(m_hitboxRect, Palette::Debug2(), 1.0f);
+	mp_graphics->drawRect(m_contentRect, Palette::Debug3(), 1.0f);
+}
+
+void HeadlessFrameImpl::onResize(Math::Rect usedRect, Math::Rect hitboxRect, Math::Rect contentRect) {
+
+	m_usedRect = usedRect;
+	m_hitboxRect = hitboxRect;
+	m_contentRect = contentRect;
+}
+
+#endif
\ No newline at end of file
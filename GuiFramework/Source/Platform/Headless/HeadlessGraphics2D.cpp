@@ -0,0 +1,553 @@
+#include "Gui.h"
+#include "Platform/Headless/HeadlessGraphics2D.h"
+#include "Common/ImageUtils.h"
+
+#include <math.h>
+#include <algorithm>
+#include <cwctype>
+
+// horizontal extent of a rounded rectangle at the height y (radii: top left, top right, bottom left, bottom right)
+static void getRoundedSpan(Math::Rect& rect, float* pa_radii, float y, float& left, float& right) {
+
+	left = rect.left();
+	right = rect.right();
+
+	// the corners are circles, so the inset grows towards the top and bottom edge
+	auto inset = [](float radius, float distance) {
+		return radius - sqrtf(max(radius * radius - distance * distance, 0.0f));
+	};
+
+	if (y < rect.top() + pa_radii[0]) {
+		left += inset(pa_radii[0], rect.top() + pa_radii[0] - y);
+	}
+	if (y > rect.bottom() - pa_radii[2]) {
+		left += inset(pa_radii[2], y - rect.bottom() + pa_radii[2]);
+	}
+	if (y < rect.top() + pa_radii[1]) {
+		right -= inset(pa_radii[1], rect.top() + pa_radii[1] - y);
+	}
+	if (y > rect.bottom() - pa_radii[3]) {
+		right -= inset(pa_radii[3], y - rect.bottom() + pa_radii[3]);
+	}
+}
+
+HeadlessGraphics2D::HeadlessGraphics2D(int width, int height, float dpiScale) : m_width(0), m_height(0), m_dpiScale(dpiScale),
+	mp_layer(nullptr), m_scaleX(1.0f), m_scaleY(1.0f), m_dx(0.0f), m_dy(0.0f), m_nPixels(0) {
+
+	setCanvasSize(width, height);
+}
+
+HeadlessGraphics2D::~HeadlessGraphics2D() { }
+
+void HeadlessGraphics2D::beginPaint() {
+
+	// only count the pixels of this frame
+	m_nPixels = 0;
+
+	resetTransform();
+	m_clipRects.assign(1, Math::Rect(0.0f, (float)m_width, 0.0f, (float)m_height));
+}
+
+void HeadlessGraphics2D::endPaint() {
+
+	// clips that weren't released don't leak into the next frame
+	m_clipRects.resize(1);
+}
+
+void HeadlessGraphics2D::createGraphicsAssets() {
+
+	// nothing to create, the framebuffer exists as long as the canvas
+}
+
+void HeadlessGraphics2D::discardGraphicsAssets() { }
+
+void HeadlessGraphics2D::resizeCanvas() {
+
+	// the size is given by the window (setCanvasSize), nothing else depends on it
+}
+
+void HeadlessGraphics2D::setCanvasSize(int width, int height) {
+
+	m_width = max(width, 1);
+	m_height = max(height, 1);
+
+	m_pixels.assign(m_width * m_height, 0);
+	m_clipRects.assign(1, Math::Rect(0.0f, (float)m_width, 0.0f, (float)m_height));
+}
+
+Math::Rect HeadlessGraphics2D::getDPISize() {
+
+	return Math::Rect(0, m_width / m_dpiScale, 0, m_height / m_dpiScale);
+}
+
+float HeadlessGraphics2D::getDPIScale() {
+
+	return m_dpiScale;
+}
+
+void HeadlessGraphics2D::fillRect(Math::Rect rect, Color color) {
+
+	Math::Rect pixelRect = toPixelRect(rect);
+	unsigned int pixel = premultiply(color);
+
+	for (int y = (int)ceilf(pixelRect.top() - 0.5f); y < (int)ceilf(pixelRect.bottom() - 0.5f); ++y) {
+		fillSpan(y, pixelRect.left(), pixelRect.right(), pixel);
+	}
+}
+
+void HeadlessGraphics2D::drawRect(Math::Rect rect, Color color, float thickness) {
+
+	drawRoundedRect(rect, 0.0f, 0.0f, 0.0f, 0.0f, color, thickness);
+}
+
+void HeadlessGraphics2D::fillRoundedRect(Math::Rect rect, float topLeftRadius, float topRightRadius, float bottomLeftRadius, float bottomRightRadius, Color color) {
+
+	float a_radii[4] = { topLeftRadius * m_dpiScale, topRightRadius * m_dpiScale, bottomLeftRadius * m_dpiScale, bottomRightRadius * m_dpiScale };
+
+	fillRoundedSpans(toPixelRect(rect), a_radii, nullptr, nullptr, premultiply(color));
+}
+
+void HeadlessGraphics2D::drawRoundedRect(Math::Rect rect, float topLeftRadius, float topRightRadius, float bottomLeftRadius, float bottomRightRadius, Color color, float thickness) {
+
+	Math::Rect pixelRect = toPixelRect(rect);
+	float a_radii[4] = { topLeftRadius, topRightRadius, bottomLeftRadius, bottomRightRadius };
+
+	// the edge is centered on the outline (at least one pixel wide)
+	float halfWidth = max(thickness * m_dpiScale, 1.0f) / 2;
+
+	Math::Rect outerRect(pixelRect.left() - halfWidth, pixelRect.right() + halfWidth, pixelRect.top() - halfWidth, pixelRect.bottom() + halfWidth);
+	Math::Rect innerRect(pixelRect.left() + halfWidth, pixelRect.right() - halfWidth, pixelRect.top() + halfWidth, pixelRect.bottom() - halfWidth);
+
+	float a_outerRadii[4];
+	float a_innerRadii[4];
+
+	for (int i = 0; i < 4; ++i) {
+		a_outerRadii[i] = a_radii[i] > 0.0f ? a_radii[i] * m_dpiScale + halfWidth : 0.0f;
+		a_innerRadii[i] = max(a_radii[i] * m_dpiScale - halfWidth, 0.0f);
+	}
+
+	bool hasInside = innerRect.getWidth() > 0.0f && innerRect.getHeight() > 0.0f;
+
+	fillRoundedSpans(outerRect, a_outerRadii, a_innerRadii, hasInside ? &innerRect : nullptr, premultiply(color));
+}
+
+void HeadlessGraphics2D::drawLine(Math::Point2D a, Math::Point2D b, Color color, float thickness) {
+
+	float a_x[2] = { a.x(), b.x() };
+	float a_y[2] = { a.y(), b.y() };
+
+	drawPolyline(a_x, a_y, 2, color, thickness);
+}
+
+void HeadlessGraphics2D::drawPolyline(float* pa_x, float* pa_y, int size, Color color, float thickness) {
+
+	unsigned int pixel = premultiply(color);
+
+	// the width isn't transformed (at least one pixel wide)
+	float halfWidth = max(thickness * m_dpiScale, 1.0f) / 2;
+
+	for (int i = 0; i + 1 < size; ++i) {
+
+		float ax = toPixelX(pa_x[i]);
+		float ay = toPixelY(pa_y[i]);
+		float bx = toPixelX(pa_x[i + 1]);
+		float by = toPixelY(pa_y[i + 1]);
+
+		float length = sqrtf((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+
+		if (length == 0.0f) {
+			continue;
+		}
+
+		// every segment is a rectangle around the line (flat caps)
+		float nx = -(by - ay) / length * halfWidth;
+		float ny = (bx - ax) / length * halfWidth;
+
+		float a_x[4] = { ax + nx, bx + nx, bx - nx, ax - nx };
+		float a_y[4] = { ay + ny, by + ny, by - ny, ay - ny };
+
+		fillPixelPolygon(a_x, a_y, 4, pixel);
+	}
+}
+
+void HeadlessGraphics2D::fillPolygon(float* pa_x, float* pa_y, int size, Color color) {
+
+	std::vector<float> x(size);
+	std::vector<float> y(size);
+
+	for (int i = 0; i < size; ++i) {
+		x[i] = toPixelX(pa_x[i]);
+		y[i] = toPixelY(pa_y[i]);
+	}
+
+	fillPixelPolygon(x.data(), y.data(), size, premultiply(color));
+}
+
+void HeadlessGraphics2D::drawText(std::wstring text, Math::Rect rect, Alignment alignment, float fontSize, Color color) {
+
+	if (text.empty()) {
+		return;
+	}
+
+	// measure the line
+	float advance = fontSize * HEADLESS_GLYPH_ADVANCE;
+	float width = text.length() * advance;
+	float height = fontSize * HEADLESS_LINE_HEIGHT;
+
+	// align the line (left, center, right and top, center, bottom)
+	int horizontal = alignment % 3;
+	int vertical = alignment / 3;
+
+	float x = horizontal == 0 ? rect.left() : (horizontal == 1 ? rect.getCenter().x() - width / 2 : rect.right() - width);
+	float y = vertical == 0 ? rect.top() : (vertical == 1 ? rect.getCenter().y() - height / 2 : rect.bottom() - height);
+
+	// glyph boxes are centered in the line
+	float top = y + (height - fontSize * HEADLESS_GLYPH_HEIGHT) / 2;
+	float bottom = top + fontSize * HEADLESS_GLYPH_HEIGHT;
+
+	for (int i = 0; i < (int)text.length(); ++i) {
+
+		if (iswspace(text[i])) {
+			continue;
+		}
+
+		float left = x + i * advance;
+		fillRect(Math::Rect(left + 0.1f * advance, left + 0.9f * advance, top, bottom), color);
+	}
+}
+
+void HeadlessGraphics2D::drawImage(unsigned int* pa_pixels, int width, int height, Math::Rect sourceRect, Math::Rect destinationRect) {
+
+	Math::Rect pixelRect = toPixelRect(destinationRect);
+
+	if (pixelRect.getWidth() <= 0.0f || pixelRect.getHeight() <= 0.0f) {
+		return;
+	}
+
+	// scale of the source per destination pixel (nearest sample)
+	float scaleU = sourceRect.getWidth() / pixelRect.getWidth();
+	float scaleV = sourceRect.getHeight() / pixelRect.getHeight();
+
+	for (int y = (int)ceilf(pixelRect.top() - 0.5f); y < (int)ceilf(pixelRect.bottom() - 0.5f); ++y) {
+
+		int first;
+		int last;
+
+		if (!getSpan(y, pixelRect.left(), pixelRect.right(), first, last)) {
+			continue;
+		}
+
+		int v = min(max((int)(sourceRect.top() + (y + 0.5f - pixelRect.top()) * scaleV), 0), height - 1);
+
+		for (int x = first; x < last; ++x) {
+
+			int u = min(max((int)(sourceRect.left() + (x + 0.5f - pixelRect.left()) * scaleU), 0), width - 1);
+
+			unsigned int& dst = m_pixels[y * m_width + x];
+			dst = blend(dst, pa_pixels[v * width + u]);
+		}
+
+		m_nPixels += last - first;
+	}
+}
+
+void HeadlessGraphics2D::pushClip(Math::Rect rect) {
+
+	// clips are transformed and intersected with the active one
+	Math::Rect pixelRect = toPixelRect(rect);
+	Math::Rect clip = m_clipRects.back();
+
+	float left = max(clip.left(), pixelRect.left());
+	float right = min(clip.right(), pixelRect.right());
+	float top = max(clip.top(), pixelRect.top());
+	float bottom = min(clip.bottom(), pixelRect.bottom());
+
+	m_clipRects.push_back(Math::Rect(left, max(left, right), top, max(top, bottom)));
+}
+
+void HeadlessGraphics2D::popClip() {
+
+	if (m_clipRects.size() > 1) {
+		m_clipRects.pop_back();
+	}
+}
+
+void HeadlessGraphics2D::setTransform(float scaleX, float scaleY, float dx, float dy) {
+
+	m_scaleX = scaleX;
+	m_scaleY = scaleY;
+	m_dx = dx;
+	m_dy = dy;
+}
+
+void HeadlessGraphics2D::resetTransform() {
+
+	setTransform(1.0f, 1.0f, 0.0f, 0.0f);
+}
+
+void HeadlessGraphics2D::beginLayer(std::vector<unsigned int>& layer, Math::Rect rect) {
+
+	// layers of another canvas size are reset
+	if (layer.size() != m_pixels.size()) {
+		layer.assign(m_pixels.size(), 0);
+	}
+
+	// paint into the layer until endLayer (the layer holds the framebuffer meanwhile)
+	std::swap(m_pixels, layer);
+	mp_layer = &layer;
+
+	m_windowClipRects.swap(m_clipRects);
+	m_clipRects.assign(1, Math::Rect(0.0f, (float)m_width, 0.0f, (float)m_height));
+
+	resetTransform();
+	pushClip(rect);
+
+	// clear the rect of the layer
+	for (int y = 0; y < m_height; ++y) {
+
+		int first;
+		int last;
+
+		if (getSpan(y, 0.0f, (float)m_width, first, last)) {
+			std::fill(m_pixels.begin() + y * m_width + first, m_pixels.begin() + y * m_width + last, 0);
+		}
+	}
+}
+
+void HeadlessGraphics2D::endLayer() {
+
+	if (mp_layer == nullptr) {
+		return;
+	}
+
+	// paint into the framebuffer again
+	std::swap(m_pixels, *mp_layer);
+	mp_layer = nullptr;
+
+	m_clipRects.swap(m_windowClipRects);
+}
+
+void HeadlessGraphics2D::drawLayer(std::vector<unsigned int>& layer, Math::Rect rect) {
+
+	if (layer.size() != m_pixels.size()) {
+		return;
+	}
+
+	// composite the rect of the layer (pixels map one to one)
+	Math::Rect pixelRect = toPixelRect(rect);
+
+	for (int y = (int)ceilf(pixelRect.top() - 0.5f); y < (int)ceilf(pixelRect.bottom() - 0.5f); ++y) {
+
+		int first;
+		int last;
+
+		if (!getSpan(y, pixelRect.left(), pixelRect.right(), first, last)) {
+			continue;
+		}
+
+		unsigned int* p_row = m_pixels.data() + y * m_width;
+		unsigned int* p_layerRow = layer.data() + y * m_width;
+
+		for (int x = first; x < last; ++x) {
+			p_row[x] = blend(p_row[x], p_layerRow[x]);
+		}
+
+		m_nPixels += last - first;
+	}
+}
+
+unsigned int* HeadlessGraphics2D::getPixels() {
+
+	return m_pixels.data();
+}
+
+int HeadlessGraphics2D::getWidth() {
+
+	return m_width;
+}
+
+int HeadlessGraphics2D::getHeight() {
+
+	return m_height;
+}
+
+long long HeadlessGraphics2D::getPixelCount() {
+
+	return m_nPixels;
+}
+
+bool HeadlessGraphics2D::savePNG(std::wstring path) {
+
+	return writePNG(path, m_pixels.data(), m_width, m_height);
+}
+
+float HeadlessGraphics2D::toPixelX(float x) {
+
+	return (x * m_scaleX + m_dx) * m_dpiScale;
+}
+
+float HeadlessGraphics2D::toPixelY(float y) {
+
+	return (y * m_scaleY + m_dy) * m_dpiScale;
+}
+
+Math::Rect HeadlessGraphics2D::toPixelRect(Math::Rect rect) {
+
+	// the transform may flip an axis (e.g. the y axis of plots)
+	float left = toPixelX(rect.left());
+	float right = toPixelX(rect.right());
+	float top = toPixelY(rect.top());
+	float bottom = toPixelY(rect.bottom());
+
+	return Math::Rect(min(left, right), max(left, right), min(top, bottom), max(top, bottom));
+}
+
+bool HeadlessGraphics2D::getSpan(int y, float left, float right, int& first, int& last) {
+
+	Math::Rect& clip = m_clipRects.back();
+
+	// a pixel is covered if its center is inside
+	if (y < 0 || y >= m_height || y + 0.5f < clip.top() || y + 0.5f >= clip.bottom()) {
+		return false;
+	}
+
+	first = max((int)ceilf(max(left, clip.left()) - 0.5f), 0);
+	last = min((int)ceilf(min(right, clip.right()) - 0.5f), m_width);
+
+	return first < last;
+}
+
+void HeadlessGraphics2D::fillSpan(int y, float left, float right, unsigned int color) {
+
+	int first;
+	int last;
+
+	if (!getSpan(y, left, right, first, last)) {
+		return;
+	}
+
+	unsigned int* p_row = m_pixels.data() + y * m_width;
+
+	for (int x = first; x < last; ++x) {
+		p_row[x] = blend(p_row[x], color);
+	}
+
+	m_nPixels += last - first;
+}
+
+void HeadlessGraphics2D::fillRoundedSpans(Math::Rect rect, float* pa_radii, float* pa_innerRadii, Math::Rect* p_innerRect, unsigned int color) {
+
+	// radii can't be larger than half of the rectangle
+	float limit = min(rect.getWidth(), rect.getHeight()) / 2;
+	float a_radii[4];
+
+	for (int i = 0; i < 4; ++i) {
+		a_radii[i] = min(max(pa_radii[i], 0.0f), limit);
+	}
+
+	for (int y = (int)ceilf(rect.top() - 0.5f); y < (int)ceilf(rect.bottom() - 0.5f); ++y) {
+
+		float center = y + 0.5f;
+
+		float left;
+		float right;
+		getRoundedSpan(rect, a_radii, center, left, right);
+
+		// leave out the inside of outlines
+		if (p_innerRect != nullptr && center >= p_innerRect->top() && center < p_innerRect->bottom()) {
+
+			float innerLimit = min(p_innerRect->getWidth(), p_innerRect->getHeight()) / 2;
+			float a_innerRadii[4];
+
+			for (int i = 0; i < 4; ++i) {
+				a_innerRadii[i] = min(pa_innerRadii[i], innerLimit);
+			}
+
+			float innerLeft;
+			float innerRight;
+			getRoundedSpan(*p_innerRect, a_innerRadii, center, innerLeft, innerRight);
+
+			fillSpan(y, left, min(innerLeft, right), color);
+			fillSpan(y, max(innerRight, left), right, color);
+		}
+		else {
+			fillSpan(y, left, right, color);
+		}
+	}
+}
+
+void HeadlessGraphics2D::fillPixelPolygon(float* pa_x, float* pa_y, int size, unsigned int color) {
+
+	if (size < 3) {
+		return;
+	}
+
+	float top = *std::min_element(pa_y, pa_y + size);
+	float bottom = *std::max_element(pa_y, pa_y + size);
+
+	Math::Rect& clip = m_clipRects.back();
+
+	int firstRow = max((int)ceilf(max(top, clip.top()) - 0.5f), 0);
+	int lastRow = min((int)ceilf(min(bottom, clip.bottom()) - 0.5f), m_height);
+
+	for (int y = firstRow; y < lastRow; ++y) {
+
+		float center = y + 0.5f;
+
+		// find where the edges cross the row (the last point connects to the first one)
+		m_crossings.clear();
+
+		for (int i = 0; i < size; ++i) {
+
+			int j = i + 1 < size ? i + 1 : 0;
+
+			if ((pa_y[i] <= center) != (pa_y[j] <= center)) {
+				m_crossings.push_back(pa_x[i] + (center - pa_y[i]) / (pa_y[j] - pa_y[i]) * (pa_x[j] - pa_x[i]));
+			}
+		}
+
+		// fill between pairs of crossings (even-odd rule)
+		std::sort(m_crossings.begin(), m_crossings.end());
+
+		for (int k = 0; k + 1 < (int)m_crossings.size(); k += 2) {
+			fillSpan(y, m_crossings[k], m_crossings[k + 1], color);
+		}
+	}
+}
+
+unsigned int HeadlessGraphics2D::premultiply(Color color) {
+
+	float a = min(max(color.a, 0.0f), 1.0f);
+
+	unsigned int alpha = (unsigned int)(a * 255.0f + 0.5f);
+	unsigned int red = (unsigned int)(min(max(color.r, 0.0f), 1.0f) * a * 255.0f + 0.5f);
+	unsigned int green = (unsigned int)(min(max(color.g, 0.0f), 1.0f) * a * 255.0f + 0.5f);
+	unsigned int blue = (unsigned int)(min(max(color.b, 0.0f), 1.0f) * a * 255.0f + 0.5f);
+
+	return (alpha << 24) | (red << 16) | (green << 8) | blue;
+}
+
+unsigned int HeadlessGraphics2D::blend(unsigned int dst, unsigned int src) {
+
+	unsigned int alpha = src >> 24;
+
+	if (alpha == 255) {
+		return src;
+	}
+	if (alpha == 0) {
+		return dst;
+	}
+
+	// source over (both premultiplied)
+	unsigned int result = 0;
+
+	for (int shift = 0; shift < 32; shift += 8) {
+
+		unsigned int s = (src >> shift) & 0xFF;
+		unsigned int d = (dst >> shift) & 0xFF;
+
+		result |= min(s + (d * (255 - alpha) + 127) / 255, 255u) << shift;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessLabelImpl.h"
+
+HeadlessLabelImpl::HeadlessLabelImpl(Graphics2D* p_graphics, WidgetStyle style) : ALabelImpl(p_graphics, style) { }
+
+void HeadlessLabelImpl::onPaint(std::wstring text) {
+
+	// draw text
+	mp_graphics->drawText(text, m_rect, m_style.getTextAlignment(), m_style.getFontSize(), m_style.getTextColor());
+}
+
+void HeadlessLabelImpl::onResize(Math::Rect contentRect) {
+
+	m_rect = contentRect;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessLayoutImpl.h"
+
+HeadlessLayoutImpl::HeadlessLayoutImpl(Graphics2D* p_graphics, WidgetStyle style) : ALayoutImpl(p_graphics, style) { }
+
+void HeadlessLayoutImpl::onPaint(Math::Rect usedRect) {
+
+	// draw background
+	mp_graphics->fillRect(usedRect, m_style.getFillColor(WidgetState::Normal));
+}
+
+#endif
\ No newline at end of file
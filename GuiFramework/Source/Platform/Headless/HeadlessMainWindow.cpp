@@ -0,0 +1,12 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessMainWindow.h"
+
+HeadlessMainWindow* HeadlessMainWindow::create(std::wstring title) {
+
+	return HeadlessWindow::create<HeadlessMainWindow>(title);
+}
+
+#endif
\ No newline at end of file
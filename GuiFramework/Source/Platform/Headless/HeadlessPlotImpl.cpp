@@ -0,0 +1,120 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessPlotImpl.h"
+
+HeadlessPlotImpl::HeadlessPlotImpl(Graphics2D* p_graphics, WidgetStyle style) : APlotImpl(p_graphics, style) { }
+
+void HeadlessPlotImpl::onResize(Math::Rect plotRect, Math::Rect legendRect) {
+
+	m_plotRect = plotRect;
+	m_legendRect = legendRect;
+}
+
+bool HeadlessPlotImpl::beginStaticLayer(Math::Rect rect) {
+
+	// a layer of another canvas size can't be composited anymore
+	if (m_layerValid && (int)m_layer.size() == mp_graphics->getWidth() * mp_graphics->getHeight()) {
+		return false;
+	}
+
+	m_layerRect = rect;
+
+	// redirect painting into the layer
+	mp_graphics->beginLayer(m_layer, rect);
+	return true;
+}
+
+void HeadlessPlotImpl::endStaticLayer() {
+
+	mp_graphics->endLayer();
+	m_layerValid = true;
+}
+
+void HeadlessPlotImpl::drawStaticLayer() {
+
+	if (m_layerValid) {
+		mp_graphics->drawLayer(m_layer, m_layerRect);
+	}
+}
+
+void HeadlessPlotImpl::onPaintAxis(std::wstring xAxisText, std::wstring yAxisText) {
+
+	// calculate coordinates
+	Math::Point2D origin(m_plotRect.left() - 10, m_plotRect.bottom() + 10);
+	Math::Point2D x_axis(m_plotRect.right(), m_plotRect.bottom() + 10);
+	Math::Point2D y_axis(m_plotRect.left() - 10, m_plotRect.top());
+
+	// draw axis
+	drawArrow(origin, x_axis, 10.0f);
+	drawArrow(origin, y_axis, 10.0f);
+
+	// calculate label rectangles
+	Math::Rect xAxisRect(x_axis.x() - 40.0f, x_axis.x() + 40.0f, x_axis.y() + 10.0f, x_axis.y() + 25.0f);
+	Math::Rect yAxisRect(y_axis.x() - 40.0f, y_axis.x() + 40.0f, y_axis.y() - 25.0f, y_axis.y() - 10.0f);
+
+	// draw labels
+	mp_graphics->drawText(xAxisText, xAxisRect, Alignment::Center, m_style.getFontSize(), m_style.getTextColor());
+	mp_graphics->drawText(yAxisText, yAxisRect, Alignment::Center, m_style.getFontSize(), m_style.getTextColor());
+}
+
+void HeadlessPlotImpl::onPaintHorizontalTicks(float value, std::wstring text) {
+
+	// calculate coordinates
+	Math::Point2D lineBegin = Math::Point2D(m_plotRect.left(), value);
+	Math::Point2D lineEnd = Math::Point2D(m_plotRect.right(), value);
+
+	Math::Point2D tickBegin = lineBegin - Math::Point2D(15, 0);
+	Math::Point2D tickEnd = lineBegin - Math::Point2D(5, 0);
+	Math::Rect textRect(lineBegin.x() - 55, lineBegin.x() - 20, lineBegin.y() - 10, lineBegin.y() + 10);
+
+	// draw line
+	mp_graphics->drawLine(lineBegin, lineEnd, m_style.getTextColor(), m_style.getEdgeThickness());
+
+	// draw tick
+	mp_graphics->drawLine(tickBegin, tickEnd, m_style.getTextColor(), m_style.getEdgeThickness());
+
+	// draw text
+	mp_graphics->drawText(text, textRect, Alignment::CenterRight, m_style.getFontSize(), m_style.getTextColor());
+}
+
+void HeadlessPlotImpl::onPaintVerticalTicks(float value, std::wstring text) {
+
+	// calculate coordinates
+	Math::Point2D lineBegin = Math::Point2D(value, m_plotRect.bottom());
+	Math::Point2D lineEnd = Math::Point2D(value, m_plotRect.top());
+
+	Math::Point2D tickBegin = lineBegin + Math::Point2D(0, 15);
+	Math::Point2D tickEnd = lineBegin + Math::Point2D(0, 5);
+	Math::Rect textRect(lineBegin.x() - 20, lineBegin.x() + 20, lineBegin.y() + 20, lineBegin.y() + 40);
+
+	// draw line
+	mp_graphics->drawLine(lineBegin, lineEnd, m_style.getTextColor(), m_style.getEdgeThickness());
+
+	// draw tick
+	mp_graphics->drawLine(tickBegin, tickEnd, m_style.getTextColor(), m_style.getEdgeThickness());
+
+	// draw text
+	mp_graphics->drawText(text, textRect, Alignment::Center, m_style.getFontSize(), m_style.getTextColor());
+}
+
+void HeadlessPlotImpl::drawArrow(Math::Point2D a, Math::Point2D b, float size) {
+
+	// calculate arrow head
+	Math::Point2D base = b - a;
+	base = base / base.length() * size;
+
+	// calculate corners
+	Math::Point2D c = b - base + Math::Point2D(-base.y(), base.x()) / 2;
+	Math::Point2D d = b - base + Math::Point2D(base.y(), -base.x()) / 2;
+
+	float a_x[3] = { b.x(), c.x(), d.x() };
+	float a_y[3] = { b.y(), c.y(), d.y() };
+
+	// draw
+	mp_graphics->drawLine(a, b, m_style.getTextColor(), m_style.getEdgeThickness());
+	mp_graphics->fillPolygon(a_x, a_y, 3, m_style.getTextColor());
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessPlotSeries1DImpl.h"
+#include "Common/Profiler.h"
+
+HeadlessPlotSeries1DImpl::HeadlessPlotSeries1DImpl(Graphics2D* p_graphics, Color color) : APlotSeries1DImpl(p_graphics, color) { }
+
+void HeadlessPlotSeries1DImpl::onUpdate(float* pa_x, float* pa_y, int size) {
+
+	PROFILE_SCOPE_OBJECT("HeadlessPlotSeries1DImpl::onUpdate", this)
+
+	m_x.assign(pa_x, pa_x + size);
+	m_y.assign(pa_y, pa_y + size);
+}
+
+void HeadlessPlotSeries1DImpl::onPaint(Math::Rect availableRect, Math::Rect plotBounds, bool fillArea) {
+
+	// create transform
+	float scaleX = availableRect.getWidth() / plotBounds.getWidth();
+	float scaleY = availableRect.getHeight() / plotBounds.getHeight();
+	float dx = availableRect.left() - plotBounds.left() / plotBounds.getWidth() * availableRect.getWidth();
+	float dy = availableRect.bottom() - plotBounds.bottom() / plotBounds.getHeight() * availableRect.getHeight();
+
+	// set transform
+	mp_graphics->setTransform(scaleX, scaleY, dx, dy);
+
+	// set mask
+	mp_graphics->pushClip(plotBounds);
+
+	// draw (the fill closes the line implicitly)
+	mp_graphics->drawPolyline(m_x.data(), m_y.data(), m_x.size(), m_color, 1.0f);
+
+	if (fillArea) {
+		mp_graphics->fillPolygon(m_x.data(), m_y.data(), m_x.size(), m_color.makeTransparent(0.2f));
+	}
+
+	// release mask
+	mp_graphics->popClip();
+
+	// release transform
+	mp_graphics->resetTransform();
+}
+
+void HeadlessPlotSeries1DImpl::setColor(Color color) {
+
+	m_color = color;
+}
+
+#endif
\ No newline at end of file
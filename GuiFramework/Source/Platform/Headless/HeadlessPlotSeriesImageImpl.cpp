@@ -0,0 +1,64 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessPlotSeriesImageImpl.h"
+
+HeadlessPlotSeriesImageImpl::HeadlessPlotSeriesImageImpl(Graphics2D* p_graphics) : APlotSeriesImageImpl(p_graphics), m_width(0), m_height(0) { }
+
+void HeadlessPlotSeriesImageImpl::onUpdate(unsigned int* pa_pixels, int width, int height) {
+
+	m_pixels.assign(pa_pixels, pa_pixels + width * height);
+
+	m_width = width;
+	m_height = height;
+}
+
+void HeadlessPlotSeriesImageImpl::onUpdateColumns(unsigned int* pa_pixels, int width, int height, int first, int count) {
+
+	// the whole image has to be copied once
+	if (m_width != width || m_height != height) {
+		onUpdate(pa_pixels, width, height);
+		return;
+	}
+
+	// copy the columns (they may wrap around the right edge)
+	while (count > 0) {
+
+		int nColumns = min(count, width - first);
+
+		for (int y = 0; y < height; ++y) {
+			std::copy(pa_pixels + y * width + first, pa_pixels + y * width + first + nColumns, m_pixels.begin() + y * width + first);
+		}
+
+		first = (first + nColumns) % width;
+		count -= nColumns;
+	}
+}
+
+void HeadlessPlotSeriesImageImpl::onPaint(Math::Rect availableRect, Math::Rect imageRect, int offset) {
+
+	if (m_pixels.empty()) {
+		return;
+	}
+
+	// set mask
+	mp_graphics->pushClip(availableRect);
+
+	// draw (columns from the offset to the right edge first, then the ones from the left edge)
+	if (offset <= 0 || offset >= m_width) {
+		mp_graphics->drawImage(m_pixels.data(), m_width, m_height, Math::Rect(0, m_width, 0, m_height), imageRect);
+	}
+	else {
+
+		float split = imageRect.left() + imageRect.getWidth() * (m_width - offset) / m_width;
+
+		mp_graphics->drawImage(m_pixels.data(), m_width, m_height, Math::Rect(offset, m_width, 0, m_height), Math::Rect(imageRect.left(), split, imageRect.top(), imageRect.bottom()));
+		mp_graphics->drawImage(m_pixels.data(), m_width, m_height, Math::Rect(0, offset, 0, m_height), Math::Rect(split, imageRect.right(), imageRect.top(), imageRect.bottom()));
+	}
+
+	// release mask
+	mp_graphics->popClip();
+}
+
+#endif
\ No newline at end of file
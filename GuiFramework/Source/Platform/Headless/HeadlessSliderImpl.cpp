@@ -0,0 +1,25 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessSliderImpl.h"
+
+HeadlessSliderImpl::HeadlessSliderImpl(Graphics2D* p_graphics, WidgetStyle style) : ASliderImpl(p_graphics, style) { }
+
+void HeadlessSliderImpl::onPaint(Math::Rect sliderRect, WidgetState widgetState) {
+
+	// set mask (the hitbox without its rounded corners)
+	mp_graphics->pushClip(m_rect);
+
+	mp_graphics->fillRect(sliderRect, m_style.getHighlightColor(widgetState).makeTransparent(0.5f));
+
+	// release mask
+	mp_graphics->popClip();
+}
+
+void HeadlessSliderImpl::onResize(Math::Rect hitboxRect) {
+
+	m_rect = hitboxRect;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessTextBoxImpl.h"
+#include "Style/Palette.h"
+
+#include <math.h>
+
+HeadlessTextBoxImpl::HeadlessTextBoxImpl(Graphics2D* p_graphics, WidgetStyle style) : ATextBoxImpl(p_graphics, style) { }
+
+void HeadlessTextBoxImpl::onPaint(WidgetState widgetState) {
+
+	// draw background
+	mp_graphics->fillRoundedRect(m_hitboxRect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getFillColor(widgetState));
+	mp_graphics->drawRoundedRect(m_hitboxRect, m_style.getTopLeftRadius(), m_style.getTopRightRadius(), m_style.getBottomLeftRadius(), m_style.getBottomRightRadius(), m_style.getEdgeColor(), m_style.getEdgeThickness());
+
+	// draw text
+	mp_graphics->drawText(m_text, m_rect, m_style.getTextAlignment(), m_style.getFontSize(), m_style.getTextColor());
+}
+
+void HeadlessTextBoxImpl::onPaintCursor(int firstIndex, int lastIndex, bool dragFirstCursor, bool cursor) {
+
+	if (firstIndex == lastIndex) {
+
+		// check animation cycle
+		if (cursor) {
+			// get cursor position
+			Math::Rect rect = getCursorPosition(firstIndex);
+			mp_graphics->drawRect(rect, m_style.getTextColor(), m_style.getEdgeThickness());
+		}
+	}
+	else {
+
+		// get cursor positions
+		Math::Point2D firstCursor = getCursorPosition(firstIndex, dragFirstCursor).topLeft();
+		Math::Point2D lastCursor = getCursorPosition(lastIndex, !dragFirstCursor).bottomRight();
+		Math::Rect rect = Math::Rect(firstCursor, lastCursor);
+
+		mp_graphics->fillRect(rect, Palette::TextSelection());
+	}
+}
+
+void HeadlessTextBoxImpl::onResize(Math::Rect hitboxRect, Math::Rect contentRect) {
+
+	m_hitboxRect = hitboxRect;
+	m_rect = contentRect;
+}
+
+void HeadlessTextBoxImpl::setText(std::wstring text) {
+
+	m_text = text;
+}
+
+int HeadlessTextBoxImpl::getMousePosition(Math::Point2D point) {
+
+	// every glyph has the same advance
+	float advance = m_style.getFontSize() * HEADLESS_GLYPH_ADVANCE;
+	int position = (int)roundf((point.x() - getTextOrigin().x()) / advance);
+
+	return min(max(position, 0), (int)m_text.length());
+}
+
+Math::Rect HeadlessTextBoxImpl::getCursorPosition(int cursor, bool trailing) {
+
+	// the trailing edge is the one after the glyph
+	float advance = m_style.getFontSize() * HEADLESS_GLYPH_ADVANCE;
+	Math::Point2D origin = getTextOrigin();
+
+	float x = origin.x() + (cursor + (trailing ? 1 : 0)) * advance;
+
+	return Math::Rect(x, x, origin.y(), origin.y() + m_style.getFontSize() * HEADLESS_LINE_HEIGHT);
+}
+
+Math::Point2D HeadlessTextBoxImpl::getTextOrigin() {
+
+	// align the line like the headless graphics do
+	float width = m_text.length() * m_style.getFontSize() * HEADLESS_GLYPH_ADVANCE;
+	float height = m_style.getFontSize() * HEADLESS_LINE_HEIGHT;
+
+	int horizontal = m_style.getTextAlignment() % 3;
+	int vertical = m_style.getTextAlignment() / 3;
+
+	float x = horizontal == 0 ? m_rect.left() : (horizontal == 1 ? m_rect.getCenter().x() - width / 2 : m_rect.right() - width);
+	float y = vertical == 0 ? m_rect.top() : (vertical == 1 ? m_rect.getCenter().y() - height / 2 : m_rect.bottom() - height);
+
+	return Math::Point2D(x, y);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessWidgetImpl.h"
+#include "Style/Palette.h"
+
+HeadlessWidgetImpl::HeadlessWidgetImpl(Graphics2D* p_graphics, WidgetStyle style) : AWidgetImpl(p_graphics, style) { }
+
+void HeadlessWidgetImpl::onPaint() {
+
+	// draw background
+	mp_graphics->fillRect(m_rect, Palette::Background());
+}
+
+void HeadlessWidgetImpl::onResize(Math::Rect availableRect) {
+
+	m_rect = availableRect;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Gui.h"
+
+#ifdef GUI_HEADLESS
+
+#include "Platform/Headless/HeadlessWindow.h"
+#include "Core/Graphics2D.h"
+
+HeadlessWindow::HeadlessWindow() { }
+
+HeadlessWindow::~HeadlessWindow() {
+
+	if (mp_graphics != nullptr) {
+		onDestroy();
+		delete mp_graphics;
+	}
+}
+
+void HeadlessWindow::injectMouseMove(Math::Point2D point) {
+
+	onMouseMove(point);
+}
+
+void HeadlessWindow::injectMouseDown(bool doubleClk, Math::Point2D point) {
+
+	onMouseDown(doubleClk, point);
+}
+
+void HeadlessWindow::injectMouseRelease(Math::Point2D point) {
+
+	onMouseRelease(point);
+}
+
+void HeadlessWindow::injectMouseScroll(bool up, bool shift, bool ctr) {
+
+	onMouseScroll(up, shift, ctr);
+}
+
+void HeadlessWindow::injectKeyDown(Key key) {
+
+	onKeyDown(key);
+}
+
+void HeadlessWindow::injectKeyDown(char key) {
+
+	onKeyDown(key);
+}
+
+void HeadlessWindow::resize(int width, int height) {
+
+	// resize framebuffer and layout, then redraw all
+	mp_graphics->setCanvasSize(width, height);
+
+	onResize(mp_graphics->getDPISize());
+	onPaint();
+}
+
+void HeadlessWindow::paint() {
+
+	onPaint();
+}
+
+bool HeadlessWindow::savePNG(std::wstring path) {
+
+	return mp_graphics->savePNG(path);
+}
+
+void HeadlessWindow::initialize(std::wstring) {
+
+	// create graphics (the title isn't shown anywhere)
+	mp_graphics = new Graphics2D(HEADLESS_WINDOW_WIDTH, HEADLESS_WINDOW_HEIGHT);
+	m_rect = mp_graphics->getDPISize();
+
+	onBegin();
+}
+
+#endif
\ No newline at end of file
@@ -1,9 +1,15 @@
 #include "Gui.h"
 #include "Platform/Win32/Win32Application.h"
+#include "Common/Profiler.h"
 #include "shlobj.h"
 
 #include <chrono>
 
+// high resolution timers exist since Windows 10 1803, older versions fail to create it
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 Win32Application::Win32Application(int argc, char** argv) : IApplication(argc, argv) { }
 
 int Win32Application::exec() {
@@ -14,33 +20,68 @@ int Win32Application::exec() {
     // call onBegin
     onBegin();
 
-    // create time stamp and duration object
-    std::chrono::time_point<std::chrono::system_clock> now, lastFrame;
-    std::chrono::duration<float> deltaTime;
-    lastFrame = std::chrono::system_clock::now();
+    // render with the refresh rate of the display
+    DEVMODE mode = { };
+    mode.dmSize = sizeof(DEVMODE);
+
+    if (EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1) {
+        setRenderRate((float)mode.dmDisplayFrequency);
+    }
+
+    // create timer to wake up for the next tick or frame
+    HANDLE timer = CreateWaitableTimerEx(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (timer == NULL) {
+        timer = CreateWaitableTimerEx(NULL, NULL, 0, TIMER_ALL_ACCESS);
+    }
+
+    // create time stamp
+    std::chrono::time_point<std::chrono::steady_clock> begin = std::chrono::steady_clock::now();
+    m_scheduler.start(0.0);
 
     // get and translate windows message
     MSG msg = { };
     while (msg.message != WM_QUIT) {
 
-        if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
-            
-            // handle Windows messages
+        // handle all waiting Windows messages
+        while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE) && msg.message != WM_QUIT) {
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
-        else {
-            // measure time
-            now = std::chrono::system_clock::now();
-            deltaTime = now - lastFrame;
-
-            if (deltaTime.count() >= 1.0f / 30.0f) {
-                onTick(deltaTime.count());
-                lastFrame = now;
+
+        if (msg.message == WM_QUIT) {
+            break;
+        }
+
+        // tick functionals and render the window if due
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - begin;
+        onSchedule(time.count());
+
+        // sleep until the next deadline or a message arrives (instead of spinning)
+        double timeout = m_scheduler.getTimeout();
+
+        if (timeout > 0.0) {
+
+            // relative due time in 100 ns units
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -(LONGLONG)(timeout * 1e7);
+
+            if (timer != NULL && SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, FALSE)) {
+                MsgWaitForMultipleObjectsEx(1, &timer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
+            else {
+                MsgWaitForMultipleObjectsEx(0, NULL, (DWORD)(timeout * 1000.0), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
             }
         }
     }
 
+    if (timer != NULL) {
+        CloseHandle(timer);
+    }
+
+    // report timings (only if built with GUI_PROFILE)
+    PROFILE_PRINT_SUMMARY()
+    PROFILE_SAVE_TRACE(getApplicationName() + L"Trace.json")
+
     // call onClose
     onClose();
 
@@ -60,7 +60,7 @@ void Win32ButtonImpl::onResize(Math::Rect hitboxRect) {
 void Win32ButtonImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
 
 	if (p_renderTarget != nullptr && p_2DFactory != nullptr) {
@@ -45,7 +45,7 @@ void Win32CheckBoxImpl::onResize(Math::Rect textRect, Math::Rect boxRect) {
 void Win32CheckBoxImpl::onPaint(std::wstring text, WidgetState widgetState) {
 
     // get render target and write factory
-    ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+    ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
     // check if render target exists
     if (p_renderTarget != nullptr) {
@@ -72,7 +72,7 @@ void Win32CheckBoxImpl::onPaint(std::wstring text, WidgetState widgetState) {
 void Win32CheckBoxImpl::initGraphicsResources() {
 
     // get render target and 2d factory
-    ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+    ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
     ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
     IDWriteFactory* p_writeFactory = mp_graphics->getWriteFactory();
 
@@ -43,7 +43,7 @@ void Win32FrameImpl::onResize(Math::Rect usedRect, Math::Rect hitboxRect, Math::
 void Win32FrameImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
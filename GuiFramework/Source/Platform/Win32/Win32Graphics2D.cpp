@@ -3,7 +3,7 @@
 #include "Platform/Win32/Win32Utils.h"
 #include "Widgets/Widget.h"
 
-Win32Graphics2D::Win32Graphics2D(HWND hWnd) : m_hWnd(hWnd), mp_2DFactory(nullptr), mp_writeFactory(nullptr), mp_renderTarget(nullptr) { }
+Win32Graphics2D::Win32Graphics2D(HWND hWnd) : m_hWnd(hWnd), mp_2DFactory(nullptr), mp_writeFactory(nullptr), mp_renderTarget(nullptr), mp_layerTarget(nullptr) { }
 
 Win32Graphics2D::~Win32Graphics2D() { }
 
@@ -28,6 +28,21 @@ void Win32Graphics2D::endPaint() {
     }
 }
 
+void Win32Graphics2D::pushClip(Math::Rect rect) {
+
+    // aliased, that way neighbouring regions don't leave seams
+    if (mp_renderTarget != nullptr) {
+        mp_renderTarget->PushAxisAlignedClip(Win32Utils::D2D1Rect(rect), D2D1_ANTIALIAS_MODE_ALIASED);
+    }
+}
+
+void Win32Graphics2D::popClip() {
+
+    if (mp_renderTarget != nullptr) {
+        mp_renderTarget->PopAxisAlignedClip();
+    }
+}
+
 void Win32Graphics2D::createGraphicsAssets() {
 
     // Create D2D1 factory
@@ -52,10 +67,10 @@ void Win32Graphics2D::initGraphicsAssets() {
         GetClientRect(m_hWnd, &rc);
         D2D1_SIZE_U size = D2D1::SizeU(rc.right, rc.bottom);
 
-        // Create the render target
+        // Create the render target (contents are retained, because only dirty regions are repainted)
         hr = mp_2DFactory->CreateHwndRenderTarget(
             D2D1::RenderTargetProperties(),
-            D2D1::HwndRenderTargetProperties(m_hWnd, size),
+            D2D1::HwndRenderTargetProperties(m_hWnd, size, D2D1_PRESENT_OPTIONS_RETAIN_CONTENTS),
             &mp_renderTarget
         );
 
@@ -67,10 +82,24 @@ ID2D1Factory1* Win32Graphics2D::get2DFactory(){
     return mp_2DFactory;
 }
 
-ID2D1HwndRenderTarget* Win32Graphics2D::getRenderTarget() {
+ID2D1RenderTarget* Win32Graphics2D::getRenderTarget() {
+
+    // widget implementations paint into the layer while one is set
+    if (mp_layerTarget != nullptr) {
+        return mp_layerTarget;
+    }
+
+    return mp_renderTarget;
+}
+
+ID2D1HwndRenderTarget* Win32Graphics2D::getWindowRenderTarget() {
     return mp_renderTarget;
 }
 
+void Win32Graphics2D::setLayerTarget(ID2D1RenderTarget* p_layerTarget) {
+    mp_layerTarget = p_layerTarget;
+}
+
 IDWriteFactory* Win32Graphics2D::getWriteFactory() {
     return mp_writeFactory;
 }
@@ -106,3 +135,9 @@ Math::Rect Win32Graphics2D::getDPISize() {
         return Math::Rect();
     }
 }
+
+float Win32Graphics2D::getDPIScale() {
+
+    // pixels per device independent pixel
+    return GetDpiForWindow(m_hWnd) / ((float)USER_DEFAULT_SCREEN_DPI);
+}
@@ -17,7 +17,7 @@ Win32LabelImpl::~Win32LabelImpl() {
 void Win32LabelImpl::onPaint(std::wstring text) {
 
     // get render target and write factory
-    ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+    ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
     // check if render target exists
     if (p_renderTarget != nullptr) {
@@ -42,7 +42,7 @@ void Win32LabelImpl::onResize(Math::Rect contentRect) {
 void Win32LabelImpl::initGraphicsResources() {
 
     // get render target and write factory
-    ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+    ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
     IDWriteFactory* p_writeFactory = mp_graphics->getWriteFactory();
 
     if (p_renderTarget != nullptr && p_writeFactory != nullptr) {
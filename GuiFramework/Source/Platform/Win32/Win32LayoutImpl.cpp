@@ -31,7 +31,7 @@ void Win32LayoutImpl::onPaint(Math::Rect usedRect) {
 void Win32LayoutImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
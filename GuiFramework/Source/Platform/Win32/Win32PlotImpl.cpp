@@ -2,12 +2,15 @@
 #include "Platform/Win32/Win32PlotImpl.h"
 #include "Platform/Win32/Win32Utils.h"
 
+#include <math.h>
+
 Win32PlotImpl::Win32PlotImpl(Graphics2D* p_graphics, WidgetStyle style) :
 	APlotImpl(p_graphics, style),
 	mp_edgeBrush(nullptr), mp_fillBrush(nullptr),
 	mp_axisBrush(nullptr), mp_textBrush(nullptr),
 	mp_xTextFormat(nullptr), mp_yTextFormat(nullptr),
-	mp_pathGeometry(nullptr) {
+	mp_pathGeometry(nullptr),
+	mp_layerTarget(nullptr), mp_layerParent(nullptr), m_layerPainting(false) {
 
 	initGraphicsResources();
 }
@@ -24,6 +27,12 @@ Win32PlotImpl::~Win32PlotImpl() {
 	Win32Utils::safeRelease(&mp_yTextFormat);
 
 	Win32Utils::safeRelease(&mp_pathGeometry);
+
+	releaseTextLayouts(m_axisTextLayouts);
+	releaseTextLayouts(m_xTextLayouts);
+	releaseTextLayouts(m_yTextLayouts);
+
+	Win32Utils::safeRelease(&mp_layerTarget);
 }
 
 void Win32PlotImpl::onResize(Math::Rect plotRect, Math::Rect legendRect) {
@@ -50,6 +59,90 @@ void Win32PlotImpl::onResize(Math::Rect plotRect, Math::Rect legendRect) {
 
 }
 
+bool Win32PlotImpl::beginStaticLayer(Math::Rect rect) {
+
+	ID2D1HwndRenderTarget* p_windowTarget = mp_graphics->getWindowRenderTarget();
+
+	// without a window target there is nothing to cache, paint directly
+	if (p_windowTarget == nullptr) {
+		return true;
+	}
+
+	// whole device independent pixels, that way the layer maps to the window without filtering
+	rect = Math::Rect(floorf(rect.left()), ceilf(rect.right()), floorf(rect.top()), ceilf(rect.bottom()));
+
+	bool sizeChanged = rect.getWidth() != m_layerRect.getWidth() || rect.getHeight() != m_layerRect.getHeight();
+
+	if (m_layerValid && !sizeChanged && mp_layerTarget != nullptr && mp_layerParent == p_windowTarget) {
+		m_layerRect = rect;
+		return false;
+	}
+
+	m_layerRect = rect;
+
+	// (re)create the layer if the size or the window target changed (resources are shared with the window target)
+	if (mp_layerTarget == nullptr || sizeChanged || mp_layerParent != p_windowTarget) {
+
+		Win32Utils::safeRelease(&mp_layerTarget);
+
+		HRESULT hr = p_windowTarget->CreateCompatibleRenderTarget(D2D1::SizeF(rect.getWidth(), rect.getHeight()), &mp_layerTarget);
+
+		if (FAILED(hr)) {
+			mp_layerTarget = nullptr;
+			return true;
+		}
+
+		// the layer is transparent, so cleartype can't be used
+		mp_layerTarget->SetTextAntialiasMode(D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE);
+		mp_layerParent = p_windowTarget;
+	}
+
+	// redirect painting into the layer (in window coordinates)
+	mp_layerTarget->BeginDraw();
+	mp_layerTarget->SetTransform(D2D1::Matrix3x2F::Translation(-rect.left(), -rect.top()));
+	mp_layerTarget->Clear(D2D1::ColorF(0.0f, 0.0f, 0.0f, 0.0f));
+
+	mp_graphics->setLayerTarget(mp_layerTarget);
+	m_layerPainting = true;
+
+	return true;
+}
+
+void Win32PlotImpl::endStaticLayer() {
+
+	if (!m_layerPainting) {
+		return;
+	}
+
+	// paint into the window again
+	mp_graphics->setLayerTarget(nullptr);
+	m_layerPainting = false;
+
+	mp_layerTarget->SetTransform(D2D1::Matrix3x2F::Identity());
+	HRESULT hr = mp_layerTarget->EndDraw();
+
+	// the layer is painted again with the next paint if it failed (e.g. the device was lost)
+	m_layerValid = SUCCEEDED(hr);
+}
+
+void Win32PlotImpl::drawStaticLayer() {
+
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+
+	if (p_renderTarget == nullptr || mp_layerTarget == nullptr || !m_layerValid) {
+		return;
+	}
+
+	// composite layer
+	ID2D1Bitmap* p_bitmap = nullptr;
+
+	if (SUCCEEDED(mp_layerTarget->GetBitmap(&p_bitmap))) {
+
+		p_renderTarget->DrawBitmap(p_bitmap, Win32Utils::D2D1Rect(m_layerRect), 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+		Win32Utils::safeRelease(&p_bitmap);
+	}
+}
+
 void Win32PlotImpl::onPaintAxis(std::wstring xAxisText, std::wstring yAxisText) {
 
 	// calculate coordinates
@@ -66,15 +159,15 @@ void Win32PlotImpl::onPaintAxis(std::wstring xAxisText, std::wstring yAxisText)
 	Math::Rect yAxisRect(y_axis.x() - 40.0f, y_axis.x() + 40.0f, y_axis.y() - 25.0f, y_axis.y() - 10.0f);
 
 	// get render target
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
 		if (mp_textBrush != nullptr) {
 
 			// draw labels
-			p_renderTarget->DrawTextW(xAxisText.c_str(), xAxisText.length(), mp_xTextFormat, Win32Utils::D2D1Rect(xAxisRect), mp_textBrush);
-			p_renderTarget->DrawTextW(yAxisText.c_str(), yAxisText.length(), mp_xTextFormat, Win32Utils::D2D1Rect(yAxisRect), mp_textBrush);
+			drawText(m_axisTextLayouts, xAxisText, mp_xTextFormat, xAxisRect);
+			drawText(m_axisTextLayouts, yAxisText, mp_xTextFormat, yAxisRect);
 		}
 		else {
 			initGraphicsResources();
@@ -85,7 +178,7 @@ void Win32PlotImpl::onPaintAxis(std::wstring xAxisText, std::wstring yAxisText)
 void Win32PlotImpl::onPaintHorizontalTicks(float value, std::wstring text) {
 
 	// get render target
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
@@ -106,7 +199,7 @@ void Win32PlotImpl::onPaintHorizontalTicks(float value, std::wstring text) {
 			p_renderTarget->DrawLine(Win32Utils::D2D1Point(tickBegin), Win32Utils::D2D1Point(tickEnd), mp_axisBrush, m_style.getEdgeThickness());
 
 			// draw text
-			p_renderTarget->DrawTextW(text.c_str(), text.length(), mp_yTextFormat, Win32Utils::D2D1Rect(textRect), mp_textBrush);
+			drawText(m_yTextLayouts, text, mp_yTextFormat, textRect);
 		}
 		else {
 			initGraphicsResources();
@@ -117,7 +210,7 @@ void Win32PlotImpl::onPaintHorizontalTicks(float value, std::wstring text) {
 void Win32PlotImpl::onPaintVerticalTicks(float value, std::wstring text) {
 
 	// get render target
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
@@ -138,7 +231,7 @@ void Win32PlotImpl::onPaintVerticalTicks(float value, std::wstring text) {
 			p_renderTarget->DrawLine(Win32Utils::D2D1Point(tickBegin), Win32Utils::D2D1Point(tickEnd), mp_axisBrush, m_style.getEdgeThickness());
 
 			// draw text
-			p_renderTarget->DrawTextW(text.c_str(), text.length(), mp_xTextFormat, Win32Utils::D2D1Rect(textRect), mp_textBrush);
+			drawText(m_xTextLayouts, text, mp_xTextFormat, textRect);
 		}
 		else {
 			initGraphicsResources();
@@ -178,7 +271,7 @@ void Win32PlotImpl::drawArrow(Math::Point2D a, Math::Point2D b, float size) {
 	Math::Point2D d = b - base + Math::Point2D(base.y(), -base.x()) / 2;
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
 
 	// create triangle
@@ -228,10 +321,54 @@ void Win32PlotImpl::drawArrow(Math::Point2D a, Math::Point2D b, float size) {
 	}
 }
 
+void Win32PlotImpl::drawText(TextLayoutCache& layouts, std::wstring& text, IDWriteTextFormat* p_format, Math::Rect rect) {
+
+	// get render target and write factory
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	IDWriteFactory* p_writeFactory = mp_graphics->getWriteFactory();
+
+	if (p_renderTarget == nullptr || p_writeFactory == nullptr || p_format == nullptr || text.empty()) {
+		return;
+	}
+
+	// labels repeat on every paint, so their layouts are only created once
+	TextLayoutCache::iterator it = layouts.find(text);
+
+	if (it == layouts.end()) {
+
+		// zooming creates new labels all the time, start over instead of growing
+		if (layouts.size() >= PLOTIMPL_MAX_TEXT_LAYOUTS) {
+			releaseTextLayouts(layouts);
+		}
+
+		// create layout with the size of the text rect (rects of one kind of label have the same size)
+		IDWriteTextLayout* p_layout = nullptr;
+		HRESULT hr = p_writeFactory->CreateTextLayout(text.c_str(), text.length(), p_format, rect.getWidth(), rect.getHeight(), &p_layout);
+
+		if (FAILED(hr)) {
+			return;
+		}
+
+		it = layouts.emplace(text, p_layout).first;
+	}
+
+	// draw layout
+	p_renderTarget->DrawTextLayout(Win32Utils::D2D1Point(rect.topLeft()), it->second, mp_textBrush);
+}
+
+void Win32PlotImpl::releaseTextLayouts(TextLayoutCache& layouts) {
+
+	for (std::pair<const std::wstring, IDWriteTextLayout*>& layout : layouts) {
+		Win32Utils::safeRelease(&layout.second);
+	}
+
+	layouts.clear();
+}
+
 void Win32PlotImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 	IDWriteFactory* p_writeFactory = mp_graphics->getWriteFactory();
 	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
 
@@ -1,12 +1,13 @@
 #include "Gui.h"
 #include "Platform/Win32/Win32PlotSeries1DImpl.h"
 #include "Platform/Win32/Win32Utils.h"
+#include "Common/Profiler.h"
 
 Win32PlotSeries1DImpl::Win32PlotSeries1DImpl(Graphics2D* p_graphics, Color color) :
 	APlotSeries1DImpl(p_graphics, color),
 	
-	mp_edgeBrush(nullptr), mp_fillBrush(nullptr),
-	mp_edgePathGeometry(nullptr), mp_fillPathGeometry(nullptr) {
+	mp_edgeBrush(nullptr), mp_fillBrush(nullptr), mp_strokeStyle(nullptr),
+	mp_pathGeometry(nullptr), m_geometryValid(false) {
 
 	initGraphicsResources();
 }
@@ -15,90 +16,59 @@ Win32PlotSeries1DImpl::~Win32PlotSeries1DImpl() {
 
 	Win32Utils::safeRelease(&mp_edgeBrush);
 	Win32Utils::safeRelease(&mp_fillBrush);
+	Win32Utils::safeRelease(&mp_strokeStyle);
 
-	Win32Utils::safeRelease(&mp_edgePathGeometry);
-	Win32Utils::safeRelease(&mp_fillPathGeometry);
+	Win32Utils::safeRelease(&mp_pathGeometry);
 }
 
-void Win32PlotSeries1DImpl::onUpdate(float* pa_data, int size, int head, float lowerBound, float upperBound) {
+void Win32PlotSeries1DImpl::onUpdate(float* pa_x, float* pa_y, int size) {
 
-	if (mp_edgePathGeometry != nullptr && mp_fillPathGeometry != nullptr) {
+	PROFILE_SCOPE_OBJECT("Win32PlotSeries1DImpl::onUpdate", this)
 
-		Win32Utils::safeRelease(&mp_edgePathGeometry);
-		Win32Utils::safeRelease(&mp_fillPathGeometry);
-	}
-
-	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
-	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
-
-	// create triangle
-	ID2D1GeometrySink* p_edgeSink;
-	ID2D1GeometrySink* p_fillSink;
-	HRESULT hr;
-
-	if (p_renderTarget != nullptr && p_2DFactory != nullptr) {
-
-		// create new path geometry
-		ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
-
-
-		// create path geometry
-		p_2DFactory->CreatePathGeometry(&mp_edgePathGeometry);
-		p_2DFactory->CreatePathGeometry(&mp_fillPathGeometry);
+	// find the span of points that changed since the last update
+	int first = 0;
+	int last = size;
 
-		// Write to the path geometry using the geometry sink.
-		hr = mp_edgePathGeometry->Open(&p_edgeSink);
-		hr |= mp_fillPathGeometry->Open(&p_fillSink);
+	if (size == m_points.size()) {
 
-		if (SUCCEEDED(hr)) {
-
-			// calculate step
-			float step = (upperBound - lowerBound) / size;
-
-			// begin figure
-			p_edgeSink->BeginFigure(
-				D2D1::Point2F(lowerBound, pa_data[head]),
-				D2D1_FIGURE_BEGIN_FILLED
-			);
-			p_fillSink->BeginFigure(
-				D2D1::Point2F(lowerBound, pa_data[head]),
-				D2D1_FIGURE_BEGIN_FILLED
-			);
-
-			// add all points
-			for (int i = 1; i < size; ++i) {
-
-				// calculate index
-				int index = (head + i) % size;
-
-				p_edgeSink->AddLine(D2D1::Point2F(lowerBound + step * i, pa_data[index]));
-				p_fillSink->AddLine(D2D1::Point2F(lowerBound + step * i, pa_data[index]));
-			}
-
-			// end figure
-			p_edgeSink->EndFigure(D2D1_FIGURE_END_OPEN);
-			p_fillSink->EndFigure(D2D1_FIGURE_END_CLOSED);
+		while (first < last && m_points[first].x == pa_x[first] && m_points[first].y == pa_y[first]) {
+			++first;
+		}
+		while (last > first && m_points[last - 1].x == pa_x[last - 1] && m_points[last - 1].y == pa_y[last - 1]) {
+			--last;
+		}
 
-			p_edgeSink->Close();
-			p_fillSink->Close();
+		// nothing changed, keep the geometry
+		if (first == last && m_geometryValid) {
+			return;
 		}
+	}
+	else {
+		m_points.resize(size);
+	}
 
-		// delete resources
-		Win32Utils::safeRelease(&p_edgeSink);
-		Win32Utils::safeRelease(&p_fillSink);
+	// copy only the changed span
+	for (int i = first; i < last; ++i) {
+		m_points[i] = D2D1::Point2F(pa_x[i], pa_y[i]);
 	}
+
+	createGeometry();
 }
 
 void Win32PlotSeries1DImpl::onPaint(Math::Rect availableRect, Math::Rect plotBounds, bool fillArea) {
 
 	// get render target
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	// check if render target exists
 	if (p_renderTarget != nullptr) {
 
-		if (mp_edgeBrush != nullptr && mp_fillBrush != nullptr && mp_edgePathGeometry != nullptr && mp_fillPathGeometry != nullptr) {
+		// the geometry can't be created without a factory
+		if (!m_geometryValid) {
+			createGeometry();
+		}
+
+		if (mp_edgeBrush != nullptr && mp_fillBrush != nullptr && m_geometryValid) {
 
 			// create transform
 			float scaleX = availableRect.getWidth() / plotBounds.getWidth();
@@ -114,11 +84,11 @@ void Win32PlotSeries1DImpl::onPaint(Math::Rect availableRect, Math::Rect plotBou
 			// set mask
 			p_renderTarget->PushAxisAlignedClip(Win32Utils::D2D1Rect(plotBounds), D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-			// draw
-			p_renderTarget->DrawGeometry(mp_edgePathGeometry, mp_edgeBrush, 1.0f, mp_strokeStyle);
+			// draw (stroke and fill share the geometry)
+			p_renderTarget->DrawGeometry(mp_pathGeometry, mp_edgeBrush, 1.0f, mp_strokeStyle);
 
 			if (fillArea) {
-				p_renderTarget->FillGeometry(mp_fillPathGeometry, mp_fillBrush);
+				p_renderTarget->FillGeometry(mp_pathGeometry, mp_fillBrush);
 			}
 
 			// release mask
@@ -127,7 +97,7 @@ void Win32PlotSeries1DImpl::onPaint(Math::Rect availableRect, Math::Rect plotBou
 			// release transform
 			p_renderTarget->SetTransform(D2D1::IdentityMatrix());
 		}
-		else {
+		else if (mp_edgeBrush == nullptr || mp_fillBrush == nullptr) {
 			initGraphicsResources();
 		}
 	}
@@ -145,7 +115,7 @@ void Win32PlotSeries1DImpl::setColor(Color color) {
 void Win32PlotSeries1DImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
 
 	if (p_renderTarget != nullptr && p_2DFactory != nullptr) {
@@ -169,9 +139,41 @@ void Win32PlotSeries1DImpl::initGraphicsResources() {
 
 		// set opacity of fill brush
 		mp_fillBrush->SetOpacity(0.2);
+	}
+}
+
+void Win32PlotSeries1DImpl::createGeometry() {
+
+	// get 2d factory
+	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
+
+	if (p_2DFactory == nullptr) {
+		return;
+	}
+
+	// path geometries are immutable, so the old one is replaced
+	Win32Utils::safeRelease(&mp_pathGeometry);
+
+	ID2D1GeometrySink* p_sink;
+	HRESULT hr = p_2DFactory->CreatePathGeometry(&mp_pathGeometry);
+
+	if (SUCCEEDED(hr)) {
+		hr = mp_pathGeometry->Open(&p_sink);
+	}
 
-		// create path geometry
-		p_2DFactory->CreatePathGeometry(&mp_edgePathGeometry);
-		p_2DFactory->CreatePathGeometry(&mp_fillPathGeometry);
+	if (SUCCEEDED(hr)) {
+
+		// add all points with one call
+		if (m_points.size() > 0) {
+
+			p_sink->BeginFigure(m_points[0], D2D1_FIGURE_BEGIN_FILLED);
+			p_sink->AddLines(m_points.data() + 1, m_points.size() - 1);
+			p_sink->EndFigure(D2D1_FIGURE_END_OPEN);
+		}
+
+		hr = p_sink->Close();
+		Win32Utils::safeRelease(&p_sink);
 	}
+
+	m_geometryValid = SUCCEEDED(hr);
 }
@@ -0,0 +1,97 @@
+#include "Gui.h"
+#include "Platform/Win32/Win32PlotSeriesImageImpl.h"
+#include "Platform/Win32/Win32Utils.h"
+
+Win32PlotSeriesImageImpl::Win32PlotSeriesImageImpl(Graphics2D* p_graphics) :
+	APlotSeriesImageImpl(p_graphics),
+
+	mp_bitmap(nullptr), m_width(0), m_height(0) { }
+
+Win32PlotSeriesImageImpl::~Win32PlotSeriesImageImpl() {
+
+	Win32Utils::safeRelease(&mp_bitmap);
+}
+
+void Win32PlotSeriesImageImpl::onUpdate(unsigned int* pa_pixels, int width, int height) {
+
+	// get render target
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+
+	if (p_renderTarget != nullptr) {
+
+		// recreate bitmap if the size changed
+		if (mp_bitmap != nullptr && (m_width != width || m_height != height)) {
+			Win32Utils::safeRelease(&mp_bitmap);
+		}
+
+		if (mp_bitmap == nullptr) {
+
+			// pixels are stored as premultiplied 0xAARRGGBB
+			D2D1_BITMAP_PROPERTIES properties = D2D1::BitmapProperties(
+				D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+			);
+
+			p_renderTarget->CreateBitmap(D2D1::SizeU(width, height), pa_pixels, width * sizeof(unsigned int), properties, &mp_bitmap);
+
+			m_width = width;
+			m_height = height;
+		}
+		else {
+
+			// only upload the pixels, that way the bitmap is reused
+			mp_bitmap->CopyFromMemory(nullptr, pa_pixels, width * sizeof(unsigned int));
+		}
+	}
+}
+
+void Win32PlotSeriesImageImpl::onUpdateColumns(unsigned int* pa_pixels, int width, int height, int first, int count) {
+
+	// the whole image has to be uploaded once
+	if (mp_bitmap == nullptr || m_width != width || m_height != height) {
+		onUpdate(pa_pixels, width, height);
+		return;
+	}
+
+	// upload the columns (they may wrap around the right edge)
+	while (count > 0) {
+
+		int nColumns = min(count, width - first);
+
+		D2D1_RECT_U rect = D2D1::RectU(first, 0, first + nColumns, height);
+		mp_bitmap->CopyFromMemory(&rect, pa_pixels + first, width * sizeof(unsigned int));
+
+		first = (first + nColumns) % width;
+		count -= nColumns;
+	}
+}
+
+void Win32PlotSeriesImageImpl::onPaint(Math::Rect availableRect, Math::Rect imageRect, int offset) {
+
+	// get render target
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+
+	// check if render target and bitmap exist
+	if (p_renderTarget != nullptr && mp_bitmap != nullptr) {
+
+		// set mask
+		p_renderTarget->PushAxisAlignedClip(Win32Utils::D2D1Rect(availableRect), D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+
+		// draw (columns from the offset to the right edge first, then the ones from the left edge)
+		if (offset <= 0 || offset >= m_width) {
+			p_renderTarget->DrawBitmap(mp_bitmap, Win32Utils::D2D1Rect(imageRect), 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+		}
+		else {
+
+			float split = imageRect.left() + imageRect.getWidth() * (m_width - offset) / m_width;
+
+			D2D1_RECT_F right = D2D1::RectF(offset, 0, m_width, m_height);
+			D2D1_RECT_F left = D2D1::RectF(0, 0, offset, m_height);
+
+			p_renderTarget->DrawBitmap(mp_bitmap, D2D1::RectF(imageRect.left(), imageRect.top(), split, imageRect.bottom()), 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, right);
+			p_renderTarget->DrawBitmap(mp_bitmap, D2D1::RectF(split, imageRect.top(), imageRect.right(), imageRect.bottom()), 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, left);
+		}
+
+		// release mask
+		p_renderTarget->PopAxisAlignedClip();
+	}
+}
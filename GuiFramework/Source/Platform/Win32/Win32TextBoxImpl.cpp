@@ -170,7 +170,7 @@ Math::Rect Win32TextBoxImpl::getCursorPosition(int cursor, bool trailing) {
 void Win32TextBoxImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 	ID2D1Factory1* p_2DFactory = mp_graphics->get2DFactory();
 	IDWriteFactory* p_writeFactory = mp_graphics->getWriteFactory();
 
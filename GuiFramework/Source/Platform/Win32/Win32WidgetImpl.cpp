@@ -40,7 +40,7 @@ void Win32WidgetImpl::onResize(Math::Rect availableRect) {
 void Win32WidgetImpl::initGraphicsResources() {
 
 	// get render target and 2d factory
-	ID2D1HwndRenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
+	ID2D1RenderTarget* p_renderTarget = mp_graphics->getRenderTarget();
 
 	if (p_renderTarget != nullptr) {
 
@@ -31,6 +31,7 @@ void CheckBox::onResize(Math::Rect availableRect) {
 void CheckBox::setText(std::wstring text) {
 
 	m_text = text;
+	requestRedraw();
 }
 
 bool CheckBox::getState() {
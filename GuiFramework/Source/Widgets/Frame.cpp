@@ -1,6 +1,7 @@
 #include "Gui.h"
 #include "Widgets/Frame.h"
 #include "Style/Style.h"
+#include "Common/Profiler.h"
 
 Frame::Frame(Window* p_parent) :
 	mp_parent(p_parent),
@@ -33,6 +34,15 @@ void Frame::onPaint() {
 	m_requestRedraw = false;
 }
 
+void Frame::onPaintRegion(Math::Rect& region) {
+
+	// frames outside the region are clipped anyway
+	if (Math::rectsOverlap(m_usedRect, region)) {
+		PROFILE_SCOPE_OBJECT("Frame::onPaintRegion", this)
+		onPaint();
+	}
+}
+
 void Frame::onResize(Math::Rect availableRect) {
 
 	if (m_fillMode == FillMode::Expand) {
@@ -180,6 +190,9 @@ bool Frame::isImmediateMode() {
 void Frame::requestRedraw() {
 
 	m_requestRedraw = true;
+
+	// the window repaints the rect with the next tick
+	mp_parent->invalidateRect(m_usedRect);
 }
 
 void Frame::enableImmediateMode() {
@@ -1,5 +1,6 @@
 #include "Gui.h"
 #include "Widgets/GridLayout.h"
+#include "Common/Profiler.h"
 
 GridLayout::GridLayout(Window* p_parent, int rows, int cols) : Layout(p_parent), m_rows(rows), m_cols(cols) {
 	
@@ -40,6 +41,29 @@ void GridLayout::onPaint() {
 	Frame::onPaint();
 }
 
+void GridLayout::onPaintRegion(Math::Rect& region) {
+
+	PROFILE_SCOPE_OBJECT("GridLayout::onPaintRegion", this)
+
+	if (!Math::rectsOverlap(m_usedRect, region)) {
+		return;
+	}
+
+	// call parent function
+	Layout::onPaint();
+
+	// only frames inside the region are painted
+	for (int i = 0; i < m_size; ++i) {
+
+		if (ma_frames[i] != nullptr) {
+			ma_frames[i]->onPaintRegion(region);
+		}
+	}
+
+	// call frame paint function
+	Frame::onPaint();
+}
+
 void GridLayout::onResize(Math::Rect availableRect) {
 
 	// call parent function
@@ -139,14 +163,13 @@ void GridLayout::onResize(Math::Rect availableRect) {
 
 void GridLayout::onTick(float deltaTime) {
 
-	// iterate over all frames
+	PROFILE_SCOPE_OBJECT("GridLayout::onTick", this)
+
+	// iterate over all frames (painting is done by the window for the requested regions)
 	for (int i = 0; i < m_size; ++i) {
 
-		if (ma_frames[i] != nullptr) {
-			if (ma_frames[i]->isImmediateMode())
-				ma_frames[i]->onTick(deltaTime);
-			if (ma_frames[i]->hasRequestedRedraw())
-				ma_frames[i]->onPaint();
+		if (ma_frames[i] != nullptr && ma_frames[i]->isImmediateMode()) {
+			ma_frames[i]->onTick(deltaTime);
 		}
 	}
 }
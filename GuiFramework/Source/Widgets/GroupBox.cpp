@@ -30,6 +30,20 @@ void GroupBox::onPaint() {
 	mp_frame->onPaint();
 }
 
+void GroupBox::onPaintRegion(Math::Rect& region) {
+
+	if (!Math::rectsOverlap(m_usedRect, region)) {
+		return;
+	}
+
+	// call parent function
+	Layout::onPaint();
+
+	// paint label and frame if they are inside the region
+	mp_label->onPaintRegion(region);
+	mp_frame->onPaintRegion(region);
+}
+
 void GroupBox::onResize(Math::Rect availableRect) {
 
 	// call parent function
@@ -44,17 +58,13 @@ void GroupBox::onResize(Math::Rect availableRect) {
 
 void GroupBox::onTick(float deltaTime) {
 
-	// check label
+	// check label (painting is done by the window for the requested regions)
 	if (mp_label->isImmediateMode())
 		mp_label->onTick(deltaTime);
-	if (mp_label->hasRequestedRedraw())
-		mp_label->onPaint();
 
 	// check frame
 	if (mp_frame->isImmediateMode())
 		mp_frame->onTick(deltaTime);
-	if (mp_frame->hasRequestedRedraw())
-		mp_frame->onPaint();
 }
 
 void GroupBox::onMouseHover(Math::Point2D point) {
@@ -27,4 +27,7 @@ void Label::onResize(Math::Rect availableRect) {
 void Label::setText(std::wstring text) {
 
 	m_text = text;
+
+	// request redraw
+	requestRedraw();
 }
@@ -1,5 +1,6 @@
 #include "Gui.h"
 #include "Widgets/LinearLayout.h"
+#include "Common/Profiler.h"
 
 LinearLayout::LinearLayout(Window* p_parent, Orientation orientation) : Layout(p_parent), m_orientation(orientation) { }
 
@@ -17,6 +18,26 @@ void LinearLayout::onPaint() {
 	Frame::onPaint();
 }
 
+void LinearLayout::onPaintRegion(Math::Rect& region) {
+
+	PROFILE_SCOPE_OBJECT("LinearLayout::onPaintRegion", this)
+
+	if (!Math::rectsOverlap(m_usedRect, region)) {
+		return;
+	}
+
+	// call parent function
+	Layout::onPaint();
+
+	// only frames inside the region are painted
+	for (Frame* w : m_frames) {
+		w->onPaintRegion(region);
+	}
+
+	// call frame paint function
+	Frame::onPaint();
+}
+
 void LinearLayout::onResize(Math::Rect availableRect) {
 
 	// call parent function
@@ -80,12 +101,12 @@ void LinearLayout::onResize(Math::Rect availableRect) {
 
 void LinearLayout::onTick(float deltaTime) {
 
-	// iterate over all frames
+	PROFILE_SCOPE_OBJECT("LinearLayout::onTick", this)
+
+	// iterate over all frames (painting is done by the window for the requested regions)
 	for (Frame* w : m_frames) {
 		if (w->isImmediateMode())
 			w->onTick(deltaTime);
-		if (w->hasRequestedRedraw())
-			w->onPaint();
 	}
 }
 
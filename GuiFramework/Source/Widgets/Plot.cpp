@@ -2,6 +2,7 @@
 #include "Widgets/Plot.h"
 #include "Style/Style.h"
 #include "Common/WidgetUtils.h"
+#include "Common/Profiler.h"
 
 #include <iostream>
 #include <math.h>
@@ -15,69 +16,49 @@ Plot::Plot(Window* p_parent, std::wstring xAxis, std::wstring yAxis, WidgetStyle
 	m_xAxisScale(AxisScale::Linear), m_yAxisScale(AxisScale::Linear),
 	m_lockXZoom(false), m_lockYZoom(false),
 	m_xAxisUnit(Unit::Second), m_yAxisUnit(Unit::Volts),
+	m_ticksValid(false),
 	m_plotImpl(mp_graphics, style) { }
 
 void Plot::onPaint() {
 
-	// draw background
-	m_widgetImpl.onPaint();
+	PROFILE_SCOPE_OBJECT("Plot::onPaint", this)
 
-	// draw axis
-	m_plotImpl.onPaintAxis(m_xAxis + L" / " + unit_symbols[m_xAxisUnit], m_yAxis + L" / " + unit_symbols[m_yAxisUnit]);
+	// background, axes and ticks only change with bounds, scales, units or size, so they are
+	// painted into a layer once and composited below the plot series (which change all the time)
+	if (m_plotImpl.beginStaticLayer(m_contentRect)) {
 
-	// define prescaler
-	float prescaler_x = m_xAxisUnit == Unit::Radians ? std::numbers::pi : 1.0f;
-	float prescaler_y = m_yAxisUnit == Unit::Radians ? std::numbers::pi : 1.0f;
+		// draw background
+		m_widgetImpl.onPaint();
 
-	// get width and height
-	float width = m_plotBounds.getWidth() / prescaler_x;
-	float height = -m_plotBounds.getHeight() / prescaler_y;
-
-	// calculate step width
-	float xStep, yStep;
-	if (m_xAxisUnit == Unit::Radians) {
-		xStep = calculateTickStep(width, 4, 2, 1);
-	}
-	else {
-		xStep = calculateTickStep(width, 5, 10, 5);
-	}
-	if (m_yAxisUnit == Unit::Radians) {
-		yStep = calculateTickStep(height, 4, 2, 1);
-	}
-	else {
-		yStep = calculateTickStep(height, 5, 10, 5);
-	}
-
-	// calculate starting point
-	// shift plot bounds magnitude_x/y numer of decimal places to the left before ceiling
-	float x0 = ceil(m_plotBounds.left() / xStep / prescaler_x) * xStep;
-	float y0 = ceil(m_plotBounds.bottom() / yStep / prescaler_y) * yStep;
-
-	// create suffix (pi if unit is radians and else empty
-	std::wstring xSuffix = m_xAxisUnit == Unit::Radians ? L"\u03C0" : L"";
-	std::wstring ySuffix = m_yAxisUnit == Unit::Radians ? L"\u03C0" : L"";
-
-	// draw 25 lines
-	for (int i = 0; i < 25; ++i) {
-
-		float x = x0 + xStep * i;
-		float y = y0 + yStep * i;
-
-		Math::Point2D screenSpace = plotToScreenSpace(Math::Point2D(x * prescaler_x, y * prescaler_y));
+		// ticks and labels are only recalculated if bounds, scales or units changed
+		if (!m_ticksValid) {
+			calculateTicks();
+		}
 
-		// check if line is in plot
-		if (prescaler_x * x < m_plotBounds.right()) {
+		// draw axis
+		m_plotImpl.onPaintAxis(m_xAxisLabel, m_yAxisLabel);
 
-			m_plotImpl.onPaintVerticalTicks(screenSpace.x(), floatToString(x) + xSuffix);
+		// draw ticks (cached in axis space, that way resizing doesn't invalidate them)
+		for (PlotTick& tick : m_xTicks) {
+			float x = (tick.value - m_plotBounds.left()) / m_plotBounds.getWidth() * m_plotRect.getWidth() + m_plotRect.left();
+			m_plotImpl.onPaintVerticalTicks(x, tick.label);
 		}
-		if (prescaler_y * y < m_plotBounds.top()) {
-			m_plotImpl.onPaintHorizontalTicks(screenSpace.y(), floatToString(y) + ySuffix);
+
+		for (PlotTick& tick : m_yTicks) {
+			float y = (tick.value - m_plotBounds.bottom()) / m_plotBounds.getHeight() * m_plotRect.getHeight() + m_plotRect.bottom();
+			m_plotImpl.onPaintHorizontalTicks(y, tick.label);
 		}
+
+		m_plotImpl.endStaticLayer();
 	}
 
+	m_plotImpl.drawStaticLayer();
+
 	// plot series
 	for (PlotSeries* p_series : mp_series) {
-		p_series->onPaint(m_plotRect);
+		if (p_series->isVisible()) {
+			p_series->onPaint(m_plotRect);
+		}
 	}
 }
 
@@ -90,6 +71,7 @@ void Plot::onResize(Math::Rect availableRect) {
 
 	// update plot rect of plot implementation
 	m_plotImpl.onResize(m_plotRect, Math::Rect());
+	m_plotImpl.invalidateStaticLayer();
 }
 
 void Plot::onUpdate() {
@@ -109,6 +91,7 @@ void Plot::onMouseHover(Math::Point2D point) {
 		m_plotBounds.topLeft() += translation;
 		m_plotBounds.bottomRight() += translation;
 
+		invalidateTicks();
 		requestRedraw();
 	}
 }
@@ -142,6 +125,7 @@ void Plot::onMouseScroll(bool up, bool shift, bool ctr) {
 	}
 	m_plotBounds = Math::Rect(left, right, top, bottom);
 
+	invalidateTicks();
 	requestRedraw();
 
 	// emit signal onZoom
@@ -160,39 +144,69 @@ void Plot::setLockYZoom(bool lock) {
 
 void Plot::setXAxisScale(AxisScale scale) {
 
+	// bounds are stored in axis space, so they are converted to the new scale
+	float left = fromAxisX(m_plotBounds.left());
+	float right = fromAxisX(m_plotBounds.right());
+
 	m_xAxisScale = scale;
+
+	setPlotXBounds(left, right);
 }
 
 void Plot::setYAxisScale(AxisScale scale) {
 
+	float top = fromAxisY(m_plotBounds.top());
+	float bottom = fromAxisY(m_plotBounds.bottom());
+
 	m_yAxisScale = scale;
+
+	setPlotYBounds(top, bottom);
+}
+
+AxisScale Plot::getXAxisScale() {
+
+	return m_xAxisScale;
+}
+
+AxisScale Plot::getYAxisScale() {
+
+	return m_yAxisScale;
 }
 
 void Plot::setXUnit(Unit unit) {
 
 	m_xAxisUnit = unit;
+	invalidateTicks();
+	requestRedraw();
 }
 
 void Plot::setYUnit(Unit unit) {
 
 	m_yAxisUnit = unit;
+	invalidateTicks();
+	requestRedraw();
 }
 
 void Plot::setPlotBounds(Math::Rect bounds) {
 
-	m_plotBounds = bounds;
+	setPlotXBounds(bounds.left(), bounds.right());
+	setPlotYBounds(bounds.top(), bounds.bottom());
 }
 
 void Plot::setPlotXBounds(float left, float right) {
 
-	m_plotBounds.left() = left;
-	m_plotBounds.right() = right;
+	m_plotBounds.left() = toAxisX(left);
+	m_plotBounds.right() = toAxisX(right);
+	invalidateTicks();
+	requestRedraw();
 }
 
 void Plot::setPlotYBounds(float top, float bottom) {
 
-	m_plotBounds.top() = top;
-	m_plotBounds.bottom() = bottom;
+	m_plotBounds.top() = toAxisY(top);
+	m_plotBounds.bottom() = toAxisY(bottom);
+	invalidateTicks();
+	requestRedraw();
 }
 
 Math::Rect Plot::getPlotBounds() {
@@ -203,10 +217,14 @@ Math::Rect Plot::getPlotBounds() {
 void Plot::addPlotSeries(PlotSeries* p_plotSeries) {
 
 	mp_series.push_back(p_plotSeries);
+	requestRedraw();
 }
 
 Math::Point2D Plot::plotToScreenSpace(Math::Point2D point) {
 
+	// plot bounds are in axis space
+	point = Math::Point2D(toAxisX(point.x()), toAxisY(point.y()));
+
 	float x = (point.x() - m_plotBounds.left()) / m_plotBounds.getWidth() * m_plotRect.getWidth() + m_plotRect.left();
 	float y = (point.y() - m_plotBounds.bottom()) / m_plotBounds.getHeight() * m_plotRect.getHeight() + m_plotRect.bottom();
 
@@ -218,7 +236,28 @@ Math::Point2D Plot::screenToPlotSpace(Math::Point2D point) {
 	float x = (point.x() - m_plotRect.left()) / m_plotRect.getWidth() * m_plotBounds.getWidth() + m_plotBounds.left();
 	float y = (point.y() - m_plotRect.bottom()) / m_plotRect.getHeight() * m_plotBounds.getHeight() + m_plotBounds.bottom();
 
-	return Math::Point2D(x, y);
+	return Math::Point2D(fromAxisX(x), fromAxisY(y));
+}
+
+float Plot::toAxisX(float x) {
+
+	// values that can't be shown on a logarithmic axis are clamped to a tiny positive value
+	return m_xAxisScale == AxisScale::Logarithmic ? log10f(max(x, 1e-30f)) : x;
+}
+
+float Plot::toAxisY(float y) {
+
+	return m_yAxisScale == AxisScale::Logarithmic ? log10f(max(y, 1e-30f)) : y;
+}
+
+float Plot::fromAxisX(float x) {
+
+	return m_xAxisScale == AxisScale::Logarithmic ? powf(10.0f, x) : x;
+}
+
+float Plot::fromAxisY(float y) {
+
+	return m_yAxisScale == AxisScale::Logarithmic ? powf(10.0f, y) : y;
 }
 
 Math::Point2D Plot::relativeScreenToPlotSpace(Math::Point2D point) {
@@ -244,4 +283,164 @@ float Plot::calculateTickStep(float width, int prefDivs, int base, float prefact
 	float step = approxStep / mag >= prefactor / 2 ? prefactor * mag : mag;
 
 	return step;
+}
+
+void Plot::invalidateTicks() {
+
+	// ticks are part of the static layer
+	m_ticksValid = false;
+	m_plotImpl.invalidateStaticLayer();
+}
+
+void Plot::calculateTicks() {
+
+	int xPrefix = PLOT_NO_PREFIX;
+	int yPrefix = PLOT_NO_PREFIX;
+
+	// labels of logarithmic axes have their own prefix
+	if (m_xAxisScale == AxisScale::Logarithmic) {
+		calculateLogTicks(m_plotBounds.left(), m_plotBounds.right(), m_xAxisUnit, m_xTicks);
+	}
+	else {
+		calculateLinearTicks(m_plotBounds.left(), m_plotBounds.right(), m_xAxisUnit, m_xTicks, xPrefix);
+	}
+
+	if (m_yAxisScale == AxisScale::Logarithmic) {
+		calculateLogTicks(m_plotBounds.bottom(), m_plotBounds.top(), m_yAxisUnit, m_yTicks);
+	}
+	else {
+		calculateLinearTicks(m_plotBounds.bottom(), m_plotBounds.top(), m_yAxisUnit, m_yTicks, yPrefix);
+	}
+
+	// the prefix of linear axes is shown with the unit (e.g. "Time / ms")
+	m_xAxisLabel = m_xAxis + L" / " + (xPrefix != PLOT_NO_PREFIX ? std::wstring(1, unit_prefixes[xPrefix]) : L"") + unit_symbols[m_xAxisUnit];
+	m_yAxisLabel = m_yAxis + L" / " + (yPrefix != PLOT_NO_PREFIX ? std::wstring(1, unit_prefixes[yPrefix]) : L"") + unit_symbols[m_yAxisUnit];
+
+	m_ticksValid = true;
+}
+
+void Plot::calculateLinearTicks(float lower, float upper, Unit unit, std::vector<PlotTick>& ticks, int& prefix) {
+
+	ticks.clear();
+
+	// define prescaler (steps of radians are fractions of pi)
+	float prescaler = unit == Unit::Radians ? std::numbers::pi : 1.0f;
+	float width = (upper - lower) / prescaler;
+
+	// calculate step width
+	float step;
+	if (unit == Unit::Radians) {
+		step = calculateTickStep(width, 4, 2, 1);
+	}
+	else {
+		step = calculateTickStep(width, 5, 10, 5);
+	}
+
+	// calculate starting point
+	float first = ceil(lower / step / prescaler) * step;
+
+	// one prefix for the whole axis, picked by the largest value shown (it is part of the axis label)
+	prefix = getUnitPrefix(max(fabsf(lower), fabsf(upper)) / prescaler, unit);
+	float prefixScale = powf(1000.0f, (float)(prefix - PLOT_NO_PREFIX));
+
+	// create suffix (pi if unit is radians and else empty)
+	std::wstring suffix = unit == Unit::Radians ? L"\u03C0" : L"";
+
+	// at most 25 lines
+	for (int i = 0; i < 25; ++i) {
+
+		float value = first + step * i;
+		if (prescaler * value >= upper) {
+			break;
+		}
+
+		// remove rounding errors of the steps around zero
+		if (fabsf(value) < step * 1e-3f) {
+			value = 0.0f;
+		}
+
+		ticks.push_back({ prescaler * value, floatToString(value / prefixScale) + suffix });
+	}
+}
+
+void Plot::calculateLogTicks(float lower, float upper, Unit unit, std::vector<PlotTick>& ticks) {
+
+	ticks.clear();
+
+	// lower and upper are given in decades
+	float decades = upper - lower;
+
+	if (decades < 1.0f) {
+
+		// less than a decade is shown, use a linear step
+		float step = calculateTickStep(powf(10.0f, upper) - powf(10.0f, lower), 5, 10, 5);
+		float first = ceil(powf(10.0f, lower) / step) * step;
+
+		for (int i = 0; i < 25; ++i) {
+
+			float value = first + step * i;
+			if (log10f(value) >= upper) {
+				break;
+			}
+
+			ticks.push_back({ log10f(value), formatTickLabel(value, getUnitPrefix(value, unit)) });
+		}
+	}
+	else {
+
+		// label every n-th decade, that way there are at most 6 labels
+		int labelStep = max((int)ceil(decades / 6.0f), 1);
+
+		for (int d = (int)floor(lower); d < upper; ++d) {
+
+			// draw sub-decade lines (2 .. 9) only if few decades are shown
+			int nSubTicks = decades <= 4.0f ? 9 : 1;
+
+			for (int m = 1; m <= nSubTicks; ++m) {
+
+				float tick = d + log10f((float)m);
+
+				if (tick < lower || tick >= upper) {
+					continue;
+				}
+
+				float value = m * powf(10.0f, d);
+
+				// label decades and (if there is space) 2 and 5
+				if (m == 1 && ((d % labelStep) + labelStep) % labelStep == 0) {
+					ticks.push_back({ tick, formatTickLabel(value, getUnitPrefix(value, unit)) });
+				}
+				else if ((m == 2 || m == 5) && decades <= 1.5f) {
+					ticks.push_back({ tick, formatTickLabel(value, getUnitPrefix(value, unit)) });
+				}
+				else {
+					ticks.push_back({ tick, L"" });
+				}
+			}
+		}
+	}
+}
+
+int Plot::getUnitPrefix(float value, Unit unit) {
+
+	// angles and levels aren't prefixed
+	if (unit == Unit::Radians || unit == Unit::Decibel || unit == Unit::Degree || value == 0.0f) {
+		return PLOT_NO_PREFIX;
+	}
+
+	// pick the engineering prefix of the magnitude (n to T)
+	int prefix = (int)floorf(log10f(fabsf(value)) / 3.0f) + PLOT_NO_PREFIX;
+	return min(max(prefix, 0), 7);
+}
+
+std::wstring Plot::formatTickLabel(float value, int prefix) {
+
+	// the prefix is part of the label (e.g. "10k")
+	std::wstring label = floatToString(value / powf(1000.0f, (float)(prefix - PLOT_NO_PREFIX)));
+
+	if (prefix != PLOT_NO_PREFIX) {
+		label += unit_prefixes[prefix];
+	}
+
+	return label;
 }
\ No newline at end of file
@@ -3,9 +3,27 @@
 #include "Style/Style.h"
 #include "Widgets/Plot.h"
 
-PlotSeries::PlotSeries(Plot* p_parent) : mp_parent(p_parent), mp_graphics(p_parent->mp_graphics), m_fillArea(false) { }
+PlotSeries::PlotSeries(Plot* p_parent) : mp_parent(p_parent), mp_graphics(p_parent->mp_graphics), m_fillArea(false), m_visible(true) { }
 
 void PlotSeries::setFillArea(bool fillArea) {
 
 	m_fillArea = fillArea;
+	requestRedraw();
 }
+
+void PlotSeries::setVisible(bool visible) {
+
+	m_visible = visible;
+	requestRedraw();
+}
+
+bool PlotSeries::isVisible() {
+
+	return m_visible;
+}
+
+void PlotSeries::requestRedraw() {
+
+	// series are painted by their plot
+	mp_parent->requestRedraw();
+}
\ No newline at end of file
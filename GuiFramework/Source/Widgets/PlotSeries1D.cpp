@@ -2,11 +2,38 @@
 #include "Widgets/PlotSeries1D.h"
 #include "Widgets/Plot.h"
 #include "Core/Graphics2D.h"
+#include "Common/Profiler.h"
 
 #include <vector>
+#include <algorithm>
+#include <math.h>
+#include <float.h>
 
 PlotSeries1D::PlotSeries1D(Plot* p_parent, float* pa_data, float lower, float upper, int size, Color color) :
-	PlotSeries(p_parent), mpa_data(pa_data), m_size(size), m_plotSeries1DImpl(mp_graphics, color), m_head(0) {
+	PlotSeries(p_parent), mpa_data(pa_data), mpa_xData(nullptr), mp_buffer(nullptr), m_version(0), m_size(size), m_head(0),
+	m_axisXScale(AxisScale::Linear), m_axisXSorted(true), m_axisXValid(false), m_axisYScale(AxisScale::Linear),
+	m_decimatedLeft(0.0f), m_decimatedRight(0.0f), m_decimatedColumns(0), m_decimationValid(false), m_plotSeries1DImpl(mp_graphics, color) {
+
+	// set bounds, that way a x data array is initialized
+	setBounds(lower, upper);
+
+	// update first time
+	onUpdate();
+}
+
+PlotSeries1D::PlotSeries1D(Plot* p_parent, float* pa_xData, float* pa_data, int size, Color color) :
+	PlotSeries(p_parent), mpa_data(pa_data), mpa_xData(pa_xData), mp_buffer(nullptr), m_version(0), m_lowerBound(0.0f), m_upperBound(1.0f), m_size(size),
+	m_head(0), m_axisXScale(AxisScale::Linear), m_axisXSorted(true), m_axisXValid(false), m_axisYScale(AxisScale::Linear),
+	m_decimatedLeft(0.0f), m_decimatedRight(0.0f), m_decimatedColumns(0), m_decimationValid(false), m_plotSeries1DImpl(mp_graphics, color) {
+
+	// update first time
+	onUpdate();
+}
+
+PlotSeries1D::PlotSeries1D(Plot* p_parent, DataBuffer* p_buffer, float lower, float upper, Color color) :
+	PlotSeries(p_parent), mpa_data(nullptr), mpa_xData(nullptr), mp_buffer(p_buffer), m_version(0), m_size(p_buffer->getSize()),
+	m_head(0), m_axisXScale(AxisScale::Linear), m_axisXSorted(true), m_axisXValid(false), m_axisYScale(AxisScale::Linear),
+	m_decimatedLeft(0.0f), m_decimatedRight(0.0f), m_decimatedColumns(0), m_decimationValid(false), m_plotSeries1DImpl(mp_graphics, color) {
 
 	// set bounds, that way a x data array is initialized
 	setBounds(lower, upper);
@@ -17,26 +44,185 @@ PlotSeries1D::PlotSeries1D(Plot* p_parent, float* pa_data, float lower, float up
 
 void PlotSeries1D::onUpdate() {
 
-	m_plotSeries1DImpl.onUpdate(mpa_data, m_size, m_head, m_lowerBound, m_upperBound);
+	PROFILE_SCOPE_OBJECT("PlotSeries1D::onUpdate", this)
+
+	// hold the latest published frame while its points are collected (the producer writes another one)
+	DataView view;
+
+	if (mp_buffer != nullptr) {
+
+		view = mp_buffer->read();
+
+		// nothing to do if the points were already calculated from this frame
+		if (view.getVersion() == m_version && m_version != 0 && m_axisXValid &&
+			m_axisXScale == mp_parent->getXAxisScale() && m_axisYScale == mp_parent->getYAxisScale()) {
+			return;
+		}
+
+		mpa_data = view.getData();
+		m_version = view.getVersion();
+
+		if (view.getSize() != m_size) {
+			m_size = view.getSize();
+			m_axisXValid = false;
+		}
+	}
+
+	// x values only change with the bounds, the x data or the axis scale
+	if (!m_axisXValid || m_axisXScale != mp_parent->getXAxisScale()) {
+		calculateAxisX();
+	}
+
+	m_axisYScale = mp_parent->getYAxisScale();
+	bool logY = m_axisYScale == AxisScale::Logarithmic;
+
+	m_validX.clear();
+	m_validY.clear();
+
+	// start at the head of the ring (wrapped without a division per point)
+	int index = m_size > 0 ? m_head % m_size : 0;
+
+	for (int i = 0; i < m_size; ++i, index = index + 1 < m_size ? index + 1 : 0) {
+
+		float x = m_axisX[i];
+		float y = logY ? (mpa_data[index] > 0.0f ? log10f(mpa_data[index]) : NAN) : mpa_data[index];
+
+		// skip points that can't be shown (e.g. zero on a logarithmic axis)
+		if (isnan(x) || isnan(y)) {
+			continue;
+		}
+
+		m_validX.push_back(x);
+		m_validY.push_back(y);
+	}
+
+	// the frame may be written again once the view is released
+	if (mp_buffer != nullptr) {
+		mpa_data = nullptr;
+	}
+
+	// the reduction depends on the data, so it is recalculated with the next paint
+	m_decimationValid = false;
+
+	requestRedraw();
 }
 
 void PlotSeries1D::onPaint(Math::Rect& available) {
 
-	m_plotSeries1DImpl.onPaint(available, mp_parent->getPlotBounds(), m_fillArea);
+	PROFILE_SCOPE_OBJECT("PlotSeries1D::onPaint", this)
+
+	// points are in axis space, so they are recalculated if a scale changed since the last update
+	if (m_axisXScale != mp_parent->getXAxisScale() || m_axisYScale != mp_parent->getYAxisScale()) {
+		onUpdate();
+	}
+
+	Math::Rect plotBounds = mp_parent->getPlotBounds();
+
+	// number of pixel columns covered by the plot
+	int nColumns = max((int)ceilf(available.getWidth() * mp_graphics->getDPIScale()), 1);
+
+	if (!m_decimationValid || plotBounds.left() != m_decimatedLeft || plotBounds.right() != m_decimatedRight || nColumns != m_decimatedColumns) {
+		decimate(plotBounds.left(), plotBounds.right(), nColumns);
+	}
+
+	m_plotSeries1DImpl.onPaint(available, plotBounds, m_fillArea);
 }
 
 void PlotSeries1D::setColor(Color color) {
 
 	m_plotSeries1DImpl.setColor(color);
+	requestRedraw();
 }
 
 void PlotSeries1D::setBounds(float lower, float upper) {
 
 	m_lowerBound = lower;
 	m_upperBound = upper;
+
+	m_axisXValid = false;
+}
+
+void PlotSeries1D::setData(float* pa_data, int size) {
+
+	mpa_data = pa_data;
+	m_decimationValid = false;
+
+	if (size != m_size) {
+		m_size = size;
+		m_axisXValid = false;
+	}
+}
+
+void PlotSeries1D::setData(float* pa_xData, float* pa_data, int size) {
+
+	if (pa_xData != mpa_xData || size != m_size) {
+		m_axisXValid = false;
+	}
+
+	mpa_xData = pa_xData;
+	mpa_data = pa_data;
+	m_size = size;
+
+	m_decimationValid = false;
+}
+
+void PlotSeries1D::invalidateXData() {
+
+	m_axisXValid = false;
 }
 
 void PlotSeries1D::setHead(int head) {
 
 	m_head = head;
+	m_decimationValid = false;
 }
+
+void PlotSeries1D::calculateAxisX() {
+
+	m_axisXScale = mp_parent->getXAxisScale();
+	m_axisX.resize(m_size);
+
+	m_axisXSorted = true;
+	float previous = -FLT_MAX;
+
+	// calculate step
+	float step = (m_upperBound - m_lowerBound) / m_size;
+
+	for (int i = 0; i < m_size; ++i) {
+
+		float x = mpa_xData != nullptr ? mpa_xData[i] : m_lowerBound + step * i;
+
+		// points left of zero can't be shown on a logarithmic axis
+		if (m_axisXScale == AxisScale::Logarithmic) {
+			x = x > 0.0f ? log10f(x) : NAN;
+		}
+
+		m_axisX[i] = x;
+
+		// the reduction to pixel columns needs ascending x values
+		if (!isnan(x)) {
+			m_axisXSorted = m_axisXSorted && x >= previous;
+			previous = x;
+		}
+	}
+
+	m_axisXValid = true;
+}
+
+void PlotSeries1D::decimate(float left, float right, int nColumns) {
+
+	m_pointsX.clear();
+	m_pointsY.clear();
+
+	// reduce the visible points to the pixel columns (M4)
+	int begin, end;
+	findColumns(m_validX.data(), m_validX.size(), m_axisXSorted, left, right, nColumns, begin, end, m_columns);
+	decimateM4(m_validX.data(), m_validY.data(), begin, end, m_columns, m_pointsX, m_pointsY);
+
+	m_plotSeries1DImpl.onUpdate(m_pointsX.data(), m_pointsY.data(), m_pointsX.size());
+
+	m_decimatedLeft = left;
+	m_decimatedRight = right;
+	m_decimatedColumns = nColumns;
+	m_decimationValid = true;
+}
\ No newline at end of file
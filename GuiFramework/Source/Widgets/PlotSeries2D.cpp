@@ -0,0 +1,223 @@
+#include "Gui.h"
+#include "Widgets/PlotSeries2D.h"
+#include "Widgets/Plot.h"
+#include "Core/Graphics2D.h"
+#include "Common/Profiler.h"
+
+#include <vector>
+#include <algorithm>
+#include <math.h>
+#include <float.h>
+
+PlotSeries2D::PlotSeries2D(Plot* p_parent, float* pa_xData, int size) :
+	PlotSeries(p_parent), mpa_xData(pa_xData), m_size(size), m_axisXScale(AxisScale::Linear), m_axisXSorted(true), m_axisXValid(false),
+	m_axisYScale(AxisScale::Linear), m_begin(0), m_end(0), m_decimatedLeft(0.0f), m_decimatedRight(0.0f), m_decimatedColumns(0),
+	m_columnsValid(false), m_decimationValid(false) {
+
+	// update first time
+	onUpdate();
+}
+
+PlotSeries2D::~PlotSeries2D() {
+
+	for (PlotSeries1DImpl* p_impl : mp_channelImpls) {
+		delete p_impl;
+	}
+}
+
+void PlotSeries2D::onUpdate() {
+
+	PROFILE_SCOPE_OBJECT("PlotSeries2D::onUpdate", this)
+
+	// x values are shared, so they are transformed once for all channels
+	if (!m_axisXValid || m_axisXScale != mp_parent->getXAxisScale()) {
+		calculateAxisX();
+	}
+
+	m_axisYScale = mp_parent->getYAxisScale();
+	m_validY.resize(mpa_yData.size() * m_validX.size());
+
+	// transform the y values of all channels
+	for (int c = 0; c < (int)mpa_yData.size(); ++c) {
+		calculateAxisY(c);
+	}
+
+	// the reduction depends on the data, so it is recalculated with the next paint
+	m_decimationValid = false;
+
+	requestRedraw();
+}
+
+void PlotSeries2D::onPaint(Math::Rect& available) {
+
+	PROFILE_SCOPE_OBJECT("PlotSeries2D::onPaint", this)
+
+	// points are in axis space, so they are recalculated if a scale changed since the last update
+	if (m_axisXScale != mp_parent->getXAxisScale() || m_axisYScale != mp_parent->getYAxisScale()) {
+		onUpdate();
+	}
+
+	Math::Rect plotBounds = mp_parent->getPlotBounds();
+
+	// number of pixel columns covered by the plot
+	int nColumns = max((int)ceilf(available.getWidth() * mp_graphics->getDPIScale()), 1);
+
+	if (!m_columnsValid || plotBounds.left() != m_decimatedLeft || plotBounds.right() != m_decimatedRight || nColumns != m_decimatedColumns) {
+		calculateColumns(plotBounds.left(), plotBounds.right(), nColumns);
+	}
+
+	if (!m_decimationValid) {
+
+		for (int c = 0; c < (int)mp_channelImpls.size(); ++c) {
+			decimate(c);
+		}
+
+		m_decimationValid = true;
+	}
+
+	for (PlotSeries1DImpl* p_impl : mp_channelImpls) {
+		p_impl->onPaint(available, plotBounds, m_fillArea);
+	}
+}
+
+void PlotSeries2D::setColor(Color color) {
+
+	for (PlotSeries1DImpl* p_impl : mp_channelImpls) {
+		p_impl->setColor(color);
+	}
+
+	requestRedraw();
+}
+
+void PlotSeries2D::setColor(int channel, Color color) {
+
+	mp_channelImpls[channel]->setColor(color);
+	requestRedraw();
+}
+
+int PlotSeries2D::addChannel(float* pa_yData, Color color) {
+
+	mpa_yData.push_back(pa_yData);
+	mp_channelImpls.push_back(new PlotSeries1DImpl(mp_graphics, color));
+
+	// the y values of all channels are stored together, so they are updated
+	onUpdate();
+
+	return mpa_yData.size() - 1;
+}
+
+int PlotSeries2D::getChannelCount() {
+
+	return mpa_yData.size();
+}
+
+void PlotSeries2D::setXData(float* pa_xData, int size) {
+
+	mpa_xData = pa_xData;
+	m_size = size;
+
+	m_axisXValid = false;
+}
+
+void PlotSeries2D::setYData(int channel, float* pa_yData) {
+
+	mpa_yData[channel] = pa_yData;
+
+	// everything is recalculated if an axis changed since the last update
+	if (!m_axisXValid || m_axisXScale != mp_parent->getXAxisScale() || m_axisYScale != mp_parent->getYAxisScale()) {
+		onUpdate();
+		return;
+	}
+
+	// otherwise only the y values of the channel are transformed again
+	calculateAxisY(channel);
+
+	m_decimationValid = false;
+	requestRedraw();
+}
+
+void PlotSeries2D::invalidateXData() {
+
+	m_axisXValid = false;
+}
+
+void PlotSeries2D::calculateAxisX() {
+
+	m_axisXScale = mp_parent->getXAxisScale();
+
+	m_validX.clear();
+	m_validIndices.clear();
+
+	m_axisXSorted = true;
+	float previous = -FLT_MAX;
+
+	for (int i = 0; i < m_size; ++i) {
+
+		float x = mpa_xData[i];
+
+		// points left of zero can't be shown on a logarithmic axis
+		if (m_axisXScale == AxisScale::Logarithmic) {
+
+			if (x <= 0.0f) {
+				continue;
+			}
+
+			x = log10f(x);
+		}
+
+		if (isnan(x)) {
+			continue;
+		}
+
+		// the reduction to pixel columns needs ascending x values
+		m_axisXSorted = m_axisXSorted && x >= previous;
+		previous = x;
+
+		m_validX.push_back(x);
+		m_validIndices.push_back(i);
+	}
+
+	m_axisXValid = true;
+	m_columnsValid = false;
+}
+
+void PlotSeries2D::calculateAxisY(int channel) {
+
+	bool logY = m_axisYScale == AxisScale::Logarithmic;
+	int nValid = m_validX.size();
+
+	float* p_data = mpa_yData[channel];
+	float* p_y = m_validY.data() + channel * nValid;
+
+	// the y values of a channel are stored one after the other
+	for (int i = 0; i < nValid; ++i) {
+
+		float y = p_data[m_validIndices[i]];
+		p_y[i] = logY ? (y > 0.0f ? log10f(y) : NAN) : y;
+	}
+}
+
+void PlotSeries2D::calculateColumns(float left, float right, int nColumns) {
+
+	// the columns are the same for every channel
+	findColumns(m_validX.data(), m_validX.size(), m_axisXSorted, left, right, nColumns, m_begin, m_end, m_columns);
+
+	m_decimatedLeft = left;
+	m_decimatedRight = right;
+	m_decimatedColumns = nColumns;
+	m_columnsValid = true;
+
+	m_decimationValid = false;
+}
+
+void PlotSeries2D::decimate(int channel) {
+
+	m_pointsX.clear();
+	m_pointsY.clear();
+
+	// reduce the visible points of the channel to the pixel columns (M4)
+	float* p_y = m_validY.data() + channel * m_validX.size();
+	decimateM4(m_validX.data(), p_y, m_begin, m_end, m_columns, m_pointsX, m_pointsY);
+
+	mp_channelImpls[channel]->onUpdate(m_pointsX.data(), m_pointsY.data(), m_pointsX.size());
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "Gui.h"
+#include "Widgets/PlotSeriesImage.h"
+#include "Widgets/Plot.h"
+
+PlotSeriesImage::PlotSeriesImage(Plot* p_parent, unsigned int* pa_pixels, int width, int height, Math::Rect bounds) :
+	PlotSeries(p_parent), mpa_pixels(pa_pixels), m_width(width), m_height(height), m_offset(0), m_bounds(bounds), m_plotSeriesImageImpl(mp_graphics) {
+
+	// update first time
+	onUpdate();
+}
+
+void PlotSeriesImage::onUpdate() {
+
+	m_plotSeriesImageImpl.onUpdate(mpa_pixels, m_width, m_height);
+	requestRedraw();
+}
+
+void PlotSeriesImage::onPaint(Math::Rect& available) {
+
+	// transform image bounds to screen space
+	Math::Point2D topLeft = mp_parent->plotToScreenSpace(m_bounds.topLeft());
+	Math::Point2D bottomRight = mp_parent->plotToScreenSpace(m_bounds.bottomRight());
+
+	m_plotSeriesImageImpl.onPaint(available, Math::Rect(topLeft, bottomRight), m_offset);
+}
+
+void PlotSeriesImage::updateColumns(int first, int count) {
+
+	m_plotSeriesImageImpl.onUpdateColumns(mpa_pixels, m_width, m_height, first, min(count, m_width));
+	requestRedraw();
+}
+
+void PlotSeriesImage::setColor(Color) { }
+
+void PlotSeriesImage::setPixels(unsigned int* pa_pixels, int width, int height) {
+
+	mpa_pixels = pa_pixels;
+	m_width = width;
+	m_height = height;
+}
+
+void PlotSeriesImage::setOffset(int offset) {
+
+	m_offset = offset;
+	requestRedraw();
+}
+
+void PlotSeriesImage::setBounds(Math::Rect bounds) {
+
+	m_bounds = bounds;
+	requestRedraw();
+}
+
+void PlotSeriesImage::setXBounds(float left, float right) {
+
+	m_bounds.left() = left;
+	m_bounds.right() = right;
+	requestRedraw();
+}
@@ -3,6 +3,8 @@
 #include "Style/Style.h"
 #include "Common/WidgetUtils.h"
 
+#include <math.h>
+
 // define all types of Sliders to be used
 template class Slider<float>;
 template class Slider<double>;
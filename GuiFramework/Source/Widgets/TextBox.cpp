@@ -20,11 +20,18 @@ TextBox::TextBox(Window* p_parent, std::wstring text, WidgetStyle style) :
 
 void TextBox::onTick(float deltaTime) {
 
+	bool cursor = m_animCycle < 0.5;
+
 	m_animCycle += deltaTime;
 
 	if (m_animCycle > 1) {
 		m_animCycle = 0;
 	}
+
+	// only repaint when the cursor blinks
+	if (cursor != (m_animCycle < 0.5)) {
+		requestRedraw();
+	}
 }
 
 void TextBox::onPaint() {
@@ -66,7 +73,7 @@ void TextBox::onMouseHover(Math::Point2D point) {
 		// get cursor position
 		int cursor = min(m_textBoxImpl.getMousePosition(point) - m_prefix.size(), m_text.size());
 
-		cursor = min(cursor, m_text.size());
+		cursor = min(cursor, (int)m_text.size());
 
 		if (m_dragFirstCursor) {
 			if (cursor <= m_lastCursor) {
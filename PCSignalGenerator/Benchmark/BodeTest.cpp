@@ -0,0 +1,138 @@
+// Headless test of the frequency response (bode) measurement with a known digital filter as the
+// device under test. The stepped sine stimulus of the sweep (same frequencies, settle times and
+// capture windows as the measurement) runs through a second order butterworth lowpass, the
+// captured input and output of every point are analyzed like on the worker thread and compared
+// against the exact response of the biquad. Gain and phase have to match within 1e-4 dB and
+// 1e-4 degrees from 20 Hz to 20 kHz.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/BodeTest.cpp Source/FrequencySweep.cpp Source/Filter.cpp Source/Convolver.cpp Source/FFT.cpp Source/DSPUtils.cpp -o BodeTest
+// run: ./BodeTest [--points 64]
+
+#include "Gui.h"
+#include "FrequencySweep.h"
+#include "Filter.h"
+
+#include <vector>
+#include <complex>
+#include <numbers>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define TEST_SAMPLE_RATE 48000.0f
+#define TEST_START_FREQUENCY 20.0f
+#define TEST_STOP_FREQUENCY 20000.0f
+#define TEST_CUTOFF 1000.0f
+#define TEST_AMPLITUDE 0.5
+#define TEST_LATENCY (1024 / TEST_SAMPLE_RATE) // output buffer of the generator
+#define TEST_MAX_CAPTURE 524288 // half of the oscilloscope record
+#define TEST_MAX_GAIN_ERROR 1e-4 // in dB
+#define TEST_MAX_PHASE_ERROR 1e-4 // in degrees
+
+// biquad in transposed direct form II (double precision, the state runs on between the points)
+class DeviceUnderTest {
+
+private:
+	Biquad m_biquad;
+	double m_s1;
+	double m_s2;
+
+public:
+	DeviceUnderTest(Biquad biquad) : m_biquad(biquad), m_s1(0.0), m_s2(0.0) { }
+
+public:
+	float process(double x) {
+
+		double y = m_biquad.b0 * x + m_s1;
+
+		m_s1 = m_biquad.b1 * x - m_biquad.a1 * y + m_s2;
+		m_s2 = m_biquad.b2 * x - m_biquad.a2 * y;
+
+		return (float)y;
+	}
+
+	std::complex<double> getResponse(double frequency) {
+
+		std::complex<double> z1 = std::polar(1.0, -2.0 * std::numbers::pi * frequency / TEST_SAMPLE_RATE);
+
+		return (m_biquad.b0 + m_biquad.b1 * z1 + m_biquad.b2 * z1 * z1) / (1.0 + m_biquad.a1 * z1 + m_biquad.a2 * z1 * z1);
+	}
+};
+
+int main(int argc, char** argv) {
+
+	int nPoints = 64;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+			nPoints = max(atoi(argv[++i]), 2);
+		}
+	}
+
+	DeviceUnderTest device(Filter::designButterworth(2, TEST_CUTOFF, TEST_SAMPLE_RATE, false)[0]);
+	std::vector<float> frequencies = FrequencySweep::getFrequencies(TEST_START_FREQUENCY, TEST_STOP_FREQUENCY, nPoints);
+
+	// the generator keeps its phase when the frequency changes
+	double phase = 0.0;
+
+	double maxGainError = 0.0;
+	double maxPhaseError = 0.0;
+
+	for (int p = 0; p < (int)frequencies.size(); ++p) {
+
+		float frequency = frequencies[p];
+
+		int settleSize = (int)(FrequencySweep::getSettleTime(frequency, TEST_LATENCY) * TEST_SAMPLE_RATE);
+		int captureSize = FrequencySweep::getCaptureSize(frequency, TEST_SAMPLE_RATE, TEST_MAX_CAPTURE);
+
+		FrequencyResponseJob job;
+		job.run = 1;
+		job.point = p;
+		job.frequency = frequency;
+		job.sampleRate = TEST_SAMPLE_RATE;
+		job.amplitude = TEST_AMPLITUDE;
+
+		job.reference.resize(captureSize);
+		job.response.resize(captureSize);
+
+		// stimulus through the device, the window after the settle time is captured (CH1 input, CH2 output)
+		double step = 2.0 * std::numbers::pi * frequency / TEST_SAMPLE_RATE;
+
+		for (int n = 0; n < settleSize + captureSize; ++n) {
+
+			float x = (float)(TEST_AMPLITUDE * sin(phase));
+			float y = device.process(x);
+
+			if (n >= settleSize) {
+				job.reference[n - settleSize] = x;
+				job.response[n - settleSize] = y;
+			}
+
+			phase = fmod(phase + step, 2.0 * std::numbers::pi);
+		}
+
+		std::complex<double> measured = FrequencySweep::analyze(job);
+		std::complex<double> expected = device.getResponse(frequency);
+
+		double gainError = fabs(20.0 * log10(std::abs(measured) / std::abs(expected)));
+		double phaseError = fabs(std::arg(measured / expected) * 180.0 / std::numbers::pi);
+
+		maxGainError = max(maxGainError, gainError);
+		maxPhaseError = max(maxPhaseError, phaseError);
+
+		if (gainError > TEST_MAX_GAIN_ERROR || phaseError > TEST_MAX_PHASE_ERROR) {
+			printf("%8.1f Hz: gain %9.4f dB (error %.1e dB), phase %9.4f deg (error %.1e deg) failed\n", frequency,
+				20.0 * log10(std::abs(measured)), gainError, std::arg(measured) * 180.0 / std::numbers::pi, phaseError);
+		}
+	}
+
+	bool passed = maxGainError <= TEST_MAX_GAIN_ERROR && maxPhaseError <= TEST_MAX_PHASE_ERROR;
+
+	printf("%d points from %.0f Hz to %.0f Hz, lowpass at %.0f Hz: max. gain error %.1e dB, max. phase error %.1e deg\n", nPoints,
+		TEST_START_FREQUENCY, TEST_STOP_FREQUENCY, TEST_CUTOFF, maxGainError, maxPhaseError);
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+// Splitting the interleaved capture into planar channels: DSP::deinterleave against a plain
+// scalar loop for 1 to 8 channels (the vectorized paths are mono, stereo and multiples of four
+// channels, the rest falls back to the scalar loop). Every result is checked against the loop.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/DeinterleaveBenchmark.cpp Source/DSPUtils.cpp -o DeinterleaveBenchmark
+// run: ./DeinterleaveBenchmark [--repeat 100]
+
+#include "Gui.h"
+#include "DSPUtils.h"
+
+#include <vector>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define BENCHMARK_SAMPLE_RATE 192000
+#define BENCHMARK_MAX_CHANNELS 8
+#define BENCHMARK_FRAMES 1923 // one second is split in packets of this size (not a multiple of four)
+
+static double getSeconds(std::chrono::steady_clock::time_point start) {
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void deinterleaveScalar(float* pa_src, int nChannels, int nFrames, float** pa_dst) {
+
+	for (int i = 0; i < nFrames; ++i) {
+		for (int c = 0; c < nChannels; ++c) {
+			pa_dst[c][i] = pa_src[nChannels * i + c];
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+
+	int nRepeat = 100;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+			nRepeat = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	// one second of interleaved samples
+	std::vector<float> source(BENCHMARK_MAX_CHANNELS * BENCHMARK_SAMPLE_RATE);
+	for (int i = 0; i < source.size(); ++i) {
+		source[i] = (float)(rand() % 2001 - 1000) / 1000.0f;
+	}
+
+	std::vector<std::vector<float>> channels(BENCHMARK_MAX_CHANNELS, std::vector<float>(BENCHMARK_FRAMES));
+	std::vector<std::vector<float>> expected(BENCHMARK_MAX_CHANNELS, std::vector<float>(BENCHMARK_FRAMES));
+
+	std::vector<float*> pa_channels;
+	std::vector<float*> pa_expected;
+
+	for (int c = 0; c < BENCHMARK_MAX_CHANNELS; ++c) {
+		pa_channels.push_back(channels[c].data());
+		pa_expected.push_back(expected[c].data());
+	}
+
+	bool passed = true;
+
+	for (int nChannels = 1; nChannels <= BENCHMARK_MAX_CHANNELS; ++nChannels) {
+
+		int nPackets = BENCHMARK_SAMPLE_RATE / BENCHMARK_FRAMES;
+
+		// check the first packet
+		DSP::deinterleave(source.data(), nChannels, BENCHMARK_FRAMES, pa_channels.data());
+		deinterleaveScalar(source.data(), nChannels, BENCHMARK_FRAMES, pa_expected.data());
+
+		for (int c = 0; c < nChannels; ++c) {
+			passed = passed && channels[c] == expected[c];
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int r = 0; r < nRepeat; ++r) {
+			for (int p = 0; p < nPackets; ++p) {
+				deinterleaveScalar(source.data() + nChannels * BENCHMARK_FRAMES * p, nChannels, BENCHMARK_FRAMES, pa_expected.data());
+			}
+		}
+
+		double scalarTime = getSeconds(start) / nRepeat;
+		start = std::chrono::steady_clock::now();
+
+		for (int r = 0; r < nRepeat; ++r) {
+			for (int p = 0; p < nPackets; ++p) {
+				DSP::deinterleave(source.data() + nChannels * BENCHMARK_FRAMES * p, nChannels, BENCHMARK_FRAMES, pa_channels.data());
+			}
+		}
+
+		double time = getSeconds(start) / nRepeat;
+
+		printf("%d channels: %.3f ms per second at %d kHz (scalar %.3f ms, %.1f x)\n", nChannels, time * 1e3,
+			BENCHMARK_SAMPLE_RATE / 1000, scalarTime * 1e3, scalarTime / time);
+	}
+
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
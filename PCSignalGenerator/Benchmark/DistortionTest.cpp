@@ -0,0 +1,136 @@
+// Synthetic accuracy test of the distortion measurement. Sines from 20 Hz to 15 kHz with known
+// harmonics (2 to 5, only those below nyquist) and white gaussian noise are analyzed frame by
+// frame like on the worker thread. THD, THD + N, SINAD and SNR have to match the analytic values
+// within 0.05 dB, ENOB within 0.05 dB / 6.02. The noise power is the power of the noise that was
+// actually added to the frame (including the rounding to float), that way the result doesn't
+// depend on the random variation of a single frame.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/DistortionTest.cpp Source/DistortionAnalyzer.cpp Source/DSPUtils.cpp Source/FFT.cpp -o DistortionTest
+// run: ./DistortionTest [--seed 1]
+
+#include "Gui.h"
+#include "DistortionAnalyzer.h"
+
+#include <vector>
+#include <numbers>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define TEST_SAMPLE_RATE 48000.0f
+#define TEST_AMPLITUDE 0.5
+#define TEST_HARMONICS 4 // harmonics 2 to 5
+#define TEST_MAX_ERROR 0.05 // in dB
+
+// levels of the harmonics 2 to 5 relative to the fundamental (in dB)
+static const double s_harmonicLevels[TEST_HARMONICS] = { -50.0, -65.0, -80.0, -75.0 };
+
+// analyzes one frame of the given sine and compares the result against the analytic values
+static bool testFrame(double frequency, double snr, std::mt19937& random, double& maxError) {
+
+	std::uniform_real_distribution<double> phase(0.0, 2.0 * std::numbers::pi);
+	std::normal_distribution<double> gauss(0.0, 1.0);
+
+	double fundamentalPower = 0.5 * TEST_AMPLITUDE * TEST_AMPLITUDE;
+	double sigma = sqrt(fundamentalPower / pow(10.0, snr / 10.0));
+
+	// harmonics above nyquist are removed by the anti-aliasing filter of a real device
+	double amplitudes[TEST_HARMONICS + 1];
+	double phases[TEST_HARMONICS + 1];
+	double harmonicPower = 0.0;
+
+	amplitudes[0] = TEST_AMPLITUDE;
+	phases[0] = phase(random);
+
+	for (int h = 1; h <= TEST_HARMONICS; ++h) {
+
+		bool audible = (h + 1) * frequency < TEST_SAMPLE_RATE / 2;
+
+		amplitudes[h] = audible ? TEST_AMPLITUDE * pow(10.0, s_harmonicLevels[h - 1] / 20.0) : 0.0;
+		phases[h] = phase(random);
+		harmonicPower += 0.5 * amplitudes[h] * amplitudes[h];
+	}
+
+	// frame of the worker
+	std::vector<float> frame(DISTORTION_SIZE);
+	double noisePower = 0.0;
+
+	for (int n = 0; n < DISTORTION_SIZE; ++n) {
+
+		double signal = 0.0;
+		for (int h = 0; h <= TEST_HARMONICS; ++h) {
+			signal += amplitudes[h] * sin(2.0 * std::numbers::pi * (h + 1) * frequency * n / TEST_SAMPLE_RATE + phases[h]);
+		}
+
+		frame[n] = (float)(signal + sigma * gauss(random));
+		noisePower += (frame[n] - signal) * (frame[n] - signal);
+	}
+
+	noisePower /= DISTORTION_SIZE;
+
+	DistortionResult result;
+	if (!DistortionAnalyzer::analyze(frame.data(), DISTORTION_SIZE, TEST_SAMPLE_RATE, result)) {
+
+		printf("%8.0f Hz, snr %5.1f dB: no fundamental found failed\n", frequency, snr);
+		return false;
+	}
+
+	double sinad = 10.0 * log10(fundamentalPower / (harmonicPower + noisePower));
+
+	// errors of every readout (thd only if there are harmonics below nyquist)
+	double errors[5];
+	errors[0] = harmonicPower > 0.0 ? fabs(result.thd - 10.0 * log10(harmonicPower / fundamentalPower)) : 0.0;
+	errors[1] = fabs(result.thdN + sinad);
+	errors[2] = fabs(result.sinad - sinad);
+	errors[3] = fabs(result.snr - 10.0 * log10(fundamentalPower / noisePower));
+	errors[4] = fabs(result.enob - (sinad - 1.76) / 6.02) * 6.02;
+
+	bool passed = true;
+	for (int i = 0; i < 5; ++i) {
+
+		maxError = max(maxError, errors[i]);
+		passed = passed && errors[i] <= TEST_MAX_ERROR;
+	}
+
+	printf("%8.0f Hz, snr %5.1f dB: thd %7.2f dB, thd+n %7.2f dB, sinad %6.2f dB, snr %6.2f dB, enob %5.2f bits, max. error %.4f dB%s\n",
+		frequency, snr, harmonicPower > 0.0 ? result.thd : NAN, result.thdN, result.sinad, result.snr, result.enob,
+		max(max(errors[0], errors[1]), max(max(errors[2], errors[3]), errors[4])), passed ? "" : " failed");
+
+	return passed;
+}
+
+int main(int argc, char** argv) {
+
+	int seed = 1;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = atoi(argv[++i]);
+		}
+	}
+
+	std::mt19937 random(seed);
+
+	// 3 kHz puts the eighth harmonic on nyquist
+	double frequencies[] = { 20.0, 50.0, 200.0, 1000.0, 3000.0, 7000.0, 11000.0, 15000.0 };
+
+	// with more noise, the noise in the bins of the harmonics alone changes the thd by a few 0.01 dB
+	double snrs[] = { 70.0, 95.0, 120.0 };
+
+	bool passed = true;
+	double maxError = 0.0;
+
+	for (double snr : snrs) {
+		for (double frequency : frequencies) {
+			passed = testFrame(frequency, snr, random, maxError) && passed;
+		}
+	}
+
+	printf("max. error %.4f dB\n", maxError);
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+// Synthetic test of equivalent-time sampling. A 21 kHz sine at 48 kHz (less than 2.3 samples per
+// period) is acquired many times with random phase relative to the sample clock, the trigger is
+// detected on the samples and refined to the sub-sample crossing of the band-limited signal
+// (windowed sinc interpolation), the same way the oscilloscope does. The reconstruction on the
+// fine time grid is compared against the exact sine, the maximum error has to stay below 0.002
+// of the amplitude for windows of 4 to 32 samples (at least 32 bins per sample). Wider windows
+// have so few bins per period that the linear interpolation of the plot dominates the error.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/EquivalentTimeTest.cpp Source/EquivalentTimeSampler.cpp Source/DSPUtils.cpp Source/FFT.cpp -o EquivalentTimeTest
+// run: ./EquivalentTimeTest [--acquisitions 4000] [--seed 1]
+
+#include "Gui.h"
+#include "EquivalentTimeSampler.h"
+#include "DSPUtils.h"
+
+#include <vector>
+#include <numbers>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define TEST_SAMPLE_RATE 48000.0
+#define TEST_FREQUENCY 21000.0
+#define TEST_AMPLITUDE 1.0
+#define TEST_LEVEL 0.0f
+#define TEST_BINS 1024 // plot buffer of the oscilloscope
+#define TEST_AVERAGE 16
+#define TEST_MAX_ERROR 0.002 // relative to the amplitude
+
+// acquires the sine with random phases and compares the reconstruction in a window of the given width (in samples)
+static bool testWindow(double window, int nAcquisitions, std::mt19937& random) {
+
+	std::uniform_real_distribution<double> phase(0.0, 2.0 * std::numbers::pi);
+
+	EquivalentTimeSampler sampler(TEST_BINS, TEST_AVERAGE);
+	sampler.setWindow(window);
+
+	// the window around the trigger plus the interpolation kernel
+	int halfSize = (int)ceil(window / 2) + DSP_SINC_HALF_WIDTH + 1;
+	double step = 2.0 * std::numbers::pi * TEST_FREQUENCY / TEST_SAMPLE_RATE;
+
+	// a period more than needed, that way there is a trigger behind the first half of the window
+	int period = (int)ceil(TEST_SAMPLE_RATE / TEST_FREQUENCY);
+	std::vector<float> capture(2 * halfSize + 1 + period);
+
+	for (int a = 0; a < nAcquisitions; ++a) {
+
+		double start = phase(random);
+
+		for (int i = 0; i < (int)capture.size(); ++i) {
+			capture[i] = (float)(TEST_AMPLITUDE * sin(start + i * step));
+		}
+
+		// first rising crossing on the samples after the first half of the window
+		int trigger = halfSize;
+		while (!(capture[trigger - 1] < TEST_LEVEL && capture[trigger] > TEST_LEVEL)) {
+			++trigger;
+		}
+
+		float* p_window = capture.data() + trigger - halfSize;
+		double crossing = DSP::findCrossing(p_window, halfSize, TEST_LEVEL);
+
+		sampler.add(p_window, 2 * halfSize + 1, -crossing);
+	}
+
+	std::vector<float> reconstruction(TEST_BINS);
+	sampler.reconstruct(reconstruction.data(), 1.0f);
+
+	// bin i is centered at -window / 2 + i * window / bins (in samples relative to the rising zero crossing)
+	double maxError = 0.0;
+
+	for (int i = 0; i < TEST_BINS; ++i) {
+
+		double t = -window / 2 + i * window / TEST_BINS;
+		double expected = TEST_AMPLITUDE * sin(t * step);
+
+		maxError = max(maxError, fabs(reconstruction[i] - expected) / TEST_AMPLITUDE);
+	}
+
+	bool passed = maxError <= TEST_MAX_ERROR && sampler.getCoverage() == 1.0f;
+
+	printf("window %7.1f samples (%6.3f samples per bin): coverage %5.1f %%, max. error %.5f%s\n", window, window / TEST_BINS,
+		100.0f * sampler.getCoverage(), maxError, passed ? "" : " failed");
+
+	return passed;
+}
+
+int main(int argc, char** argv) {
+
+	int nAcquisitions = 4000;
+	int seed = 1;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--acquisitions") == 0 && i + 1 < argc) {
+			nAcquisitions = max(atoi(argv[++i]), 1);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = atoi(argv[++i]);
+		}
+	}
+
+	std::mt19937 random(seed);
+	bool passed = true;
+
+	// from less than two periods up to 14 periods
+	double windows[] = { 4.0, 8.0, 16.0, 32.0 };
+
+	for (double window : windows) {
+		passed = testWindow(window, nAcquisitions, random) && passed;
+	}
+
+	printf("%.0f Hz at %.0f Hz, %d acquisitions per window\n", TEST_FREQUENCY, TEST_SAMPLE_RATE, nAcquisitions);
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
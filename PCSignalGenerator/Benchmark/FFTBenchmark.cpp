@@ -0,0 +1,137 @@
+// Cost of the real FFT at the sizes used by the analyzers (up to 64k, the largest spectrum
+// size). Forward and inverse transforms are timed, a few bins are checked against a direct DFT,
+// the round trip is checked against the input and the inverse must not allocate (it runs on
+// the capture path through the FIR filters).
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/FFTBenchmark.cpp Source/FFT.cpp -o FFTBenchmark
+// run: ./FFTBenchmark [--repeat 200]
+
+#include "Gui.h"
+#include "FFT.h"
+
+#include <vector>
+#include <complex>
+#include <chrono>
+#include <new>
+#include <numbers>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define BENCHMARK_MIN_SIZE 1024
+#define BENCHMARK_MAX_SIZE 65536
+#define BENCHMARK_CHECKED_BINS 8
+
+static long long s_nAllocations = 0;
+
+void* operator new(size_t size) {
+
+	++s_nAllocations;
+
+	void* p_memory = malloc(max(size, (size_t)1));
+	if (p_memory == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return p_memory;
+}
+
+void operator delete(void* p_memory) noexcept {
+
+	free(p_memory);
+}
+
+static double getSeconds(std::chrono::steady_clock::time_point start) {
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// bins spread over the spectrum against a direct DFT (relative to the largest magnitude)
+static double checkBins(std::vector<float>& signal, std::vector<std::complex<float>>& bins) {
+
+	int size = signal.size();
+	double maxError = 0.0;
+	double maxMagnitude = 1e-20;
+
+	for (int b = 0; b < BENCHMARK_CHECKED_BINS; ++b) {
+
+		int k = (int)((long long)b * (size / 2) / (BENCHMARK_CHECKED_BINS - 1));
+		std::complex<double> expected = 0.0;
+
+		for (int n = 0; n < size; ++n) {
+			double phase = -2.0 * std::numbers::pi * ((long long)k * n % size) / size;
+			expected += std::complex<double>(cos(phase), sin(phase)) * (double)signal[n];
+		}
+
+		maxError = max(maxError, std::abs(expected - std::complex<double>(bins[k])));
+		maxMagnitude = max(maxMagnitude, std::abs(expected));
+	}
+
+	return maxError / maxMagnitude;
+}
+
+int main(int argc, char** argv) {
+
+	int nRepeat = 200;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+			nRepeat = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	bool passed = true;
+
+	for (int size = BENCHMARK_MIN_SIZE; size <= BENCHMARK_MAX_SIZE; size *= 4) {
+
+		FFT& fft = FFT::getPlan(size);
+
+		// noise with a sine on top
+		std::vector<float> signal(size);
+		for (int n = 0; n < size; ++n) {
+			signal[n] = sinf(0.01f * n) + (rand() % 2001 - 1000) / 10000.0f;
+		}
+
+		std::vector<float> buffer(signal);
+		std::vector<std::complex<float>> bins(fft.getBinCount());
+		std::vector<float> output(size);
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (int r = 0; r < nRepeat; ++r) {
+			fft.transform(buffer.data(), bins.data());
+		}
+
+		double forwardTime = getSeconds(start) / nRepeat;
+
+		long long nAllocations = s_nAllocations;
+		start = std::chrono::steady_clock::now();
+
+		for (int r = 0; r < nRepeat; ++r) {
+			fft.inverse(bins.data(), output.data());
+		}
+
+		double inverseTime = getSeconds(start) / nRepeat;
+		nAllocations = s_nAllocations - nAllocations;
+
+		// the transforms don't modify their input, so the last round trip is checked
+		double roundTripError = 0.0;
+		for (int n = 0; n < size; ++n) {
+			roundTripError = max(roundTripError, (double)fabsf(output[n] - signal[n]));
+		}
+
+		double binError = checkBins(signal, bins);
+
+		bool sizePassed = roundTripError < 1e-4 && binError < 1e-4 && nAllocations == 0;
+		passed = passed && sizePassed;
+
+		printf("%6d: forward %8.1f us, inverse %8.1f us, bin error %.1e, round trip error %.1e, %lld allocations %s\n", size,
+			forwardTime * 1e6, inverseTime * 1e6, binError, roundTripError, nAllocations, sizePassed ? "" : "(failed)");
+	}
+
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+// Headless test of the impulse response measurement with a simulated device under test. The
+// exponential sweep of the generator runs through a one pole lowpass at 2 kHz followed by a static
+// nonlinearity (second and third order distortion, -32 dB and -50 dB at low frequencies), the
+// recorded input and output are analyzed like on the worker thread. The linear response has to
+// match the exact response within 0.1 dB, the second and third harmonic their analytic levels
+// within 0.5 dB from 50 Hz to 15 kHz. The block and the streaming convolution (process in pieces
+// of random size) of a few seconds of noise are compared against a direct convolution.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/ImpulseResponseTest.cpp Source/SweepAnalysis.cpp Source/Convolver.cpp Source/FFT.cpp Source/DSPUtils.cpp -o ImpulseResponseTest
+// run: ./ImpulseResponseTest [--duration 5] [--seed 1]
+
+#include "Gui.h"
+#include "SweepAnalysis.h"
+#include "Convolver.h"
+#include "DSPUtils.h"
+
+#include <vector>
+#include <complex>
+#include <numbers>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define TEST_SAMPLE_RATE 48000.0f
+#define TEST_START_FREQUENCY 20.0f
+#define TEST_STOP_FREQUENCY 20000.0f
+#define TEST_CUTOFF 2000.0f
+#define TEST_AMPLITUDE 0.5
+#define TEST_K2 0.1 // second order coefficient of the nonlinearity
+#define TEST_K3 0.05 // third order coefficient of the nonlinearity
+#define TEST_LATENCY 1024 // output buffer of the generator in samples
+#define TEST_MIN_FREQUENCY 50.0f // checked range of the harmonic frequencies (the fades of the sweep are left out)
+#define TEST_MAX_FREQUENCY 15000.0f
+#define TEST_MAX_LINEAR_ERROR 0.1 // in dB
+#define TEST_MAX_HARMONIC_ERROR 0.5 // in dB
+#define TEST_KERNEL_SIZE 4800 // kernel of the convolution test
+#define TEST_MAX_CONVOLUTION_ERROR 1e-5 // relative to the peak of the output
+
+// one pole lowpass followed by a nonlinearity (double precision), the lowpass keeps the harmonics
+// of the high frequencies from aliasing
+class DeviceUnderTest {
+
+private:
+	double m_alpha;
+	double m_state;
+
+public:
+	DeviceUnderTest(double cutoff) : m_alpha(1.0 - exp(-2.0 * std::numbers::pi * cutoff / TEST_SAMPLE_RATE)), m_state(0.0) { }
+
+public:
+	float process(double x) {
+
+		m_state += m_alpha * (x - m_state);
+		double u = m_state;
+
+		return (float)(u + TEST_K2 * u * u + TEST_K3 * u * u * u);
+	}
+
+	double getGain(double frequency) {
+
+		std::complex<double> z1 = std::polar(1.0, -2.0 * std::numbers::pi * frequency / TEST_SAMPLE_RATE);
+
+		return std::abs(m_alpha / (1.0 - (1.0 - m_alpha) * z1));
+	}
+
+	// level of harmonic n of a sine of the test amplitude relative to the amplitude (in dB)
+	double getLevel(int n, double frequency) {
+
+		// amplitude at the nonlinearity
+		double A = TEST_AMPLITUDE * getGain(frequency);
+		double level = 0.0;
+
+		switch (n) {
+		case 1: level = 1.0 + 0.75 * TEST_K3 * A * A; break; // the third order term adds to the fundamental
+		case 2: level = 0.5 * TEST_K2 * A; break;
+		case 3: level = 0.25 * TEST_K3 * A * A; break;
+		}
+
+		return 20.0 * log10(level * getGain(frequency));
+	}
+};
+
+// compares the streaming and the block convolution of a few seconds of noise against a direct convolution
+static bool testConvolution(int size, std::mt19937& random) {
+
+	std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> pieceSize(1, 3 * TEST_KERNEL_SIZE);
+
+	std::vector<float> kernel(TEST_KERNEL_SIZE);
+	std::vector<float> input(size);
+
+	// decaying kernel like an impulse response
+	for (int i = 0; i < TEST_KERNEL_SIZE; ++i) {
+		kernel[i] = noise(random) * expf(-5.0f * i / TEST_KERNEL_SIZE);
+	}
+	for (int i = 0; i < size; ++i) {
+		input[i] = noise(random);
+	}
+
+	// direct convolution
+	std::vector<double> expected(size + TEST_KERNEL_SIZE - 1, 0.0);
+
+	for (int i = 0; i < size; ++i) {
+		for (int k = 0; k < TEST_KERNEL_SIZE; ++k) {
+			expected[i + k] += (double)input[i] * kernel[k];
+		}
+	}
+
+	double peak = 0.0;
+	for (int i = 0; i < (int)expected.size(); ++i) {
+		peak = max(peak, fabs(expected[i]));
+	}
+
+	// whole signal at once
+	Convolver convolver(kernel.data(), TEST_KERNEL_SIZE);
+
+	std::vector<float> output(convolver.getOutputSize(size));
+	convolver.convolve(input.data(), size, output.data());
+
+	double blockError = 0.0;
+	for (int i = 0; i < (int)output.size(); ++i) {
+		blockError = max(blockError, fabs(output[i] - expected[i]) / peak);
+	}
+
+	// stream in pieces of random size (shorter and longer than the kernel), the output is as long as the input
+	Convolver stream(kernel.data(), TEST_KERNEL_SIZE);
+	std::vector<float> data(input);
+
+	int nPieces = 0;
+	for (int first = 0; first < size; ++nPieces) {
+
+		int nSamples = min(pieceSize(random), size - first);
+		stream.process(data.data() + first, nSamples);
+		first += nSamples;
+	}
+
+	double streamError = 0.0;
+	for (int i = 0; i < size; ++i) {
+		streamError = max(streamError, fabs(data[i] - expected[i]) / peak);
+	}
+
+	bool passed = blockError <= TEST_MAX_CONVOLUTION_ERROR && streamError <= TEST_MAX_CONVOLUTION_ERROR;
+
+	printf("convolution of %d samples with %d taps: max. error %.1e (block), %.1e (stream of %d pieces)%s\n", size, TEST_KERNEL_SIZE,
+		blockError, streamError, nPieces, passed ? "" : " failed");
+
+	return passed;
+}
+
+int main(int argc, char** argv) {
+
+	float duration = 5.0f;
+	int seed = 1;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+			// shorter sweeps leave too little room before the harmonics for the ringing of the low frequencies
+			duration = max((float)atof(argv[++i]), 2.0f);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+			seed = atoi(argv[++i]);
+		}
+	}
+
+	// recording of the sweep like the measurement captures it (CH1 input, CH2 output)
+	int sweepSize = (int)(duration * TEST_SAMPLE_RATE);
+	int captureSize = TEST_LATENCY + sweepSize + (int)(IMPRESP_TAIL_TIME * TEST_SAMPLE_RATE);
+
+	ImpulseResponseJob job;
+	job.startFrequency = TEST_START_FREQUENCY;
+	job.stopFrequency = TEST_STOP_FREQUENCY;
+	job.duration = duration;
+	job.sampleRate = TEST_SAMPLE_RATE;
+	job.amplitude = TEST_AMPLITUDE;
+
+	job.reference.resize(captureSize);
+	job.response.resize(captureSize);
+
+	DeviceUnderTest device(TEST_CUTOFF);
+
+	for (int i = 0; i < captureSize; ++i) {
+
+		// same stimulus as the generator (silence before and after the sweep)
+		double time = (i - TEST_LATENCY) / (double)TEST_SAMPLE_RATE;
+		float x = 0.0f;
+
+		if (time >= 0.0 && time < duration) {
+			double phase = DSP::sweepPhase(time, TEST_START_FREQUENCY, TEST_STOP_FREQUENCY, duration);
+			x = (float)(TEST_AMPLITUDE * DSP::sweepFade(time, duration) * sin(2 * std::numbers::pi * (phase - floor(phase))));
+		}
+
+		job.reference[i] = x;
+		job.response[i] = device.process(x);
+	}
+
+	ImpulseResponseResult result;
+	SweepAnalysis::analyze(job, result);
+
+	// compare the levels where the harmonic lies within the checked range
+	bool passed = true;
+
+	// reported point
+	int report = 0;
+	while (report + 1 < IMPRESP_PLOT_SIZE && result.frequencies[report] < 100.0f) {
+		++report;
+	}
+
+	for (int n = 1; n <= 3; ++n) {
+
+		double maxError = 0.0;
+		int nChecked = 0;
+
+		for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+
+			float frequency = result.frequencies[j];
+
+			if (frequency < TEST_MIN_FREQUENCY || n * frequency > TEST_MAX_FREQUENCY) {
+				continue;
+			}
+
+			double error = fabs(result.levels[n - 1][j] - device.getLevel(n, frequency));
+			maxError = max(maxError, error);
+			++nChecked;
+		}
+
+		double maxAllowed = n == 1 ? TEST_MAX_LINEAR_ERROR : TEST_MAX_HARMONIC_ERROR;
+		passed = passed && maxError <= maxAllowed;
+
+		printf("harmonic %d: %7.2f dB at %.0f Hz (expected %7.2f dB), max. error %.3f dB over %d frequencies%s\n", n,
+			result.levels[n - 1][report], result.frequencies[report], device.getLevel(n, result.frequencies[report]), maxError, nChecked,
+			maxError <= maxAllowed ? "" : " failed");
+	}
+
+	std::mt19937 random(seed);
+	passed = testConvolution(sweepSize, random) && passed;
+
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+// Waveforms per second of the persistence map at the size used by the oscilloscope
+// (512 columns and 256 amplitude bins). The envelopes are folded in directly (the work of
+// the worker thread) and through the queue (the capture path), and the map is rendered.
+// The hits of a single waveform are checked against the bins it covers.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/PersistenceBenchmark.cpp Source/PersistenceMap.cpp ../GuiFramework/Source/Style/Color.cpp -o PersistenceBenchmark
+// run: ./PersistenceBenchmark [--waveforms 20000]
+
+#include "Gui.h"
+#include "PersistenceMap.h"
+
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define BENCHMARK_WIDTH 512
+#define BENCHMARK_HEIGHT 256
+#define BENCHMARK_RANGE 2.0f
+#define BENCHMARK_MAX_PENDING 512 // waveforms queued ahead of the worker (the queue drops above its limit)
+
+static double getSeconds(std::chrono::steady_clock::time_point start) {
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// a single flat waveform has to light exactly the rows it covers
+static bool checkHits() {
+
+	PersistenceMap map(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, -BENCHMARK_RANGE, BENCHMARK_RANGE, Color(0xFFFFFF));
+
+	std::vector<float> minimum(BENCHMARK_WIDTH, 0.0f);
+	std::vector<float> maximum(BENCHMARK_WIDTH, 0.5f);
+
+	map.accumulate(minimum.data(), maximum.data());
+	unsigned int* p_pixels = map.render();
+
+	float binScale = (BENCHMARK_HEIGHT - 1) / (2.0f * BENCHMARK_RANGE);
+	int firstBin = (int)floorf(BENCHMARK_RANGE * binScale);
+	int lastBin = (int)ceilf((0.5f + BENCHMARK_RANGE) * binScale);
+
+	for (int r = 0; r < BENCHMARK_HEIGHT; ++r) {
+
+		int bin = BENCHMARK_HEIGHT - 1 - r;
+		bool covered = bin >= firstBin && bin <= lastBin;
+
+		for (int c = 0; c < BENCHMARK_WIDTH; ++c) {
+			if ((p_pixels[r * BENCHMARK_WIDTH + c] != 0) != covered) {
+				printf("pixel (%d, %d) %s\n", c, r, covered ? "not hit" : "hit");
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv) {
+
+	int nWaveforms = 20000;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--waveforms") == 0 && i + 1 < argc) {
+			nWaveforms = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	// noisy sine envelopes (a few different ones, that way every waveform covers other bins)
+	int nShapes = 64;
+	std::vector<float> minimum(nShapes * BENCHMARK_WIDTH);
+	std::vector<float> maximum(nShapes * BENCHMARK_WIDTH);
+
+	for (int s = 0; s < nShapes; ++s) {
+		for (int c = 0; c < BENCHMARK_WIDTH; ++c) {
+
+			float value = sinf(c * 0.05f + s * 0.1f);
+			float noise = (rand() % 100) / 1000.0f;
+
+			minimum[s * BENCHMARK_WIDTH + c] = value - 0.05f - noise;
+			maximum[s * BENCHMARK_WIDTH + c] = value + 0.05f + noise;
+		}
+	}
+
+	PersistenceMap map(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, -BENCHMARK_RANGE, BENCHMARK_RANGE, Color(0xFFFFFF));
+
+	// work of the worker thread
+	auto start = std::chrono::steady_clock::now();
+
+	for (int w = 0; w < nWaveforms; ++w) {
+
+		int s = w % nShapes;
+		map.accumulate(minimum.data() + s * BENCHMARK_WIDTH, maximum.data() + s * BENCHMARK_WIDTH);
+	}
+
+	printf("accumulate: %.0f waveforms/s\n", nWaveforms / getSeconds(start));
+
+	// queued from the capture path (waits if the worker falls behind, that way nothing is dropped)
+	map.clear();
+	long long processed = map.getWaveformCount();
+
+	start = std::chrono::steady_clock::now();
+
+	for (int w = 0; w < nWaveforms; ++w) {
+
+		while (w - (map.getWaveformCount() - processed) > BENCHMARK_MAX_PENDING) {
+			std::this_thread::yield();
+		}
+
+		int s = w % nShapes;
+		map.addWaveform(minimum.data() + s * BENCHMARK_WIDTH, maximum.data() + s * BENCHMARK_WIDTH);
+	}
+
+	while (map.getWaveformCount() - processed < nWaveforms) {
+		std::this_thread::yield();
+	}
+
+	printf("queued: %.0f waveforms/s\n", nWaveforms / getSeconds(start));
+
+	// rendering happens once per tick
+	int nRenders = 100;
+	start = std::chrono::steady_clock::now();
+
+	for (int r = 0; r < nRenders; ++r) {
+		map.render();
+	}
+
+	printf("render: %.3f ms\n", getSeconds(start) / nRenders * 1e3);
+
+	bool passed = checkHits();
+	printf("hits: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
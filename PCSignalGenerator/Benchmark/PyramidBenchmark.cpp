@@ -0,0 +1,131 @@
+// Cost of the full rate oscilloscope record: one second of 8 channels at 192 kHz is pushed
+// into the min/max pyramids of all channels (the capture path of every tick) and the whole
+// record is reduced to the plot envelope (the plot path). Queries of random spans are checked
+// against a brute force minimum and maximum.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/PyramidBenchmark.cpp Source/MinMaxPyramid.cpp -o PyramidBenchmark
+// run: ./PyramidBenchmark [--seconds 10]
+
+#include "Gui.h"
+#include "MinMaxPyramid.h"
+
+#include <vector>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define BENCHMARK_SAMPLE_RATE 192000
+#define BENCHMARK_CHANNELS 8
+#define BENCHMARK_RECORD_SIZE 1048576 // same as the oscilloscope
+#define BENCHMARK_PACKET_SIZE 1920 // 10 ms, the size of a capture packet
+#define BENCHMARK_COLUMNS 512 // plot columns of the envelope
+#define BENCHMARK_QUERIES 1000
+
+static double getSeconds(std::chrono::steady_clock::time_point start) {
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// minimum and maximum of random spans against a brute force search
+static bool checkQueries(MinMaxPyramid& record, std::vector<float>& samples, std::mt19937& random) {
+
+	long long first = record.getFirstAvailable();
+	long long count = record.getCount();
+
+	for (int q = 0; q < BENCHMARK_QUERIES; ++q) {
+
+		long long begin = first + random() % (count - first);
+		long long end = begin + 1 + random() % (count - begin);
+
+		float minValue;
+		float maxValue;
+		record.getMinMax(begin, end, minValue, maxValue);
+
+		float expectedMin = samples[begin];
+		float expectedMax = samples[begin];
+
+		for (long long i = begin; i < end; ++i) {
+			expectedMin = min(expectedMin, samples[i]);
+			expectedMax = max(expectedMax, samples[i]);
+		}
+
+		if (minValue != expectedMin || maxValue != expectedMax) {
+			printf("query [%lld, %lld) failed\n", begin, end);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv) {
+
+	int nSeconds = 10;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+			nSeconds = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	// one second of every channel (repeated, the pyramid doesn't depend on the values)
+	std::vector<std::vector<float>> channels(BENCHMARK_CHANNELS, std::vector<float>(BENCHMARK_SAMPLE_RATE));
+	for (std::vector<float>& channel : channels) {
+		for (float& sample : channel) {
+			sample = distribution(random);
+		}
+	}
+
+	std::vector<MinMaxPyramid> records(BENCHMARK_CHANNELS, MinMaxPyramid(BENCHMARK_RECORD_SIZE));
+
+	// capture path (packets of all channels, like every tick of the oscilloscope)
+	auto start = std::chrono::steady_clock::now();
+
+	for (int s = 0; s < nSeconds; ++s) {
+		for (int first = 0; first < BENCHMARK_SAMPLE_RATE; first += BENCHMARK_PACKET_SIZE) {
+			for (int c = 0; c < BENCHMARK_CHANNELS; ++c) {
+				records[c].push(channels[c].data() + first, min(BENCHMARK_PACKET_SIZE, BENCHMARK_SAMPLE_RATE - first));
+			}
+		}
+	}
+
+	double pushTime = getSeconds(start) / nSeconds;
+
+	printf("push: %.2f ms per second of %d x %d kHz (%.0f x real time, %.1f Msamples/s)\n", pushTime * 1e3, BENCHMARK_CHANNELS,
+		BENCHMARK_SAMPLE_RATE / 1000, 1.0 / pushTime, BENCHMARK_CHANNELS * BENCHMARK_SAMPLE_RATE / pushTime / 1e6);
+
+	// plot path (the whole record of all channels reduced to the plot columns)
+	std::vector<float> minimum(BENCHMARK_COLUMNS);
+	std::vector<float> maximum(BENCHMARK_COLUMNS);
+
+	int nEnvelopes = 100;
+	start = std::chrono::steady_clock::now();
+
+	for (int e = 0; e < nEnvelopes; ++e) {
+		for (MinMaxPyramid& record : records) {
+			record.getEnvelope(record.getFirstAvailable(), record.getCount() - record.getFirstAvailable(), BENCHMARK_COLUMNS, minimum.data(), maximum.data());
+		}
+	}
+
+	printf("envelope: %.3f ms for %d channels of %d samples\n", getSeconds(start) / nEnvelopes * 1e3, BENCHMARK_CHANNELS, BENCHMARK_RECORD_SIZE);
+
+	// check queries on a record that wrapped around several times
+	MinMaxPyramid record(BENCHMARK_RECORD_SIZE / 16);
+	std::vector<float> samples(BENCHMARK_RECORD_SIZE / 4);
+
+	for (float& sample : samples) {
+		sample = distribution(random);
+		record.push(sample);
+	}
+
+	bool passed = checkQueries(record, samples, random);
+	printf("queries: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+// Synthetic burst test of segmented acquisition. Bursts (a single sample above the trigger level)
+// are spaced closer than the segment length and fed to the recorder in capture packets, the same
+// way the oscilloscope does. Checks the number of captured segments, their trigger positions,
+// timestamps and data, and the re-arm gap (samples between the end of the post-trigger window
+// of a segment and the earliest trigger of the next one).
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/SegmentBurstTest.cpp Source/SegmentRecorder.cpp Source/SegmentPool.cpp Source/MinMaxPyramid.cpp -o SegmentBurstTest
+// run: ./SegmentBurstTest
+
+#include "Gui.h"
+#include "SegmentRecorder.h"
+
+#include <vector>
+#include <stdio.h>
+
+#define TEST_SAMPLE_RATE 48000.0f
+#define TEST_RECORD_SIZE 1048576
+#define TEST_SEGMENT_COUNT 64
+#define TEST_SEGMENT_SIZE 1024
+#define TEST_PACKET_SIZE 480 // 10 ms
+#define TEST_FIRST_BURST 2000
+#define TEST_LEVEL 0.5f
+
+// feeds bursts at the given spacing and checks the captured segments against the trigger rule
+static bool testSpacing(int spacing, int nBursts, int& rearmGap) {
+
+	// channel 0 holds the bursts, channel 1 the record index (shows where a segment was copied from)
+	std::vector<MinMaxPyramid> records(2, MinMaxPyramid(TEST_RECORD_SIZE));
+
+	SegmentPool pool(TEST_SEGMENT_COUNT, 2, TEST_SEGMENT_SIZE);
+	SegmentRecorder recorder(&pool, TEST_SEGMENT_SIZE);
+
+	int postWindow = TEST_SEGMENT_SIZE - TEST_SEGMENT_SIZE / 2;
+	int length = TEST_FIRST_BURST + spacing * nBursts + 2 * TEST_SEGMENT_SIZE;
+
+	// bursts the recorder has to capture (a burst before the re-arm index is skipped)
+	std::vector<long long> expected;
+	long long rearm = 0;
+
+	for (int b = 0; b < nBursts; ++b) {
+
+		long long position = TEST_FIRST_BURST + (long long)b * spacing;
+
+		if (position >= rearm && expected.size() < TEST_SEGMENT_COUNT) {
+			expected.push_back(position);
+			rearm = position + postWindow;
+		}
+	}
+
+	// capture in packets (trigger every sample, store complete segments after every packet)
+	std::vector<float> bursts(TEST_PACKET_SIZE);
+	std::vector<float> indices(TEST_PACKET_SIZE);
+
+	float lastValue = 0.0f;
+	rearmGap = -1;
+
+	for (long long first = 0; first < length; first += TEST_PACKET_SIZE) {
+
+		for (int i = 0; i < TEST_PACKET_SIZE; ++i) {
+
+			long long index = first + i;
+			bool burst = index >= TEST_FIRST_BURST && (index - TEST_FIRST_BURST) % spacing == 0 && (index - TEST_FIRST_BURST) / spacing < nBursts;
+
+			bursts[i] = burst ? 1.0f : 0.0f;
+			indices[i] = (float)index;
+		}
+
+		records[0].push(bursts.data(), TEST_PACKET_SIZE);
+		records[1].push(indices.data(), TEST_PACKET_SIZE);
+
+		for (int i = 0; i < TEST_PACKET_SIZE; ++i) {
+
+			long long index = first + i;
+			long long armed = recorder.getRearmIndex();
+
+			// the gap is measured from the re-arm index of the previous segment
+			if (recorder.trigger(lastValue, bursts[i], TEST_LEVEL, index) && pool.getCount() + recorder.getPendingCount() > 1) {
+				rearmGap = rearmGap < 0 ? (int)(index - armed) : min(rearmGap, (int)(index - armed));
+			}
+
+			lastValue = bursts[i];
+		}
+
+		recorder.store(records, TEST_SAMPLE_RATE);
+	}
+
+	// number of segments
+	if (pool.getCount() != (int)expected.size()) {
+		printf("spacing %d: %d segments captured, %d expected\n", spacing, pool.getCount(), (int)expected.size());
+		return false;
+	}
+
+	for (int s = 0; s < pool.getCount(); ++s) {
+
+		Segment segment = pool.getSegment(s);
+
+		// trigger position and timestamp
+		double timestamp = (expected[s] - expected[0]) / (double)TEST_SAMPLE_RATE;
+
+		if (segment.triggerIndex != expected[s] || segment.timestamp != timestamp || segment.size != TEST_SEGMENT_SIZE) {
+			printf("spacing %d: segment %d triggered at %lld, expected %lld\n", spacing, s, segment.triggerIndex, expected[s]);
+			return false;
+		}
+
+		// the trigger is in the center of the segment, the window is copied from the right place
+		float* p_bursts = pool.getSegmentData(s, 0);
+		float* p_indices = pool.getSegmentData(s, 1);
+
+		for (int i = 0; i < TEST_SEGMENT_SIZE; ++i) {
+			if (p_indices[i] != (float)(expected[s] - TEST_SEGMENT_SIZE / 2 + i)) {
+				printf("spacing %d: segment %d holds the wrong samples\n", spacing, s);
+				return false;
+			}
+		}
+
+		if (p_bursts[TEST_SEGMENT_SIZE / 2] != 1.0f) {
+			printf("spacing %d: segment %d doesn't hold its burst at the trigger\n", spacing, s);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main() {
+
+	bool passed = true;
+
+	// spacing (in samples) of the bursts, all closer than the segment length
+	int a_spacings[] = { TEST_SEGMENT_SIZE - TEST_SEGMENT_SIZE / 2, 300, 700, TEST_SEGMENT_SIZE - 1 };
+	int nBursts = 40;
+
+	for (int spacing : a_spacings) {
+
+		int rearmGap;
+		bool spacingPassed = testSpacing(spacing, nBursts, rearmGap);
+
+		// bursts at exactly the post-trigger window are all captured, so the trigger re-arms without dead time
+		if (spacing == TEST_SEGMENT_SIZE - TEST_SEGMENT_SIZE / 2 && rearmGap != 0) {
+			printf("spacing %d: re-arm gap of %d samples\n", spacing, rearmGap);
+			spacingPassed = false;
+		}
+
+		printf("spacing %4d: %s, shortest re-arm gap %d samples\n", spacing, spacingPassed ? "passed" : "failed", rearmGap);
+		passed = passed && spacingPassed;
+	}
+
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+// Update rate of the transfer function analyzer at the default frame size (16k samples, a new
+// result every half frame). The measured channel is the reference delayed by a number of
+// samples, after a while the delay changes (like switching to another device), which has to
+// be tracked by the analyzer.
+//
+// build (from PCSignalGenerator): g++ -std=c++20 -O2 -DGUI_HEADLESS -IInclude -I../GuiFramework/Include
+//   Benchmark/TransferBenchmark.cpp Source/TransferFunctionAnalyzer.cpp Source/DSPUtils.cpp Source/FFT.cpp -o TransferBenchmark
+// run: ./TransferBenchmark [--frames 200]
+
+#include "Gui.h"
+#include "TransferFunctionAnalyzer.h"
+
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define BENCHMARK_SAMPLE_RATE 48000.0f
+#define BENCHMARK_FIRST_DELAY 37 // in samples
+#define BENCHMARK_SECOND_DELAY 4000 // about 80 ms later, like another device
+#define BENCHMARK_LEAD 1024 // frames are aligned by the delay, so they need more samples than the frame size
+#define BENCHMARK_TIMEOUT 0.5 // longest wait for a result (in s)
+
+static double getSeconds(std::chrono::steady_clock::time_point start) {
+
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// excitation with the measured channel behind the reference by the delay
+class DelayedNoise {
+
+private:
+	std::mt19937 m_random;
+	std::normal_distribution<float> m_distribution;
+
+	std::vector<float> m_history; // latest reference samples (ring)
+	long long m_count;
+
+public:
+	DelayedNoise() : m_random(1), m_distribution(0.0f, 0.3f), m_history(8192, 0.0f), m_count(0) { }
+
+public:
+	void generate(float* pa_reference, float* pa_measurement, int size, int delay) {
+
+		for (int i = 0; i < size; ++i, ++m_count) {
+
+			float sample = m_distribution(m_random);
+			m_history[m_count % m_history.size()] = sample;
+
+			pa_reference[i] = sample;
+			pa_measurement[i] = m_count >= delay ? m_history[(m_count - delay) % m_history.size()] : 0.0f;
+		}
+	}
+};
+
+// passes one hop and waits for the result of it (false if the analyzer doesn't respond)
+static bool analyzeHop(TransferFunctionAnalyzer& analyzer, DelayedNoise& noise, std::vector<float>& reference,
+	std::vector<float>& measurement, int delay) {
+
+	noise.generate(reference.data(), measurement.data(), reference.size(), delay);
+	analyzer.addSamples(reference.data(), measurement.data(), reference.size());
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (!analyzer.update()) {
+
+		if (getSeconds(start) > BENCHMARK_TIMEOUT) {
+			return false;
+		}
+
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv) {
+
+	int nFrames = 200;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			nFrames = max(atoi(argv[++i]), 1);
+		}
+	}
+
+	TransferFunctionAnalyzer analyzer(BENCHMARK_SAMPLE_RATE, TRANSFER_SIZE);
+	analyzer.enableAnalysis(true);
+
+	DelayedNoise noise;
+
+	int hop = TRANSFER_SIZE / 2;
+	std::vector<float> reference(hop);
+	std::vector<float> measurement(hop);
+
+	// the first result needs a whole frame (and the samples it is shifted by)
+	std::vector<float> leadReference(hop + BENCHMARK_LEAD);
+	std::vector<float> leadMeasurement(hop + BENCHMARK_LEAD);
+
+	noise.generate(leadReference.data(), leadMeasurement.data(), leadReference.size(), BENCHMARK_FIRST_DELAY);
+	analyzer.addSamples(leadReference.data(), leadMeasurement.data(), leadReference.size());
+
+	bool passed = true;
+
+	// update rate (every hop is analyzed before the next one is passed)
+	auto start = std::chrono::steady_clock::now();
+
+	for (int f = 0; f < nFrames && passed; ++f) {
+		passed = analyzeHop(analyzer, noise, reference, measurement, BENCHMARK_FIRST_DELAY);
+	}
+
+	double frameTime = getSeconds(start) / nFrames;
+
+	// a new frame is due every hop
+	double realTime = hop / BENCHMARK_SAMPLE_RATE / frameTime;
+
+	printf("update: %.2f ms per frame of %d, %.0f frames/s (%.0f x real time at %.0f kHz)\n", frameTime * 1e3, TRANSFER_SIZE,
+		1.0 / frameTime, realTime, BENCHMARK_SAMPLE_RATE / 1000.0f);
+
+	double delay = analyzer.getDelay() * BENCHMARK_SAMPLE_RATE;
+	bool delayPassed = fabs(delay - BENCHMARK_FIRST_DELAY) < 0.1;
+	printf("delay: %.3f samples (expected %d)\n", delay, BENCHMARK_FIRST_DELAY);
+
+	// the delay changes, it has to be measured again (when the coherence drops or after the interval)
+	int nTracked = -1;
+
+	for (int f = 0; f <= 2 * TRANSFER_DELAY_INTERVAL; ++f) {
+
+		// a frame aligned by a longer delay needs the samples of the next hop too, so a hop may give no result
+		analyzeHop(analyzer, noise, reference, measurement, BENCHMARK_SECOND_DELAY);
+
+		if (fabs(analyzer.getDelay() * BENCHMARK_SAMPLE_RATE - BENCHMARK_SECOND_DELAY) < 0.1) {
+			nTracked = f + 1;
+			break;
+		}
+	}
+
+	bool trackPassed = nTracked > 0;
+
+	if (trackPassed) {
+		printf("changed delay: tracked after %d frames\n", nTracked);
+	}
+	else {
+		printf("changed delay: not tracked (%.3f samples)\n", analyzer.getDelay() * BENCHMARK_SAMPLE_RATE);
+	}
+
+	passed = passed && delayPassed && trackPassed;
+	printf("results: %s\n", passed ? "passed" : "failed");
+
+	return passed ? 0 : 1;
+}
\ No newline at end of file
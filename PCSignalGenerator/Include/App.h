@@ -13,24 +13,45 @@
 #include "Widgets/StateButton.h"
 #include "Widgets/CheckBox.h"
 #include "Widgets/PlotSeries1D.h"
+#include "Widgets/PlotSeries2D.h"
+#include "Widgets/PlotSeriesImage.h"
 
 #include "SignalGenerator.h"
 #include "Oscilloscope.h"
+#include "FrequencyResponse.h"
+#include "ImpulseResponse.h"
+#include "LatencyMeter.h"
 
 class App : public Application {
 
 private:
 	SignalGenerator* mp_sigGen;
 	Oscilloscope* mp_osc;
+	FrequencyResponse* mp_freqResponse;
+	ImpulseResponse* mp_impulseResponse;
+	LatencyMeter* mp_latencyMeter;
 
 	MainWindow* mp_window;
 
 	Plot* mp_sigGenPlot;
 	Plot* mp_oscPlot;
 	Plot* mp_bode;
+	Plot* mp_spectrumPlot;
+	Plot* mp_spectrogramPlot;
+	Plot* mp_impulsePlot;
 
 	PlotSeries1D* mp_sigGenPlotSeries;
-	PlotSeries1D* mp_oscPlotSeries;
+	std::vector<PlotSeries1D*> mp_oscPlotSeries; // one per channel and the math channel
+	PlotSeriesImage* mp_persistenceSeries;
+	PlotSeries1D* mp_spectrumPlotSeries;
+	PlotSeriesImage* mp_spectrogramSeries;
+	PlotSeries1D* mp_gainPlotSeries;
+	PlotSeries1D* mp_phasePlotSeries;
+	PlotSeries1D* mp_transferGainSeries;
+	PlotSeries1D* mp_transferPhaseSeries;
+	PlotSeries1D* mp_coherenceSeries;
+	PlotSeries1D* mp_impulsePlotSeries;
+	PlotSeries2D* mp_harmonicPlotSeries; // one channel for the fundamental and every harmonic
 
 	LinearLayout* mp_mainLayout;
 	LinearLayout* mp_parameterLayout;
@@ -40,10 +61,24 @@ private:
 	GroupBox* mp_sigGenGroup;
 	GroupBox* mp_oscGroup;
 	GroupBox* mp_freqResponseGroup;
+	GroupBox* mp_spectrumGroup;
+	GroupBox* mp_impulseGroup;
+	GroupBox* mp_distortionGroup;
+	GroupBox* mp_measurementGroup;
+	GroupBox* mp_filterGroup;
+	GroupBox* mp_transferGroup;
+	GroupBox* mp_latencyGroup;
 
 	GridLayout* mp_sigGenLayout;
 	GridLayout* mp_oscLayout;
 	GridLayout* mp_freqResponseLayout;
+	GridLayout* mp_spectrumLayout;
+	GridLayout* mp_impulseLayout;
+	GridLayout* mp_distortionLayout;
+	GridLayout* mp_measurementLayout;
+	GridLayout* mp_filterLayout;
+	GridLayout* mp_transferLayout;
+	GridLayout* mp_latencyLayout;
 
 	Label* mp_enableSigGenLabel;
 	StateButton* mp_enableSigGenButton;
@@ -69,6 +104,193 @@ private:
 	Label* mp_triggerLevelLabel;
 	Slider<float>* mp_triggerLevelSlider;
 
+	Label* mp_triggerSourceLabel;
+	ComboBox* mp_triggerSourceComboBox;
+
+	Label* mp_mathModeLabel;
+	ComboBox* mp_mathModeComboBox;
+
+	Label* mp_scaleChannelLabel;
+	ComboBox* mp_scaleChannelComboBox;
+
+	Label* mp_channelScaleLabel;
+	Slider<float>* mp_channelScaleSlider;
+
+	Label* mp_segmentLabel;
+	Slider<int>* mp_segmentSlider;
+
+	Label* mp_segmentViewLabel;
+	ComboBox* mp_segmentViewComboBox;
+
+	Label* mp_persistenceLabel;
+	ComboBox* mp_persistenceComboBox;
+
+	Label* mp_spectrumChannelLabel;
+	ComboBox* mp_spectrumChannelComboBox;
+
+	Label* mp_spectrumSizeLabel;
+	ComboBox* mp_spectrumSizeComboBox;
+
+	Label* mp_spectrumWindowLabel;
+	ComboBox* mp_spectrumWindowComboBox;
+
+	Label* mp_spectrumOverlapLabel;
+	ComboBox* mp_spectrumOverlapComboBox;
+
+	Label* mp_spectrumAveragingLabel;
+	ComboBox* mp_spectrumAveragingComboBox;
+
+	Label* mp_spectrumScaleLabel;
+	ComboBox* mp_spectrumScaleComboBox;
+
+	Label* mp_colorMapLabel;
+	ComboBox* mp_colorMapComboBox;
+
+	Label* mp_spectrogramSaveLabel;
+	Button* mp_spectrogramSaveButton;
+
+	Label* mp_measureLabel;
+	StateButton* mp_measureButton;
+
+	Label* mp_startFrequencyLabel;
+	Slider<float>* mp_startFrequencySlider;
+
+	Label* mp_stopFrequencyLabel;
+	Slider<float>* mp_stopFrequencySlider;
+
+	Label* mp_pointCountLabel;
+	Slider<int>* mp_pointCountSlider;
+
+	Label* mp_bodeDisplayLabel;
+	ComboBox* mp_bodeDisplayComboBox;
+
+	Label* mp_sweepMeasureLabel;
+	StateButton* mp_sweepMeasureButton;
+
+	Label* mp_sweepStartLabel;
+	Slider<float>* mp_sweepStartSlider;
+
+	Label* mp_sweepStopLabel;
+	Slider<float>* mp_sweepStopSlider;
+
+	Label* mp_sweepDurationLabel;
+	Slider<float>* mp_sweepDurationSlider;
+
+	Label* mp_impulseDisplayLabel;
+	ComboBox* mp_impulseDisplayComboBox;
+
+	Label* mp_distortionChannelLabel;
+	ComboBox* mp_distortionChannelComboBox;
+
+	Label* mp_fundamentalLabel;
+	Label* mp_fundamentalValueLabel;
+
+	Label* mp_thdLabel;
+	Label* mp_thdValueLabel;
+
+	Label* mp_thdNLabel;
+	Label* mp_thdNValueLabel;
+
+	Label* mp_sinadLabel;
+	Label* mp_sinadValueLabel;
+
+	Label* mp_snrLabel;
+	Label* mp_snrValueLabel;
+
+	Label* mp_enobLabel;
+	Label* mp_enobValueLabel;
+
+	Label* mp_measurementChannelLabel;
+	ComboBox* mp_measurementChannelComboBox;
+
+	Label* mp_measuredFrequencyLabel;
+	Label* mp_measuredFrequencyValueLabel;
+
+	Label* mp_measuredPeriodLabel;
+	Label* mp_measuredPeriodValueLabel;
+
+	Label* mp_peakToPeakLabel;
+	Label* mp_peakToPeakValueLabel;
+
+	Label* mp_rmsLabel;
+	Label* mp_rmsValueLabel;
+
+	Label* mp_meanLabel;
+	Label* mp_meanValueLabel;
+
+	Label* mp_riseTimeLabel;
+	Label* mp_riseTimeValueLabel;
+
+	Label* mp_fallTimeLabel;
+	Label* mp_fallTimeValueLabel;
+
+	Label* mp_measuredDutyCycleLabel;
+	Label* mp_measuredDutyCycleValueLabel;
+
+	Label* mp_acquisitionCountLabel;
+	Label* mp_acquisitionCountValueLabel;
+
+	Label* mp_statisticsLabel;
+	Button* mp_resetStatisticsButton;
+
+	Label* mp_filterTypeLabel;
+	ComboBox* mp_filterTypeComboBox;
+
+	Label* mp_filterResponseLabel;
+	ComboBox* mp_filterResponseComboBox;
+
+	Label* mp_filterFrequencyLabel;
+	Slider<float>* mp_filterFrequencySlider;
+
+	Label* mp_filterOrderLabel;
+	Slider<int>* mp_filterOrderSlider;
+
+	Label* mp_filterTapsLabel;
+	Slider<int>* mp_filterTapsSlider;
+
+	Label* mp_transferEnableLabel;
+	StateButton* mp_transferEnableButton;
+
+	Label* mp_transferReferenceLabel;
+	ComboBox* mp_transferReferenceComboBox;
+
+	Label* mp_transferChannelLabel;
+	ComboBox* mp_transferChannelComboBox;
+
+	Label* mp_estimatorLabel;
+	ComboBox* mp_estimatorComboBox;
+
+	Label* mp_transferAveragesLabel;
+	Slider<int>* mp_transferAveragesSlider;
+
+	Label* mp_delayLabel;
+	Label* mp_delayValueLabel;
+
+	Label* mp_transferResetLabel;
+	Button* mp_transferResetButton;
+
+	Label* mp_latencyMeasureLabel;
+	StateButton* mp_latencyMeasureButton;
+
+	Label* mp_latencyChannelLabel;
+	ComboBox* mp_latencyChannelComboBox;
+
+	Label* mp_latencyLabel;
+	Label* mp_latencyValueLabel;
+
+	Label* mp_driftLabel;
+	Label* mp_driftValueLabel;
+
+	Label* mp_markerCountLabel;
+	Label* mp_markerCountValueLabel;
+
+	Label* mp_clockCorrectionLabel;
+	StateButton* mp_clockCorrectionButton;
+
+	int m_scaleChannel;
+	int m_impulseDisplay;
+	int m_bodeDisplay;
+
 public:
 	App(int argc, char** argv);
 	~App();
@@ -76,5 +298,28 @@ public:
 private:
 	void initUI() override;
 
+	void setOscBounds(float lower, float upper);
+	void setMathMode(int mode);
+	void setPersistence(int persistence);
+	void setScaleChannel(int channel);
+	void setChannelScale(float scale);
+	void setSpectrumSize(int state);
+	void setSpectrumOverlap(int state);
+	void setSpectrumScale(int scale);
+	void updateSpectrum();
+	void updateSpectrogram(int first, int count);
+	void saveSpectrogram();
+	void setBodeBounds(float lower, float upper);
+	void setBodeDisplay(int display);
+	void enableTransferAnalysis(int enable);
+	void updateTransferFunction();
+	void updateImpulseResponse();
+	void setImpulseDisplay(int display);
+	void updateDistortion();
+	void updateMeasurements();
+	void updateLatency();
+
+	std::wstring formatValue(double value, Unit unit);
+
 	std::wstring getApplicationName();
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <complex>
+#include <vector>
+
+// Fast convolution with a fixed kernel by the overlap-add method. The input is cut
+// into blocks of fft size - kernel size + 1 samples, every block is multiplied with
+// the kernel spectrum (transformed once) and the block results are added up with
+// their tails overlapping. Long signals cost O(n log k) instead of O(n k).
+// A stream can be filtered in pieces of any size, the tail is kept between calls.
+class Convolver {
+
+private:
+	int m_kernelSize;
+	int m_fftSize;
+	int m_blockSize;
+
+	std::vector<std::complex<float>> m_kernelSpectrum;
+
+	std::vector<float> m_tail; // overlap of the last block (kernel size - 1 samples)
+	std::vector<float> m_block;
+	std::vector<std::complex<float>> m_spectrum;
+
+public:
+	Convolver(float* pa_kernel, int kernelSize);
+
+public:
+	void convolve(float* pa_src, int size, float* pa_dst);
+	void process(float* pa_data, int size);
+
+	int getOutputSize(int size);
+	int getKernelSize();
+	int getBlockSize();
+};
\ No newline at end of file
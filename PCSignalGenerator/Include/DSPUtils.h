@@ -0,0 +1,57 @@
+#pragma once
+#include <complex>
+
+#define DSP_SINC_HALF_WIDTH 32
+#define DSP_SWEEP_FADE_TIME 0.01
+#define DSP_SINE_FIT_ITERATIONS 4
+
+namespace DSP {
+
+	enum WindowType {
+		Hann = 0,
+		BlackmanHarris = 1,
+		FlatTop = 2
+	};
+
+	// splits interleaved frames (c0 c1 .. cn c0 c1 ..) into one planar buffer per channel
+	void deinterleave(float* pa_src, int nChannels, int nFrames, float** pa_dst);
+
+	// minimum, maximum, sum and sum of squares of pa_src in a single pass
+	void reduce(float* pa_src, int size, float& minValue, float& maxValue, double& sum, double& sumSquares);
+
+	// band-limited (Blackman windowed sinc) value at fractional position t,
+	// DSP_SINC_HALF_WIDTH samples are needed on both sides of t
+	float interpolate(float* pa_src, double t);
+
+	// sub-sample position of a rising level crossing between index - 1 and index
+	double findCrossing(float* pa_src, int index, float level);
+
+	// fills pa_dst with a periodic window (for spectral analysis) and returns its sum
+	float createWindow(WindowType type, int size, float* pa_dst);
+
+	// synchronous (lock-in) demodulation, returns amplitude and phase of the given
+	// frequency as a complex number (phase relative to the first sample)
+	std::complex<float> demodulate(float* pa_src, int size, double frequency, double sampleRate);
+
+	// least squares fit of a cos(w m) + b sin(w m) + c with m = n - size / 2 (IEEE 1057 four parameter fit),
+	// the angular frequency w (radians per sample) has to be estimated before and is refined by the fit
+	bool fitSine(float* pa_src, int size, double& w, double& a, double& b, double& c);
+
+	// least squares fit of harmonics 1 to nHarmonics of w (same time origin as fitSine) and an offset c,
+	// pa_dst receives a + ib of every harmonic
+	bool fitHarmonics(float* pa_src, int size, double w, int nHarmonics, std::complex<double>* pa_dst, double& c);
+
+	// phase (in periods) of an exponential sine sweep from start to stop frequency at the given time
+	double sweepPhase(double time, double start, double stop, double duration);
+
+	// gain of the fade in and out of a sweep, an abrupt start or end would spread over all frequencies
+	double sweepFade(double time, double duration);
+
+	// fills pa_dst (duration * sampleRate samples) with the inverse filter of an exponential sweep,
+	// convolving the sweep with it gives a band limited impulse of unit gain
+	void createInverseSweep(float start, float stop, float duration, float sampleRate, float* pa_dst);
+
+	// fills pa_dst with a maximum length sequence of 2^order - 1 values of +-1 (order 10 to 16),
+	// its circular autocorrelation is a single peak, that way it can be located very precisely
+	void createMLS(int order, float* pa_dst);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+#include "Common/Signal.h"
+
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define DISTORTION_SIZE 16384 // samples per analyzed frame
+#define DISTORTION_HARMONICS 9 // harmonics 2 to 10 are counted as distortion
+#define DISTORTION_MIN_AMPLITUDE 1e-5f // below, no fundamental is detected
+
+struct DistortionResult {
+
+	bool valid; // false if no fundamental was found
+
+	float frequency; // fundamental
+	float amplitude;
+	float harmonics[DISTORTION_HARMONICS]; // amplitudes of harmonics 2 to 10 (zero above nyquist)
+
+	// in dB relative to the fundamental (thd and thd + n are negative, sinad and snr positive)
+	float thd;
+	float thdN;
+	float sinad;
+	float snr;
+
+	float enob; // effective number of bits
+};
+
+// Continuous distortion measurement of a sine. The fundamental is fitted to every
+// frame (four parameter sine fit), which removes it without leakage, that way the
+// residual is the noise and distortion (like behind a perfect notch filter). The
+// harmonics are demodulated from the residual, the rest is noise. Frames are
+// analyzed on a worker thread.
+class DistortionAnalyzer {
+
+private:
+	float m_sampleRate;
+
+	std::mutex m_mutex; // guards the result
+	DistortionResult m_result;
+	bool m_updated;
+
+	DistortionResult m_latest; // only accessed from the GUI thread
+
+	std::thread m_worker;
+	std::mutex m_inputMutex; // guards input and running flag
+	std::condition_variable m_condition;
+	std::vector<float> m_input; // samples not yet analyzed
+	bool m_running;
+
+public:
+	DistortionAnalyzer(float sampleRate);
+	~DistortionAnalyzer();
+
+public:
+	void addSamples(float* pa_data, int size);
+	bool update();
+
+	DistortionResult getResult();
+	float getSampleRate();
+
+	static bool analyze(float* pa_src, int size, float sampleRate, DistortionResult& result);
+
+	Signal<> onResultUpdate;
+
+private:
+	static void evaluate(std::complex<double>* pa_harmonics, int first, int last, double w, double c, float* pa_dst, int size);
+
+	void run();
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+// Reconstructs a repetitive signal on a time grid much finer than the sample
+// period (random interleaved equivalent-time sampling). Every acquisition is
+// placed relative to its sub-sample trigger time, so the samples of many
+// acquisitions land on different bins and fill the grid over time. Every bin
+// keeps the mean position of its samples as well, the value at the center is
+// interpolated between the means of the neighbouring bins.
+class EquivalentTimeSampler {
+
+private:
+	int m_nBins;
+	int m_maxAverage; // every bin averages over at most this many acquisitions
+	double m_window; // width of the reconstructed window (in samples)
+
+	std::vector<float> m_mean;
+	std::vector<float> m_offset; // mean position of the samples relative to the center of the bin (in bins)
+	std::vector<int> m_count;
+	int m_nAcquisitions;
+
+public:
+	EquivalentTimeSampler(int nBins, int maxAverage);
+
+public:
+	void add(float* pa_samples, int size, double offset);
+	void reconstruct(float* pa_dst, float scale);
+	void clear();
+
+	void setWindow(double window);
+
+	double getWindow();
+	int getBinCount();
+	int getAcquisitionCount();
+	float getCoverage();
+};
\ No newline at end of file
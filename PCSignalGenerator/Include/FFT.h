@@ -0,0 +1,33 @@
+#pragma once
+#include <complex>
+#include <vector>
+
+// Real-input FFT of a power of two size. The real signal is packed into a complex
+// FFT of half the size and split afterwards. Bit reversal and twiddles are computed
+// once per size, plans are cached and shared, transforms don't modify the plan
+// (so one plan can be used from several threads).
+class FFT {
+
+private:
+	int m_size; // number of real samples
+	int m_half;
+
+	std::vector<int> m_bitReverse; // permutation of the half size complex FFT
+	std::vector<std::complex<float>> m_twiddles; // e^(-2 pi i k / half), k < half / 2
+	std::vector<std::complex<float>> m_realTwiddles; // e^(-2 pi i k / size), k <= half / 2
+
+public:
+	FFT(int size);
+
+public:
+	static FFT& getPlan(int size);
+
+	void transform(float* pa_src, std::complex<float>* pa_dst);
+	void inverse(std::complex<float>* pa_src, float* pa_dst); // pa_dst must not overlap pa_src
+
+	int getSize();
+	int getBinCount();
+
+private:
+	void transformComplex(std::complex<float>* pa_data, bool inverse);
+};
\ No newline at end of file
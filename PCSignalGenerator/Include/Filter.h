@@ -0,0 +1,60 @@
+#pragma once
+#include "Convolver.h"
+
+#include <vector>
+#include <complex>
+
+#define FILTER_MAX_ORDER 8
+#define FILTER_MAX_TAPS 4095
+#define FILTER_DIRECT_TAPS 64 // longer kernels are convolved in the frequency domain
+#define FILTER_CHEBYSHEV_RIPPLE 1.0 // passband ripple in dB
+#define FILTER_NOTCH_Q 5.0
+
+struct Biquad {
+
+	// transfer function (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+	double b0, b1, b2;
+	double a1, a2;
+};
+
+// Designed filter with the state of every channel, ready to run on the capture path.
+// IIR filters are cascades of biquads, each biquad processes four samples per step:
+// the four outputs and the new state are linear in the four inputs and the old
+// state, so the matrix of that block is computed once and applied with SIMD.
+// FIR filters are convolved directly (short kernels) or by overlap-add.
+class Filter {
+
+private:
+	int m_nChannels;
+
+	std::vector<Biquad> m_sections;
+	std::vector<float> m_blockMatrices; // [section][output y0..y3, s1, s2][input x0..x3, s1, s2]
+	std::vector<float> m_states; // [channel][section][s1, s2]
+
+	std::vector<float> m_kernel;
+	std::vector<std::vector<float>> m_history; // last kernel size - 1 inputs of every channel (direct convolution)
+	std::vector<Convolver> m_convolvers; // one per channel (fast convolution)
+	std::vector<float> m_buffer;
+
+public:
+	Filter(int nChannels);
+	Filter(int nChannels, std::vector<Biquad> sections);
+	Filter(int nChannels, float* pa_kernel, int size);
+
+public:
+	void process(float* pa_data, int size, int channel);
+
+	bool isEmpty();
+
+	static std::vector<Biquad> designButterworth(int order, float frequency, float sampleRate, bool highPass);
+	static std::vector<Biquad> designChebyshev(int order, float frequency, float sampleRate, bool highPass);
+	static Biquad designNotch(float frequency, float sampleRate);
+	static std::vector<float> designWindowedSinc(int taps, float frequency, float sampleRate, bool highPass);
+
+private:
+	void processBiquad(float* pa_data, int size, int section, float* pa_state);
+	void processDirect(float* pa_data, int size, int channel);
+
+	static std::vector<Biquad> designPrototype(std::vector<std::complex<double>> poles, double gain, float frequency, float sampleRate, bool highPass);
+	static Biquad bilinear(double* pa_numerator, double* pa_denominator, double k);
+};
\ No newline at end of file
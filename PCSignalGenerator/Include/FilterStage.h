@@ -0,0 +1,61 @@
+#pragma once
+#include "Filter.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+struct FilterSettings {
+
+	int type; // 0: off, 1: butterworth, 2: chebyshev, 3: notch, 4: windowed sinc
+	int response; // 0: low pass, 1: high pass
+	float frequency; // cutoff or notch frequency
+	int order; // iir order
+	int taps; // fir length
+};
+
+// Filter on the capture path, applied to every channel before it is recorded.
+// Filters are designed on a worker thread (including the kernel spectra of long FIR
+// filters) and handed to the capture path by exchanging a pointer, that way the
+// capture path never waits for a design and never runs a half updated filter.
+class FilterStage {
+
+private:
+	float m_sampleRate;
+	int m_nChannels;
+
+	std::atomic<Filter*> mp_pending; // latest design, not yet taken by the capture path
+	Filter* mp_filter; // only accessed from the capture path
+
+	std::thread m_worker;
+	std::mutex m_inputMutex; // guards settings and running flag
+	std::condition_variable m_condition;
+	FilterSettings m_settings;
+	bool m_redesign;
+	bool m_running;
+
+public:
+	FilterStage(float sampleRate, int nChannels);
+	~FilterStage();
+
+public:
+	void process(float** pa_channels, int nFrames);
+
+	int getType();
+	int getResponse();
+	float getFrequency();
+	int getOrder();
+	int getTaps();
+
+	void setType(int type);
+	void setResponse(int response);
+	void setFrequency(float frequency);
+	void setOrder(int order);
+	void setTaps(int taps);
+
+private:
+	Filter* design(FilterSettings settings);
+
+	void run();
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include "Core/IFunctional.h"
+#include "Common/Signal.h"
+
+#include "SignalGenerator.h"
+#include "Oscilloscope.h"
+#include "FrequencySweep.h"
+
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define FREQRESP_PLOT_SIZE 512
+// Automated frequency response (bode) measurement. The signal generator is stepped
+// through logarithmically spaced sine frequencies, the oscilloscope captures the
+// input (CH1) and output (CH2) of the device under test and every point is analyzed
+// by synchronous demodulation. Points are pipelined: while the generator settles on
+// the next frequency, the previous point is analyzed on a worker thread.
+class FrequencyResponse : public IFunctional {
+
+private:
+	SignalGenerator* mp_sigGen;
+	Oscilloscope* mp_osc;
+
+	// generator settings restored after the measurement
+	bool m_savedOutput;
+	int m_savedWaveformType;
+	float m_savedFrequency;
+
+	std::vector<float> m_frequencies;
+	int m_point; // point the generator is currently set to (-1 if no measurement is running)
+	long long m_captureStart; // record index of the first sample of the current point
+	int m_captureSize;
+
+	std::mutex m_mutex; // guards the results
+	std::vector<std::complex<float>> m_results; // transfer function of every point
+	int m_nResults;
+	int m_run; // incremented by every measurement, results of older ones are dropped
+	bool m_updated;
+
+	float ma_frequencyData[FREQRESP_PLOT_SIZE]; // logarithmically spaced between the first and last point
+	float ma_gainData[FREQRESP_PLOT_SIZE]; // gain in dB
+	float ma_phaseData[FREQRESP_PLOT_SIZE]; // phase in degrees
+
+	std::thread m_worker;
+	std::mutex m_queueMutex; // guards queue and running flag
+	std::condition_variable m_condition;
+	std::vector<FrequencyResponseJob> m_queue;
+	bool m_running;
+
+	float m_startFrequency;
+	float m_stopFrequency;
+	int m_nPoints;
+
+public:
+	FrequencyResponse(SignalGenerator* p_sigGen, Oscilloscope* p_osc);
+	~FrequencyResponse();
+
+public:
+	void enableMeasurement(int enable);
+	void setStartFrequency(float frequency);
+	void setStopFrequency(float frequency);
+	void setPointCount(int nPoints);
+
+	bool isMeasuring();
+	float getStartFrequency();
+	float getStopFrequency();
+	int getPointCount();
+
+	float* getFrequencyData();
+	float* getGainData();
+	float* getPhaseData();
+	int getPlotDataSize();
+
+	Signal<> onPlotUpdate;
+	Signal<int> onMeasurementChanged;
+	Signal<float, float> onBoundsChange;
+
+private:
+	void onTick(float deltaTime) override;
+	void onBegin() override;
+	void onClose() override;
+
+	void startPoint(int point);
+	void finishMeasurement();
+	void updatePlotData();
+	void calculateFrequencyData(float start, float stop);
+
+	void run();
+
+	IMPLEMENT_LOADSAVE(FrequencyResponse);
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <complex>
+
+#define FREQRESP_MIN_PERIODS 8
+#define FREQRESP_MIN_CAPTURE_TIME 0.1f
+#define FREQRESP_SETTLE_TIME 0.05f
+
+struct FrequencyResponseJob {
+
+	int run; // measurement the point belongs to
+	int point;
+	float frequency;
+	float sampleRate;
+	float amplitude; // generator amplitude (only used without reference)
+
+	std::vector<float> reference; // captured input of the device under test (CH1)
+	std::vector<float> response; // captured output of the device under test (CH2)
+};
+
+// Stepped sine sweep of the frequency response measurement, independent of the devices:
+// the frequencies of the points, how long a point settles, how much of it is captured
+// and the analysis of a captured point by synchronous demodulation.
+class FrequencySweep {
+
+public:
+	static std::vector<float> getFrequencies(float start, float stop, int nPoints);
+
+	static float getSettleTime(float frequency, float latency);
+	static int getCaptureSize(float frequency, float sampleRate, int maxSize);
+
+	static std::complex<float> analyze(FrequencyResponseJob& job);
+};
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#include "Core/IFunctional.h"
+#include "Common/Signal.h"
+
+#include "SignalGenerator.h"
+#include "Oscilloscope.h"
+#include "SweepAnalysis.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define IMPRESP_MAX_DURATION 10.0f
+
+// Impulse response measurement with an exponential sine sweep (Farina method). The
+// generator plays one sweep, the oscilloscope records the input (CH1) and output (CH2)
+// of the device under test and the recording is deconvolved with the inverse filter
+// of the sweep on a worker thread. Harmonics of a sweep are sweeps shifted in time, so
+// the deconvolution places the impulse responses of the harmonic distortion before the
+// linear impulse response, where they are cut out separately.
+class ImpulseResponse : public IFunctional {
+
+private:
+	SignalGenerator* mp_sigGen;
+	Oscilloscope* mp_osc;
+
+	// generator settings restored after the measurement
+	bool m_savedOutput;
+	int m_savedWaveformType;
+
+	bool m_measuring;
+	long long m_captureStart; // record index of the first sample of the sweep
+	int m_captureSize;
+
+	// sweep of the running measurement
+	float m_start;
+	float m_stop;
+	float m_duration;
+
+	std::mutex m_mutex; // guards the result
+	ImpulseResponseResult m_result;
+	bool m_updated;
+
+	// plot data (only used by the gui thread)
+	std::vector<float> m_timeData;
+	std::vector<float> m_impulseData;
+	float ma_frequencyData[IMPRESP_PLOT_SIZE];
+	float ma_levelData[IMPRESP_HARMONICS][IMPRESP_PLOT_SIZE];
+
+	std::thread m_worker;
+	std::mutex m_queueMutex; // guards queue and running flag
+	std::condition_variable m_condition;
+	std::vector<ImpulseResponseJob> m_queue;
+	bool m_running;
+
+	float m_startFrequency;
+	float m_stopFrequency;
+	float m_sweepDuration;
+
+public:
+	ImpulseResponse(SignalGenerator* p_sigGen, Oscilloscope* p_osc);
+	~ImpulseResponse();
+
+public:
+	void enableMeasurement(int enable);
+	void setStartFrequency(float frequency);
+	void setStopFrequency(float frequency);
+	void setSweepDuration(float duration);
+
+	bool isMeasuring();
+	float getStartFrequency();
+	float getStopFrequency();
+	float getSweepDuration();
+
+	float* getTimeData();
+	float* getImpulseData();
+	int getImpulseDataSize();
+
+	float* getFrequencyData();
+	float* getLevelData(int harmonic);
+	int getPlotDataSize();
+	int getHarmonicCount();
+
+	Signal<> onPlotUpdate;
+	Signal<int> onMeasurementChanged;
+
+private:
+	void onTick(float deltaTime) override;
+	void onBegin() override;
+	void onClose() override;
+
+	void finishMeasurement();
+
+	void run();
+
+	IMPLEMENT_LOADSAVE(ImpulseResponse);
+};
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+#include "Core/IFunctional.h"
+#include "Common/Signal.h"
+
+#include "SignalGenerator.h"
+#include "Oscilloscope.h"
+#include "RunningStatistics.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define LATENCY_MAX_DELAY 0.5f // longest latency that is searched for
+#define LATENCY_PRE_TIME 0.05f // also searched before the expected arrival (timestamp jitter)
+#define LATENCY_MIN_PEAK 8.0f // correlation peak relative to the rms of the correlation (below, the marker is lost)
+#define LATENCY_MAX_LATE 0.1f // markers timed later than this after they started playing are skipped
+#define LATENCY_CORRECTION_MARKERS 3 // markers needed before the clock correction is applied
+
+struct LatencyJob {
+
+	long long marker; // output position of the first marker sample
+	double expected; // record index at which the marker would arrive without latency
+	long long first; // record index of the first captured sample
+	int size;
+
+	std::vector<float> samples;
+};
+
+struct LatencyResult {
+
+	long long marker;
+	double expected;
+	double arrival; // record index of the first marker sample (sub-sample)
+	bool found;
+};
+
+// Latency and clock drift between the generator and the oscilloscope. Both use their own
+// device with an independent clock, so the generator plays a maximum length sequence
+// every marker period and every marker is located in the capture by cross correlation
+// (on a worker thread). The time at which a marker was played and the time at which
+// the capture was recorded come from the device timestamps, their difference is the
+// latency. The drift is the slope of the marker positions in the record over their
+// positions in the output, which only depends on sample indices. Optionally, the slope
+// corrects the generator, that way its waveforms stay aligned to the capture clock.
+class LatencyMeter : public IFunctional {
+
+private:
+	SignalGenerator* mp_sigGen;
+	Oscilloscope* mp_osc;
+
+	// generator settings restored after the measurement
+	bool m_savedOutput;
+	int m_savedWaveformType;
+
+	bool m_measuring;
+	long long m_nextMarker; // number of the next marker to be timed
+	std::vector<LatencyJob> m_pending; // timed markers whose capture isn't complete yet
+
+	// results (only used by the gui thread)
+	RunningStatistics m_latency;
+	double m_lastLatency;
+	int m_nLost;
+
+	// least squares fit of the arrival over the output position (relative to the first marker)
+	long long m_firstMarker;
+	double m_firstArrival;
+	long long m_nFit;
+	double m_meanX;
+	double m_meanY;
+	double m_covXX;
+	double m_covXY;
+	double m_drift; // in ppm
+	long long m_breakMarker; // first marker after the latest break in the capture
+
+	std::mutex m_mutex; // guards the located markers
+	std::vector<LatencyResult> m_results;
+
+	std::thread m_worker;
+	std::mutex m_queueMutex; // guards queue and running flag
+	std::condition_variable m_condition;
+	std::vector<LatencyJob> m_queue;
+	bool m_running;
+
+	int m_channel;
+	int m_correction;
+
+public:
+	LatencyMeter(SignalGenerator* p_sigGen, Oscilloscope* p_osc);
+	~LatencyMeter();
+
+public:
+	void enableMeasurement(int enable);
+	void enableCorrection(int enable);
+	void restartFit();
+	void setChannel(int channel);
+
+	bool isMeasuring();
+	bool isCorrectionEnabled();
+	int getChannel();
+
+	float getLatency();
+	RunningStatistics* getStatistics();
+	double getDrift();
+	int getMarkerCount();
+	int getLostCount();
+
+	static bool locate(float* pa_marker, int markerSize, float* pa_src, int size, double& position);
+
+	Signal<> onResultUpdate;
+	Signal<int> onMeasurementChanged;
+
+private:
+	void onTick(float deltaTime) override;
+	void onBegin() override;
+	void onClose() override;
+
+	void finishMeasurement();
+	void addResult(LatencyResult& result);
+
+	void run();
+
+	IMPLEMENT_LOADSAVE(LatencyMeter);
+};
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+// Rolling record of samples with a min/max level-of-detail pyramid on top.
+// Level k stores the minimum and maximum of every aligned block of 2^k samples,
+// so any span of the record can be reduced to a pixel envelope without touching
+// every sample. Pushing is amortized O(1) per sample. A span of the record can also
+// be read in place as (at most) two contiguous segments of the ring.
+class MinMaxPyramid {
+
+private:
+	int m_capacity; // number of samples kept (power of two)
+	int m_nLevels;
+
+	std::vector<float> m_samples; // level 0
+	std::vector<std::vector<float>> m_min; // levels 1 .. m_nLevels - 1
+	std::vector<std::vector<float>> m_max;
+
+	long long m_count; // total number of samples pushed
+
+public:
+	MinMaxPyramid(int capacity);
+
+public:
+	void push(float value);
+	void push(float* pa_data, int size);
+
+	void clear();
+
+	long long getCount();
+	long long getFirstAvailable();
+	int getCapacity();
+
+	float getSample(long long index);
+	void copy(long long first, int size, float* pa_dst);
+	void getSegments(long long first, long long size, float** pa_segments, int* pa_sizes);
+
+	void getMinMax(long long first, long long last, float& minValue, float& maxValue);
+	void getEnvelope(long long first, long long nSamples, int nColumns, float* pa_min, float* pa_max);
+
+private:
+	void updateLevels();
+};
\ No newline at end of file
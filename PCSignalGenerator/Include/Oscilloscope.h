@@ -5,8 +5,33 @@
 #include "Core/IFunctional.h"
 #include "Common/Signal.h"
 #include "Common/MathUtils.h"
+#include "Common/DataBuffer.h"
+
+#include "MinMaxPyramid.h"
+#include "SegmentPool.h"
+#include "SegmentRecorder.h"
+#include "PersistenceMap.h"
+#include "EquivalentTimeSampler.h"
+#include "SpectrumAnalyzer.h"
+#include "Spectrogram.h"
+#include "DistortionAnalyzer.h"
+#include "TransferFunctionAnalyzer.h"
+#include "WaveformMeasurements.h"
+#include "FilterStage.h"
+
+#include <vector>
+#include <deque>
 
 #define OSC_DATA_BUFFER_SIZE 1024
+#define OSC_RECORD_SIZE 1048576
+#define OSC_SEGMENT_COUNT 256
+#define OSC_SEGMENT_SIZE 4096
+#define OSC_PERSISTENCE_HEIGHT 256
+#define OSC_PERSISTENCE_RANGE 2.0f
+#define OSC_ETS_AVERAGE 16
+#define OSC_ETS_MAX_TRIGGERS 64 // acquisitions added per tick (the rest is decimated)
+#define OSC_SPECTRUM_SIZE 8192
+#define OSC_MEASUREMENT_SIZE 131072 // samples measured per plotted acquisition (around the center of longer spans)
 
 class Oscilloscope : public IFunctional {
 
@@ -18,49 +43,136 @@ private:
 	WAVEFORMATEX* mp_format;
 	unsigned int m_bufferSize;
 
-	float ma_data[OSC_DATA_BUFFER_SIZE]; // Rolling buffer
-	int m_head;
-	float m_lastValue; // stores the last value
+	int m_nChannels; // number of captured channels (the math channel is stored after them)
 
-	std::vector<int> m_triggerLoc; // stores all triggering events until they are actually emitted
+	std::vector<MinMaxPyramid> m_records; // full rate record of every channel
+	std::vector<std::vector<float>> m_channelData; // deinterleaved samples of the current packet
+	std::vector<float*> mp_channels; // points into m_channelData (allocated once)
+	FilterStage* mp_filter; // filters the captured channels before they are recorded
+	std::vector<DataBuffer*> mp_plotBuffers; // plot data of every channel (min/max envelope of the visible span)
+	std::vector<float> m_channelScale; // vertical scale of every channel
+	float m_lastValue; // stores the last value of the trigger source
+
+	std::vector<long long> m_triggerLoc; // stores all triggering events (as record index) until they are actually emitted
+
+	SegmentPool* mp_segmentPool; // storage for segmented aquisition
+	SegmentRecorder* mp_segmentRecorder; // triggers segments and stores them into the pool
+	int m_selectedSegment;
+	int m_segmentView;
+
+	PersistenceMap* mp_persistence; // intensity graded map of all triggered waveforms
+
+	std::vector<EquivalentTimeSampler> m_etsSamplers; // equivalent-time reconstruction of every channel
+	std::deque<long long> m_etsTriggerLoc; // trigger events whose windows are not complete yet
+	std::vector<float> m_etsBuffer;
+	double m_etsWindow; // width of the reconstructed window (in samples, may be less than one per plot point)
+
+	SpectrumAnalyzer* mp_spectrum; // spectrum of the selected channel (runs on its own thread)
+	Spectrogram* mp_spectrogram; // spectrogram of the same channel (runs on its own thread)
+	DistortionAnalyzer* mp_distortion; // distortion of the selected channel (runs on its own thread)
+	TransferFunctionAnalyzer* mp_transfer; // transfer function between two channels (runs on its own thread)
+
+	WaveformMeasurements* mp_measurements; // measurements of the selected channel (every plotted acquisition)
 
 	float m_sampleRate;
-	int m_nSamplesSkiped;
+	long long m_span; // number of record samples shown in the plot
+
+	long long m_capturePosition; // record index of the latest packet with a valid timestamp
+	double m_captureTime; // performance counter time (in s) at which that packet was recorded
 
 	bool m_enable;
 	int m_aquisitionMode;
 	float m_triggerLevel;
+	int m_triggerSource;
+	int m_mathMode;
+	int m_persistence;
+	int m_spectrumChannel;
+	int m_distortionChannel;
+	int m_measurementChannel;
+	int m_transferReference;
+	int m_transferChannel;
 
 public:
 	Oscilloscope();
 	~Oscilloscope();
 
 public:
-	float* getPlotData();
-	int getPlotDataSize();
+	DataBuffer* getPlotBuffer(int channel);
+	int getChannelCount();
+	int getMathChannel();
+	MinMaxPyramid* getRecord(int channel);
+	float getSampleRate();
+	bool getCapturePosition(double& position, double& time);
 
 	int getAquisitionMode();
 	float getTriggerLevel();
+	int getTriggerSource();
+	int getMathMode();
+	float getChannelScale(int channel);
+	int getSegmentCount();
+	int getSegmentCapacity();
+	int getPersistence();
+	unsigned int* getPersistenceImage();
+	int getPersistenceWidth();
+	int getPersistenceHeight();
+	int getSpectrumChannel();
+	SpectrumAnalyzer* getSpectrumAnalyzer();
+	Spectrogram* getSpectrogram();
+	int getDistortionChannel();
+	DistortionAnalyzer* getDistortionAnalyzer();
+	int getMeasurementChannel();
+	WaveformMeasurements* getMeasurements();
+	FilterStage* getFilterStage();
+	int getTransferReference();
+	int getTransferChannel();
+	TransferFunctionAnalyzer* getTransferAnalyzer();
 	bool isOscEnabled();
 	
 	void setAquisitionMode(int mode);
 	void setTriggerLevel(float level);
+	void setTriggerSource(int source);
+	void setMathMode(int mode);
+	void setChannelScale(int channel, float scale);
+	void setSelectedSegment(int segment);
+	void setSegmentView(int view);
+	void setPersistence(int persistence);
+	void setSpectrumChannel(int channel);
+	void setDistortionChannel(int channel);
+	void setMeasurementChannel(int channel);
+	void setTransferReference(int channel);
+	void setTransferChannel(int channel);
 	void enableOscilloscope(int enable);
 
+	void rearmSegments();
+	void rearmEquivalentTime();
+
 	void calculateSampleRate(Math::Size plotBounds);
 
 	Signal<> onPlotUpdate;
 	Signal<int> onTrigger;
 	Signal<float, float> onBoundsChange;
+	Signal<int> onSegmentCaptured;
+	Signal<> onDiscontinuity;
 
 private:
 	void onTick(float deltaTime) override;
 	void onBegin() override;
 	void onClose() override;
 
-	void handleAquisitionMode(float value);
+	void addPacket(float* pa_data, int nFrames);
+	void handleDiscontinuity();
+
+	void handleAquisitionMode(float value, long long index);
 	void handleTriggerTiming();
 
+	void handleSegments();
+	void handleEquivalentTime();
+
+	void calculateMathChannel(int nFrames);
+
+	void updatePlotData(long long first);
+	void updateSegmentPlotData();
+
 
 	IMPLEMENT_LOADSAVE(Oscilloscope);
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+#include "Style/Color.h"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Intensity graded (persistence) display of many waveforms. Every waveform is
+// given as a min/max envelope per pixel column and adds hits to all amplitude
+// bins it covers. Older waveforms decay exponentially. Waveforms are folded in
+// on a worker thread, so the capture path only has to copy the envelope.
+class PersistenceMap {
+
+private:
+	int m_width; // number of pixel columns
+	int m_height; // number of amplitude bins
+
+	float m_lower; // amplitude of the lowest bin
+	float m_upper; // amplitude of the highest bin
+	float m_decay; // factor applied to all hits per waveform
+
+	std::mutex m_mutex; // guards hits, weight and pixels
+	std::vector<float> m_hits; // [column][bin], that way a vertical span is contiguous
+	float m_weight; // weight of the next waveform (decay is applied lazily)
+	long long m_nWaveforms;
+
+	std::vector<unsigned int> m_pixels; // [row][column] premultiplied 0xAARRGGBB
+	unsigned int ma_lut[256]; // color of every intensity level
+
+	std::thread m_worker;
+	std::mutex m_queueMutex; // guards queue and running flag
+	std::condition_variable m_condition;
+	std::vector<float> m_queue; // pending envelopes (min and max of every column)
+	bool m_running;
+
+public:
+	PersistenceMap(int width, int height, float lower, float upper, Color color);
+	~PersistenceMap();
+
+public:
+	void addWaveform(float* pa_min, float* pa_max);
+	void accumulate(float* pa_min, float* pa_max);
+
+	unsigned int* render();
+	void clear();
+
+	void setDecay(float decay);
+	void setColor(Color color);
+
+	unsigned int* getPixels();
+	int getWidth();
+	int getHeight();
+	long long getWaveformCount();
+
+private:
+	void run();
+	void normalize();
+};
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+// Minimum, maximum, mean and standard deviation of a stream of values. The mean
+// and variance are updated incrementally (Welford), that way no values are kept
+// and the variance doesn't suffer from cancellation like a sum of squares.
+class RunningStatistics {
+
+private:
+	long long m_count;
+	double m_min;
+	double m_max;
+	double m_mean;
+	double m_m2; // sum of squared differences from the mean
+
+public:
+	RunningStatistics();
+
+public:
+	void add(double value);
+	void clear();
+
+	long long getCount();
+	double getMin();
+	double getMax();
+	double getMean();
+	double getStandardDeviation();
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+struct Segment {
+
+	long long triggerIndex; // record index of the triggered sample
+	double timestamp; // time of the trigger in seconds (relative to the first segment)
+	int size; // number of samples per channel
+};
+
+// Preallocated storage for triggered segments (segmented memory / fast frame
+// acquisition). Every segment holds a window of samples around its trigger for
+// all channels, so no allocation happens while segments are captured.
+class SegmentPool {
+
+private:
+	int m_nSegments;
+	int m_nChannels;
+	int m_maxSize; // maximum number of samples per channel and segment
+
+	std::vector<float> m_data; // [segment][channel][sample]
+	std::vector<Segment> m_segments;
+	int m_count;
+
+public:
+	SegmentPool(int nSegments, int nChannels, int maxSize);
+
+public:
+	int store(long long triggerIndex, double timestamp, int size);
+	void clear();
+
+	bool isFull();
+	int getCount();
+	int getCapacity();
+	int getMaxSize();
+
+	Segment getSegment(int segment);
+	float* getSegmentData(int segment, int channel);
+
+	void getEnvelope(int firstSegment, int lastSegment, int channel, int nColumns, float* pa_min, float* pa_max);
+};
\ No newline at end of file
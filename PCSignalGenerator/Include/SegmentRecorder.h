@@ -0,0 +1,35 @@
+#pragma once
+#include "SegmentPool.h"
+#include "MinMaxPyramid.h"
+
+#include <vector>
+#include <deque>
+
+// Triggers segmented acquisition on the continuous record and stores the segments
+// into a pool. A segment is stored as soon as its post-trigger window is captured.
+// The record is captured without gaps, so the trigger re-arms directly after the
+// post-trigger window of the previous segment (there is no dead time).
+class SegmentRecorder {
+
+private:
+	SegmentPool* mp_pool;
+
+	std::deque<long long> m_pending; // trigger events whose segments are not complete yet
+	long long m_rearm; // first record index at which the next segment can be triggered
+	long long m_origin; // record index of the first segment
+	int m_size; // number of samples per segment (half of them before the trigger)
+
+public:
+	SegmentRecorder(SegmentPool* p_pool, int size);
+
+public:
+	void arm(int size);
+	void restart(long long index);
+
+	bool trigger(float lastValue, float value, float level, long long index);
+	int store(std::vector<MinMaxPyramid>& records, float sampleRate);
+
+	int getSize();
+	int getPendingCount();
+	long long getRearmIndex();
+};
\ No newline at end of file
@@ -4,9 +4,13 @@
 
 #include "Core/IFunctional.h"
 #include "Common/Signal.h"
+#include "Common/DataBuffer.h"
 
+#include <vector>
 
 #define SIGGEN_PLOT_SIZE 1024
+#define SIGGEN_MARKER_ORDER 13 // length of the marker sequence (2^order - 1 samples)
+#define SIGGEN_MARKER_PERIOD 1.0f // time between two markers
 
 class SignalGenerator : public IFunctional {
 
@@ -14,12 +18,17 @@ private:
 	IMMDevice* mp_audioDevice;
 	IAudioClient* mp_audioClient;
 	IAudioRenderClient* mp_audioRenderClient;
+	IAudioClock* mp_audioClock;
 
 	WAVEFORMATEX* mp_format;
 	unsigned int m_bufferSize;
+	unsigned long long m_clockFrequency; // units of the device position per second
 	float m_phase;
 
-	float ma_plotData[SIGGEN_PLOT_SIZE];
+	long long m_writePosition; // number of samples written to the device since it was created
+	double m_clockCorrection; // ratio of the capture to the output clock, applied to all synthesized waveforms
+
+	DataBuffer m_plotBuffer; // one period of the waveform
 
 	bool m_output;
 	int m_waveformType;
@@ -27,6 +36,16 @@ private:
 	float m_amplitude;
 	int m_dutyCycle;
 
+	// exponential sine sweep (played once)
+	float m_sweepStart;
+	float m_sweepStop;
+	float m_sweepDuration;
+	long long m_sweepPosition; // samples played since the start of the sweep
+
+	// maximum length sequence repeated every marker period (latency and drift measurement)
+	std::vector<float> m_marker;
+	long long m_markerStart; // write position of the first marker
+
 public:
 	SignalGenerator();
 	~SignalGenerator();
@@ -37,14 +56,24 @@ public:
 	void setFrequency(float frequency);
 	void setAmplitude(float amplitude);
 	void setDutyCycle(int dutyCycle);
+	void setSweep(float start, float stop, float duration);
+	void setClockCorrection(double ratio);
 
-	float* getPlotData();
-	int getPlotDataSize();
+	DataBuffer* getPlotBuffer();
 	bool isOutputEnabled();
 	int getWaveformType();
 	float getFrequency();
 	float getAmplitude();
 	int getDutyCycle();
+	float getLatency();
+	float getSampleRate();
+	double getClockCorrection();
+
+	float* getMarker();
+	int getMarkerSize();
+	int getMarkerPeriod();
+	long long getMarkerStart();
+	bool getPlaybackPosition(double& position, double& time);
 
 public:
 	Signal<> onPlotUpdate;
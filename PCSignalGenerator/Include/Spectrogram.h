@@ -0,0 +1,83 @@
+#pragma once
+#include "Common/Signal.h"
+
+#include "FFT.h"
+#include "DSPUtils.h"
+
+#include <string>
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define SPECTROGRAM_WIDTH 512
+#define SPECTROGRAM_HEIGHT 256
+#define SPECTROGRAM_SIZE 2048
+#define SPECTROGRAM_MIN_DB -120.0f
+#define SPECTROGRAM_MAX_DB 0.0f
+
+// Scrolling time-frequency display (waterfall). Overlapping frames are transformed
+// on a worker thread, every frame becomes one column of intensity levels. The columns
+// are kept in a ring, that way a new column never moves the older ones: the GUI only
+// colors the new columns and the image is drawn starting at the oldest one.
+class Spectrogram {
+
+private:
+	float m_sampleRate;
+
+	int m_width; // number of columns (frames) kept
+	int m_height; // number of frequency rows
+	int m_size; // number of samples per frame
+	int m_hop; // number of samples between two frames
+
+	std::vector<float> m_window;
+	float m_windowSum;
+
+	std::vector<float> m_frame;
+	std::vector<std::complex<float>> m_bins;
+	std::vector<int> m_rowBins; // first bin of every row (and one past the last bin)
+
+	std::mutex m_mutex; // guards levels and column count
+	std::vector<unsigned char> m_levels; // [column][row] intensity of every pixel
+	long long m_nColumns; // total number of columns written by the worker
+
+	std::vector<unsigned int> m_pixels; // [row][column] premultiplied 0xAARRGGBB (GUI thread)
+	long long m_nPlotColumns; // number of columns colored by the GUI
+	unsigned int ma_lut[256]; // color of every intensity level
+	int m_colorMap; // 0 heat, 1 blue-green-yellow, 2 gray
+
+	std::thread m_worker;
+	std::mutex m_inputMutex; // guards input and running flag
+	std::condition_variable m_condition;
+	std::vector<float> m_input; // samples not yet transformed
+	bool m_running;
+
+public:
+	Spectrogram(float sampleRate, int width, int height, int size);
+	~Spectrogram();
+
+public:
+	void addSamples(float* pa_data, int size);
+	bool update();
+
+	void clear();
+	bool savePNG(std::wstring path);
+
+	unsigned int* getPixels();
+	int getWidth();
+	int getHeight();
+	int getOffset();
+	float getDuration();
+	float getSampleRate();
+	int getColorMap();
+
+	void setColorMap(int colorMap);
+
+	Signal<int, int> onColumnsUpdate; // first column and number of columns
+
+private:
+	void run();
+	void analyzeFrame();
+	void colorColumn(int column);
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+#include "Common/Signal.h"
+
+#include "FFT.h"
+#include "DSPUtils.h"
+
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define SPECTRUM_MIN_DB -160.0f
+
+// Streaming spectrum analyzer. Samples are collected from the capture path and
+// transformed on a worker thread (windowed, overlapping frames), the averaged
+// spectrum of every bin is published in dB.
+class SpectrumAnalyzer {
+
+private:
+	float m_sampleRate;
+
+	int m_size; // number of samples per FFT frame
+	DSP::WindowType m_windowType;
+	float m_overlap; // fraction of a frame shared with the next one
+	int m_averaging; // 0 off, 1 linear (magnitude), 2 rms (power), 3 peak hold
+	int m_nAverages;
+
+	std::vector<float> m_window;
+	float m_windowSum;
+
+	std::vector<float> m_frame;
+	std::vector<std::complex<float>> m_bins;
+	std::vector<float> m_average; // magnitude (or power for rms averaging) of every bin
+	int m_count; // number of frames in the average
+
+	std::mutex m_mutex; // guards the result
+	std::vector<float> m_result; // magnitude of every bin in dB
+	bool m_updated;
+
+	std::vector<float> m_plotData; // only accessed from the GUI thread
+	std::vector<float> m_frequencies; // frequency of every bin (GUI thread)
+
+	std::thread m_worker;
+	std::mutex m_inputMutex; // guards input, settings and running flag
+	std::condition_variable m_condition;
+	std::vector<float> m_input; // samples not yet transformed
+	bool m_reset; // settings changed, the worker has to rebuild its buffers
+	bool m_running;
+
+public:
+	SpectrumAnalyzer(float sampleRate, int size);
+	~SpectrumAnalyzer();
+
+public:
+	void addSamples(float* pa_data, int size);
+	bool update();
+
+	float* getPlotData();
+	float* getFrequencyData();
+	int getPlotDataSize();
+	float getSampleRate();
+
+	int getSize();
+	int getWindowType();
+	int getOverlap();
+	int getAveraging();
+
+	void setSize(int size);
+	void setWindowType(int type);
+	void setOverlap(int overlap);
+	void setAveraging(int averaging);
+	void setAverageCount(int nAverages);
+
+	Signal<> onPlotUpdate;
+
+private:
+	void run();
+	void reset();
+	void analyzeFrame(int averaging, int nAverages);
+};
\ No newline at end of file
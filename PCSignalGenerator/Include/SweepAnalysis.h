@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+
+#define IMPRESP_PLOT_SIZE 512
+#define IMPRESP_HARMONICS 5 // fundamental and harmonics 2 to 5
+#define IMPRESP_MIN_DB -160.0f
+#define IMPRESP_TAIL_TIME 0.5f // recorded after the sweep ended (decay of the device under test)
+#define IMPRESP_PRE_PERIODS 1.0f // kept before every impulse in periods of the start frequency (pre ringing of the band limited impulse)
+
+struct ImpulseResponseJob {
+
+	float startFrequency;
+	float stopFrequency;
+	float duration;
+	float sampleRate;
+	float amplitude; // generator amplitude (only used without reference)
+
+	std::vector<float> reference; // captured input of the device under test (CH1)
+	std::vector<float> response; // captured output of the device under test (CH2)
+};
+
+struct ImpulseResponseResult {
+
+	std::vector<float> time; // relative to the linear impulse
+	std::vector<float> impulse; // linear impulse response
+
+	float frequencies[IMPRESP_PLOT_SIZE]; // excitation frequencies (logarithmically spaced)
+	float levels[IMPRESP_HARMONICS][IMPRESP_PLOT_SIZE]; // level of the fundamental and every harmonic in dB
+};
+
+// Analysis of a recorded exponential sine sweep, independent of the devices: deconvolution
+// with the inverse filter of the sweep, the linear impulse response and the level of the
+// fundamental and every harmonic over the excitation frequency.
+class SweepAnalysis {
+
+public:
+	static void analyze(ImpulseResponseJob& job, ImpulseResponseResult& result);
+
+private:
+	static void extract(std::vector<float>& impulse, int begin, int size, int fadeIn, float* pa_dst);
+	static void calculateLevels(float* pa_impulse, int size, int harmonic, float sampleRate, float* pa_frequencies, float* pa_dst);
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include "Common/Signal.h"
+
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define TRANSFER_SIZE 16384 // samples per FFT frame
+#define TRANSFER_MIN_DB -160.0f
+#define TRANSFER_DELAY_INTERVAL 32 // frames after which the delay is measured again
+#define TRANSFER_DELAY_COHERENCE 0.8f // the delay is measured again if the mean coherence falls below this part of its best value
+
+// Dual channel FFT analyzer, estimates the transfer function from a reference to a
+// measured channel with any broadband excitation (noise, music). Auto and cross
+// spectra of windowed, overlapping frames are averaged (Welch), the transfer function
+// is G_xy / G_xx (H1, unbiased by noise on the output) or G_yy / G_yx (H2, unbiased
+// by noise on the input), the coherence shows how much of the output is explained
+// by the input. The delay between the channels is found by cross-correlation after every
+// reset, every now and then and whenever the coherence drops (e.g. another device), frames
+// are aligned by it and the remaining fraction of a sample is fitted to the cross spectrum
+// phase, so the phase is shown without the delay.
+class TransferFunctionAnalyzer {
+
+private:
+	float m_sampleRate;
+	int m_size;
+
+	bool m_enable;
+	int m_estimator; // 0: H1, 1: H2
+	int m_nAverages;
+
+	std::vector<float> m_window;
+
+	double m_delay; // measured channel behind the reference (in samples)
+	int m_shift; // integer part of the delay, by which the frames are aligned
+	bool m_delayValid;
+	int m_delayAge; // frames analyzed since the delay was measured
+	float m_bestCoherence; // best mean coherence since the delay was measured
+	bool m_coherenceDropped;
+
+	std::vector<float> m_referenceFrame;
+	std::vector<float> m_measurementFrame;
+	std::vector<std::complex<float>> m_referenceBins;
+	std::vector<std::complex<float>> m_measurementBins;
+
+	// averaged auto and cross spectra
+	std::vector<double> m_gxx;
+	std::vector<double> m_gyy;
+	std::vector<std::complex<double>> m_gxy;
+	int m_count;
+
+	std::mutex m_mutex; // guards the result
+	std::vector<float> m_gainResult;
+	std::vector<float> m_phaseResult;
+	std::vector<float> m_coherenceResult;
+	double m_delayResult;
+	bool m_updated;
+
+	// only accessed from the GUI thread
+	std::vector<float> m_gainData; // dB
+	std::vector<float> m_phaseData; // degree
+	std::vector<float> m_coherenceData; // dB
+	std::vector<float> m_frequencies;
+	double m_latestDelay;
+
+	std::thread m_worker;
+	std::mutex m_inputMutex; // guards input, settings and running flag
+	std::condition_variable m_condition;
+	std::vector<float> m_referenceInput; // samples not yet transformed
+	std::vector<float> m_measurementInput;
+	bool m_reset;
+	bool m_running;
+
+public:
+	TransferFunctionAnalyzer(float sampleRate, int size);
+	~TransferFunctionAnalyzer();
+
+public:
+	void addSamples(float* pa_reference, float* pa_measurement, int size);
+	bool update();
+
+	float* getFrequencyData();
+	float* getGainData();
+	float* getPhaseData();
+	float* getCoherenceData();
+	int getPlotDataSize();
+	float getDelay(); // in seconds
+
+	bool isEnabled();
+	int getEstimator();
+	int getAverageCount();
+
+	void enableAnalysis(int enable);
+	void setEstimator(int estimator);
+	void setAverageCount(int nAverages);
+	void clear();
+
+	static double estimateDelay(float* pa_reference, float* pa_measurement, int size);
+
+	Signal<> onPlotUpdate;
+
+private:
+	void run();
+	void reset();
+	void analyzeFrame(int estimator, int nAverages);
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "Common/Signal.h"
+#include "RunningStatistics.h"
+
+#define MEASUREMENT_COUNT 8
+#define MEASUREMENT_LOW_LEVEL 0.1f // reference levels of rise and fall time (relative to peak to peak)
+#define MEASUREMENT_HIGH_LEVEL 0.9f
+
+enum Measurement {
+	Frequency = 0,
+	Period = 1,
+	PeakToPeak = 2,
+	RMS = 3,
+	Mean = 4,
+	RiseTime = 5,
+	FallTime = 6,
+	DutyCycle = 7
+};
+
+struct MeasurementResult {
+
+	bool valid[MEASUREMENT_COUNT]; // false if a quantity couldn't be measured (e.g. no complete period)
+	float values[MEASUREMENT_COUNT]; // in Hz, s, V and %
+};
+
+// Automatic measurements of a waveform (like the measure menu of an oscilloscope).
+// Amplitudes are reduced in a single vectorized pass, the timing quantities come
+// from interpolated crossings of the mid, low and high reference levels (the low
+// and high level act as hysteresis, so noise on an edge isn't counted as an edge).
+// The reference levels depend on the minimum and maximum of the whole waveform,
+// so the edges are found in a second (scalar) pass after the reduction. A waveform
+// may consist of several segments (e.g. the pieces of a ring buffer), they are
+// measured in place as if they were one.
+// Statistics over all measured acquisitions are updated incrementally.
+class WaveformMeasurements {
+
+private:
+	MeasurementResult m_result;
+	RunningStatistics ma_statistics[MEASUREMENT_COUNT];
+
+public:
+	WaveformMeasurements();
+
+public:
+	void measure(float* pa_src, int size, float sampleRate, float scale);
+	void measure(float** pa_segments, int* pa_sizes, int nSegments, float sampleRate, float scale);
+	void clearStatistics();
+
+	MeasurementResult getResult();
+	RunningStatistics* getStatistics(int measurement);
+
+	static void analyze(float* pa_src, int size, float sampleRate, MeasurementResult& result);
+	static void analyze(float** pa_segments, int* pa_sizes, int nSegments, float sampleRate, MeasurementResult& result);
+
+	Signal<> onResultUpdate;
+};
\ No newline at end of file
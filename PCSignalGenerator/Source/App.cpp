@@ -3,18 +3,32 @@
 
 #include "Style/Palette.h"
 
+#include <bit>
 #include <numbers>
 #include <string>
+#include <sstream>
+#include <iomanip>
 #include <vector>
 
-App::App(int argc, char** argv) : Application(argc, argv), mp_sigGen(new SignalGenerator()), mp_osc(new Oscilloscope) {
+App::App(int argc, char** argv) : Application(argc, argv), mp_sigGen(new SignalGenerator()), mp_osc(new Oscilloscope), m_scaleChannel(0),
+	m_impulseDisplay(0), m_bodeDisplay(0) {
+
+	mp_freqResponse = new FrequencyResponse(mp_sigGen, mp_osc);
+	mp_impulseResponse = new ImpulseResponse(mp_sigGen, mp_osc);
+	mp_latencyMeter = new LatencyMeter(mp_sigGen, mp_osc);
 
 	REGISTER_FUNCTIONAL(mp_sigGen)
 	REGISTER_FUNCTIONAL(mp_osc)
+	REGISTER_FUNCTIONAL(mp_freqResponse)
+	REGISTER_FUNCTIONAL(mp_impulseResponse)
+	REGISTER_FUNCTIONAL(mp_latencyMeter)
 }
 
 App::~App() {
 
+	delete mp_freqResponse;
+	delete mp_impulseResponse;
+	delete mp_latencyMeter;
 	delete mp_sigGen;
 	delete mp_osc;
 
@@ -23,9 +37,27 @@ App::~App() {
 	delete mp_sigGenPlot;
 	delete mp_oscPlot;
 	delete mp_bode;
+	delete mp_spectrumPlot;
+	delete mp_spectrogramPlot;
+	delete mp_impulsePlot;
 
 	delete mp_sigGenPlotSeries;
-	delete mp_oscPlotSeries;
+
+	for (PlotSeries1D* p_series : mp_oscPlotSeries) {
+		delete p_series;
+	}
+
+	delete mp_persistenceSeries;
+	delete mp_spectrumPlotSeries;
+	delete mp_spectrogramSeries;
+	delete mp_gainPlotSeries;
+	delete mp_phasePlotSeries;
+	delete mp_transferGainSeries;
+	delete mp_transferPhaseSeries;
+	delete mp_coherenceSeries;
+	delete mp_impulsePlotSeries;
+
+	delete mp_harmonicPlotSeries;
 
 	delete mp_mainLayout;
 	delete mp_parameterLayout;
@@ -36,10 +68,24 @@ App::~App() {
 	delete mp_sigGenGroup;
 	delete mp_oscGroup;
 	delete mp_freqResponseGroup;
+	delete mp_spectrumGroup;
+	delete mp_impulseGroup;
+	delete mp_distortionGroup;
+	delete mp_measurementGroup;
+	delete mp_filterGroup;
+	delete mp_transferGroup;
+	delete mp_latencyGroup;
 
 	delete mp_sigGenLayout;
 	delete mp_oscLayout;
 	delete mp_freqResponseLayout;
+	delete mp_spectrumLayout;
+	delete mp_impulseLayout;
+	delete mp_distortionLayout;
+	delete mp_measurementLayout;
+	delete mp_filterLayout;
+	delete mp_transferLayout;
+	delete mp_latencyLayout;
 
 	delete mp_enableSigGenLabel;
 	delete mp_enableSigGenButton;
@@ -64,6 +110,189 @@ App::~App() {
 
 	delete mp_triggerLevelLabel;
 	delete mp_triggerLevelSlider;
+
+	delete mp_triggerSourceLabel;
+	delete mp_triggerSourceComboBox;
+
+	delete mp_mathModeLabel;
+	delete mp_mathModeComboBox;
+
+	delete mp_scaleChannelLabel;
+	delete mp_scaleChannelComboBox;
+
+	delete mp_channelScaleLabel;
+	delete mp_channelScaleSlider;
+
+	delete mp_segmentLabel;
+	delete mp_segmentSlider;
+
+	delete mp_segmentViewLabel;
+	delete mp_segmentViewComboBox;
+
+	delete mp_persistenceLabel;
+	delete mp_persistenceComboBox;
+
+	delete mp_spectrumChannelLabel;
+	delete mp_spectrumChannelComboBox;
+
+	delete mp_spectrumSizeLabel;
+	delete mp_spectrumSizeComboBox;
+
+	delete mp_spectrumWindowLabel;
+	delete mp_spectrumWindowComboBox;
+
+	delete mp_spectrumOverlapLabel;
+	delete mp_spectrumOverlapComboBox;
+
+	delete mp_spectrumAveragingLabel;
+	delete mp_spectrumAveragingComboBox;
+
+	delete mp_spectrumScaleLabel;
+	delete mp_spectrumScaleComboBox;
+
+	delete mp_colorMapLabel;
+	delete mp_colorMapComboBox;
+
+	delete mp_spectrogramSaveLabel;
+	delete mp_spectrogramSaveButton;
+
+	delete mp_measureLabel;
+	delete mp_measureButton;
+
+	delete mp_startFrequencyLabel;
+	delete mp_startFrequencySlider;
+
+	delete mp_stopFrequencyLabel;
+	delete mp_stopFrequencySlider;
+
+	delete mp_pointCountLabel;
+	delete mp_pointCountSlider;
+
+	delete mp_bodeDisplayLabel;
+	delete mp_bodeDisplayComboBox;
+
+	delete mp_sweepMeasureLabel;
+	delete mp_sweepMeasureButton;
+
+	delete mp_sweepStartLabel;
+	delete mp_sweepStartSlider;
+
+	delete mp_sweepStopLabel;
+	delete mp_sweepStopSlider;
+
+	delete mp_sweepDurationLabel;
+	delete mp_sweepDurationSlider;
+
+	delete mp_impulseDisplayLabel;
+	delete mp_impulseDisplayComboBox;
+
+	delete mp_distortionChannelLabel;
+	delete mp_distortionChannelComboBox;
+
+	delete mp_fundamentalLabel;
+	delete mp_fundamentalValueLabel;
+
+	delete mp_thdLabel;
+	delete mp_thdValueLabel;
+
+	delete mp_thdNLabel;
+	delete mp_thdNValueLabel;
+
+	delete mp_sinadLabel;
+	delete mp_sinadValueLabel;
+
+	delete mp_snrLabel;
+	delete mp_snrValueLabel;
+
+	delete mp_enobLabel;
+	delete mp_enobValueLabel;
+
+	delete mp_measurementChannelLabel;
+	delete mp_measurementChannelComboBox;
+
+	delete mp_measuredFrequencyLabel;
+	delete mp_measuredFrequencyValueLabel;
+
+	delete mp_measuredPeriodLabel;
+	delete mp_measuredPeriodValueLabel;
+
+	delete mp_peakToPeakLabel;
+	delete mp_peakToPeakValueLabel;
+
+	delete mp_rmsLabel;
+	delete mp_rmsValueLabel;
+
+	delete mp_meanLabel;
+	delete mp_meanValueLabel;
+
+	delete mp_riseTimeLabel;
+	delete mp_riseTimeValueLabel;
+
+	delete mp_fallTimeLabel;
+	delete mp_fallTimeValueLabel;
+
+	delete mp_measuredDutyCycleLabel;
+	delete mp_measuredDutyCycleValueLabel;
+
+	delete mp_acquisitionCountLabel;
+	delete mp_acquisitionCountValueLabel;
+
+	delete mp_statisticsLabel;
+	delete mp_resetStatisticsButton;
+
+	delete mp_filterTypeLabel;
+	delete mp_filterTypeComboBox;
+
+	delete mp_filterResponseLabel;
+	delete mp_filterResponseComboBox;
+
+	delete mp_filterFrequencyLabel;
+	delete mp_filterFrequencySlider;
+
+	delete mp_filterOrderLabel;
+	delete mp_filterOrderSlider;
+
+	delete mp_filterTapsLabel;
+	delete mp_filterTapsSlider;
+
+	delete mp_transferEnableLabel;
+	delete mp_transferEnableButton;
+
+	delete mp_transferReferenceLabel;
+	delete mp_transferReferenceComboBox;
+
+	delete mp_transferChannelLabel;
+	delete mp_transferChannelComboBox;
+
+	delete mp_estimatorLabel;
+	delete mp_estimatorComboBox;
+
+	delete mp_transferAveragesLabel;
+	delete mp_transferAveragesSlider;
+
+	delete mp_delayLabel;
+	delete mp_delayValueLabel;
+
+	delete mp_transferResetLabel;
+	delete mp_transferResetButton;
+
+	delete mp_latencyMeasureLabel;
+	delete mp_latencyMeasureButton;
+
+	delete mp_latencyChannelLabel;
+	delete mp_latencyChannelComboBox;
+
+	delete mp_latencyLabel;
+	delete mp_latencyValueLabel;
+
+	delete mp_driftLabel;
+	delete mp_driftValueLabel;
+
+	delete mp_markerCountLabel;
+	delete mp_markerCountValueLabel;
+
+	delete mp_clockCorrectionLabel;
+	delete mp_clockCorrectionButton;
 }
 
 void App::initUI() {
@@ -82,8 +311,7 @@ void App::initUI() {
 	//mp_sigGenPlot->setPlotYBounds(-7, 7);
 
 	// create plot series
-	mp_sigGenPlotSeries = new PlotSeries1D(mp_sigGenPlot, mp_sigGen->getPlotData(), 0,
-		2 * std::numbers::pi,mp_sigGen->getPlotDataSize(), Palette::Plot(2));
+	mp_sigGenPlotSeries = new PlotSeries1D(mp_sigGenPlot, mp_sigGen->getPlotBuffer(), 0, 2 * std::numbers::pi, Palette::Plot(2));
 
 	mp_sigGenPlot->addPlotSeries(mp_sigGenPlotSeries);
 
@@ -97,19 +325,117 @@ void App::initUI() {
 
 	connect<Plot, Oscilloscope, Math::Size>(mp_osc, &Oscilloscope::calculateSampleRate, mp_oscPlot->onZoom);
 
-	// create plot series
-	mp_oscPlotSeries = new PlotSeries1D(mp_oscPlot, mp_osc->getPlotData(), -1, 1, mp_osc->getPlotDataSize(), Palette::Plot(0));
-	mp_oscPlot->addPlotSeries(mp_oscPlotSeries);
+	// create persistence series (drawn below the traces)
+	mp_persistenceSeries = new PlotSeriesImage(mp_oscPlot, mp_osc->getPersistenceImage(), mp_osc->getPersistenceWidth(),
+		mp_osc->getPersistenceHeight(), Math::Rect(-1, 1, OSC_PERSISTENCE_RANGE, -OSC_PERSISTENCE_RANGE));
+	mp_persistenceSeries->setVisible(mp_osc->getPersistence() != 0);
+	mp_oscPlot->addPlotSeries(mp_persistenceSeries);
+
+	// create plot series (one per channel and the math channel)
+	for (int c = 0; c <= mp_osc->getChannelCount(); ++c) {
+
+		PlotSeries1D* p_series = new PlotSeries1D(mp_oscPlot, mp_osc->getPlotBuffer(c), -1, 1, Palette::Plot(c));
+		mp_oscPlot->addPlotSeries(p_series);
+		mp_oscPlotSeries.push_back(p_series);
+	}
+
+	// hide math channel if it is disabled
+	mp_oscPlotSeries.back()->setVisible(mp_osc->getMathMode() != 0);
+
+	connect<Oscilloscope, Plot>(mp_oscPlot, &Plot::onUpdate, mp_osc->onPlotUpdate);
+	connect<Oscilloscope, App, float, float>(this, &App::setOscBounds, mp_osc->onBoundsChange);
+
+	// create spectrum plot
+	SpectrumAnalyzer* p_spectrum = mp_osc->getSpectrumAnalyzer();
+
+	mp_spectrumPlot = new Plot(mp_window, L"Frequency", L"Magnitude");
+	mp_spectrumPlot->setXUnit(Unit::Hertz);
+	mp_spectrumPlot->setYUnit(Unit::Decibel);
+	mp_spectrumPlot->setFillMode(FillMode::Expand);
+	mp_spectrumPlot->setXAxisScale(AxisScale::Logarithmic);
+	mp_spectrumPlot->setPlotXBounds(20, p_spectrum->getSampleRate() / 2);
+	mp_spectrumPlot->setPlotYBounds(0, SPECTRUM_MIN_DB);
+
+	mp_spectrumPlotSeries = new PlotSeries1D(mp_spectrumPlot, p_spectrum->getFrequencyData(), p_spectrum->getPlotData(),
+		p_spectrum->getPlotDataSize(), Palette::Plot(1));
+
+	mp_spectrumPlot->addPlotSeries(mp_spectrumPlotSeries);
+
+	connect<SpectrumAnalyzer, App>(this, &App::updateSpectrum, p_spectrum->onPlotUpdate);
+
+	// create spectrogram plot (the newest column is drawn at the right edge)
+	Spectrogram* p_spectrogram = mp_osc->getSpectrogram();
+
+	mp_spectrogramPlot = new Plot(mp_window, L"Time", L"Frequency");
+	mp_spectrogramPlot->setXUnit(Unit::Second);
+	mp_spectrogramPlot->setYUnit(Unit::Hertz);
+	mp_spectrogramPlot->setFillMode(FillMode::Expand);
+	mp_spectrogramPlot->setPlotXBounds(-p_spectrogram->getDuration(), 0);
+	mp_spectrogramPlot->setPlotYBounds(p_spectrogram->getSampleRate() / 2, 0);
 
-	connect<Oscilloscope, PlotSeries1D>(mp_oscPlotSeries, &PlotSeries1D::onUpdate, mp_osc->onPlotUpdate);
-	connect<Oscilloscope, PlotSeries1D, int>(mp_oscPlotSeries, &PlotSeries1D::setHead, mp_osc->onTrigger);
-	connect<Oscilloscope, PlotSeries1D, float, float>(mp_oscPlotSeries, &PlotSeries1D::setBounds, mp_osc->onBoundsChange);
+	mp_spectrogramSeries = new PlotSeriesImage(mp_spectrogramPlot, p_spectrogram->getPixels(), p_spectrogram->getWidth(),
+		p_spectrogram->getHeight(), Math::Rect(-p_spectrogram->getDuration(), 0, p_spectrogram->getSampleRate() / 2, 0));
+	mp_spectrogramPlot->addPlotSeries(mp_spectrogramSeries);
+
+	connect<Spectrogram, App, int, int>(this, &App::updateSpectrogram, p_spectrogram->onColumnsUpdate);
 
 	// create bode plot
-	mp_bode = new Plot(mp_window, L"Frequency", L"Voltage");
+	mp_bode = new Plot(mp_window, L"Frequency", L"Gain");
 	mp_bode->setXUnit(Unit::Hertz);
-	mp_bode->setYUnit(Unit::Volts);
+	mp_bode->setYUnit(Unit::Decibel);
 	mp_bode->setFillMode(FillMode::Expand);
+	mp_bode->setXAxisScale(AxisScale::Logarithmic);
+	mp_bode->setPlotXBounds(mp_freqResponse->getStartFrequency(), mp_freqResponse->getStopFrequency());
+
+	mp_gainPlotSeries = new PlotSeries1D(mp_bode, mp_freqResponse->getFrequencyData(), mp_freqResponse->getGainData(),
+		mp_freqResponse->getPlotDataSize(), Palette::Plot(0));
+	mp_phasePlotSeries = new PlotSeries1D(mp_bode, mp_freqResponse->getFrequencyData(), mp_freqResponse->getPhaseData(),
+		mp_freqResponse->getPlotDataSize(), Palette::Plot(1));
+	mp_phasePlotSeries->setVisible(false);
+
+	// the transfer function is shown on top of the stepped sine measurement
+	TransferFunctionAnalyzer* p_transfer = mp_osc->getTransferAnalyzer();
+
+	mp_transferGainSeries = new PlotSeries1D(mp_bode, p_transfer->getFrequencyData(), p_transfer->getGainData(),
+		p_transfer->getPlotDataSize(), Palette::Plot(2));
+	mp_transferPhaseSeries = new PlotSeries1D(mp_bode, p_transfer->getFrequencyData(), p_transfer->getPhaseData(),
+		p_transfer->getPlotDataSize(), Palette::Plot(3));
+	mp_coherenceSeries = new PlotSeries1D(mp_bode, p_transfer->getFrequencyData(), p_transfer->getCoherenceData(),
+		p_transfer->getPlotDataSize(), Palette::Plot(4));
+	mp_transferGainSeries->setVisible(false);
+	mp_transferPhaseSeries->setVisible(false);
+	mp_coherenceSeries->setVisible(false);
+
+	mp_bode->addPlotSeries(mp_gainPlotSeries);
+	mp_bode->addPlotSeries(mp_phasePlotSeries);
+	mp_bode->addPlotSeries(mp_transferGainSeries);
+	mp_bode->addPlotSeries(mp_transferPhaseSeries);
+	mp_bode->addPlotSeries(mp_coherenceSeries);
+
+	connect<FrequencyResponse, Plot>(mp_bode, &Plot::onUpdate, mp_freqResponse->onPlotUpdate);
+	connect<FrequencyResponse, App, float, float>(this, &App::setBodeBounds, mp_freqResponse->onBoundsChange);
+	connect<TransferFunctionAnalyzer, App>(this, &App::updateTransferFunction, p_transfer->onPlotUpdate);
+
+	// create impulse response plot (shows the linear impulse response or the harmonic levels)
+	mp_impulsePlot = new Plot(mp_window, L"Time", L"Amplitude");
+	mp_impulsePlot->setFillMode(FillMode::Expand);
+
+	mp_impulsePlotSeries = new PlotSeries1D(mp_impulsePlot, mp_impulseResponse->getTimeData(), mp_impulseResponse->getImpulseData(),
+		mp_impulseResponse->getImpulseDataSize(), Palette::Plot(0));
+	mp_impulsePlot->addPlotSeries(mp_impulsePlotSeries);
+
+	// all harmonic levels share the excitation frequencies
+	mp_harmonicPlotSeries = new PlotSeries2D(mp_impulsePlot, mp_impulseResponse->getFrequencyData(), mp_impulseResponse->getPlotDataSize());
+
+	for (int n = 0; n < mp_impulseResponse->getHarmonicCount(); ++n) {
+		mp_harmonicPlotSeries->addChannel(mp_impulseResponse->getLevelData(n), Palette::Plot(n));
+	}
+
+	mp_impulsePlot->addPlotSeries(mp_harmonicPlotSeries);
+
+	setImpulseDisplay(m_impulseDisplay);
+
+	connect<ImpulseResponse, App>(this, &App::updateImpulseResponse, mp_impulseResponse->onPlotUpdate);
 
 	// create parameters
 	mp_enableSigGenLabel = new Label(mp_window, L"Signal Generator");
@@ -127,7 +453,7 @@ void App::initUI() {
 	mp_waveformLabel->setMargin(10.0f);
 	mp_waveformLabel->setPadding(10.0f);
 
-	mp_waveformComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Sine", L"Rectangular", L"Triangle", L"Sawtooth" }));
+	mp_waveformComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Sine", L"Rectangular", L"Triangle", L"Sawtooth", L"Sweep", L"Marker" }));
 	mp_waveformComboBox->setState(mp_sigGen->getWaveformType());
 	mp_waveformComboBox->setMargin(10.0f);
 	mp_waveformComboBox->setPadding(10.0f);
@@ -182,7 +508,7 @@ void App::initUI() {
 	mp_aquisitionModeLabel->setMargin(10.0f);
 	mp_aquisitionModeLabel->setPadding(10.0f);
 
-	mp_aquisitionModeComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Trigger", L"Rolling" }));
+	mp_aquisitionModeComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Trigger", L"Rolling", L"Segmented", L"Equivalent Time" }));
 	mp_aquisitionModeComboBox->setState(mp_osc->getAquisitionMode());
 	mp_aquisitionModeComboBox->setMargin(10.0f);
 	mp_aquisitionModeComboBox->setPadding(10.0f);
@@ -199,10 +525,673 @@ void App::initUI() {
 	mp_triggerLevelSlider->setSuffix(L" V");
 	connect<Slider<float>, Oscilloscope, float>(mp_osc, &Oscilloscope::setTriggerLevel, mp_triggerLevelSlider->onValueChanged);
 
+
+	// create channel names (the math channel is the last one)
+	std::vector<std::wstring> channelNames;
+	for (int c = 0; c < mp_osc->getChannelCount(); ++c) {
+		channelNames.push_back(L"CH" + std::to_wstring(c + 1));
+	}
+	channelNames.push_back(L"Math");
+
+	mp_triggerSourceLabel = new Label(mp_window, L"Trigger Source");
+	mp_triggerSourceLabel->setMargin(10.0f);
+	mp_triggerSourceLabel->setPadding(10.0f);
+
+	mp_triggerSourceComboBox = new ComboBox(mp_window, channelNames);
+	mp_triggerSourceComboBox->setState(mp_osc->getTriggerSource());
+	mp_triggerSourceComboBox->setMargin(10.0f);
+	mp_triggerSourceComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setTriggerSource, mp_triggerSourceComboBox->onStateChanged);
+
+
+	mp_mathModeLabel = new Label(mp_window, L"Math");
+	mp_mathModeLabel->setMargin(10.0f);
+	mp_mathModeLabel->setPadding(10.0f);
+
+	mp_mathModeComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Off", L"CH1 + CH2", L"CH1 - CH2" }));
+	mp_mathModeComboBox->setState(mp_osc->getMathMode());
+	mp_mathModeComboBox->setMargin(10.0f);
+	mp_mathModeComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setMathMode, mp_mathModeComboBox->onStateChanged);
+
+
+	mp_scaleChannelLabel = new Label(mp_window, L"Channel");
+	mp_scaleChannelLabel->setMargin(10.0f);
+	mp_scaleChannelLabel->setPadding(10.0f);
+
+	mp_scaleChannelComboBox = new ComboBox(mp_window, channelNames);
+	mp_scaleChannelComboBox->setState(m_scaleChannel);
+	mp_scaleChannelComboBox->setMargin(10.0f);
+	mp_scaleChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setScaleChannel, mp_scaleChannelComboBox->onStateChanged);
+
+
+	mp_channelScaleLabel = new Label(mp_window, L"Vertical Scale");
+	mp_channelScaleLabel->setMargin(10.0f);
+	mp_channelScaleLabel->setPadding(10.0f);
+
+	mp_channelScaleSlider = new Slider<float>(mp_window, mp_osc->getChannelScale(m_scaleChannel), 0, 10);
+	mp_channelScaleSlider->setMargin(10.0f);
+	mp_channelScaleSlider->setPadding(10.0f);
+	mp_channelScaleSlider->setSuffix(L" x");
+	connect<Slider<float>, App, float>(this, &App::setChannelScale, mp_channelScaleSlider->onValueChanged);
+
+
+	mp_segmentLabel = new Label(mp_window, L"Segment");
+	mp_segmentLabel->setMargin(10.0f);
+	mp_segmentLabel->setPadding(10.0f);
+
+	mp_segmentSlider = new Slider<int>(mp_window, 0, 0, mp_osc->getSegmentCapacity() - 1);
+	mp_segmentSlider->setMargin(10.0f);
+	mp_segmentSlider->setPadding(10.0f);
+	connect<Slider<int>, Oscilloscope, int>(mp_osc, &Oscilloscope::setSelectedSegment, mp_segmentSlider->onValueChanged);
+
+
+	mp_segmentViewLabel = new Label(mp_window, L"Segment View");
+	mp_segmentViewLabel->setMargin(10.0f);
+	mp_segmentViewLabel->setPadding(10.0f);
+
+	mp_segmentViewComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Single", L"Overlay" }));
+	mp_segmentViewComboBox->setMargin(10.0f);
+	mp_segmentViewComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setSegmentView, mp_segmentViewComboBox->onStateChanged);
+
+
+	mp_persistenceLabel = new Label(mp_window, L"Persistence");
+	mp_persistenceLabel->setMargin(10.0f);
+	mp_persistenceLabel->setPadding(10.0f);
+
+	mp_persistenceComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_persistenceComboBox->setState(mp_osc->getPersistence());
+	mp_persistenceComboBox->setMargin(10.0f);
+	mp_persistenceComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setPersistence, mp_persistenceComboBox->onStateChanged);
+
+
+
+	mp_measurementChannelLabel = new Label(mp_window, L"Channel");
+	mp_measurementChannelLabel->setMargin(10.0f);
+	mp_measurementChannelLabel->setPadding(10.0f);
+
+	mp_measurementChannelComboBox = new ComboBox(mp_window, channelNames);
+	mp_measurementChannelComboBox->setState(mp_osc->getMeasurementChannel());
+	mp_measurementChannelComboBox->setMargin(10.0f);
+	mp_measurementChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setMeasurementChannel, mp_measurementChannelComboBox->onStateChanged);
+
+
+	mp_measuredFrequencyLabel = new Label(mp_window, L"Frequency");
+	mp_measuredFrequencyLabel->setMargin(10.0f);
+	mp_measuredFrequencyLabel->setPadding(10.0f);
+
+	mp_measuredFrequencyValueLabel = new Label(mp_window, L"-");
+	mp_measuredFrequencyValueLabel->setMargin(10.0f);
+	mp_measuredFrequencyValueLabel->setPadding(10.0f);
+
+
+	mp_measuredPeriodLabel = new Label(mp_window, L"Period");
+	mp_measuredPeriodLabel->setMargin(10.0f);
+	mp_measuredPeriodLabel->setPadding(10.0f);
+
+	mp_measuredPeriodValueLabel = new Label(mp_window, L"-");
+	mp_measuredPeriodValueLabel->setMargin(10.0f);
+	mp_measuredPeriodValueLabel->setPadding(10.0f);
+
+
+	mp_peakToPeakLabel = new Label(mp_window, L"Peak to Peak");
+	mp_peakToPeakLabel->setMargin(10.0f);
+	mp_peakToPeakLabel->setPadding(10.0f);
+
+	mp_peakToPeakValueLabel = new Label(mp_window, L"-");
+	mp_peakToPeakValueLabel->setMargin(10.0f);
+	mp_peakToPeakValueLabel->setPadding(10.0f);
+
+
+	mp_rmsLabel = new Label(mp_window, L"RMS");
+	mp_rmsLabel->setMargin(10.0f);
+	mp_rmsLabel->setPadding(10.0f);
+
+	mp_rmsValueLabel = new Label(mp_window, L"-");
+	mp_rmsValueLabel->setMargin(10.0f);
+	mp_rmsValueLabel->setPadding(10.0f);
+
+
+	mp_meanLabel = new Label(mp_window, L"Mean");
+	mp_meanLabel->setMargin(10.0f);
+	mp_meanLabel->setPadding(10.0f);
+
+	mp_meanValueLabel = new Label(mp_window, L"-");
+	mp_meanValueLabel->setMargin(10.0f);
+	mp_meanValueLabel->setPadding(10.0f);
+
+
+	mp_riseTimeLabel = new Label(mp_window, L"Rise Time");
+	mp_riseTimeLabel->setMargin(10.0f);
+	mp_riseTimeLabel->setPadding(10.0f);
+
+	mp_riseTimeValueLabel = new Label(mp_window, L"-");
+	mp_riseTimeValueLabel->setMargin(10.0f);
+	mp_riseTimeValueLabel->setPadding(10.0f);
+
+
+	mp_fallTimeLabel = new Label(mp_window, L"Fall Time");
+	mp_fallTimeLabel->setMargin(10.0f);
+	mp_fallTimeLabel->setPadding(10.0f);
+
+	mp_fallTimeValueLabel = new Label(mp_window, L"-");
+	mp_fallTimeValueLabel->setMargin(10.0f);
+	mp_fallTimeValueLabel->setPadding(10.0f);
+
+
+	mp_measuredDutyCycleLabel = new Label(mp_window, L"Duty Cycle");
+	mp_measuredDutyCycleLabel->setMargin(10.0f);
+	mp_measuredDutyCycleLabel->setPadding(10.0f);
+
+	mp_measuredDutyCycleValueLabel = new Label(mp_window, L"-");
+	mp_measuredDutyCycleValueLabel->setMargin(10.0f);
+	mp_measuredDutyCycleValueLabel->setPadding(10.0f);
+
+
+	mp_acquisitionCountLabel = new Label(mp_window, L"Acquisitions");
+	mp_acquisitionCountLabel->setMargin(10.0f);
+	mp_acquisitionCountLabel->setPadding(10.0f);
+
+	mp_acquisitionCountValueLabel = new Label(mp_window, L"-");
+	mp_acquisitionCountValueLabel->setMargin(10.0f);
+	mp_acquisitionCountValueLabel->setPadding(10.0f);
+
+
+	mp_statisticsLabel = new Label(mp_window, L"Statistics");
+	mp_statisticsLabel->setMargin(10.0f);
+	mp_statisticsLabel->setPadding(10.0f);
+
+	mp_resetStatisticsButton = new Button(mp_window, L"Reset");
+	mp_resetStatisticsButton->setMargin(10.0f);
+	mp_resetStatisticsButton->setPadding(10.0f);
+	connect<Button, WaveformMeasurements>(mp_osc->getMeasurements(), &WaveformMeasurements::clearStatistics, mp_resetStatisticsButton->onButtonClick);
+
+	connect<WaveformMeasurements, App>(this, &App::updateMeasurements, mp_osc->getMeasurements()->onResultUpdate);
+
+
+
+	FilterStage* p_filter = mp_osc->getFilterStage();
+
+	mp_filterTypeLabel = new Label(mp_window, L"Type");
+	mp_filterTypeLabel->setMargin(10.0f);
+	mp_filterTypeLabel->setPadding(10.0f);
+
+	mp_filterTypeComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Off", L"Butterworth", L"Chebyshev", L"Notch", L"FIR" }));
+	mp_filterTypeComboBox->setState(p_filter->getType());
+	mp_filterTypeComboBox->setMargin(10.0f);
+	mp_filterTypeComboBox->setPadding(10.0f);
+	connect<ComboBox, FilterStage, int>(p_filter, &FilterStage::setType, mp_filterTypeComboBox->onStateChanged);
+
+
+	mp_filterResponseLabel = new Label(mp_window, L"Response");
+	mp_filterResponseLabel->setMargin(10.0f);
+	mp_filterResponseLabel->setPadding(10.0f);
+
+	mp_filterResponseComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Low Pass", L"High Pass" }));
+	mp_filterResponseComboBox->setState(p_filter->getResponse());
+	mp_filterResponseComboBox->setMargin(10.0f);
+	mp_filterResponseComboBox->setPadding(10.0f);
+	connect<ComboBox, FilterStage, int>(p_filter, &FilterStage::setResponse, mp_filterResponseComboBox->onStateChanged);
+
+
+	mp_filterFrequencyLabel = new Label(mp_window, L"Frequency");
+	mp_filterFrequencyLabel->setMargin(10.0f);
+	mp_filterFrequencyLabel->setPadding(10.0f);
+
+	mp_filterFrequencySlider = new Slider<float>(mp_window, p_filter->getFrequency(), 10, 20000);
+	mp_filterFrequencySlider->setMargin(10.0f);
+	mp_filterFrequencySlider->setPadding(10.0f);
+	mp_filterFrequencySlider->setSuffix(L" Hz");
+	connect<Slider<float>, FilterStage, float>(p_filter, &FilterStage::setFrequency, mp_filterFrequencySlider->onValueChanged);
+
+
+	mp_filterOrderLabel = new Label(mp_window, L"Order");
+	mp_filterOrderLabel->setMargin(10.0f);
+	mp_filterOrderLabel->setPadding(10.0f);
+
+	mp_filterOrderSlider = new Slider<int>(mp_window, p_filter->getOrder(), 1, FILTER_MAX_ORDER);
+	mp_filterOrderSlider->setMargin(10.0f);
+	mp_filterOrderSlider->setPadding(10.0f);
+	connect<Slider<int>, FilterStage, int>(p_filter, &FilterStage::setOrder, mp_filterOrderSlider->onValueChanged);
+
+
+	mp_filterTapsLabel = new Label(mp_window, L"Taps");
+	mp_filterTapsLabel->setMargin(10.0f);
+	mp_filterTapsLabel->setPadding(10.0f);
+
+	mp_filterTapsSlider = new Slider<int>(mp_window, p_filter->getTaps(), 3, FILTER_MAX_TAPS);
+	mp_filterTapsSlider->setMargin(10.0f);
+	mp_filterTapsSlider->setPadding(10.0f);
+	connect<Slider<int>, FilterStage, int>(p_filter, &FilterStage::setTaps, mp_filterTapsSlider->onValueChanged);
+
+
+
+	mp_transferEnableLabel = new Label(mp_window, L"Analysis");
+	mp_transferEnableLabel->setMargin(10.0f);
+	mp_transferEnableLabel->setPadding(10.0f);
+
+	mp_transferEnableButton = new StateButton(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_transferEnableButton->setMargin(10.0f);
+	mp_transferEnableButton->setPadding(10.0f);
+	connect<StateButton, App, int>(this, &App::enableTransferAnalysis, mp_transferEnableButton->onStateChanged);
+
+
+	mp_transferReferenceLabel = new Label(mp_window, L"Reference");
+	mp_transferReferenceLabel->setMargin(10.0f);
+	mp_transferReferenceLabel->setPadding(10.0f);
+
+	mp_transferReferenceComboBox = new ComboBox(mp_window, channelNames);
+	mp_transferReferenceComboBox->setState(mp_osc->getTransferReference());
+	mp_transferReferenceComboBox->setMargin(10.0f);
+	mp_transferReferenceComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setTransferReference, mp_transferReferenceComboBox->onStateChanged);
+
+
+	mp_transferChannelLabel = new Label(mp_window, L"Channel");
+	mp_transferChannelLabel->setMargin(10.0f);
+	mp_transferChannelLabel->setPadding(10.0f);
+
+	mp_transferChannelComboBox = new ComboBox(mp_window, channelNames);
+	mp_transferChannelComboBox->setState(mp_osc->getTransferChannel());
+	mp_transferChannelComboBox->setMargin(10.0f);
+	mp_transferChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setTransferChannel, mp_transferChannelComboBox->onStateChanged);
+
+
+	mp_estimatorLabel = new Label(mp_window, L"Estimator");
+	mp_estimatorLabel->setMargin(10.0f);
+	mp_estimatorLabel->setPadding(10.0f);
+
+	mp_estimatorComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"H1", L"H2" }));
+	mp_estimatorComboBox->setState(p_transfer->getEstimator());
+	mp_estimatorComboBox->setMargin(10.0f);
+	mp_estimatorComboBox->setPadding(10.0f);
+	connect<ComboBox, TransferFunctionAnalyzer, int>(p_transfer, &TransferFunctionAnalyzer::setEstimator, mp_estimatorComboBox->onStateChanged);
+
+
+	mp_transferAveragesLabel = new Label(mp_window, L"Averages");
+	mp_transferAveragesLabel->setMargin(10.0f);
+	mp_transferAveragesLabel->setPadding(10.0f);
+
+	mp_transferAveragesSlider = new Slider<int>(mp_window, p_transfer->getAverageCount(), 1, 256);
+	mp_transferAveragesSlider->setMargin(10.0f);
+	mp_transferAveragesSlider->setPadding(10.0f);
+	connect<Slider<int>, TransferFunctionAnalyzer, int>(p_transfer, &TransferFunctionAnalyzer::setAverageCount, mp_transferAveragesSlider->onValueChanged);
+
+
+	mp_delayLabel = new Label(mp_window, L"Delay");
+	mp_delayLabel->setMargin(10.0f);
+	mp_delayLabel->setPadding(10.0f);
+
+	mp_delayValueLabel = new Label(mp_window, L"-");
+	mp_delayValueLabel->setMargin(10.0f);
+	mp_delayValueLabel->setPadding(10.0f);
+
+
+	mp_transferResetLabel = new Label(mp_window, L"Average");
+	mp_transferResetLabel->setMargin(10.0f);
+	mp_transferResetLabel->setPadding(10.0f);
+
+	mp_transferResetButton = new Button(mp_window, L"Reset");
+	mp_transferResetButton->setMargin(10.0f);
+	mp_transferResetButton->setPadding(10.0f);
+	connect<Button, TransferFunctionAnalyzer>(p_transfer, &TransferFunctionAnalyzer::clear, mp_transferResetButton->onButtonClick);
+
+
+
+	mp_spectrumChannelLabel = new Label(mp_window, L"Channel");
+	mp_spectrumChannelLabel->setMargin(10.0f);
+	mp_spectrumChannelLabel->setPadding(10.0f);
+
+	mp_spectrumChannelComboBox = new ComboBox(mp_window, channelNames);
+	mp_spectrumChannelComboBox->setState(mp_osc->getSpectrumChannel());
+	mp_spectrumChannelComboBox->setMargin(10.0f);
+	mp_spectrumChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setSpectrumChannel, mp_spectrumChannelComboBox->onStateChanged);
+
+
+	mp_spectrumSizeLabel = new Label(mp_window, L"FFT Size");
+	mp_spectrumSizeLabel->setMargin(10.0f);
+	mp_spectrumSizeLabel->setPadding(10.0f);
+
+	// sizes from 1024 to 65536 samples
+	std::vector<std::wstring> sizeNames;
+	for (int size = 1024; size <= 65536; size *= 2) {
+		sizeNames.push_back(std::to_wstring(size));
+	}
+
+	mp_spectrumSizeComboBox = new ComboBox(mp_window, sizeNames);
+	mp_spectrumSizeComboBox->setState(std::countr_zero((unsigned int)p_spectrum->getSize()) - 10);
+	mp_spectrumSizeComboBox->setMargin(10.0f);
+	mp_spectrumSizeComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setSpectrumSize, mp_spectrumSizeComboBox->onStateChanged);
+
+
+	mp_spectrumWindowLabel = new Label(mp_window, L"Window");
+	mp_spectrumWindowLabel->setMargin(10.0f);
+	mp_spectrumWindowLabel->setPadding(10.0f);
+
+	mp_spectrumWindowComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Hann", L"Blackman-Harris", L"Flat Top" }));
+	mp_spectrumWindowComboBox->setState(p_spectrum->getWindowType());
+	mp_spectrumWindowComboBox->setMargin(10.0f);
+	mp_spectrumWindowComboBox->setPadding(10.0f);
+	connect<ComboBox, SpectrumAnalyzer, int>(p_spectrum, &SpectrumAnalyzer::setWindowType, mp_spectrumWindowComboBox->onStateChanged);
+
+
+	mp_spectrumOverlapLabel = new Label(mp_window, L"Overlap");
+	mp_spectrumOverlapLabel->setMargin(10.0f);
+	mp_spectrumOverlapLabel->setPadding(10.0f);
+
+	mp_spectrumOverlapComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"0 %", L"50 %", L"75 %" }));
+	mp_spectrumOverlapComboBox->setState(p_spectrum->getOverlap() >= 75 ? 2 : (p_spectrum->getOverlap() >= 50 ? 1 : 0));
+	mp_spectrumOverlapComboBox->setMargin(10.0f);
+	mp_spectrumOverlapComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setSpectrumOverlap, mp_spectrumOverlapComboBox->onStateChanged);
+
+
+	mp_spectrumAveragingLabel = new Label(mp_window, L"Averaging");
+	mp_spectrumAveragingLabel->setMargin(10.0f);
+	mp_spectrumAveragingLabel->setPadding(10.0f);
+
+	mp_spectrumAveragingComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Off", L"Linear", L"RMS", L"Peak Hold" }));
+	mp_spectrumAveragingComboBox->setState(p_spectrum->getAveraging());
+	mp_spectrumAveragingComboBox->setMargin(10.0f);
+	mp_spectrumAveragingComboBox->setPadding(10.0f);
+	connect<ComboBox, SpectrumAnalyzer, int>(p_spectrum, &SpectrumAnalyzer::setAveraging, mp_spectrumAveragingComboBox->onStateChanged);
+
+
+	mp_spectrumScaleLabel = new Label(mp_window, L"Frequency Axis");
+	mp_spectrumScaleLabel->setMargin(10.0f);
+	mp_spectrumScaleLabel->setPadding(10.0f);
+
+	mp_spectrumScaleComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Linear", L"Logarithmic" }));
+	mp_spectrumScaleComboBox->setState(mp_spectrumPlot->getXAxisScale());
+	mp_spectrumScaleComboBox->setMargin(10.0f);
+	mp_spectrumScaleComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setSpectrumScale, mp_spectrumScaleComboBox->onStateChanged);
+
+
+	mp_colorMapLabel = new Label(mp_window, L"Spectrogram Colors");
+	mp_colorMapLabel->setMargin(10.0f);
+	mp_colorMapLabel->setPadding(10.0f);
+
+	mp_colorMapComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Heat", L"Blue-Yellow", L"Gray" }));
+	mp_colorMapComboBox->setState(mp_osc->getSpectrogram()->getColorMap());
+	mp_colorMapComboBox->setMargin(10.0f);
+	mp_colorMapComboBox->setPadding(10.0f);
+	connect<ComboBox, Spectrogram, int>(mp_osc->getSpectrogram(), &Spectrogram::setColorMap, mp_colorMapComboBox->onStateChanged);
+
+
+	mp_spectrogramSaveLabel = new Label(mp_window, L"Spectrogram Image");
+	mp_spectrogramSaveLabel->setMargin(10.0f);
+	mp_spectrogramSaveLabel->setPadding(10.0f);
+
+	mp_spectrogramSaveButton = new Button(mp_window, L"Save PNG");
+	mp_spectrogramSaveButton->setMargin(10.0f);
+	mp_spectrogramSaveButton->setPadding(10.0f);
+	connect<Button, App>(this, &App::saveSpectrogram, mp_spectrogramSaveButton->onButtonClick);
+
+
+
+	mp_distortionChannelLabel = new Label(mp_window, L"Channel");
+	mp_distortionChannelLabel->setMargin(10.0f);
+	mp_distortionChannelLabel->setPadding(10.0f);
+
+	mp_distortionChannelComboBox = new ComboBox(mp_window, channelNames);
+	mp_distortionChannelComboBox->setState(mp_osc->getDistortionChannel());
+	mp_distortionChannelComboBox->setMargin(10.0f);
+	mp_distortionChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, Oscilloscope, int>(mp_osc, &Oscilloscope::setDistortionChannel, mp_distortionChannelComboBox->onStateChanged);
+
+
+	mp_fundamentalLabel = new Label(mp_window, L"Fundamental");
+	mp_fundamentalLabel->setMargin(10.0f);
+	mp_fundamentalLabel->setPadding(10.0f);
+
+	mp_fundamentalValueLabel = new Label(mp_window, L"-");
+	mp_fundamentalValueLabel->setMargin(10.0f);
+	mp_fundamentalValueLabel->setPadding(10.0f);
+
+
+	mp_thdLabel = new Label(mp_window, L"THD");
+	mp_thdLabel->setMargin(10.0f);
+	mp_thdLabel->setPadding(10.0f);
+
+	mp_thdValueLabel = new Label(mp_window, L"-");
+	mp_thdValueLabel->setMargin(10.0f);
+	mp_thdValueLabel->setPadding(10.0f);
+
+
+	mp_thdNLabel = new Label(mp_window, L"THD+N");
+	mp_thdNLabel->setMargin(10.0f);
+	mp_thdNLabel->setPadding(10.0f);
+
+	mp_thdNValueLabel = new Label(mp_window, L"-");
+	mp_thdNValueLabel->setMargin(10.0f);
+	mp_thdNValueLabel->setPadding(10.0f);
+
+
+	mp_sinadLabel = new Label(mp_window, L"SINAD");
+	mp_sinadLabel->setMargin(10.0f);
+	mp_sinadLabel->setPadding(10.0f);
+
+	mp_sinadValueLabel = new Label(mp_window, L"-");
+	mp_sinadValueLabel->setMargin(10.0f);
+	mp_sinadValueLabel->setPadding(10.0f);
+
+
+	mp_snrLabel = new Label(mp_window, L"SNR");
+	mp_snrLabel->setMargin(10.0f);
+	mp_snrLabel->setPadding(10.0f);
+
+	mp_snrValueLabel = new Label(mp_window, L"-");
+	mp_snrValueLabel->setMargin(10.0f);
+	mp_snrValueLabel->setPadding(10.0f);
+
+
+	mp_enobLabel = new Label(mp_window, L"ENOB");
+	mp_enobLabel->setMargin(10.0f);
+	mp_enobLabel->setPadding(10.0f);
+
+	mp_enobValueLabel = new Label(mp_window, L"-");
+	mp_enobValueLabel->setMargin(10.0f);
+	mp_enobValueLabel->setPadding(10.0f);
+
+	connect<DistortionAnalyzer, App>(this, &App::updateDistortion, mp_osc->getDistortionAnalyzer()->onResultUpdate);
+
+
+
+	mp_measureLabel = new Label(mp_window, L"Measurement");
+	mp_measureLabel->setMargin(10.0f);
+	mp_measureLabel->setPadding(10.0f);
+
+	mp_measureButton = new StateButton(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_measureButton->setState(mp_freqResponse->isMeasuring());
+	mp_measureButton->setMargin(10.0f);
+	mp_measureButton->setPadding(10.0f);
+	connect<StateButton, FrequencyResponse, int>(mp_freqResponse, &FrequencyResponse::enableMeasurement, mp_measureButton->onStateChanged);
+	connect<FrequencyResponse, StateButton, int>(mp_measureButton, &StateButton::setState, mp_freqResponse->onMeasurementChanged);
+
+
+	mp_startFrequencyLabel = new Label(mp_window, L"Start Frequency");
+	mp_startFrequencyLabel->setMargin(10.0f);
+	mp_startFrequencyLabel->setPadding(10.0f);
+
+	mp_startFrequencySlider = new Slider<float>(mp_window, mp_freqResponse->getStartFrequency(), 1, 20000);
+	mp_startFrequencySlider->setMargin(10.0f);
+	mp_startFrequencySlider->setPadding(10.0f);
+	mp_startFrequencySlider->setSuffix(L" Hz");
+	connect<Slider<float>, FrequencyResponse, float>(mp_freqResponse, &FrequencyResponse::setStartFrequency, mp_startFrequencySlider->onValueChanged);
+
+
+	mp_stopFrequencyLabel = new Label(mp_window, L"Stop Frequency");
+	mp_stopFrequencyLabel->setMargin(10.0f);
+	mp_stopFrequencyLabel->setPadding(10.0f);
+
+	mp_stopFrequencySlider = new Slider<float>(mp_window, mp_freqResponse->getStopFrequency(), 1, 20000);
+	mp_stopFrequencySlider->setMargin(10.0f);
+	mp_stopFrequencySlider->setPadding(10.0f);
+	mp_stopFrequencySlider->setSuffix(L" Hz");
+	connect<Slider<float>, FrequencyResponse, float>(mp_freqResponse, &FrequencyResponse::setStopFrequency, mp_stopFrequencySlider->onValueChanged);
+
+
+	mp_pointCountLabel = new Label(mp_window, L"Points");
+	mp_pointCountLabel->setMargin(10.0f);
+	mp_pointCountLabel->setPadding(10.0f);
+
+	mp_pointCountSlider = new Slider<int>(mp_window, mp_freqResponse->getPointCount(), 2, 256);
+	mp_pointCountSlider->setMargin(10.0f);
+	mp_pointCountSlider->setPadding(10.0f);
+	connect<Slider<int>, FrequencyResponse, int>(mp_freqResponse, &FrequencyResponse::setPointCount, mp_pointCountSlider->onValueChanged);
+
+
+	mp_bodeDisplayLabel = new Label(mp_window, L"Display");
+	mp_bodeDisplayLabel->setMargin(10.0f);
+	mp_bodeDisplayLabel->setPadding(10.0f);
+
+	mp_bodeDisplayComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Gain", L"Phase", L"Coherence" }));
+	mp_bodeDisplayComboBox->setMargin(10.0f);
+	mp_bodeDisplayComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setBodeDisplay, mp_bodeDisplayComboBox->onStateChanged);
+
+
+
+	mp_sweepMeasureLabel = new Label(mp_window, L"Measurement");
+	mp_sweepMeasureLabel->setMargin(10.0f);
+	mp_sweepMeasureLabel->setPadding(10.0f);
+
+	mp_sweepMeasureButton = new StateButton(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_sweepMeasureButton->setState(mp_impulseResponse->isMeasuring());
+	mp_sweepMeasureButton->setMargin(10.0f);
+	mp_sweepMeasureButton->setPadding(10.0f);
+	connect<StateButton, ImpulseResponse, int>(mp_impulseResponse, &ImpulseResponse::enableMeasurement, mp_sweepMeasureButton->onStateChanged);
+	connect<ImpulseResponse, StateButton, int>(mp_sweepMeasureButton, &StateButton::setState, mp_impulseResponse->onMeasurementChanged);
+
+
+	mp_sweepStartLabel = new Label(mp_window, L"Start Frequency");
+	mp_sweepStartLabel->setMargin(10.0f);
+	mp_sweepStartLabel->setPadding(10.0f);
+
+	mp_sweepStartSlider = new Slider<float>(mp_window, mp_impulseResponse->getStartFrequency(), 1, 20000);
+	mp_sweepStartSlider->setMargin(10.0f);
+	mp_sweepStartSlider->setPadding(10.0f);
+	mp_sweepStartSlider->setSuffix(L" Hz");
+	connect<Slider<float>, ImpulseResponse, float>(mp_impulseResponse, &ImpulseResponse::setStartFrequency, mp_sweepStartSlider->onValueChanged);
+
+
+	mp_sweepStopLabel = new Label(mp_window, L"Stop Frequency");
+	mp_sweepStopLabel->setMargin(10.0f);
+	mp_sweepStopLabel->setPadding(10.0f);
+
+	mp_sweepStopSlider = new Slider<float>(mp_window, mp_impulseResponse->getStopFrequency(), 1, 20000);
+	mp_sweepStopSlider->setMargin(10.0f);
+	mp_sweepStopSlider->setPadding(10.0f);
+	mp_sweepStopSlider->setSuffix(L" Hz");
+	connect<Slider<float>, ImpulseResponse, float>(mp_impulseResponse, &ImpulseResponse::setStopFrequency, mp_sweepStopSlider->onValueChanged);
+
+
+	mp_sweepDurationLabel = new Label(mp_window, L"Sweep Duration");
+	mp_sweepDurationLabel->setMargin(10.0f);
+	mp_sweepDurationLabel->setPadding(10.0f);
+
+	mp_sweepDurationSlider = new Slider<float>(mp_window, mp_impulseResponse->getSweepDuration(), 0.1f, IMPRESP_MAX_DURATION);
+	mp_sweepDurationSlider->setMargin(10.0f);
+	mp_sweepDurationSlider->setPadding(10.0f);
+	mp_sweepDurationSlider->setSuffix(L" s");
+	connect<Slider<float>, ImpulseResponse, float>(mp_impulseResponse, &ImpulseResponse::setSweepDuration, mp_sweepDurationSlider->onValueChanged);
+
+
+	mp_impulseDisplayLabel = new Label(mp_window, L"Display");
+	mp_impulseDisplayLabel->setMargin(10.0f);
+	mp_impulseDisplayLabel->setPadding(10.0f);
+
+	mp_impulseDisplayComboBox = new ComboBox(mp_window, std::vector<std::wstring>({ L"Impulse", L"Harmonics" }));
+	mp_impulseDisplayComboBox->setState(m_impulseDisplay);
+	mp_impulseDisplayComboBox->setMargin(10.0f);
+	mp_impulseDisplayComboBox->setPadding(10.0f);
+	connect<ComboBox, App, int>(this, &App::setImpulseDisplay, mp_impulseDisplayComboBox->onStateChanged);
+
+
+
+	mp_latencyMeasureLabel = new Label(mp_window, L"Measurement");
+	mp_latencyMeasureLabel->setMargin(10.0f);
+	mp_latencyMeasureLabel->setPadding(10.0f);
+
+	mp_latencyMeasureButton = new StateButton(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_latencyMeasureButton->setState(mp_latencyMeter->isMeasuring());
+	mp_latencyMeasureButton->setMargin(10.0f);
+	mp_latencyMeasureButton->setPadding(10.0f);
+	connect<StateButton, LatencyMeter, int>(mp_latencyMeter, &LatencyMeter::enableMeasurement, mp_latencyMeasureButton->onStateChanged);
+	connect<LatencyMeter, StateButton, int>(mp_latencyMeasureButton, &StateButton::setState, mp_latencyMeter->onMeasurementChanged);
+
+
+	mp_latencyChannelLabel = new Label(mp_window, L"Channel");
+	mp_latencyChannelLabel->setMargin(10.0f);
+	mp_latencyChannelLabel->setPadding(10.0f);
+
+	// markers are only located in captured channels
+	mp_latencyChannelComboBox = new ComboBox(mp_window, std::vector<std::wstring>(channelNames.begin(), channelNames.end() - 1));
+	mp_latencyChannelComboBox->setState(mp_latencyMeter->getChannel());
+	mp_latencyChannelComboBox->setMargin(10.0f);
+	mp_latencyChannelComboBox->setPadding(10.0f);
+	connect<ComboBox, LatencyMeter, int>(mp_latencyMeter, &LatencyMeter::setChannel, mp_latencyChannelComboBox->onStateChanged);
+
+
+	mp_latencyLabel = new Label(mp_window, L"Latency");
+	mp_latencyLabel->setMargin(10.0f);
+	mp_latencyLabel->setPadding(10.0f);
+
+	mp_latencyValueLabel = new Label(mp_window, L"-");
+	mp_latencyValueLabel->setMargin(10.0f);
+	mp_latencyValueLabel->setPadding(10.0f);
+
+
+	mp_driftLabel = new Label(mp_window, L"Drift");
+	mp_driftLabel->setMargin(10.0f);
+	mp_driftLabel->setPadding(10.0f);
+
+	mp_driftValueLabel = new Label(mp_window, L"-");
+	mp_driftValueLabel->setMargin(10.0f);
+	mp_driftValueLabel->setPadding(10.0f);
+
+
+	mp_markerCountLabel = new Label(mp_window, L"Markers");
+	mp_markerCountLabel->setMargin(10.0f);
+	mp_markerCountLabel->setPadding(10.0f);
+
+	mp_markerCountValueLabel = new Label(mp_window, L"0");
+	mp_markerCountValueLabel->setMargin(10.0f);
+	mp_markerCountValueLabel->setPadding(10.0f);
+
+
+	mp_clockCorrectionLabel = new Label(mp_window, L"Clock Correction");
+	mp_clockCorrectionLabel->setMargin(10.0f);
+	mp_clockCorrectionLabel->setPadding(10.0f);
+
+	mp_clockCorrectionButton = new StateButton(mp_window, std::vector<std::wstring>({ L"Off", L"On" }));
+	mp_clockCorrectionButton->setState(mp_latencyMeter->isCorrectionEnabled());
+	mp_clockCorrectionButton->setMargin(10.0f);
+	mp_clockCorrectionButton->setPadding(10.0f);
+	connect<StateButton, LatencyMeter, int>(mp_latencyMeter, &LatencyMeter::enableCorrection, mp_clockCorrectionButton->onStateChanged);
+
+	connect<LatencyMeter, App>(this, &App::updateLatency, mp_latencyMeter->onResultUpdate);
+	connect<Oscilloscope, LatencyMeter>(mp_latencyMeter, &LatencyMeter::restartFit, mp_osc->onDiscontinuity);
+
 	// create parameter GridLayouts
 	mp_sigGenLayout = new GridLayout(mp_window, 5, 2);
-	mp_oscLayout = new GridLayout(mp_window, 3, 2);
-	mp_freqResponseLayout = new GridLayout(mp_window, 4, 2);
+	mp_oscLayout = new GridLayout(mp_window, 10, 2);
+	mp_freqResponseLayout = new GridLayout(mp_window, 5, 2);
+	mp_spectrumLayout = new GridLayout(mp_window, 8, 2);
+	mp_impulseLayout = new GridLayout(mp_window, 5, 2);
+	mp_distortionLayout = new GridLayout(mp_window, 7, 2);
+	mp_measurementLayout = new GridLayout(mp_window, 11, 2);
+	mp_filterLayout = new GridLayout(mp_window, 5, 2);
+	mp_transferLayout = new GridLayout(mp_window, 7, 2);
+	mp_latencyLayout = new GridLayout(mp_window, 6, 2);
 
 	mp_sigGenLayout->addFrame(mp_enableSigGenLabel, 0, 0);
 	mp_sigGenLayout->addFrame(mp_enableSigGenButton, 0, 1);
@@ -221,6 +1210,136 @@ void App::initUI() {
 	mp_oscLayout->addFrame(mp_aquisitionModeComboBox, 1, 1);
 	mp_oscLayout->addFrame(mp_triggerLevelLabel, 2, 0);
 	mp_oscLayout->addFrame(mp_triggerLevelSlider, 2, 1);
+	mp_oscLayout->addFrame(mp_triggerSourceLabel, 3, 0);
+	mp_oscLayout->addFrame(mp_triggerSourceComboBox, 3, 1);
+	mp_oscLayout->addFrame(mp_mathModeLabel, 4, 0);
+	mp_oscLayout->addFrame(mp_mathModeComboBox, 4, 1);
+	mp_oscLayout->addFrame(mp_scaleChannelLabel, 5, 0);
+	mp_oscLayout->addFrame(mp_scaleChannelComboBox, 5, 1);
+	mp_oscLayout->addFrame(mp_channelScaleLabel, 6, 0);
+	mp_oscLayout->addFrame(mp_channelScaleSlider, 6, 1);
+	mp_oscLayout->addFrame(mp_segmentLabel, 7, 0);
+	mp_oscLayout->addFrame(mp_segmentSlider, 7, 1);
+	mp_oscLayout->addFrame(mp_segmentViewLabel, 8, 0);
+	mp_oscLayout->addFrame(mp_segmentViewComboBox, 8, 1);
+	mp_oscLayout->addFrame(mp_persistenceLabel, 9, 0);
+	mp_oscLayout->addFrame(mp_persistenceComboBox, 9, 1);
+
+	mp_measurementLayout->addFrame(mp_measurementChannelLabel, 0, 0);
+	mp_measurementLayout->addFrame(mp_measurementChannelComboBox, 0, 1);
+	mp_measurementLayout->addFrame(mp_measuredFrequencyLabel, 1, 0);
+	mp_measurementLayout->addFrame(mp_measuredFrequencyValueLabel, 1, 1);
+	mp_measurementLayout->addFrame(mp_measuredPeriodLabel, 2, 0);
+	mp_measurementLayout->addFrame(mp_measuredPeriodValueLabel, 2, 1);
+	mp_measurementLayout->addFrame(mp_peakToPeakLabel, 3, 0);
+	mp_measurementLayout->addFrame(mp_peakToPeakValueLabel, 3, 1);
+	mp_measurementLayout->addFrame(mp_rmsLabel, 4, 0);
+	mp_measurementLayout->addFrame(mp_rmsValueLabel, 4, 1);
+	mp_measurementLayout->addFrame(mp_meanLabel, 5, 0);
+	mp_measurementLayout->addFrame(mp_meanValueLabel, 5, 1);
+	mp_measurementLayout->addFrame(mp_riseTimeLabel, 6, 0);
+	mp_measurementLayout->addFrame(mp_riseTimeValueLabel, 6, 1);
+	mp_measurementLayout->addFrame(mp_fallTimeLabel, 7, 0);
+	mp_measurementLayout->addFrame(mp_fallTimeValueLabel, 7, 1);
+	mp_measurementLayout->addFrame(mp_measuredDutyCycleLabel, 8, 0);
+	mp_measurementLayout->addFrame(mp_measuredDutyCycleValueLabel, 8, 1);
+	mp_measurementLayout->addFrame(mp_acquisitionCountLabel, 9, 0);
+	mp_measurementLayout->addFrame(mp_acquisitionCountValueLabel, 9, 1);
+	mp_measurementLayout->addFrame(mp_statisticsLabel, 10, 0);
+	mp_measurementLayout->addFrame(mp_resetStatisticsButton, 10, 1);
+
+	mp_filterLayout->addFrame(mp_filterTypeLabel, 0, 0);
+	mp_filterLayout->addFrame(mp_filterTypeComboBox, 0, 1);
+	mp_filterLayout->addFrame(mp_filterResponseLabel, 1, 0);
+	mp_filterLayout->addFrame(mp_filterResponseComboBox, 1, 1);
+	mp_filterLayout->addFrame(mp_filterFrequencyLabel, 2, 0);
+	mp_filterLayout->addFrame(mp_filterFrequencySlider, 2, 1);
+	mp_filterLayout->addFrame(mp_filterOrderLabel, 3, 0);
+	mp_filterLayout->addFrame(mp_filterOrderSlider, 3, 1);
+	mp_filterLayout->addFrame(mp_filterTapsLabel, 4, 0);
+	mp_filterLayout->addFrame(mp_filterTapsSlider, 4, 1);
+
+	mp_spectrumLayout->addFrame(mp_spectrumChannelLabel, 0, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumChannelComboBox, 0, 1);
+	mp_spectrumLayout->addFrame(mp_spectrumSizeLabel, 1, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumSizeComboBox, 1, 1);
+	mp_spectrumLayout->addFrame(mp_spectrumWindowLabel, 2, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumWindowComboBox, 2, 1);
+	mp_spectrumLayout->addFrame(mp_spectrumOverlapLabel, 3, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumOverlapComboBox, 3, 1);
+	mp_spectrumLayout->addFrame(mp_spectrumAveragingLabel, 4, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumAveragingComboBox, 4, 1);
+	mp_spectrumLayout->addFrame(mp_spectrumScaleLabel, 5, 0);
+	mp_spectrumLayout->addFrame(mp_spectrumScaleComboBox, 5, 1);
+	mp_spectrumLayout->addFrame(mp_colorMapLabel, 6, 0);
+	mp_spectrumLayout->addFrame(mp_colorMapComboBox, 6, 1);
+	mp_spectrumLayout->addFrame(mp_spectrogramSaveLabel, 7, 0);
+	mp_spectrumLayout->addFrame(mp_spectrogramSaveButton, 7, 1);
+
+	mp_distortionLayout->addFrame(mp_distortionChannelLabel, 0, 0);
+	mp_distortionLayout->addFrame(mp_distortionChannelComboBox, 0, 1);
+	mp_distortionLayout->addFrame(mp_fundamentalLabel, 1, 0);
+	mp_distortionLayout->addFrame(mp_fundamentalValueLabel, 1, 1);
+	mp_distortionLayout->addFrame(mp_thdLabel, 2, 0);
+	mp_distortionLayout->addFrame(mp_thdValueLabel, 2, 1);
+	mp_distortionLayout->addFrame(mp_thdNLabel, 3, 0);
+	mp_distortionLayout->addFrame(mp_thdNValueLabel, 3, 1);
+	mp_distortionLayout->addFrame(mp_sinadLabel, 4, 0);
+	mp_distortionLayout->addFrame(mp_sinadValueLabel, 4, 1);
+	mp_distortionLayout->addFrame(mp_snrLabel, 5, 0);
+	mp_distortionLayout->addFrame(mp_snrValueLabel, 5, 1);
+	mp_distortionLayout->addFrame(mp_enobLabel, 6, 0);
+	mp_distortionLayout->addFrame(mp_enobValueLabel, 6, 1);
+
+	mp_freqResponseLayout->addFrame(mp_measureLabel, 0, 0);
+	mp_freqResponseLayout->addFrame(mp_measureButton, 0, 1);
+	mp_freqResponseLayout->addFrame(mp_startFrequencyLabel, 1, 0);
+	mp_freqResponseLayout->addFrame(mp_startFrequencySlider, 1, 1);
+	mp_freqResponseLayout->addFrame(mp_stopFrequencyLabel, 2, 0);
+	mp_freqResponseLayout->addFrame(mp_stopFrequencySlider, 2, 1);
+	mp_freqResponseLayout->addFrame(mp_pointCountLabel, 3, 0);
+	mp_freqResponseLayout->addFrame(mp_pointCountSlider, 3, 1);
+	mp_freqResponseLayout->addFrame(mp_bodeDisplayLabel, 4, 0);
+	mp_freqResponseLayout->addFrame(mp_bodeDisplayComboBox, 4, 1);
+
+	mp_transferLayout->addFrame(mp_transferEnableLabel, 0, 0);
+	mp_transferLayout->addFrame(mp_transferEnableButton, 0, 1);
+	mp_transferLayout->addFrame(mp_transferReferenceLabel, 1, 0);
+	mp_transferLayout->addFrame(mp_transferReferenceComboBox, 1, 1);
+	mp_transferLayout->addFrame(mp_transferChannelLabel, 2, 0);
+	mp_transferLayout->addFrame(mp_transferChannelComboBox, 2, 1);
+	mp_transferLayout->addFrame(mp_estimatorLabel, 3, 0);
+	mp_transferLayout->addFrame(mp_estimatorComboBox, 3, 1);
+	mp_transferLayout->addFrame(mp_transferAveragesLabel, 4, 0);
+	mp_transferLayout->addFrame(mp_transferAveragesSlider, 4, 1);
+	mp_transferLayout->addFrame(mp_delayLabel, 5, 0);
+	mp_transferLayout->addFrame(mp_delayValueLabel, 5, 1);
+	mp_transferLayout->addFrame(mp_transferResetLabel, 6, 0);
+	mp_transferLayout->addFrame(mp_transferResetButton, 6, 1);
+
+	mp_latencyLayout->addFrame(mp_latencyMeasureLabel, 0, 0);
+	mp_latencyLayout->addFrame(mp_latencyMeasureButton, 0, 1);
+	mp_latencyLayout->addFrame(mp_latencyChannelLabel, 1, 0);
+	mp_latencyLayout->addFrame(mp_latencyChannelComboBox, 1, 1);
+	mp_latencyLayout->addFrame(mp_latencyLabel, 2, 0);
+	mp_latencyLayout->addFrame(mp_latencyValueLabel, 2, 1);
+	mp_latencyLayout->addFrame(mp_driftLabel, 3, 0);
+	mp_latencyLayout->addFrame(mp_driftValueLabel, 3, 1);
+	mp_latencyLayout->addFrame(mp_markerCountLabel, 4, 0);
+	mp_latencyLayout->addFrame(mp_markerCountValueLabel, 4, 1);
+	mp_latencyLayout->addFrame(mp_clockCorrectionLabel, 5, 0);
+	mp_latencyLayout->addFrame(mp_clockCorrectionButton, 5, 1);
+
+	mp_impulseLayout->addFrame(mp_sweepMeasureLabel, 0, 0);
+	mp_impulseLayout->addFrame(mp_sweepMeasureButton, 0, 1);
+	mp_impulseLayout->addFrame(mp_sweepStartLabel, 1, 0);
+	mp_impulseLayout->addFrame(mp_sweepStartSlider, 1, 1);
+	mp_impulseLayout->addFrame(mp_sweepStopLabel, 2, 0);
+	mp_impulseLayout->addFrame(mp_sweepStopSlider, 2, 1);
+	mp_impulseLayout->addFrame(mp_sweepDurationLabel, 3, 0);
+	mp_impulseLayout->addFrame(mp_sweepDurationSlider, 3, 1);
+	mp_impulseLayout->addFrame(mp_impulseDisplayLabel, 4, 0);
+	mp_impulseLayout->addFrame(mp_impulseDisplayComboBox, 4, 1);
 
 	// create GroupBoxes
 	mp_sigGenGroup = new GroupBox(mp_window, mp_sigGenLayout, L"Signal Generator");
@@ -235,6 +1354,34 @@ void App::initUI() {
 	mp_freqResponseGroup->setMargin(10.0f);
 	mp_freqResponseGroup->setPadding(10.0f);
 
+	mp_measurementGroup = new GroupBox(mp_window, mp_measurementLayout, L"Measurements");
+	mp_measurementGroup->setMargin(10.0f);
+	mp_measurementGroup->setPadding(10.0f);
+
+	mp_filterGroup = new GroupBox(mp_window, mp_filterLayout, L"Filter");
+	mp_filterGroup->setMargin(10.0f);
+	mp_filterGroup->setPadding(10.0f);
+
+	mp_spectrumGroup = new GroupBox(mp_window, mp_spectrumLayout, L"Spectrum");
+	mp_spectrumGroup->setMargin(10.0f);
+	mp_spectrumGroup->setPadding(10.0f);
+
+	mp_distortionGroup = new GroupBox(mp_window, mp_distortionLayout, L"Distortion");
+	mp_distortionGroup->setMargin(10.0f);
+	mp_distortionGroup->setPadding(10.0f);
+
+	mp_transferGroup = new GroupBox(mp_window, mp_transferLayout, L"Transfer Function");
+	mp_transferGroup->setMargin(10.0f);
+	mp_transferGroup->setPadding(10.0f);
+
+	mp_impulseGroup = new GroupBox(mp_window, mp_impulseLayout, L"Impulse Response");
+	mp_impulseGroup->setMargin(10.0f);
+	mp_impulseGroup->setPadding(10.0f);
+
+	mp_latencyGroup = new GroupBox(mp_window, mp_latencyLayout, L"Latency");
+	mp_latencyGroup->setMargin(10.0f);
+	mp_latencyGroup->setPadding(10.0f);
+
 	// create Layouts
 	mp_mainLayout = new LinearLayout(mp_window, Orientation::Horizontal);
 
@@ -248,13 +1395,23 @@ void App::initUI() {
 
 	// add to Layouts
 	mp_vertPlotLayout->addFrame(mp_oscPlot);
+	mp_vertPlotLayout->addFrame(mp_spectrumPlot);
 	mp_vertPlotLayout->addFrame(mp_horPlotLayout);
 	mp_horPlotLayout->addFrame(mp_sigGenPlot);
+	mp_horPlotLayout->addFrame(mp_spectrogramPlot);
 	mp_horPlotLayout->addFrame(mp_bode);
+	mp_horPlotLayout->addFrame(mp_impulsePlot);
 
 	mp_parameterLayout->addFrame(mp_sigGenGroup);
 	mp_parameterLayout->addFrame(mp_oscGroup);
+	mp_parameterLayout->addFrame(mp_filterGroup);
+	mp_parameterLayout->addFrame(mp_measurementGroup);
+	mp_parameterLayout->addFrame(mp_spectrumGroup);
+	mp_parameterLayout->addFrame(mp_distortionGroup);
 	mp_parameterLayout->addFrame(mp_freqResponseGroup);
+	mp_parameterLayout->addFrame(mp_transferGroup);
+	mp_parameterLayout->addFrame(mp_impulseGroup);
+	mp_parameterLayout->addFrame(mp_latencyGroup);
 
 	mp_mainLayout->addFrame(mp_vertPlotLayout);
 	mp_mainLayout->addFrame(mp_parameterLayout);
@@ -263,6 +1420,315 @@ void App::initUI() {
 	mp_window->setLayout(mp_mainLayout);
 }
 
+void App::setOscBounds(float lower, float upper) {
+
+	for (PlotSeries1D* p_series : mp_oscPlotSeries) {
+		p_series->setBounds(lower, upper);
+	}
+
+	mp_persistenceSeries->setXBounds(lower, upper);
+}
+
+void App::setMathMode(int mode) {
+
+	mp_osc->setMathMode(mode);
+
+	// show math channel only if it is enabled
+	mp_oscPlotSeries.back()->setVisible(mode != 0);
+}
+
+void App::setPersistence(int persistence) {
+
+	mp_osc->setPersistence(persistence);
+
+	// show persistence image only if it is enabled
+	mp_persistenceSeries->setVisible(persistence != 0);
+}
+
+void App::setSpectrumSize(int state) {
+
+	// sizes start at 1024 samples
+	mp_osc->getSpectrumAnalyzer()->setSize(1024 << state);
+}
+
+void App::setSpectrumOverlap(int state) {
+
+	const int overlaps[3] = { 0, 50, 75 };
+	mp_osc->getSpectrumAnalyzer()->setOverlap(overlaps[state]);
+}
+
+void App::setSpectrumScale(int scale) {
+
+	mp_spectrumPlot->setXAxisScale((AxisScale)scale);
+
+	// zero can't be shown on a logarithmic axis
+	float lower = scale == AxisScale::Logarithmic ? 20.0f : 0.0f;
+	mp_spectrumPlot->setPlotXBounds(lower, mp_osc->getSpectrumAnalyzer()->getSampleRate() / 2);
+
+	mp_spectrumPlotSeries->onUpdate();
+}
+
+void App::updateSpectrum() {
+
+	SpectrumAnalyzer* p_spectrum = mp_osc->getSpectrumAnalyzer();
+
+	// the number of bins changes with the size
+	mp_spectrumPlotSeries->setData(p_spectrum->getFrequencyData(), p_spectrum->getPlotData(), p_spectrum->getPlotDataSize());
+	mp_spectrumPlotSeries->onUpdate();
+}
+
+void App::updateSpectrogram(int first, int count) {
+
+	// only the new columns are uploaded, the offset scrolls the image
+	mp_spectrogramSeries->updateColumns(first, count);
+	mp_spectrogramSeries->setOffset(mp_osc->getSpectrogram()->getOffset());
+}
+
+void App::saveSpectrogram() {
+
+	mp_osc->getSpectrogram()->savePNG(L"spectrogram.png");
+}
+
+void App::setBodeBounds(float lower, float upper) {
+
+	// the frequencies of the plot points changed
+	mp_gainPlotSeries->invalidateXData();
+	mp_phasePlotSeries->invalidateXData();
+	mp_transferGainSeries->invalidateXData();
+	mp_transferPhaseSeries->invalidateXData();
+	mp_coherenceSeries->invalidateXData();
+
+	mp_bode->setPlotXBounds(lower, upper);
+}
+
+void App::setBodeDisplay(int display) {
+
+	m_bodeDisplay = display;
+
+	// gain and phase share the plot, only one of them is shown (the coherence only exists for the transfer function)
+	bool transfer = mp_osc->getTransferAnalyzer()->isEnabled();
+
+	mp_gainPlotSeries->setVisible(display == 0);
+	mp_phasePlotSeries->setVisible(display == 1);
+	mp_transferGainSeries->setVisible(transfer && display == 0);
+	mp_transferPhaseSeries->setVisible(transfer && display == 1);
+	mp_coherenceSeries->setVisible(transfer && display == 2);
+
+	if (display == 1) {
+		mp_bode->setYUnit(Unit::Degree);
+		mp_bode->setPlotYBounds(180.0f, -180.0f);
+	}
+	else {
+		mp_bode->setYUnit(Unit::Decibel);
+		mp_bode->setPlotYBounds(display == 0 ? 20.0f : 5.0f, display == 0 ? -80.0f : -40.0f);
+	}
+}
+
+void App::enableTransferAnalysis(int enable) {
+
+	mp_osc->getTransferAnalyzer()->enableAnalysis(enable);
+
+	if (!enable) {
+		mp_delayValueLabel->setText(L"-");
+	}
+
+	setBodeDisplay(m_bodeDisplay);
+}
+
+void App::updateTransferFunction() {
+
+	mp_transferGainSeries->onUpdate();
+	mp_transferPhaseSeries->onUpdate();
+	mp_coherenceSeries->onUpdate();
+
+	mp_delayValueLabel->setText(formatValue(mp_osc->getTransferAnalyzer()->getDelay(), Unit::Second));
+}
+
+void App::updateImpulseResponse() {
+
+	// the length of the impulse response and the excitation frequencies change with every measurement
+	mp_impulsePlotSeries->setData(mp_impulseResponse->getTimeData(), mp_impulseResponse->getImpulseData(),
+		mp_impulseResponse->getImpulseDataSize());
+
+	mp_harmonicPlotSeries->invalidateXData();
+
+	setImpulseDisplay(m_impulseDisplay);
+}
+
+void App::setImpulseDisplay(int display) {
+
+	m_impulseDisplay = display;
+
+	// impulse and harmonic levels share the plot, only one of them is shown
+	mp_impulsePlotSeries->setVisible(display == 0);
+
+	mp_harmonicPlotSeries->setVisible(display == 1);
+
+	if (display == 0) {
+
+		int size = mp_impulseResponse->getImpulseDataSize();
+		float* p_time = mp_impulseResponse->getTimeData();
+
+		mp_impulsePlot->setXAxisScale(AxisScale::Linear);
+		mp_impulsePlot->setXUnit(Unit::Second);
+		mp_impulsePlot->setYUnit(Unit::Volts);
+		mp_impulsePlot->setPlotXBounds(size > 0 ? p_time[0] : 0.0f, size > 0 ? p_time[size - 1] : IMPRESP_TAIL_TIME);
+		mp_impulsePlot->setPlotYBounds(1.0f, -1.0f);
+	}
+	else {
+
+		float* p_frequencies = mp_impulseResponse->getFrequencyData();
+
+		mp_impulsePlot->setXAxisScale(AxisScale::Logarithmic);
+		mp_impulsePlot->setXUnit(Unit::Hertz);
+		mp_impulsePlot->setYUnit(Unit::Decibel);
+		mp_impulsePlot->setPlotXBounds(p_frequencies[0], p_frequencies[mp_impulseResponse->getPlotDataSize() - 1]);
+		mp_impulsePlot->setPlotYBounds(20.0f, -120.0f);
+	}
+
+	mp_impulsePlotSeries->onUpdate();
+
+	mp_harmonicPlotSeries->onUpdate();
+}
+
+void App::updateDistortion() {
+
+	DistortionResult result = mp_osc->getDistortionAnalyzer()->getResult();
+
+	// without a fundamental there is nothing to show
+	if (!result.valid) {
+
+		mp_fundamentalValueLabel->setText(L"-");
+		mp_thdValueLabel->setText(L"-");
+		mp_thdNValueLabel->setText(L"-");
+		mp_sinadValueLabel->setText(L"-");
+		mp_snrValueLabel->setText(L"-");
+		mp_enobValueLabel->setText(L"-");
+		return;
+	}
+
+	std::wstringstream fundamental, thd, thdN, sinad, snr, enob;
+
+	fundamental << std::fixed << std::setprecision(2) << result.frequency << L" Hz, " << std::setprecision(3) << result.amplitude << L" V";
+
+	// distortion is given in percent and in dB
+	thd << std::setprecision(3) << 100.0f * powf(10.0f, result.thd / 20.0f) << L" % (" << std::fixed << std::setprecision(1) << result.thd << L" dB)";
+	thdN << std::setprecision(3) << 100.0f * powf(10.0f, result.thdN / 20.0f) << L" % (" << std::fixed << std::setprecision(1) << result.thdN << L" dB)";
+
+	sinad << std::fixed << std::setprecision(1) << result.sinad << L" dB";
+	snr << std::fixed << std::setprecision(1) << result.snr << L" dB";
+	enob << std::fixed << std::setprecision(2) << result.enob << L" bit";
+
+	mp_fundamentalValueLabel->setText(fundamental.str());
+	mp_thdValueLabel->setText(thd.str());
+	mp_thdNValueLabel->setText(thdN.str());
+	mp_sinadValueLabel->setText(sinad.str());
+	mp_snrValueLabel->setText(snr.str());
+	mp_enobValueLabel->setText(enob.str());
+}
+
+void App::updateMeasurements() {
+
+	WaveformMeasurements* p_measurements = mp_osc->getMeasurements();
+	MeasurementResult result = p_measurements->getResult();
+
+	// units of all measurements (the duty cycle is given in percent)
+	Unit units[MEASUREMENT_COUNT] = { Unit::Hertz, Unit::Second, Unit::Volts, Unit::Volts, Unit::Volts, Unit::Second, Unit::Second, Unit::Volts };
+
+	std::wstring texts[MEASUREMENT_COUNT];
+
+	for (int m = 0; m < MEASUREMENT_COUNT; ++m) {
+
+		if (!result.valid[m]) {
+			texts[m] = L"-";
+			continue;
+		}
+
+		RunningStatistics* p_statistics = p_measurements->getStatistics(m);
+
+		// latest value followed by mean and standard deviation of all acquisitions
+		if (m == Measurement::DutyCycle) {
+
+			std::wstringstream text;
+			text << std::fixed << std::setprecision(1) << result.values[m] << L" % (" << p_statistics->getMean() << L" \u00B1 " << p_statistics->getStandardDeviation() << L" %)";
+			texts[m] = text.str();
+		}
+		else {
+			texts[m] = formatValue(result.values[m], units[m]) + L" (" + formatValue(p_statistics->getMean(), units[m]) + L" \u00B1 " + formatValue(p_statistics->getStandardDeviation(), units[m]) + L")";
+		}
+	}
+
+	mp_measuredFrequencyValueLabel->setText(texts[Measurement::Frequency]);
+	mp_measuredPeriodValueLabel->setText(texts[Measurement::Period]);
+	mp_peakToPeakValueLabel->setText(texts[Measurement::PeakToPeak]);
+	mp_rmsValueLabel->setText(texts[Measurement::RMS]);
+	mp_meanValueLabel->setText(texts[Measurement::Mean]);
+	mp_riseTimeValueLabel->setText(texts[Measurement::RiseTime]);
+	mp_fallTimeValueLabel->setText(texts[Measurement::FallTime]);
+	mp_measuredDutyCycleValueLabel->setText(texts[Measurement::DutyCycle]);
+
+	// the peak to peak value is measured in every acquisition
+	mp_acquisitionCountValueLabel->setText(std::to_wstring(p_measurements->getStatistics(Measurement::PeakToPeak)->getCount()));
+}
+
+void App::updateLatency() {
+
+	RunningStatistics* p_statistics = mp_latencyMeter->getStatistics();
+
+	// latest latency followed by mean and standard deviation (jitter) of all markers
+	if (p_statistics->getCount() > 0) {
+		mp_latencyValueLabel->setText(formatValue(mp_latencyMeter->getLatency(), Unit::Second) + L" (" + formatValue(p_statistics->getMean(), Unit::Second) +
+			L" \u00B1 " + formatValue(p_statistics->getStandardDeviation(), Unit::Second) + L")");
+	}
+	else {
+		mp_latencyValueLabel->setText(L"-");
+	}
+
+	// the drift needs two markers
+	if (mp_latencyMeter->getMarkerCount() > 1) {
+
+		std::wstringstream text;
+		text << std::showpos << std::fixed << std::setprecision(2) << mp_latencyMeter->getDrift() << L" ppm";
+		mp_driftValueLabel->setText(text.str());
+	}
+	else {
+		mp_driftValueLabel->setText(L"-");
+	}
+
+	mp_markerCountValueLabel->setText(std::to_wstring(mp_latencyMeter->getMarkerCount()) + L" (" + std::to_wstring(mp_latencyMeter->getLostCount()) + L" lost)");
+}
+
+std::wstring App::formatValue(double value, Unit unit) {
+
+	// pick the engineering prefix of the magnitude (n to T)
+	int prefix = 3;
+
+	if (value != 0.0) {
+		prefix = (int)floor(log10(fabs(value)) / 3.0) + 3;
+		prefix = min(max(prefix, 0), 7);
+	}
+
+	std::wstringstream text;
+	text << std::setprecision(4) << value / pow(1000.0, prefix - 3) << L" ";
+
+	if (prefix != 3) {
+		text << unit_prefixes[prefix];
+	}
+
+	text << unit_symbols[unit];
+	return text.str();
+}
+
+void App::setScaleChannel(int channel) {
+
+	m_scaleChannel = channel;
+}
+
+void App::setChannelScale(float scale) {
+
+	mp_osc->setChannelScale(m_scaleChannel, scale);
+}
+
 std::wstring App::getApplicationName() {
 	return TEXT(PROJECT_NAME);
 }
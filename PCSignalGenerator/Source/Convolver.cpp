@@ -0,0 +1,108 @@
+#include "Gui.h"
+#include "Convolver.h"
+#include "FFT.h"
+
+#include <bit>
+#include <string.h>
+
+Convolver::Convolver(float* pa_kernel, int kernelSize) : m_kernelSize(max(kernelSize, 1)) {
+
+	// twice the kernel size keeps the number of blocks (and FFTs) per input sample low,
+	// the size must match the plan (which is at least 4)
+	m_fftSize = std::bit_ceil((unsigned int)max(2 * m_kernelSize, 4));
+	m_blockSize = m_fftSize - m_kernelSize + 1;
+
+	// transform zero padded kernel
+	FFT& fft = FFT::getPlan(m_fftSize);
+
+	std::vector<float> kernel(m_fftSize, 0.0f);
+	memcpy(kernel.data(), pa_kernel, kernelSize * sizeof(float));
+
+	m_kernelSpectrum.resize(fft.getBinCount());
+	fft.transform(kernel.data(), m_kernelSpectrum.data());
+
+	// buffers of the stream
+	m_tail.resize(m_kernelSize - 1, 0.0f);
+	m_block.resize(m_fftSize);
+	m_spectrum.resize(fft.getBinCount());
+}
+
+void Convolver::convolve(float* pa_src, int size, float* pa_dst) {
+
+	FFT& fft = FFT::getPlan(m_fftSize);
+
+	int outputSize = getOutputSize(size);
+	memset(pa_dst, 0, outputSize * sizeof(float));
+
+	std::vector<float> block(m_fftSize);
+	std::vector<std::complex<float>> spectrum(fft.getBinCount());
+
+	for (int first = 0; first < size; first += m_blockSize) {
+
+		// zero padding leaves room for the tail, that way the circular convolution is linear
+		int nSamples = min(m_blockSize, size - first);
+
+		memcpy(block.data(), pa_src + first, nSamples * sizeof(float));
+		memset(block.data() + nSamples, 0, (m_fftSize - nSamples) * sizeof(float));
+
+		fft.transform(block.data(), spectrum.data());
+
+		for (int k = 0; k < (int)spectrum.size(); ++k) {
+			spectrum[k] *= m_kernelSpectrum[k];
+		}
+
+		fft.inverse(spectrum.data(), block.data());
+
+		// add block with its tail overlapping the next blocks
+		int nOutput = min(nSamples + m_kernelSize - 1, outputSize - first);
+
+		for (int i = 0; i < nOutput; ++i) {
+			pa_dst[first + i] += block[i];
+		}
+	}
+}
+
+void Convolver::process(float* pa_data, int size) {
+
+	FFT& fft = FFT::getPlan(m_fftSize);
+
+	for (int first = 0; first < size; first += m_blockSize) {
+
+		int nSamples = min(m_blockSize, size - first);
+
+		memcpy(m_block.data(), pa_data + first, nSamples * sizeof(float));
+		memset(m_block.data() + nSamples, 0, (m_fftSize - nSamples) * sizeof(float));
+
+		fft.transform(m_block.data(), m_spectrum.data());
+
+		for (int k = 0; k < (int)m_spectrum.size(); ++k) {
+			m_spectrum[k] *= m_kernelSpectrum[k];
+		}
+
+		fft.inverse(m_spectrum.data(), m_block.data());
+
+		// add the tail of the earlier blocks
+		for (int i = 0; i < m_kernelSize - 1; ++i) {
+			m_block[i] += m_tail[i];
+		}
+
+		// the block is complete up to the input size, the rest is the new tail
+		memcpy(pa_data + first, m_block.data(), nSamples * sizeof(float));
+		memcpy(m_tail.data(), m_block.data() + nSamples, (m_kernelSize - 1) * sizeof(float));
+	}
+}
+
+int Convolver::getOutputSize(int size) {
+
+	return size + m_kernelSize - 1;
+}
+
+int Convolver::getKernelSize() {
+
+	return m_kernelSize;
+}
+
+int Convolver::getBlockSize() {
+
+	return m_blockSize;
+}
\ No newline at end of file
@@ -0,0 +1,498 @@
+#include "Gui.h"
+#include "DSPUtils.h"
+
+#include <immintrin.h>
+#include <string.h>
+#include <math.h>
+#include <numbers>
+#include <vector>
+#include <bit>
+
+void DSP::deinterleave(float* pa_src, int nChannels, int nFrames, float** pa_dst) {
+
+	int i = 0;
+
+	switch (nChannels) {
+
+	case 1: { // mono (nothing to split)
+
+		memcpy(pa_dst[0], pa_src, nFrames * sizeof(float));
+		return;
+	}
+	case 2: { // stereo (split even and odd lanes of two vectors)
+
+		for (; i + 4 <= nFrames; i += 4) {
+
+			__m128 a = _mm_loadu_ps(pa_src + 2 * i);
+			__m128 b = _mm_loadu_ps(pa_src + 2 * i + 4);
+
+			_mm_storeu_ps(pa_dst[0] + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(pa_dst[1] + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+		break;
+	}
+	default: { // multiples of four channels (transpose 4x4 blocks of frames and channels)
+
+		if (nChannels % 4 != 0) {
+			break;
+		}
+
+		for (; i + 4 <= nFrames; i += 4) {
+
+			for (int c = 0; c < nChannels; c += 4) {
+
+				float* p_block = pa_src + nChannels * i + c;
+
+				__m128 r0 = _mm_loadu_ps(p_block);
+				__m128 r1 = _mm_loadu_ps(p_block + nChannels);
+				__m128 r2 = _mm_loadu_ps(p_block + 2 * nChannels);
+				__m128 r3 = _mm_loadu_ps(p_block + 3 * nChannels);
+
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+				_mm_storeu_ps(pa_dst[c] + i, r0);
+				_mm_storeu_ps(pa_dst[c + 1] + i, r1);
+				_mm_storeu_ps(pa_dst[c + 2] + i, r2);
+				_mm_storeu_ps(pa_dst[c + 3] + i, r3);
+			}
+		}
+		break;
+	}
+	}
+
+	// copy remaining frames (and all other channel counts) one by one
+	for (; i < nFrames; ++i) {
+		for (int c = 0; c < nChannels; ++c) {
+			pa_dst[c][i] = pa_src[nChannels * i + c];
+		}
+	}
+}
+
+void DSP::reduce(float* pa_src, int size, float& minValue, float& maxValue, double& sum, double& sumSquares) {
+
+	sum = 0.0;
+	sumSquares = 0.0;
+
+	if (size <= 0) {
+		minValue = 0.0f;
+		maxValue = 0.0f;
+		return;
+	}
+
+	__m128 minVector = _mm_set1_ps(pa_src[0]);
+	__m128 maxVector = minVector;
+
+	int i = 0;
+
+	// float sums lose precision over long records, so the vector sums are
+	// added to the double sums after every block
+	while (i + 4 <= size) {
+
+		__m128 sumVector = _mm_setzero_ps();
+		__m128 squareVector = _mm_setzero_ps();
+
+		int end = min(i + 4096, size - size % 4);
+
+		for (; i < end; i += 4) {
+
+			__m128 x = _mm_loadu_ps(pa_src + i);
+
+			minVector = _mm_min_ps(minVector, x);
+			maxVector = _mm_max_ps(maxVector, x);
+			sumVector = _mm_add_ps(sumVector, x);
+			squareVector = _mm_add_ps(squareVector, _mm_mul_ps(x, x));
+		}
+
+		float a_sum[4];
+		float a_square[4];
+		_mm_storeu_ps(a_sum, sumVector);
+		_mm_storeu_ps(a_square, squareVector);
+
+		sum += (double)a_sum[0] + a_sum[1] + a_sum[2] + a_sum[3];
+		sumSquares += (double)a_square[0] + a_square[1] + a_square[2] + a_square[3];
+	}
+
+	// combine lanes
+	float a_min[4];
+	float a_max[4];
+	_mm_storeu_ps(a_min, minVector);
+	_mm_storeu_ps(a_max, maxVector);
+
+	minValue = min(min(a_min[0], a_min[1]), min(a_min[2], a_min[3]));
+	maxValue = max(max(a_max[0], a_max[1]), max(a_max[2], a_max[3]));
+
+	// remaining samples one by one
+	for (; i < size; ++i) {
+
+		minValue = min(minValue, pa_src[i]);
+		maxValue = max(maxValue, pa_src[i]);
+		sum += pa_src[i];
+		sumSquares += (double)pa_src[i] * pa_src[i];
+	}
+}
+
+
+float DSP::interpolate(float* pa_src, double t) {
+
+	int n0 = (int)floor(t);
+	double sum = 0.0;
+
+	for (int n = n0 - DSP_SINC_HALF_WIDTH + 1; n <= n0 + DSP_SINC_HALF_WIDTH; ++n) {
+
+		double d = t - n;
+		double x = std::numbers::pi * d;
+
+		// sinc kernel tapered by a Blackman window
+		double sinc = fabs(d) < 1e-9 ? 1.0 : sin(x) / x;
+		double window = 0.42 + 0.5 * cos(x / DSP_SINC_HALF_WIDTH) + 0.08 * cos(2.0 * x / DSP_SINC_HALF_WIDTH);
+
+		sum += pa_src[n] * sinc * window;
+	}
+
+	return (float)sum;
+}
+
+double DSP::findCrossing(float* pa_src, int index, float level) {
+
+	// linear interpolation is off by a large fraction of a sample for signals near
+	// nyquist, so the crossing of the band-limited signal is found by bisection
+	double lower = index - 1;
+	double upper = index;
+
+	for (int i = 0; i < 24; ++i) {
+
+		double center = (lower + upper) / 2;
+
+		if (interpolate(pa_src, center) < level) {
+			lower = center;
+		}
+		else {
+			upper = center;
+		}
+	}
+
+	return (lower + upper) / 2;
+}
+
+float DSP::createWindow(WindowType type, int size, float* pa_dst) {
+
+	// cosine sum coefficients of every window type
+	double a[5] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+
+	switch (type) {
+
+	case WindowType::Hann: {
+
+		a[0] = 0.5;
+		a[1] = 0.5;
+		break;
+	}
+	case WindowType::BlackmanHarris: {
+
+		a[0] = 0.35875;
+		a[1] = 0.48829;
+		a[2] = 0.14128;
+		a[3] = 0.01168;
+		break;
+	}
+	case WindowType::FlatTop: {
+
+		a[0] = 0.21557895;
+		a[1] = 0.41663158;
+		a[2] = 0.277263158;
+		a[3] = 0.083578947;
+		a[4] = 0.006947368;
+		break;
+	}
+	}
+
+	double sum = 0.0;
+
+	for (int n = 0; n < size; ++n) {
+
+		double x = 2.0 * std::numbers::pi * n / size;
+		double value = a[0] - a[1] * cos(x) + a[2] * cos(2.0 * x) - a[3] * cos(3.0 * x) + a[4] * cos(4.0 * x);
+
+		pa_dst[n] = (float)value;
+		sum += value;
+	}
+
+	return (float)sum;
+}
+
+std::complex<float> DSP::demodulate(float* pa_src, int size, double frequency, double sampleRate) {
+
+	// the reference oscillator is advanced by complex multiplication instead of calling sin/cos per sample
+	std::complex<double> step = std::polar(1.0, -2.0 * std::numbers::pi * frequency / sampleRate);
+	std::complex<double> oscillator = 1.0;
+	std::complex<double> sum = 0.0;
+	double windowSum = 0.0;
+
+	for (int n = 0; n < size; ++n) {
+
+		// hann window suppresses leakage of other frequencies and of a non integer number of periods
+		double window = 0.5 - 0.5 * cos(2.0 * std::numbers::pi * n / size);
+
+		sum += pa_src[n] * window * oscillator;
+		windowSum += window;
+
+		oscillator *= step;
+
+		// renormalize every now and then, the magnitude drifts slowly
+		if ((n & 1023) == 1023) {
+			oscillator /= std::abs(oscillator);
+		}
+	}
+
+	// a sine of amplitude a gives a / 2 on every side band
+	sum *= 2.0 / windowSum;
+
+	// the reference is e^(-i w n), so the sine phase is offset by 90 degrees
+	return std::complex<float>(sum * std::complex<double>(0.0, 1.0));
+}
+
+// solves the normal equations (n rows with the right hand side in column n) by gaussian
+// elimination with partial pivoting, the matrix is modified
+static bool solve(double* pa_matrix, int n, int stride, double* pa_x) {
+
+	for (int i = 0; i < n; ++i) {
+
+		int pivot = i;
+		for (int r = i + 1; r < n; ++r) {
+			if (fabs(pa_matrix[r * stride + i]) > fabs(pa_matrix[pivot * stride + i])) {
+				pivot = r;
+			}
+		}
+
+		if (fabs(pa_matrix[pivot * stride + i]) < 1e-30) {
+			return false;
+		}
+
+		for (int j = 0; j <= n; ++j) {
+			std::swap(pa_matrix[i * stride + j], pa_matrix[pivot * stride + j]);
+		}
+
+		for (int r = i + 1; r < n; ++r) {
+
+			double factor = pa_matrix[r * stride + i] / pa_matrix[i * stride + i];
+			for (int j = i; j <= n; ++j) {
+				pa_matrix[r * stride + j] -= factor * pa_matrix[i * stride + j];
+			}
+		}
+	}
+
+	for (int i = n - 1; i >= 0; --i) {
+
+		double sum = pa_matrix[i * stride + n];
+		for (int j = i + 1; j < n; ++j) {
+			sum -= pa_matrix[i * stride + j] * pa_x[j];
+		}
+		pa_x[i] = sum / pa_matrix[i * stride + i];
+	}
+
+	return true;
+}
+
+bool DSP::fitSine(float* pa_src, int size, double& w, double& a, double& b, double& c) {
+
+	a = 0.0;
+	b = 0.0;
+	c = 0.0;
+
+	// the first pass fits amplitudes and offset at the estimated frequency, every
+	// further pass linearizes the sine around the last fit and corrects the frequency
+	for (int iteration = 0; iteration <= DSP_SINE_FIT_ITERATIONS; ++iteration) {
+
+		int nParams = iteration == 0 ? 3 : 4;
+
+		double ata[4][5] = { }; // normal equations (the right hand side follows the last parameter)
+
+		// m is centered, that way the frequency column is almost orthogonal to the others
+		std::complex<double> step = std::polar(1.0, w);
+		std::complex<double> oscillator = std::polar(1.0, -w * (size / 2));
+
+		for (int n = 0; n < size; ++n) {
+
+			double m = n - size / 2;
+			double basis[4] = { oscillator.real(), oscillator.imag(), 1.0, m * (b * oscillator.real() - a * oscillator.imag()) };
+
+			for (int i = 0; i < nParams; ++i) {
+				for (int j = 0; j < nParams; ++j) {
+					ata[i][j] += basis[i] * basis[j];
+				}
+				ata[i][nParams] += basis[i] * pa_src[n];
+			}
+
+			oscillator *= step;
+
+			// renormalize every now and then, the magnitude drifts slowly
+			if ((n & 1023) == 1023) {
+				oscillator /= std::abs(oscillator);
+			}
+		}
+
+		double x[4];
+		if (!solve(&ata[0][0], nParams, 5, x)) {
+			return false;
+		}
+
+		a = x[0];
+		b = x[1];
+		c = x[2];
+
+		if (nParams == 4) {
+			w += x[3];
+		}
+
+		// the frequency has to stay between dc and nyquist
+		if (!(w > 0.0 && w < std::numbers::pi)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool DSP::fitHarmonics(float* pa_src, int size, double w, int nHarmonics, std::complex<double>* pa_dst, double& c) {
+
+	// linear least squares of all harmonics and the offset at once (the frequencies are known)
+	int nParams = 2 * nHarmonics + 1;
+
+	std::vector<double> ata(nParams * (nParams + 1), 0.0);
+	std::vector<double> basis(nParams);
+	std::vector<std::complex<double>> steps(nHarmonics);
+	std::vector<std::complex<double>> oscillators(nHarmonics);
+
+	for (int h = 0; h < nHarmonics; ++h) {
+		steps[h] = std::polar(1.0, w * (h + 1));
+		oscillators[h] = std::polar(1.0, -w * (h + 1) * (size / 2));
+	}
+
+	for (int n = 0; n < size; ++n) {
+
+		for (int h = 0; h < nHarmonics; ++h) {
+
+			basis[2 * h] = oscillators[h].real();
+			basis[2 * h + 1] = oscillators[h].imag();
+
+			oscillators[h] *= steps[h];
+
+			// renormalize every now and then, the magnitude drifts slowly
+			if ((n & 1023) == 1023) {
+				oscillators[h] /= std::abs(oscillators[h]);
+			}
+		}
+		basis[nParams - 1] = 1.0;
+
+		// the matrix is symmetric, the lower half is mirrored afterwards
+		for (int i = 0; i < nParams; ++i) {
+			for (int j = i; j < nParams; ++j) {
+				ata[i * (nParams + 1) + j] += basis[i] * basis[j];
+			}
+			ata[i * (nParams + 1) + nParams] += basis[i] * pa_src[n];
+		}
+	}
+
+	for (int i = 0; i < nParams; ++i) {
+		for (int j = 0; j < i; ++j) {
+			ata[i * (nParams + 1) + j] = ata[j * (nParams + 1) + i];
+		}
+	}
+
+	std::vector<double> x(nParams);
+	if (!solve(ata.data(), nParams, nParams + 1, x.data())) {
+		return false;
+	}
+
+	for (int h = 0; h < nHarmonics; ++h) {
+		pa_dst[h] = std::complex<double>(x[2 * h], x[2 * h + 1]);
+	}
+	c = x[nParams - 1];
+
+	return true;
+}
+
+double DSP::sweepPhase(double time, double start, double stop, double duration) {
+
+	// the instantaneous frequency start * e^(t / L) reaches stop at the end of the sweep
+	double L = duration / log(stop / start);
+
+	return start * L * (exp(time / L) - 1.0);
+}
+
+double DSP::sweepFade(double time, double duration) {
+
+	double fade = min(DSP_SWEEP_FADE_TIME, duration / 4.0);
+
+	// half hann at both ends
+	if (time < fade) {
+		return 0.5 - 0.5 * cos(std::numbers::pi * time / fade);
+	}
+	if (time > duration - fade) {
+		return 0.5 - 0.5 * cos(std::numbers::pi * (duration - time) / fade);
+	}
+
+	return 1.0;
+}
+
+void DSP::createInverseSweep(float start, float stop, float duration, float sampleRate, float* pa_dst) {
+
+	int size = (int)(duration * sampleRate);
+	double L = duration / log(stop / start);
+
+	// the gain is measured at the center of the sweep (on a logarithmic scale)
+	double center = sqrt((double)start * stop);
+	std::complex<double> step = std::polar(1.0, -2.0 * std::numbers::pi * center / sampleRate);
+	std::complex<double> oscillator = 1.0;
+	std::complex<double> sweepSum = 0.0;
+	std::complex<double> inverseSum = 0.0;
+
+	for (int n = 0; n < size; ++n) {
+
+		// time reversed sweep, low frequencies last
+		double time = (size - 1 - n) / (double)sampleRate;
+		double sweep = sweepFade(time, duration) * sin(2.0 * std::numbers::pi * sweepPhase(time, start, stop, duration));
+
+		// the sweep spends more time on low frequencies, the envelope (proportional to the
+		// instantaneous frequency) compensates with 6 dB per octave
+		pa_dst[n] = (float)(sweep * exp((time - duration) / L));
+
+		// single DFT bin of the sweep and the inverse filter (the sweep is reversed, which only changes the phase)
+		sweepSum += sweep * std::conj(oscillator);
+		inverseSum += (double)pa_dst[n] * oscillator;
+
+		oscillator *= step;
+
+		// renormalize every now and then, the magnitude drifts slowly
+		if ((n & 1023) == 1023) {
+			oscillator /= std::abs(oscillator);
+		}
+	}
+
+	// the spectrum of the deconvolved sweep is flat within the sweep range
+	float scale = (float)(1.0 / max(std::abs(sweepSum * inverseSum), 1e-12));
+
+	for (int n = 0; n < size; ++n) {
+		pa_dst[n] *= scale;
+	}
+}
+
+void DSP::createMLS(int order, float* pa_dst) {
+
+	// feedback taps of a maximal length linear feedback shift register (orders 10 to 16)
+	static const unsigned int taps[7] = { 0x240, 0x500, 0xE08, 0x1C80, 0x3802, 0x6000, 0xD008 };
+
+	order = min(max(order, 10), 16);
+
+	unsigned int mask = (1u << order) - 1;
+	unsigned int state = 1;
+
+	for (int n = 0; n < (int)mask; ++n) {
+
+		// the register visits every non zero state once
+		pa_dst[n] = (state & 1) ? 1.0f : -1.0f;
+
+		unsigned int feedback = std::popcount(state & taps[order - 10]) & 1;
+		state = ((state << 1) | feedback) & mask;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "Gui.h"
+#include "DistortionAnalyzer.h"
+#include "DSPUtils.h"
+#include "FFT.h"
+
+#include <bit>
+#include <complex>
+#include <numbers>
+#include <math.h>
+
+#define DISTORTION_MAX_INPUT 4 // maximum number of frames waiting in the input
+#define DISTORTION_FIT_PASSES 2 // fits of the fundamental without the harmonics
+
+DistortionAnalyzer::DistortionAnalyzer(float sampleRate) : m_sampleRate(sampleRate), m_result{ }, m_updated(false), m_latest{ }, m_running(true) {
+
+	// start worker
+	m_worker = std::thread(&DistortionAnalyzer::run, this);
+}
+
+DistortionAnalyzer::~DistortionAnalyzer() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void DistortionAnalyzer::addSamples(float* pa_data, int size) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_input.insert(m_input.end(), pa_data, pa_data + size);
+
+		// drop the oldest samples if the worker can't keep up
+		int maxInput = DISTORTION_MAX_INPUT * DISTORTION_SIZE;
+		if ((int)m_input.size() > maxInput) {
+			m_input.erase(m_input.begin(), m_input.end() - maxInput);
+		}
+	}
+	m_condition.notify_one();
+}
+
+bool DistortionAnalyzer::update() {
+
+	// copy the latest result
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_updated) {
+			return false;
+		}
+
+		m_latest = m_result;
+		m_updated = false;
+	}
+
+	EMIT(onResultUpdate);
+	return true;
+}
+
+DistortionResult DistortionAnalyzer::getResult() {
+
+	return m_latest;
+}
+
+float DistortionAnalyzer::getSampleRate() {
+
+	return m_sampleRate;
+}
+
+bool DistortionAnalyzer::analyze(float* pa_src, int size, float sampleRate, DistortionResult& result) {
+
+	result = { };
+
+	// estimate the fundamental from the largest bin of a windowed spectrum
+	int fftSize = std::bit_floor((unsigned int)size);
+	FFT& fft = FFT::getPlan(fftSize);
+
+	std::vector<float> frame(fftSize);
+	std::vector<std::complex<float>> bins(fft.getBinCount());
+
+	DSP::createWindow(DSP::WindowType::BlackmanHarris, fftSize, frame.data());
+
+	for (int n = 0; n < fftSize; ++n) {
+		frame[n] *= pa_src[n];
+	}
+
+	fft.transform(frame.data(), bins.data());
+
+	// skip dc and the bins next to it (main lobe of the window)
+	int peak = 4;
+	for (int k = 4; k < (int)bins.size() - 1; ++k) {
+
+		if (std::norm(bins[k]) > std::norm(bins[peak])) {
+			peak = k;
+		}
+	}
+
+	// parabolic interpolation of the log magnitude gives a fraction of a bin
+	float alpha = logf(std::abs(bins[peak - 1]) + 1e-20f);
+	float beta = logf(std::abs(bins[peak]) + 1e-20f);
+	float gamma = logf(std::abs(bins[peak + 1]) + 1e-20f);
+	float offset = 0.5f * (alpha - gamma) / (alpha - 2.0f * beta + gamma);
+
+	double w = 2.0 * std::numbers::pi * (peak + offset) / fftSize;
+
+	// fit the fundamental to the whole frame, that way its frequency is known exactly
+	double a, b, c;
+	if (!DSP::fitSine(pa_src, size, w, a, b, c)) {
+		return false;
+	}
+
+	// fit fundamental and harmonics below nyquist together, that way nothing leaks into the noise
+	// (sine and cosine of a harmonic within a bin of nyquist are almost the same, the fit would be singular)
+	double limit = std::numbers::pi * (1.0 - 2.0 / size);
+
+	int nHarmonics = 1;
+	while (nHarmonics <= DISTORTION_HARMONICS && (nHarmonics + 1) * w < limit) {
+		++nHarmonics;
+	}
+
+	std::complex<double> harmonics[DISTORTION_HARMONICS + 1];
+	if (!DSP::fitHarmonics(pa_src, size, w, nHarmonics, harmonics, c)) {
+		return false;
+	}
+
+	// strong harmonics pull the frequency of the fundamental fit (mostly with few periods per frame),
+	// so the fundamental is fitted again without them (the harmonics of the first pass are still off
+	// by the pulled frequency, the second pass removes them from the noise of very clean signals)
+	for (int pass = 0; pass < DISTORTION_FIT_PASSES && nHarmonics > 1; ++pass) {
+
+		std::vector<float> fundamental(pa_src, pa_src + size);
+		evaluate(harmonics, 1, nHarmonics, w, 0.0, fundamental.data(), size);
+
+		if (!DSP::fitSine(fundamental.data(), size, w, a, b, c) || !DSP::fitHarmonics(pa_src, size, w, nHarmonics, harmonics, c)) {
+			return false;
+		}
+	}
+
+	double amplitude = std::abs(harmonics[0]);
+	if (amplitude < DISTORTION_MIN_AMPLITUDE) {
+		return false;
+	}
+
+	double fundamentalPower = 0.5 * amplitude * amplitude;
+	double harmonicPower = 0.0;
+
+	for (int h = 1; h < nHarmonics; ++h) {
+
+		result.harmonics[h - 1] = (float)std::abs(harmonics[h]);
+		harmonicPower += 0.5 * std::norm(harmonics[h]);
+	}
+
+	// the noise is what remains after removing the fitted signal
+	std::vector<float> noise(pa_src, pa_src + size);
+	evaluate(harmonics, 0, nHarmonics, w, c, noise.data(), size);
+
+	double noisePower = 0.0;
+	for (int n = 0; n < size; ++n) {
+		noisePower += (double)noise[n] * noise[n];
+	}
+
+	noisePower = max(noisePower / size, 1e-30);
+	harmonicPower = max(harmonicPower, 1e-30);
+
+	result.valid = true;
+	result.frequency = (float)(w * sampleRate / (2.0 * std::numbers::pi));
+	result.amplitude = (float)amplitude;
+	result.thd = (float)(10.0 * log10(harmonicPower / fundamentalPower));
+	result.thdN = (float)(10.0 * log10((harmonicPower + noisePower) / fundamentalPower));
+	result.sinad = -result.thdN;
+	result.snr = (float)(10.0 * log10(fundamentalPower / noisePower));
+	result.enob = (result.sinad - 1.76f) / 6.02f;
+
+	return true;
+}
+
+void DistortionAnalyzer::evaluate(std::complex<double>* pa_harmonics, int first, int last, double w, double c, float* pa_dst, int size) {
+
+	std::complex<double> step = std::polar(1.0, w);
+	std::complex<double> oscillator = std::polar(1.0, -w * (size / 2));
+
+	for (int n = 0; n < size; ++n) {
+
+		// the powers of the oscillator are the oscillators of the harmonics
+		double value = c;
+		std::complex<double> harmonic = std::pow(oscillator, first + 1);
+
+		for (int h = first; h < last; ++h) {
+
+			value += pa_harmonics[h].real() * harmonic.real() + pa_harmonics[h].imag() * harmonic.imag();
+			harmonic *= oscillator;
+		}
+
+		pa_dst[n] -= (float)value;
+
+		oscillator *= step;
+
+		// renormalize every now and then, the magnitude drifts slowly
+		if ((n & 1023) == 1023) {
+			oscillator /= std::abs(oscillator);
+		}
+	}
+}
+
+void DistortionAnalyzer::run() {
+
+	std::unique_lock<std::mutex> lock(m_inputMutex);
+
+	while (true) {
+
+		// wait for a complete frame
+		m_condition.wait(lock, [this] { return !m_running || m_input.size() >= DISTORTION_SIZE; });
+
+		if (!m_running) {
+			return;
+		}
+
+		// take the frame and advance by half a frame
+		std::vector<float> frame(m_input.begin(), m_input.begin() + DISTORTION_SIZE);
+		m_input.erase(m_input.begin(), m_input.begin() + DISTORTION_SIZE / 2);
+
+		// analyze without holding the lock, that way the capture path is never blocked
+		lock.unlock();
+
+		DistortionResult result;
+		analyze(frame.data(), frame.size(), m_sampleRate, result);
+
+		// publish result
+		{
+			std::lock_guard<std::mutex> resultLock(m_mutex);
+
+			m_result = result;
+			m_updated = true;
+		}
+
+		lock.lock();
+	}
+}
\ No newline at end of file
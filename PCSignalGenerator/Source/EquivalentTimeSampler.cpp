@@ -0,0 +1,126 @@
+#include "Gui.h"
+#include "EquivalentTimeSampler.h"
+
+#include <math.h>
+
+EquivalentTimeSampler::EquivalentTimeSampler(int nBins, int maxAverage) : m_nBins(nBins), m_maxAverage(max(maxAverage, 1)), m_window(nBins), m_nAcquisitions(0) {
+
+	// one more bin outside of the window on both sides, that way the edges are interpolated as well
+	m_mean.resize(m_nBins + 2, 0.0f);
+	m_offset.resize(m_nBins + 2, 0.0f);
+	m_count.resize(m_nBins + 2, 0);
+}
+
+void EquivalentTimeSampler::add(float* pa_samples, int size, double offset) {
+
+	// bin i is centered at -window / 2 + i * window / nBins (relative to the trigger) and stored
+	// at i + 1, bins -1 and nBins lie outside of the window
+	double binsPerSample = m_nBins / m_window;
+
+	for (int i = 0; i < size; ++i) {
+
+		// time of this sample relative to the trigger
+		double t = offset + i;
+		double position = (t + m_window / 2) * binsPerSample + 1.0;
+		int bin = (int)floor(position + 0.5);
+
+		if (bin < 0 || bin >= m_nBins + 2) {
+			continue;
+		}
+
+		// running average (turns into an exponential average once the limit is reached),
+		// the position is averaged the same way, so the mean value belongs to it
+		m_count[bin] = min(m_count[bin] + 1, m_maxAverage);
+		m_mean[bin] += (pa_samples[i] - m_mean[bin]) / m_count[bin];
+		m_offset[bin] += ((float)(position - bin) - m_offset[bin]) / m_count[bin];
+	}
+
+	++m_nAcquisitions;
+}
+
+void EquivalentTimeSampler::reconstruct(float* pa_dst, float scale) {
+
+	// the samples of a bin are spread over its width, so the mean of a bin is off by up to half a bin
+	// at steep slopes. The center of every bin is interpolated linearly between the filled bins with
+	// the nearest mean positions on both sides, that also fills the bins that are still empty.
+	int size = m_nBins + 2;
+	int previous = -1;
+	int next = 0;
+
+	for (int i = 0; i < m_nBins; ++i) {
+
+		// find the first filled bin with its mean position right of the center
+		while (next < size && (m_count[next] == 0 || next + m_offset[next] <= i + 1)) {
+
+			if (m_count[next] > 0) {
+				previous = next;
+			}
+			++next;
+		}
+
+		if (previous < 0 && next == size) {
+			pa_dst[i] = 0.0f;
+		}
+		else if (previous < 0) {
+
+			// hold the first value until the beginning of the window
+			pa_dst[i] = scale * m_mean[next];
+		}
+		else if (next == size) {
+
+			// hold the last value until the end of the window
+			pa_dst[i] = scale * m_mean[previous];
+		}
+		else {
+
+			float left = previous + m_offset[previous];
+			float right = next + m_offset[next];
+			float t = (i + 1 - left) / (right - left);
+
+			pa_dst[i] = scale * (m_mean[previous] + t * (m_mean[next] - m_mean[previous]));
+		}
+	}
+}
+
+void EquivalentTimeSampler::clear() {
+
+	std::fill(m_mean.begin(), m_mean.end(), 0.0f);
+	std::fill(m_offset.begin(), m_offset.end(), 0.0f);
+	std::fill(m_count.begin(), m_count.end(), 0);
+	m_nAcquisitions = 0;
+}
+
+void EquivalentTimeSampler::setWindow(double window) {
+
+	// bins of the old window are meaningless for the new one
+	if (window != m_window) {
+		m_window = window;
+		clear();
+	}
+}
+
+double EquivalentTimeSampler::getWindow() {
+
+	return m_window;
+}
+
+int EquivalentTimeSampler::getBinCount() {
+
+	return m_nBins;
+}
+
+int EquivalentTimeSampler::getAcquisitionCount() {
+
+	return m_nAcquisitions;
+}
+
+float EquivalentTimeSampler::getCoverage() {
+
+	// bins inside of the window
+	int nFilled = 0;
+	for (int i = 1; i <= m_nBins; ++i) {
+		nFilled += m_count[i] > 0;
+	}
+
+	return (float)nFilled / m_nBins;
+}
@@ -0,0 +1,155 @@
+#include "Gui.h"
+#include "FFT.h"
+
+#include <bit>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <numbers>
+
+FFT::FFT(int size) {
+
+	// only power of two sizes are supported
+	m_size = std::bit_ceil((unsigned int)max(size, 4));
+	m_half = m_size / 2;
+
+	// calculate bit reversal of the half size complex FFT
+	int nBits = std::countr_zero((unsigned int)m_half);
+	m_bitReverse.resize(m_half);
+
+	for (int i = 0; i < m_half; ++i) {
+
+		int reversed = 0;
+		for (int b = 0; b < nBits; ++b) {
+			reversed |= ((i >> b) & 1) << (nBits - 1 - b);
+		}
+
+		m_bitReverse[i] = reversed;
+	}
+
+	// calculate twiddles (in double precision, that way large sizes stay accurate)
+	m_twiddles.resize(max(m_half / 2, 1));
+	for (int k = 0; k < (int)m_twiddles.size(); ++k) {
+		double phase = -2.0 * std::numbers::pi * k / m_half;
+		m_twiddles[k] = std::complex<float>((float)cos(phase), (float)sin(phase));
+	}
+
+	m_realTwiddles.resize(m_half / 2 + 1);
+	for (int k = 0; k < (int)m_realTwiddles.size(); ++k) {
+		double phase = -2.0 * std::numbers::pi * k / m_size;
+		m_realTwiddles[k] = std::complex<float>((float)cos(phase), (float)sin(phase));
+	}
+}
+
+FFT& FFT::getPlan(int size) {
+
+	static std::mutex s_mutex;
+	static std::map<int, std::unique_ptr<FFT>> s_plans;
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	// create plan on first use
+	size = std::bit_ceil((unsigned int)max(size, 4));
+	std::unique_ptr<FFT>& p_plan = s_plans[size];
+
+	if (!p_plan) {
+		p_plan = std::make_unique<FFT>(size);
+	}
+
+	return *p_plan;
+}
+
+void FFT::transform(float* pa_src, std::complex<float>* pa_dst) {
+
+	// pack even samples into the real and odd samples into the imaginary part
+	for (int n = 0; n < m_half; ++n) {
+		pa_dst[m_bitReverse[n]] = std::complex<float>(pa_src[2 * n], pa_src[2 * n + 1]);
+	}
+
+	transformComplex(pa_dst, false);
+
+	// split the spectra of even and odd samples and combine them (in place, k and half - k at once)
+	std::complex<float> z0 = pa_dst[0];
+	pa_dst[0] = std::complex<float>(z0.real() + z0.imag(), 0.0f);
+	pa_dst[m_half] = std::complex<float>(z0.real() - z0.imag(), 0.0f);
+
+	for (int k = 1; k <= m_half / 2; ++k) {
+
+		std::complex<float> a = pa_dst[k];
+		std::complex<float> b = std::conj(pa_dst[m_half - k]);
+
+		std::complex<float> even = 0.5f * (a + b);
+		std::complex<float> odd = std::complex<float>(0.0f, -0.5f) * (a - b);
+
+		// twiddle of half - k is -conj(twiddle of k)
+		std::complex<float> w = m_realTwiddles[k];
+
+		pa_dst[k] = even + w * odd;
+		pa_dst[m_half - k] = std::conj(even - w * odd);
+	}
+}
+
+void FFT::inverse(std::complex<float>* pa_src, float* pa_dst) {
+
+	// the output holds exactly half size complex values, so the half size complex FFT
+	// runs in place there (nothing is allocated per call)
+	std::complex<float>* p_data = reinterpret_cast<std::complex<float>*>(pa_dst);
+
+	// undo the split, that way the half size complex FFT can be used again
+	for (int k = 0; k <= m_half / 2; ++k) {
+
+		std::complex<float> a = pa_src[k];
+		std::complex<float> b = std::conj(pa_src[m_half - k]);
+
+		std::complex<float> even = 0.5f * (a + b);
+		std::complex<float> odd = 0.5f * (a - b) * std::conj(m_realTwiddles[k]);
+
+		// z[k] = even + i * odd
+		p_data[m_bitReverse[k]] = even + std::complex<float>(0.0f, 1.0f) * odd;
+
+		if (k > 0 && k < m_half - k) {
+			p_data[m_bitReverse[m_half - k]] = std::conj(even - std::complex<float>(0.0f, 1.0f) * odd);
+		}
+	}
+
+	transformComplex(p_data, true);
+
+	// even samples are the real and odd samples the imaginary parts already, only normalize
+	float scale = 1.0f / m_half;
+
+	for (int n = 0; n < m_size; ++n) {
+		pa_dst[n] *= scale;
+	}
+}
+
+int FFT::getSize() {
+
+	return m_size;
+}
+
+int FFT::getBinCount() {
+
+	return m_half + 1;
+}
+
+void FFT::transformComplex(std::complex<float>* pa_data, bool inverse) {
+
+	// iterative radix-2 butterflies (input is already in bit reversed order)
+	for (int length = 2; length <= m_half; length *= 2) {
+
+		int half = length / 2;
+		int step = m_half / length;
+
+		for (int i = 0; i < m_half; i += length) {
+			for (int j = 0; j < half; ++j) {
+
+				std::complex<float> w = inverse ? std::conj(m_twiddles[j * step]) : m_twiddles[j * step];
+				std::complex<float> u = pa_data[i + j];
+				std::complex<float> v = pa_data[i + j + half] * w;
+
+				pa_data[i + j] = u + v;
+				pa_data[i + j + half] = u - v;
+			}
+		}
+	}
+}
\ No newline at end of file
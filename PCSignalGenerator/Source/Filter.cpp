@@ -0,0 +1,353 @@
+#include "Gui.h"
+#include "Filter.h"
+
+#include <immintrin.h>
+#include <string.h>
+#include <numbers>
+#include <math.h>
+
+Filter::Filter(int nChannels) : m_nChannels(nChannels) { }
+
+Filter::Filter(int nChannels, std::vector<Biquad> sections) : m_nChannels(nChannels), m_sections(sections) {
+
+	int nSections = m_sections.size();
+
+	m_blockMatrices.resize(nSections * 6 * 6, 0.0f);
+	m_states.resize(m_nChannels * nSections * 2, 0.0f);
+
+	// run every section for four samples with a single non-zero input (x0..x3, s1, s2),
+	// which gives one column of the block matrix
+	for (int s = 0; s < nSections; ++s) {
+
+		Biquad& q = m_sections[s];
+		float* p_matrix = m_blockMatrices.data() + s * 36;
+
+		for (int j = 0; j < 6; ++j) {
+
+			double x[4] = { 0.0, 0.0, 0.0, 0.0 };
+			double s1 = j == 4 ? 1.0 : 0.0;
+			double s2 = j == 5 ? 1.0 : 0.0;
+
+			if (j < 4) {
+				x[j] = 1.0;
+			}
+
+			for (int n = 0; n < 4; ++n) {
+
+				// transposed direct form II
+				double y = q.b0 * x[n] + s1;
+				s1 = q.b1 * x[n] - q.a1 * y + s2;
+				s2 = q.b2 * x[n] - q.a2 * y;
+
+				p_matrix[n * 6 + j] = y;
+			}
+
+			p_matrix[4 * 6 + j] = s1;
+			p_matrix[5 * 6 + j] = s2;
+		}
+	}
+}
+
+Filter::Filter(int nChannels, float* pa_kernel, int size) : m_nChannels(nChannels), m_kernel(pa_kernel, pa_kernel + size) {
+
+	if (size > FILTER_DIRECT_TAPS) {
+
+		m_convolvers.reserve(m_nChannels);
+		for (int c = 0; c < m_nChannels; ++c) {
+			m_convolvers.emplace_back(pa_kernel, size);
+		}
+	}
+	else {
+		m_history.resize(m_nChannels, std::vector<float>(size - 1, 0.0f));
+	}
+}
+
+void Filter::process(float* pa_data, int size, int channel) {
+
+	// biquad cascade (every section in place)
+	for (int s = 0; s < m_sections.size(); ++s) {
+		processBiquad(pa_data, size, s, m_states.data() + (channel * m_sections.size() + s) * 2);
+	}
+
+	// fir
+	if (m_convolvers.size() > 0) {
+		m_convolvers[channel].process(pa_data, size);
+	}
+	else if (m_kernel.size() > 0) {
+		processDirect(pa_data, size, channel);
+	}
+}
+
+bool Filter::isEmpty() {
+
+	return m_sections.size() == 0 && m_kernel.size() == 0;
+}
+
+std::vector<Biquad> Filter::designButterworth(int order, float frequency, float sampleRate, bool highPass) {
+
+	// poles on the unit circle (upper half, the real pole of odd orders last)
+	std::vector<std::complex<double>> poles;
+
+	for (int k = 0; k < order / 2; ++k) {
+
+		double theta = std::numbers::pi * (2 * k + 1) / (2 * order);
+		poles.push_back(std::complex<double>(-sin(theta), cos(theta)));
+	}
+
+	if (order % 2 == 1) {
+		poles.push_back(-1.0);
+	}
+
+	return designPrototype(poles, 1.0, frequency, sampleRate, highPass);
+}
+
+std::vector<Biquad> Filter::designChebyshev(int order, float frequency, float sampleRate, bool highPass) {
+
+	// poles on an ellipse (type I, ripple in the passband)
+	double epsilon = sqrt(pow(10.0, FILTER_CHEBYSHEV_RIPPLE / 10.0) - 1.0);
+	double mu = asinh(1.0 / epsilon) / order;
+
+	std::vector<std::complex<double>> poles;
+
+	for (int k = 0; k < order / 2; ++k) {
+
+		double theta = std::numbers::pi * (2 * k + 1) / (2 * order);
+		poles.push_back(std::complex<double>(-sinh(mu) * sin(theta), cosh(mu) * cos(theta)));
+	}
+
+	if (order % 2 == 1) {
+		poles.push_back(-sinh(mu));
+	}
+
+	// even orders start at the bottom of the ripple, that way the passband peaks at unity
+	double gain = order % 2 == 0 ? 1.0 / sqrt(1.0 + epsilon * epsilon) : 1.0;
+
+	return designPrototype(poles, gain, frequency, sampleRate, highPass);
+}
+
+Biquad Filter::designNotch(float frequency, float sampleRate) {
+
+	// zeros on the unit circle, poles just inside
+	double w = 2.0 * std::numbers::pi * frequency / sampleRate;
+	double alpha = sin(w) / (2.0 * FILTER_NOTCH_Q);
+	double a0 = 1.0 + alpha;
+
+	return { 1.0 / a0, -2.0 * cos(w) / a0, 1.0 / a0, -2.0 * cos(w) / a0, (1.0 - alpha) / a0 };
+}
+
+std::vector<float> Filter::designWindowedSinc(int taps, float frequency, float sampleRate, bool highPass) {
+
+	// odd number of taps, that way the kernel has an integer delay and can be inverted
+	taps |= 1;
+
+	std::vector<float> kernel(taps);
+	double fc = frequency / sampleRate;
+	double sum = 0.0;
+	int center = taps / 2;
+
+	for (int n = 0; n < taps; ++n) {
+
+		double x = std::numbers::pi * 2.0 * fc * (n - center);
+		double sinc = n == center ? 1.0 : sin(x) / x;
+
+		// symmetric blackman window
+		double phase = 2.0 * std::numbers::pi * n / (taps - 1);
+		double window = taps > 1 ? 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase) : 1.0;
+
+		kernel[n] = 2.0 * fc * sinc * window;
+		sum += kernel[n];
+	}
+
+	// unity gain at dc
+	for (int n = 0; n < taps; ++n) {
+		kernel[n] /= sum;
+	}
+
+	// high pass by spectral inversion (unit impulse minus low pass)
+	if (highPass) {
+
+		for (int n = 0; n < taps; ++n) {
+			kernel[n] = -kernel[n];
+		}
+
+		kernel[center] += 1.0f;
+	}
+
+	return kernel;
+}
+
+void Filter::processBiquad(float* pa_data, int size, int section, float* pa_state) {
+
+	float* p_matrix = m_blockMatrices.data() + section * 36;
+
+	// columns of the block matrix (outputs in the lanes, state in the first two lanes)
+	__m128 a_output[6];
+	__m128 a_state[6];
+
+	for (int j = 0; j < 6; ++j) {
+		a_output[j] = _mm_setr_ps(p_matrix[j], p_matrix[6 + j], p_matrix[12 + j], p_matrix[18 + j]);
+		a_state[j] = _mm_setr_ps(p_matrix[24 + j], p_matrix[30 + j], 0.0f, 0.0f);
+	}
+
+	__m128 s1 = _mm_set1_ps(pa_state[0]);
+	__m128 s2 = _mm_set1_ps(pa_state[1]);
+
+	int i = 0;
+
+	for (; i + 4 <= size; i += 4) {
+
+		__m128 x = _mm_loadu_ps(pa_data + i);
+
+		__m128 x0 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 x1 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 x2 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 x3 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+		// outputs
+		__m128 y = _mm_mul_ps(x0, a_output[0]);
+		y = _mm_add_ps(y, _mm_mul_ps(x1, a_output[1]));
+		y = _mm_add_ps(y, _mm_mul_ps(x2, a_output[2]));
+		y = _mm_add_ps(y, _mm_mul_ps(x3, a_output[3]));
+		y = _mm_add_ps(y, _mm_mul_ps(s1, a_output[4]));
+		y = _mm_add_ps(y, _mm_mul_ps(s2, a_output[5]));
+
+		// new state
+		__m128 state = _mm_mul_ps(x0, a_state[0]);
+		state = _mm_add_ps(state, _mm_mul_ps(x1, a_state[1]));
+		state = _mm_add_ps(state, _mm_mul_ps(x2, a_state[2]));
+		state = _mm_add_ps(state, _mm_mul_ps(x3, a_state[3]));
+		state = _mm_add_ps(state, _mm_mul_ps(s1, a_state[4]));
+		state = _mm_add_ps(state, _mm_mul_ps(s2, a_state[5]));
+
+		_mm_storeu_ps(pa_data + i, y);
+
+		s1 = _mm_shuffle_ps(state, state, _MM_SHUFFLE(0, 0, 0, 0));
+		s2 = _mm_shuffle_ps(state, state, _MM_SHUFFLE(1, 1, 1, 1));
+	}
+
+	pa_state[0] = _mm_cvtss_f32(s1);
+	pa_state[1] = _mm_cvtss_f32(s2);
+
+	// remaining samples one by one
+	Biquad& q = m_sections[section];
+
+	for (; i < size; ++i) {
+
+		float x = pa_data[i];
+		float y = q.b0 * x + pa_state[0];
+
+		pa_state[0] = q.b1 * x - q.a1 * y + pa_state[1];
+		pa_state[1] = q.b2 * x - q.a2 * y;
+
+		pa_data[i] = y;
+	}
+}
+
+void Filter::processDirect(float* pa_data, int size, int channel) {
+
+	std::vector<float>& history = m_history[channel];
+	int taps = m_kernel.size();
+
+	// history followed by the new samples, that way every output has all its inputs in one buffer
+	m_buffer.resize(taps - 1 + size);
+	memcpy(m_buffer.data(), history.data(), (taps - 1) * sizeof(float));
+	memcpy(m_buffer.data() + taps - 1, pa_data, size * sizeof(float));
+
+	float* p_input = m_buffer.data() + taps - 1;
+	int i = 0;
+
+	// four outputs at once
+	for (; i + 4 <= size; i += 4) {
+
+		__m128 sum = _mm_setzero_ps();
+
+		for (int k = 0; k < taps; ++k) {
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m_kernel[k]), _mm_loadu_ps(p_input + i - k)));
+		}
+
+		_mm_storeu_ps(pa_data + i, sum);
+	}
+
+	for (; i < size; ++i) {
+
+		float sum = 0.0f;
+
+		for (int k = 0; k < taps; ++k) {
+			sum += m_kernel[k] * p_input[i - k];
+		}
+
+		pa_data[i] = sum;
+	}
+
+	// keep the last inputs for the next call
+	memcpy(history.data(), m_buffer.data() + size, (taps - 1) * sizeof(float));
+}
+
+std::vector<Biquad> Filter::designPrototype(std::vector<std::complex<double>> poles, double gain, float frequency, float sampleRate, bool highPass) {
+
+	std::vector<Biquad> sections;
+
+	// prewarped cutoff of the bilinear transform (the analog prototype has its cutoff at 1)
+	double k = tan(std::numbers::pi * min(frequency, 0.49f * sampleRate) / sampleRate);
+
+	for (std::complex<double> p : poles) {
+
+		// coefficients of s^2, s and 1
+		double a_numerator[3];
+		double a_denominator[3];
+
+		if (p.imag() > 0.0) {
+
+			// conjugate pole pair, unity gain at dc (low pass) or at infinity (high pass, s -> 1 / s)
+			double magnitude = std::norm(p);
+
+			if (highPass) {
+				a_numerator[0] = magnitude; a_numerator[1] = 0.0; a_numerator[2] = 0.0;
+				a_denominator[0] = magnitude; a_denominator[1] = -2.0 * p.real(); a_denominator[2] = 1.0;
+			}
+			else {
+				a_numerator[0] = 0.0; a_numerator[1] = 0.0; a_numerator[2] = magnitude;
+				a_denominator[0] = 1.0; a_denominator[1] = -2.0 * p.real(); a_denominator[2] = magnitude;
+			}
+		}
+		else {
+
+			// real pole
+			double r = -p.real();
+
+			if (highPass) {
+				a_numerator[0] = 0.0; a_numerator[1] = r; a_numerator[2] = 0.0;
+				a_denominator[0] = 0.0; a_denominator[1] = r; a_denominator[2] = 1.0;
+			}
+			else {
+				a_numerator[0] = 0.0; a_numerator[1] = 0.0; a_numerator[2] = r;
+				a_denominator[0] = 0.0; a_denominator[1] = 1.0; a_denominator[2] = r;
+			}
+		}
+
+		sections.push_back(bilinear(a_numerator, a_denominator, k));
+	}
+
+	// overall gain is applied to the first section
+	if (sections.size() > 0) {
+		sections[0].b0 *= gain;
+		sections[0].b1 *= gain;
+		sections[0].b2 *= gain;
+	}
+
+	return sections;
+}
+
+Biquad Filter::bilinear(double* pa_numerator, double* pa_denominator, double k) {
+
+	// substitute s = (1 - z^-1) / (k (1 + z^-1)) and multiply by k^2 (1 + z^-1)^2
+	double b0 = pa_numerator[0] + pa_numerator[1] * k + pa_numerator[2] * k * k;
+	double b1 = -2.0 * pa_numerator[0] + 2.0 * pa_numerator[2] * k * k;
+	double b2 = pa_numerator[0] - pa_numerator[1] * k + pa_numerator[2] * k * k;
+
+	double a0 = pa_denominator[0] + pa_denominator[1] * k + pa_denominator[2] * k * k;
+	double a1 = -2.0 * pa_denominator[0] + 2.0 * pa_denominator[2] * k * k;
+	double a2 = pa_denominator[0] - pa_denominator[1] * k + pa_denominator[2] * k * k;
+
+	return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
\ No newline at end of file
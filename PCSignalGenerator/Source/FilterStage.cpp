@@ -0,0 +1,183 @@
+#include "Gui.h"
+#include "FilterStage.h"
+
+FilterStage::FilterStage(float sampleRate, int nChannels) : m_sampleRate(sampleRate), m_nChannels(nChannels), mp_pending(nullptr),
+	m_settings{ 0, 0, 1000.0f, 4, 255 }, m_redesign(false), m_running(true) {
+
+	mp_filter = new Filter(m_nChannels);
+
+	// start worker
+	m_worker = std::thread(&FilterStage::run, this);
+}
+
+FilterStage::~FilterStage() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+
+	delete mp_pending.load();
+	delete mp_filter;
+}
+
+void FilterStage::process(float** pa_channels, int nFrames) {
+
+	// take the latest design (its state starts at zero)
+	Filter* p_filter = mp_pending.exchange(nullptr);
+
+	if (p_filter != nullptr) {
+		delete mp_filter;
+		mp_filter = p_filter;
+	}
+
+	if (mp_filter->isEmpty()) {
+		return;
+	}
+
+	for (int c = 0; c < m_nChannels; ++c) {
+		mp_filter->process(pa_channels[c], nFrames, c);
+	}
+}
+
+int FilterStage::getType() {
+
+	return m_settings.type;
+}
+
+int FilterStage::getResponse() {
+
+	return m_settings.response;
+}
+
+float FilterStage::getFrequency() {
+
+	return m_settings.frequency;
+}
+
+int FilterStage::getOrder() {
+
+	return m_settings.order;
+}
+
+int FilterStage::getTaps() {
+
+	return m_settings.taps;
+}
+
+void FilterStage::setType(int type) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_settings.type = type;
+		m_redesign = true;
+	}
+	m_condition.notify_one();
+}
+
+void FilterStage::setResponse(int response) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_settings.response = response;
+		m_redesign = true;
+	}
+	m_condition.notify_one();
+}
+
+void FilterStage::setFrequency(float frequency) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_settings.frequency = frequency;
+		m_redesign = true;
+	}
+	m_condition.notify_one();
+}
+
+void FilterStage::setOrder(int order) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_settings.order = min(max(order, 1), FILTER_MAX_ORDER);
+		m_redesign = true;
+	}
+	m_condition.notify_one();
+}
+
+void FilterStage::setTaps(int taps) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_settings.taps = min(max(taps, 1), FILTER_MAX_TAPS);
+		m_redesign = true;
+	}
+	m_condition.notify_one();
+}
+
+Filter* FilterStage::design(FilterSettings settings) {
+
+	// keep the frequency below nyquist
+	float frequency = min(max(settings.frequency, 1.0f), 0.49f * m_sampleRate);
+	bool highPass = settings.response == 1;
+
+	switch (settings.type) {
+
+	case 1: { // butterworth
+
+		return new Filter(m_nChannels, Filter::designButterworth(settings.order, frequency, m_sampleRate, highPass));
+	}
+	case 2: { // chebyshev
+
+		return new Filter(m_nChannels, Filter::designChebyshev(settings.order, frequency, m_sampleRate, highPass));
+	}
+	case 3: { // notch
+
+		return new Filter(m_nChannels, std::vector<Biquad>({ Filter::designNotch(frequency, m_sampleRate) }));
+	}
+	case 4: { // windowed sinc
+
+		std::vector<float> kernel = Filter::designWindowedSinc(settings.taps, frequency, m_sampleRate, highPass);
+		return new Filter(m_nChannels, kernel.data(), kernel.size());
+	}
+	default: { // off
+
+		return new Filter(m_nChannels);
+	}
+	}
+}
+
+void FilterStage::run() {
+
+	std::unique_lock<std::mutex> lock(m_inputMutex);
+
+	while (true) {
+
+		m_condition.wait(lock, [this] { return !m_running || m_redesign; });
+
+		if (!m_running) {
+			return;
+		}
+
+		// design without holding the lock, settings that change meanwhile cause another design
+		FilterSettings settings = m_settings;
+		m_redesign = false;
+
+		lock.unlock();
+
+		// a design that wasn't taken yet is outdated
+		Filter* p_filter = design(settings);
+		delete mp_pending.exchange(p_filter);
+
+		lock.lock();
+	}
+}
\ No newline at end of file
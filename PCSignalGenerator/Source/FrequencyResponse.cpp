@@ -0,0 +1,339 @@
+#include "Gui.h"
+#include "FrequencyResponse.h"
+#include "Common/Reflection/Internal.h"
+
+#include <numbers>
+#include <math.h>
+
+FrequencyResponse::FrequencyResponse(SignalGenerator* p_sigGen, Oscilloscope* p_osc) : mp_sigGen(p_sigGen), mp_osc(p_osc),
+	m_savedOutput(false), m_savedWaveformType(0), m_savedFrequency(0.0f), m_point(-1), m_captureStart(0), m_captureSize(0),
+	m_nResults(0), m_run(0), m_updated(false), m_running(true), m_startFrequency(20.0f), m_stopFrequency(20000.0f), m_nPoints(64) {
+
+	// add members to reflection
+	ADD_FIELD(float, m_startFrequency);
+	ADD_FIELD(float, m_stopFrequency);
+	ADD_FIELD(int, m_nPoints);
+
+	for (int i = 0; i < FREQRESP_PLOT_SIZE; ++i) {
+		ma_gainData[i] = 0.0f;
+		ma_phaseData[i] = 0.0f;
+	}
+
+	calculateFrequencyData(m_startFrequency, m_stopFrequency);
+
+	// start worker
+	m_worker = std::thread(&FrequencyResponse::run, this);
+}
+
+FrequencyResponse::~FrequencyResponse() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void FrequencyResponse::enableMeasurement(int enable) {
+
+	if (enable && m_point < 0) {
+
+		// save generator settings
+		m_savedOutput = mp_sigGen->isOutputEnabled();
+		m_savedWaveformType = mp_sigGen->getWaveformType();
+		m_savedFrequency = mp_sigGen->getFrequency();
+
+		// calculate logarithmically spaced frequencies
+		m_frequencies = FrequencySweep::getFrequencies(m_startFrequency, m_stopFrequency, m_nPoints);
+		int nPoints = m_frequencies.size();
+
+		// remove old points and results
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_queue.clear();
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			// a job of the previous measurement may still be analyzed
+			m_results.assign(nPoints, std::complex<float>(0.0f, 0.0f));
+			m_nResults = 0;
+			++m_run;
+			m_updated = true;
+		}
+
+		// plot points lie between the first and the last frequency
+		calculateFrequencyData(m_frequencies.front(), m_frequencies.back());
+		EMIT(onBoundsChange, m_frequencies.front(), m_frequencies.back());
+
+		// measure with a sine
+		mp_sigGen->setWaveformType(0);
+
+		if (!mp_sigGen->isOutputEnabled()) {
+			mp_sigGen->enableOutput(true);
+		}
+		if (!mp_osc->isOscEnabled()) {
+			mp_osc->enableOscilloscope(true);
+		}
+
+		startPoint(0);
+	}
+	else if (!enable && m_point >= 0) {
+
+		finishMeasurement();
+	}
+}
+
+void FrequencyResponse::setStartFrequency(float frequency) {
+
+	m_startFrequency = max(frequency, 1.0f);
+}
+
+void FrequencyResponse::setStopFrequency(float frequency) {
+
+	m_stopFrequency = max(frequency, 1.0f);
+}
+
+void FrequencyResponse::setPointCount(int nPoints) {
+
+	m_nPoints = max(nPoints, 2);
+}
+
+bool FrequencyResponse::isMeasuring() {
+
+	return m_point >= 0;
+}
+
+float FrequencyResponse::getStartFrequency() {
+
+	return m_startFrequency;
+}
+
+float FrequencyResponse::getStopFrequency() {
+
+	return m_stopFrequency;
+}
+
+int FrequencyResponse::getPointCount() {
+
+	return m_nPoints;
+}
+
+float* FrequencyResponse::getFrequencyData() {
+
+	return ma_frequencyData;
+}
+
+float* FrequencyResponse::getGainData() {
+
+	return ma_gainData;
+}
+
+float* FrequencyResponse::getPhaseData() {
+
+	return ma_phaseData;
+}
+
+int FrequencyResponse::getPlotDataSize() {
+
+	return FREQRESP_PLOT_SIZE;
+}
+
+void FrequencyResponse::onTick(float deltaTime) {
+
+	if (m_point >= 0) {
+
+		MinMaxPyramid* p_record = mp_osc->getRecord(0);
+
+		// check if the capture window of the current point is complete
+		if (p_record->getCount() >= m_captureStart + m_captureSize) {
+
+			FrequencyResponseJob job;
+			job.run = m_run;
+			job.point = m_point;
+			job.frequency = m_frequencies[m_point];
+			job.sampleRate = mp_osc->getSampleRate();
+			job.amplitude = mp_sigGen->getAmplitude();
+
+			// CH1 is the reference, CH2 the response (mono devices only measure the gain)
+			if (mp_osc->getChannelCount() > 1) {
+
+				job.reference.resize(m_captureSize);
+				job.response.resize(m_captureSize);
+
+				mp_osc->getRecord(0)->copy(m_captureStart, m_captureSize, job.reference.data());
+				mp_osc->getRecord(1)->copy(m_captureStart, m_captureSize, job.response.data());
+			}
+			else {
+
+				job.response.resize(m_captureSize);
+				mp_osc->getRecord(0)->copy(m_captureStart, m_captureSize, job.response.data());
+			}
+
+			// analyze on the worker
+			{
+				std::lock_guard<std::mutex> lock(m_queueMutex);
+				m_queue.push_back(std::move(job));
+			}
+			m_condition.notify_one();
+
+			// the next point settles while this one is analyzed
+			if (m_point + 1 < (int)m_frequencies.size()) {
+				startPoint(m_point + 1);
+			}
+			else {
+				finishMeasurement();
+			}
+		}
+	}
+
+	// show new results
+	bool updated;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		updated = m_updated;
+		m_updated = false;
+
+		if (updated) {
+			updatePlotData();
+		}
+	}
+
+	if (updated) {
+		EMIT(onPlotUpdate);
+	}
+}
+
+void FrequencyResponse::onBegin() { }
+
+void FrequencyResponse::onClose() {
+
+	// leave the generator as it was
+	if (m_point >= 0) {
+		finishMeasurement();
+	}
+}
+
+void FrequencyResponse::startPoint(int point) {
+
+	m_point = point;
+
+	float frequency = m_frequencies[point];
+	float sampleRate = mp_osc->getSampleRate();
+
+	mp_sigGen->setFrequency(frequency);
+
+	// wait until the new frequency left the output buffer and the device under test settled,
+	// then capture an integer number of periods
+	float settleTime = FrequencySweep::getSettleTime(frequency, mp_sigGen->getLatency());
+
+	m_captureStart = mp_osc->getRecord(0)->getCount() + (long long)(settleTime * sampleRate);
+	m_captureSize = FrequencySweep::getCaptureSize(frequency, sampleRate, mp_osc->getRecord(0)->getCapacity() / 2);
+}
+
+void FrequencyResponse::finishMeasurement() {
+
+	m_point = -1;
+
+	// restore generator settings
+	mp_sigGen->setWaveformType(m_savedWaveformType);
+	mp_sigGen->setFrequency(m_savedFrequency);
+
+	if (!m_savedOutput) {
+		mp_sigGen->enableOutput(false);
+	}
+
+	EMIT(onMeasurementChanged, 0);
+}
+
+void FrequencyResponse::updatePlotData() {
+
+	// called with the results locked
+	if (m_nResults == 0) {
+		return;
+	}
+
+	// calculate gain and unwrapped phase of all measured points
+	std::vector<float> gain(m_nResults);
+	std::vector<float> phase(m_nResults);
+
+	for (int i = 0; i < m_nResults; ++i) {
+
+		gain[i] = 20.0f * log10f(max(std::abs(m_results[i]), 1e-9f));
+		phase[i] = std::arg(m_results[i]) * 180.0f / std::numbers::pi;
+
+		// keep the phase continuous
+		if (i > 0) {
+			phase[i] -= 360.0f * roundf((phase[i] - phase[i - 1]) / 360.0f);
+		}
+	}
+
+	// the points are spaced evenly on the logarithmic frequency axis, so plot points
+	// are interpolated linearly between them (unmeasured points hold the last value)
+	int nPoints = m_results.size();
+
+	for (int j = 0; j < FREQRESP_PLOT_SIZE; ++j) {
+
+		float position = j * (nPoints - 1) / (float)(FREQRESP_PLOT_SIZE - 1);
+		int i = min((int)position, m_nResults - 1);
+
+		if (i + 1 < m_nResults) {
+
+			float t = position - i;
+			ma_gainData[j] = gain[i] + t * (gain[i + 1] - gain[i]);
+			ma_phaseData[j] = phase[i] + t * (phase[i + 1] - phase[i]);
+		}
+		else {
+
+			ma_gainData[j] = gain[i];
+			ma_phaseData[j] = phase[i];
+		}
+	}
+}
+
+void FrequencyResponse::calculateFrequencyData(float start, float stop) {
+
+	for (int j = 0; j < FREQRESP_PLOT_SIZE; ++j) {
+		ma_frequencyData[j] = start * powf(stop / start, j / (float)(FREQRESP_PLOT_SIZE - 1));
+	}
+}
+
+void FrequencyResponse::run() {
+
+	std::unique_lock<std::mutex> lock(m_queueMutex);
+
+	while (true) {
+
+		// wait for a captured point
+		m_condition.wait(lock, [this] { return !m_running || m_queue.size() > 0; });
+
+		if (!m_running) {
+			return;
+		}
+
+		FrequencyResponseJob job = std::move(m_queue.front());
+		m_queue.erase(m_queue.begin());
+
+		// analyze without holding the lock
+		lock.unlock();
+
+		std::complex<float> result = FrequencySweep::analyze(job);
+
+		// publish result (points are analyzed in order, results of a previous measurement are dropped)
+		{
+			std::lock_guard<std::mutex> resultLock(m_mutex);
+
+			if (job.run == m_run && job.point < (int)m_results.size()) {
+				m_results[job.point] = result;
+				m_nResults = max(m_nResults, job.point + 1);
+				m_updated = true;
+			}
+		}
+
+		lock.lock();
+	}
+}
\ No newline at end of file
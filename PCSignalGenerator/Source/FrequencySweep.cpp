@@ -0,0 +1,51 @@
+#include "Gui.h"
+#include "FrequencySweep.h"
+#include "DSPUtils.h"
+
+#include <math.h>
+
+std::vector<float> FrequencySweep::getFrequencies(float start, float stop, int nPoints) {
+
+	// logarithmically spaced between start and stop
+	nPoints = max(nPoints, 2);
+	std::vector<float> frequencies(nPoints);
+
+	for (int i = 0; i < nPoints; ++i) {
+		frequencies[i] = start * powf(stop / start, i / (float)(nPoints - 1));
+	}
+
+	return frequencies;
+}
+
+float FrequencySweep::getSettleTime(float frequency, float latency) {
+
+	// wait until the new frequency left the output buffer and the device under test settled
+	return latency + FREQRESP_SETTLE_TIME + FREQRESP_MIN_PERIODS / frequency;
+}
+
+int FrequencySweep::getCaptureSize(float frequency, float sampleRate, int maxSize) {
+
+	// capture an integer number of periods
+	float nPeriods = max(ceilf(frequency * FREQRESP_MIN_CAPTURE_TIME), (float)FREQRESP_MIN_PERIODS);
+
+	return min((int)roundf(nPeriods * sampleRate / frequency), maxSize);
+}
+
+std::complex<float> FrequencySweep::analyze(FrequencyResponseJob& job) {
+
+	std::complex<float> response = DSP::demodulate(job.response.data(), job.response.size(), job.frequency, job.sampleRate);
+
+	// without a reference channel only the gain relative to the generator amplitude is known
+	if (job.reference.size() == 0) {
+		return std::abs(response) / max(job.amplitude, 1e-6f);
+	}
+
+	std::complex<float> reference = DSP::demodulate(job.reference.data(), job.reference.size(), job.frequency, job.sampleRate);
+
+	if (std::abs(reference) < 1e-9f) {
+		return 0.0f;
+	}
+
+	// both channels are captured by the same device, so latency and clock offsets cancel out
+	return response / reference;
+}
\ No newline at end of file
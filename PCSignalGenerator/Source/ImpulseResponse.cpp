@@ -0,0 +1,275 @@
+#include "Gui.h"
+#include "ImpulseResponse.h"
+#include "Common/Reflection/Internal.h"
+
+#include <string.h>
+#include <math.h>
+
+ImpulseResponse::ImpulseResponse(SignalGenerator* p_sigGen, Oscilloscope* p_osc) : mp_sigGen(p_sigGen), mp_osc(p_osc),
+	m_savedOutput(false), m_savedWaveformType(0), m_measuring(false), m_captureStart(0), m_captureSize(0), m_start(0.0f), m_stop(0.0f),
+	m_duration(0.0f),
+	m_updated(false), m_running(true), m_startFrequency(20.0f), m_stopFrequency(20000.0f), m_sweepDuration(5.0f) {
+
+	// add members to reflection
+	ADD_FIELD(float, m_startFrequency);
+	ADD_FIELD(float, m_stopFrequency);
+	ADD_FIELD(float, m_sweepDuration);
+
+	for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+
+		ma_frequencyData[j] = m_startFrequency * powf(m_stopFrequency / m_startFrequency, j / (float)(IMPRESP_PLOT_SIZE - 1));
+
+		for (int k = 0; k < IMPRESP_HARMONICS; ++k) {
+			ma_levelData[k][j] = IMPRESP_MIN_DB;
+		}
+	}
+
+	// start worker
+	m_worker = std::thread(&ImpulseResponse::run, this);
+}
+
+ImpulseResponse::~ImpulseResponse() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void ImpulseResponse::enableMeasurement(int enable) {
+
+	if (enable && !m_measuring) {
+
+		// save generator settings
+		m_savedOutput = mp_sigGen->isOutputEnabled();
+		m_savedWaveformType = mp_sigGen->getWaveformType();
+
+		if (!mp_osc->isOscEnabled()) {
+			mp_osc->enableOscilloscope(true);
+		}
+
+		// the whole sweep (delayed by the output buffer) and the decay have to fit in the record
+		MinMaxPyramid* p_record = mp_osc->getRecord(0);
+		float sampleRate = mp_osc->getSampleRate();
+
+		// sweeps above nyquist can't be played, the start frequency has to stay below the stop frequency
+		m_stop = min(m_stopFrequency, 0.45f * sampleRate);
+		m_start = min(m_startFrequency, 0.5f * m_stop);
+		m_duration = min(max(m_sweepDuration, 0.1f), IMPRESP_MAX_DURATION);
+
+		m_captureStart = p_record->getCount();
+		m_captureSize = (int)((mp_sigGen->getLatency() + m_duration + IMPRESP_TAIL_TIME) * sampleRate);
+		m_captureSize = min(m_captureSize, p_record->getCapacity() * 3 / 4);
+
+		// play one sweep
+		mp_sigGen->setSweep(m_start, m_stop, m_duration);
+		mp_sigGen->setWaveformType(4);
+
+		if (!mp_sigGen->isOutputEnabled()) {
+			mp_sigGen->enableOutput(true);
+		}
+
+		m_measuring = true;
+	}
+	else if (!enable && m_measuring) {
+
+		finishMeasurement();
+	}
+}
+
+void ImpulseResponse::setStartFrequency(float frequency) {
+
+	m_startFrequency = max(frequency, 1.0f);
+}
+
+void ImpulseResponse::setStopFrequency(float frequency) {
+
+	m_stopFrequency = max(frequency, 1.0f);
+}
+
+void ImpulseResponse::setSweepDuration(float duration) {
+
+	m_sweepDuration = min(max(duration, 0.1f), IMPRESP_MAX_DURATION);
+}
+
+bool ImpulseResponse::isMeasuring() {
+
+	return m_measuring;
+}
+
+float ImpulseResponse::getStartFrequency() {
+
+	return m_startFrequency;
+}
+
+float ImpulseResponse::getStopFrequency() {
+
+	return m_stopFrequency;
+}
+
+float ImpulseResponse::getSweepDuration() {
+
+	return m_sweepDuration;
+}
+
+float* ImpulseResponse::getTimeData() {
+
+	return m_timeData.data();
+}
+
+float* ImpulseResponse::getImpulseData() {
+
+	return m_impulseData.data();
+}
+
+int ImpulseResponse::getImpulseDataSize() {
+
+	return m_impulseData.size();
+}
+
+float* ImpulseResponse::getFrequencyData() {
+
+	return ma_frequencyData;
+}
+
+float* ImpulseResponse::getLevelData(int harmonic) {
+
+	return ma_levelData[harmonic];
+}
+
+int ImpulseResponse::getPlotDataSize() {
+
+	return IMPRESP_PLOT_SIZE;
+}
+
+int ImpulseResponse::getHarmonicCount() {
+
+	return IMPRESP_HARMONICS;
+}
+
+void ImpulseResponse::onTick(float deltaTime) {
+
+	if (m_measuring) {
+
+		MinMaxPyramid* p_record = mp_osc->getRecord(0);
+
+		// check if the sweep and the decay are recorded
+		if (p_record->getCount() >= m_captureStart + m_captureSize) {
+
+			ImpulseResponseJob job;
+			job.startFrequency = m_start;
+			job.stopFrequency = m_stop;
+			job.duration = m_duration;
+			job.sampleRate = mp_osc->getSampleRate();
+			job.amplitude = mp_sigGen->getAmplitude();
+
+			// CH1 is the reference, CH2 the response (mono devices are compared to the generator amplitude)
+			if (mp_osc->getChannelCount() > 1) {
+
+				job.reference.resize(m_captureSize);
+				job.response.resize(m_captureSize);
+
+				mp_osc->getRecord(0)->copy(m_captureStart, m_captureSize, job.reference.data());
+				mp_osc->getRecord(1)->copy(m_captureStart, m_captureSize, job.response.data());
+			}
+			else {
+
+				job.response.resize(m_captureSize);
+				mp_osc->getRecord(0)->copy(m_captureStart, m_captureSize, job.response.data());
+			}
+
+			// deconvolve on the worker
+			{
+				std::lock_guard<std::mutex> lock(m_queueMutex);
+				m_queue.push_back(std::move(job));
+			}
+			m_condition.notify_one();
+
+			finishMeasurement();
+		}
+	}
+
+	// show new result
+	bool updated;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		updated = m_updated;
+		m_updated = false;
+
+		if (updated) {
+
+			m_timeData.swap(m_result.time);
+			m_impulseData.swap(m_result.impulse);
+
+			memcpy(ma_frequencyData, m_result.frequencies, sizeof(ma_frequencyData));
+			memcpy(ma_levelData, m_result.levels, sizeof(ma_levelData));
+		}
+	}
+
+	if (updated) {
+		EMIT(onPlotUpdate);
+	}
+}
+
+void ImpulseResponse::onBegin() { }
+
+void ImpulseResponse::onClose() {
+
+	// leave the generator as it was
+	if (m_measuring) {
+		finishMeasurement();
+	}
+}
+
+void ImpulseResponse::finishMeasurement() {
+
+	m_measuring = false;
+
+	// restore generator settings
+	mp_sigGen->setWaveformType(m_savedWaveformType);
+
+	if (!m_savedOutput) {
+		mp_sigGen->enableOutput(false);
+	}
+
+	EMIT(onMeasurementChanged, 0);
+}
+
+void ImpulseResponse::run() {
+
+	std::unique_lock<std::mutex> lock(m_queueMutex);
+
+	while (true) {
+
+		// wait for a recorded sweep
+		m_condition.wait(lock, [this] { return !m_running || m_queue.size() > 0; });
+
+		if (!m_running) {
+			return;
+		}
+
+		ImpulseResponseJob job = std::move(m_queue.front());
+		m_queue.erase(m_queue.begin());
+
+		// analyze without holding the lock
+		lock.unlock();
+
+		ImpulseResponseResult result;
+		SweepAnalysis::analyze(job, result);
+
+		// publish result
+		{
+			std::lock_guard<std::mutex> resultLock(m_mutex);
+
+			m_result = std::move(result);
+			m_updated = true;
+		}
+
+		lock.lock();
+	}
+}
\ No newline at end of file
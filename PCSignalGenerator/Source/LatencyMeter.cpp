@@ -0,0 +1,412 @@
+#include "Gui.h"
+#include "LatencyMeter.h"
+#include "Common/Reflection/Internal.h"
+#include "FFT.h"
+
+#include <bit>
+#include <numbers>
+#include <math.h>
+
+LatencyMeter::LatencyMeter(SignalGenerator* p_sigGen, Oscilloscope* p_osc) : mp_sigGen(p_sigGen), mp_osc(p_osc),
+	m_savedOutput(false), m_savedWaveformType(0), m_measuring(false), m_nextMarker(0), m_lastLatency(0.0), m_nLost(0),
+	m_firstMarker(0), m_firstArrival(0.0), m_nFit(0), m_meanX(0.0), m_meanY(0.0), m_covXX(0.0), m_covXY(0.0), m_drift(0.0), m_breakMarker(0),
+	m_running(true), m_channel(0), m_correction(0) {
+
+	// add members to reflection
+	ADD_FIELD(int, m_channel);
+	ADD_FIELD(int, m_correction);
+
+	// start worker
+	m_worker = std::thread(&LatencyMeter::run, this);
+}
+
+LatencyMeter::~LatencyMeter() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void LatencyMeter::enableMeasurement(int enable) {
+
+	if (enable && !m_measuring) {
+
+		// save generator settings
+		m_savedOutput = mp_sigGen->isOutputEnabled();
+		m_savedWaveformType = mp_sigGen->getWaveformType();
+
+		if (!mp_osc->isOscEnabled()) {
+			mp_osc->enableOscilloscope(true);
+		}
+
+		// start with empty results
+		m_latency.clear();
+		m_lastLatency = 0.0;
+		m_nLost = 0;
+
+		m_nFit = 0;
+		m_meanX = 0.0;
+		m_meanY = 0.0;
+		m_covXX = 0.0;
+		m_covXY = 0.0;
+		m_drift = 0.0;
+		m_breakMarker = 0;
+
+		m_pending.clear();
+		m_nextMarker = 0;
+
+		// play markers (the first one starts with the next written sample)
+		mp_sigGen->setWaveformType(5);
+
+		if (!mp_sigGen->isOutputEnabled()) {
+			mp_sigGen->enableOutput(true);
+		}
+
+		m_measuring = true;
+		EMIT(onResultUpdate);
+	}
+	else if (!enable && m_measuring) {
+
+		finishMeasurement();
+	}
+}
+
+void LatencyMeter::enableCorrection(int enable) {
+
+	m_correction = enable;
+
+	// the last measured drift is kept after the measurement
+	if (m_correction && m_nFit >= LATENCY_CORRECTION_MARKERS) {
+		mp_sigGen->setClockCorrection(1.0 + m_drift * 1e-6);
+	}
+	else {
+		mp_sigGen->setClockCorrection(1.0);
+	}
+}
+
+void LatencyMeter::restartFit() {
+
+	if (!m_measuring) {
+		return;
+	}
+
+	// markers timed before a break in the capture don't relate to the record after it
+	m_pending.clear();
+	m_breakMarker = mp_sigGen->getMarkerStart() + m_nextMarker * mp_sigGen->getMarkerPeriod();
+
+	// the last drift is kept (and still corrects the generator) until the new fit has enough markers
+	m_nFit = 0;
+	m_meanX = 0.0;
+	m_meanY = 0.0;
+	m_covXX = 0.0;
+	m_covXY = 0.0;
+}
+
+void LatencyMeter::setChannel(int channel) {
+
+	m_channel = channel;
+}
+
+bool LatencyMeter::isMeasuring() {
+
+	return m_measuring;
+}
+
+bool LatencyMeter::isCorrectionEnabled() {
+
+	return m_correction;
+}
+
+int LatencyMeter::getChannel() {
+
+	return m_channel;
+}
+
+float LatencyMeter::getLatency() {
+
+	return m_lastLatency;
+}
+
+RunningStatistics* LatencyMeter::getStatistics() {
+
+	return &m_latency;
+}
+
+double LatencyMeter::getDrift() {
+
+	return m_drift;
+}
+
+int LatencyMeter::getMarkerCount() {
+
+	return m_nFit;
+}
+
+int LatencyMeter::getLostCount() {
+
+	return m_nLost;
+}
+
+bool LatencyMeter::locate(float* pa_marker, int markerSize, float* pa_src, int size, double& position) {
+
+	// zero padding makes the circular correlation linear
+	int fftSize = std::bit_ceil((unsigned int)(size + markerSize));
+	FFT& fft = FFT::getPlan(fftSize);
+
+	std::vector<float> buffer(fftSize, 0.0f);
+	std::vector<std::complex<float>> marker(fft.getBinCount());
+	std::vector<std::complex<float>> cross(fft.getBinCount());
+
+	std::copy(pa_marker, pa_marker + markerSize, buffer.begin());
+	fft.transform(buffer.data(), marker.data());
+
+	std::fill(buffer.begin(), buffer.end(), 0.0f);
+	std::copy(pa_src, pa_src + size, buffer.begin());
+	fft.transform(buffer.data(), cross.data());
+
+	for (int k = 0; k < cross.size(); ++k) {
+		cross[k] *= std::conj(marker[k]);
+	}
+
+	fft.inverse(cross.data(), buffer.data());
+
+	// largest correlation of all positions where the whole marker fits (the polarity may be inverted)
+	int peak = 0;
+	double energy = 0.0;
+
+	for (int lag = 0; lag <= size - markerSize; ++lag) {
+
+		energy += (double)buffer[lag] * buffer[lag];
+
+		if (fabsf(buffer[lag]) > fabsf(buffer[peak])) {
+			peak = lag;
+		}
+	}
+
+	// the marker is lost if the peak doesn't stand out of the correlation of the noise
+	double rms = sqrt(energy / (size - markerSize + 1));
+
+	if (fabsf(buffer[peak]) < LATENCY_MIN_PEAK * rms) {
+		return false;
+	}
+
+	// the remaining fraction is the slope of the cross spectrum phase after removing
+	// the integer lag (least squares fit through zero, weighted by the magnitude)
+	float polarity = buffer[peak] < 0.0f ? -1.0f : 1.0f;
+	double sumPhase = 0.0;
+	double sumSquares = 0.0;
+
+	for (int k = 1; k < cross.size(); ++k) {
+
+		double angle = 2.0 * std::numbers::pi * (((long long)k * peak) % fftSize) / fftSize;
+		std::complex<double> aligned = std::complex<double>(cross[k]) * std::polar((double)polarity, angle);
+
+		double weight = std::abs(aligned);
+		sumPhase += weight * k * std::arg(aligned);
+		sumSquares += weight * k * k;
+	}
+
+	double fraction = sumSquares > 0.0 ? -sumPhase / sumSquares * fftSize / (2.0 * std::numbers::pi) : 0.0;
+
+	position = peak + min(max(fraction, -1.0), 1.0);
+	return true;
+}
+
+void LatencyMeter::onTick(float deltaTime) {
+
+	if (m_measuring) {
+
+		float sampleRate = mp_osc->getSampleRate();
+		int period = mp_sigGen->getMarkerPeriod();
+		int markerSize = mp_sigGen->getMarkerSize();
+
+		double playback;
+		double playTime;
+		double capture;
+		double captureTime;
+
+		// time every marker that started playing since the last tick
+		if (mp_sigGen->getPlaybackPosition(playback, playTime) && mp_osc->getCapturePosition(capture, captureTime)) {
+
+			while (true) {
+
+				long long marker = mp_sigGen->getMarkerStart() + m_nextMarker * period;
+
+				if (playback < marker) {
+					break;
+				}
+
+				++m_nextMarker;
+
+				// the timestamps are only extrapolated over a short time, that way the difference
+				// between the nominal and the real sample rates doesn't matter
+				if (playback - marker > LATENCY_MAX_LATE * sampleRate) {
+					++m_nLost;
+					continue;
+				}
+
+				double markerTime = playTime + (marker - playback) / mp_sigGen->getSampleRate();
+
+				LatencyJob job;
+				job.marker = marker;
+				job.expected = capture + (markerTime - captureTime) * sampleRate;
+				job.first = (long long)floor(job.expected - LATENCY_PRE_TIME * sampleRate);
+				job.size = (int)((LATENCY_PRE_TIME + LATENCY_MAX_DELAY) * sampleRate) + markerSize;
+
+				m_pending.push_back(std::move(job));
+			}
+		}
+
+		// pass all completely recorded markers to the worker
+		MinMaxPyramid* p_record = mp_osc->getRecord(min(max(m_channel, 0), mp_osc->getChannelCount() - 1));
+
+		while (m_pending.size() > 0 && p_record->getCount() >= m_pending.front().first + m_pending.front().size) {
+
+			LatencyJob& job = m_pending.front();
+
+			job.samples.resize(job.size);
+			p_record->copy(job.first, job.size, job.samples.data());
+
+			{
+				std::lock_guard<std::mutex> lock(m_queueMutex);
+				m_queue.push_back(std::move(job));
+			}
+			m_condition.notify_one();
+
+			m_pending.erase(m_pending.begin());
+		}
+	}
+
+	// add located markers
+	std::vector<LatencyResult> results;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		results.swap(m_results);
+	}
+
+	for (LatencyResult& result : results) {
+		addResult(result);
+	}
+
+	if (results.size() > 0) {
+		EMIT(onResultUpdate);
+	}
+}
+
+void LatencyMeter::onBegin() { }
+
+void LatencyMeter::onClose() {
+
+	// leave the generator as it was
+	if (m_measuring) {
+		finishMeasurement();
+	}
+}
+
+void LatencyMeter::finishMeasurement() {
+
+	m_measuring = false;
+	m_pending.clear();
+
+	// restore generator settings
+	mp_sigGen->setWaveformType(m_savedWaveformType);
+
+	if (!m_savedOutput) {
+		mp_sigGen->enableOutput(false);
+	}
+
+	EMIT(onMeasurementChanged, 0);
+}
+
+void LatencyMeter::addResult(LatencyResult& result) {
+
+	// markers of an earlier measurement (or from before a break in the capture) are ignored
+	if (result.marker < mp_sigGen->getMarkerStart() || result.marker < m_breakMarker) {
+		return;
+	}
+
+	if (!result.found) {
+		++m_nLost;
+		return;
+	}
+
+	float sampleRate = mp_osc->getSampleRate();
+
+	m_lastLatency = (result.arrival - result.expected) / sampleRate;
+	m_latency.add(m_lastLatency);
+
+	// update the fit incrementally (Welford), the positions grow large over a long measurement
+	if (m_nFit == 0) {
+		m_firstMarker = result.marker;
+		m_firstArrival = result.arrival;
+	}
+
+	double x = result.marker - m_firstMarker;
+	double y = result.arrival - m_firstArrival;
+
+	++m_nFit;
+
+	double dx = x - m_meanX;
+	m_meanX += dx / m_nFit;
+	m_meanY += (y - m_meanY) / m_nFit;
+	m_covXX += dx * (x - m_meanX);
+	m_covXY += dx * (y - m_meanY);
+
+	if (m_nFit < 2 || m_covXX <= 0.0) {
+		return;
+	}
+
+	// captured samples per played sample relative to the nominal ratio of the sample rates
+	double slope = m_covXY / m_covXX * mp_sigGen->getSampleRate() / sampleRate;
+	m_drift = (slope - 1.0) * 1e6;
+
+	if (m_correction && m_nFit >= LATENCY_CORRECTION_MARKERS) {
+		mp_sigGen->setClockCorrection(slope);
+	}
+}
+
+void LatencyMeter::run() {
+
+	std::unique_lock<std::mutex> lock(m_queueMutex);
+
+	while (true) {
+
+		// wait for a recorded marker
+		m_condition.wait(lock, [this] { return !m_running || m_queue.size() > 0; });
+
+		if (!m_running) {
+			return;
+		}
+
+		LatencyJob job = std::move(m_queue.front());
+		m_queue.erase(m_queue.begin());
+
+		// locate without holding the lock
+		lock.unlock();
+
+		LatencyResult result;
+		result.marker = job.marker;
+		result.expected = job.expected;
+		result.arrival = 0.0;
+
+		double position;
+		result.found = locate(mp_sigGen->getMarker(), mp_sigGen->getMarkerSize(), job.samples.data(), job.size, position);
+
+		if (result.found) {
+			result.arrival = job.first + position;
+		}
+
+		// publish result
+		{
+			std::lock_guard<std::mutex> resultLock(m_mutex);
+			m_results.push_back(result);
+		}
+
+		lock.lock();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "Gui.h"
+#include "MinMaxPyramid.h"
+
+#include <bit>
+#include <float.h>
+
+MinMaxPyramid::MinMaxPyramid(int capacity) : m_count(0) {
+
+	// round capacity up to the next power of two, that way ring indices can be masked
+	m_capacity = std::bit_ceil((unsigned int)max(capacity, 2));
+	m_nLevels = std::bit_width((unsigned int)m_capacity);
+
+	// allocate all levels (level k holds capacity / 2^k blocks)
+	m_samples.resize(m_capacity, 0.0f);
+
+	m_min.resize(m_nLevels);
+	m_max.resize(m_nLevels);
+
+	for (int k = 1; k < m_nLevels; ++k) {
+		m_min[k].resize(m_capacity >> k, 0.0f);
+		m_max[k].resize(m_capacity >> k, 0.0f);
+	}
+}
+
+void MinMaxPyramid::push(float value) {
+
+	m_samples[m_count & (m_capacity - 1)] = value;
+	++m_count;
+
+	updateLevels();
+}
+
+void MinMaxPyramid::push(float* pa_data, int size) {
+
+	for (int i = 0; i < size; ++i) {
+		push(pa_data[i]);
+	}
+}
+
+void MinMaxPyramid::clear() {
+
+	m_count = 0;
+}
+
+long long MinMaxPyramid::getCount() {
+
+	return m_count;
+}
+
+long long MinMaxPyramid::getFirstAvailable() {
+
+	return max(m_count - m_capacity, 0LL);
+}
+
+int MinMaxPyramid::getCapacity() {
+
+	return m_capacity;
+}
+
+float MinMaxPyramid::getSample(long long index) {
+
+	// clamp index to the samples still available
+	index = min(max(index, getFirstAvailable()), m_count - 1);
+
+	if (index < 0) {
+		return 0.0f;
+	}
+
+	return m_samples[index & (m_capacity - 1)];
+}
+
+void MinMaxPyramid::copy(long long first, int size, float* pa_dst) {
+
+	for (int i = 0; i < size; ++i) {
+
+		long long index = first + i;
+
+		// samples that are not available (anymore) are set to zero
+		if (index < getFirstAvailable() || index >= m_count) {
+			pa_dst[i] = 0.0f;
+		}
+		else {
+			pa_dst[i] = m_samples[index & (m_capacity - 1)];
+		}
+	}
+}
+
+void MinMaxPyramid::getSegments(long long first, long long size, float** pa_segments, int* pa_sizes) {
+
+	// clamp range to the samples still available
+	long long last = min(first + size, m_count);
+	first = max(first, getFirstAvailable());
+	size = max(last - first, 0LL);
+
+	// the range wraps around the end of the ring at most once
+	int offset = (int)(first & (m_capacity - 1));
+	int firstSize = (int)min(size, (long long)(m_capacity - offset));
+
+	pa_segments[0] = m_samples.data() + offset;
+	pa_sizes[0] = firstSize;
+
+	pa_segments[1] = m_samples.data();
+	pa_sizes[1] = (int)size - firstSize;
+}
+
+void MinMaxPyramid::getMinMax(long long first, long long last, float& minValue, float& maxValue) {
+
+	minValue = FLT_MAX;
+	maxValue = -FLT_MAX;
+
+	// clamp range to the samples still available
+	first = max(first, getFirstAvailable());
+	last = min(last, m_count);
+
+	// cover the range with the largest aligned blocks that fit (O(log n) steps)
+	while (first < last) {
+
+		// the block size is limited by the alignment of first and the remaining length
+		int k = std::bit_width((unsigned long long)(last - first)) - 1;
+		if (first != 0) {
+			k = min(k, std::countr_zero((unsigned long long)first));
+		}
+		k = min(k, m_nLevels - 1);
+
+		if (k == 0) {
+
+			float value = m_samples[first & (m_capacity - 1)];
+			minValue = min(minValue, value);
+			maxValue = max(maxValue, value);
+		}
+		else {
+
+			int index = (first >> k) & ((m_capacity >> k) - 1);
+			minValue = min(minValue, m_min[k][index]);
+			maxValue = max(maxValue, m_max[k][index]);
+		}
+
+		first += 1LL << k;
+	}
+}
+
+void MinMaxPyramid::getEnvelope(long long first, long long nSamples, int nColumns, float* pa_min, float* pa_max) {
+
+	for (int i = 0; i < nColumns; ++i) {
+
+		// calculate sample range of this column
+		long long begin = first + nSamples * i / nColumns;
+		long long end = first + nSamples * (i + 1) / nColumns;
+
+		if (end <= begin) {
+			end = begin + 1;
+		}
+
+		getMinMax(begin, end, pa_min[i], pa_max[i]);
+
+		// fill columns without any available samples with zero
+		if (pa_min[i] > pa_max[i]) {
+			pa_min[i] = 0.0f;
+			pa_max[i] = 0.0f;
+		}
+	}
+}
+
+void MinMaxPyramid::updateLevels() {
+
+	// a block at level k completes every 2^k samples, so on average less than
+	// two blocks are combined per pushed sample
+	long long block = m_count;
+
+	for (int k = 1; k < m_nLevels && (block & 1) == 0; ++k) {
+
+		block >>= 1;
+
+		// index of the completed block at level k and its two children at level k - 1
+		long long j = block - 1;
+		int index = j & ((m_capacity >> k) - 1);
+		int left = (2 * j) & ((m_capacity >> (k - 1)) - 1);
+		int right = (2 * j + 1) & ((m_capacity >> (k - 1)) - 1);
+
+		if (k == 1) {
+			m_min[k][index] = min(m_samples[left], m_samples[right]);
+			m_max[k][index] = max(m_samples[left], m_samples[right]);
+		}
+		else {
+			m_min[k][index] = min(m_min[k - 1][left], m_min[k - 1][right]);
+			m_max[k][index] = max(m_max[k - 1][left], m_max[k - 1][right]);
+		}
+	}
+}
\ No newline at end of file
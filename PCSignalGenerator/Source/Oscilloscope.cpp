@@ -1,19 +1,32 @@
 #include "Gui.h"
 #include "Oscilloscope.h"
 #include "Common/Reflection/Internal.h"
+#include "DSPUtils.h"
+#include "Style/Palette.h"
 
 #include <numbers>
 #include <assert.h>
+#include <math.h>
 
 #define REFTIMES_PER_SEC 1000000
 
 const IID IID_IAudioCaptureClient = __uuidof(IAudioCaptureClient);
 
-Oscilloscope::Oscilloscope() : m_head(0), m_lastValue(0.0f), m_enable(false), m_nSamplesSkiped(1) {
+Oscilloscope::Oscilloscope() : m_lastValue(0.0f), m_enable(false), m_aquisitionMode(0), m_triggerLevel(0.0f), m_span(OSC_DATA_BUFFER_SIZE), m_triggerSource(0), m_mathMode(0), m_persistence(0), m_spectrumChannel(0),
+	m_distortionChannel(0), m_measurementChannel(0), m_transferReference(0), m_transferChannel(1), m_selectedSegment(0), m_segmentView(0), m_etsWindow(OSC_DATA_BUFFER_SIZE),
+	m_capturePosition(-1), m_captureTime(0.0) {
 
 	// add members to reflection
 	ADD_FIELD(int, m_aquisitionMode);
 	ADD_FIELD(float, m_triggerLevel);
+	ADD_FIELD(int, m_triggerSource);
+	ADD_FIELD(int, m_mathMode);
+	ADD_FIELD(int, m_persistence);
+	ADD_FIELD(int, m_spectrumChannel);
+	ADD_FIELD(int, m_distortionChannel);
+	ADD_FIELD(int, m_measurementChannel);
+	ADD_FIELD(int, m_transferReference);
+	ADD_FIELD(int, m_transferChannel);
 
 	// initialize audio devices
 	HRESULT hr;
@@ -51,6 +64,49 @@ Oscilloscope::Oscilloscope() : m_head(0), m_lastValue(0.0f), m_enable(false), m_
 	// set sample rate
 	m_sampleRate = mp_format->nSamplesPerSec;
 
+	// create records and buffers for all channels and the math channel
+	m_nChannels = mp_format->nChannels;
+
+	m_records.reserve(m_nChannels + 1);
+	for (int c = 0; c <= m_nChannels; ++c) {
+		m_records.emplace_back(OSC_RECORD_SIZE);
+	}
+
+	m_channelData.resize(m_nChannels + 1);
+	for (int c = 0; c <= m_nChannels; ++c) {
+		mp_plotBuffers.push_back(new DataBuffer(OSC_DATA_BUFFER_SIZE));
+	}
+
+	m_channelScale.resize(m_nChannels + 1, 1.0f);
+
+	// create filter stage (designs run on its own thread)
+	mp_filter = new FilterStage(m_sampleRate, m_nChannels);
+
+	// preallocate segments for all channels and the math channel
+	mp_segmentPool = new SegmentPool(OSC_SEGMENT_COUNT, m_nChannels + 1, OSC_SEGMENT_SIZE);
+	mp_segmentRecorder = new SegmentRecorder(mp_segmentPool, OSC_DATA_BUFFER_SIZE);
+
+	// create persistence map (one pixel column per plot column)
+	mp_persistence = new PersistenceMap(OSC_DATA_BUFFER_SIZE / 2, OSC_PERSISTENCE_HEIGHT, -OSC_PERSISTENCE_RANGE, OSC_PERSISTENCE_RANGE, Palette::Plot(0));
+
+	// create equivalent-time samplers (one bin per plot point)
+	m_etsSamplers.resize(m_nChannels + 1, EquivalentTimeSampler(OSC_DATA_BUFFER_SIZE, OSC_ETS_AVERAGE));
+
+	// create spectrum analyzer
+	mp_spectrum = new SpectrumAnalyzer(m_sampleRate, OSC_SPECTRUM_SIZE);
+
+	// create spectrogram
+	mp_spectrogram = new Spectrogram(m_sampleRate, SPECTROGRAM_WIDTH, SPECTROGRAM_HEIGHT, SPECTROGRAM_SIZE);
+
+	// create distortion analyzer
+	mp_distortion = new DistortionAnalyzer(m_sampleRate);
+
+	// create transfer function analyzer
+	mp_transfer = new TransferFunctionAnalyzer(m_sampleRate, TRANSFER_SIZE);
+
+	// create waveform measurements
+	mp_measurements = new WaveformMeasurements();
+
 	// initialize audio client
 	hr = mp_audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED, 0, REFTIMES_PER_SEC, 0, mp_format, NULL);
 	assert(SUCCEEDED(hr));
@@ -63,6 +119,13 @@ Oscilloscope::Oscilloscope() : m_head(0), m_lastValue(0.0f), m_enable(false), m_
 	hr = mp_audioClient->GetBufferSize(&m_bufferSize);
 	assert(SUCCEEDED(hr));
 
+	// a packet never holds more frames than the endpoint buffer
+	mp_channels.resize(m_nChannels + 1);
+	for (int c = 0; c <= m_nChannels; ++c) {
+		m_channelData[c].resize(m_bufferSize);
+		mp_channels[c] = m_channelData[c].data();
+	}
+
 	enableOscilloscope(true);
 }
 
@@ -74,17 +137,58 @@ Oscilloscope::~Oscilloscope() {
 	mp_audioClient->Release();
 	mp_audioDevice->Release();
 
+	delete mp_filter;
+	delete mp_segmentRecorder;
+	delete mp_segmentPool;
+	delete mp_persistence;
+	delete mp_spectrum;
+	delete mp_spectrogram;
+	delete mp_distortion;
+	delete mp_transfer;
+	delete mp_measurements;
+
+	for (DataBuffer* p_buffer : mp_plotBuffers) {
+		delete p_buffer;
+	}
+
 	CoUninitialize();
 }
 
-float* Oscilloscope::getPlotData() {
+DataBuffer* Oscilloscope::getPlotBuffer(int channel) {
 
-	return ma_data;
+	return mp_plotBuffers[channel];
 }
 
-int Oscilloscope::getPlotDataSize() {
+int Oscilloscope::getChannelCount() {
 
-	return OSC_DATA_BUFFER_SIZE;
+	return m_nChannels;
+}
+
+int Oscilloscope::getMathChannel() {
+
+	return m_nChannels;
+}
+
+MinMaxPyramid* Oscilloscope::getRecord(int channel) {
+
+	return &m_records[channel];
+}
+
+float Oscilloscope::getSampleRate() {
+
+	return m_sampleRate;
+}
+
+bool Oscilloscope::getCapturePosition(double& position, double& time) {
+
+	// no packet with a valid timestamp yet
+	if (m_capturePosition < 0) {
+		return false;
+	}
+
+	position = m_capturePosition;
+	time = m_captureTime;
+	return true;
 }
 
 void Oscilloscope::enableOscilloscope(int enable) {
@@ -93,6 +197,11 @@ void Oscilloscope::enableOscilloscope(int enable) {
 
 	if (m_enable) {
 		mp_audioClient->Start();
+
+		// start a new sequence of segments
+		if (m_aquisitionMode == 2) {
+			rearmSegments();
+		}
 	}
 	else {
 		mp_audioClient->Stop();
@@ -101,15 +210,30 @@ void Oscilloscope::enableOscilloscope(int enable) {
 
 void Oscilloscope::calculateSampleRate(Math::Size plotBounds) {
 
-	// calculate optimal sample rate (Data should span two times the width of the plot)
-	float exactSampleRate = OSC_DATA_BUFFER_SIZE / plotBounds.width() / 2.0f;
+	// the record is always captured at full rate, zooming only changes the span
+	// that is reduced into the plot data (Data should span two times the width of the plot)
+	m_span = plotBounds.width() * 2.0f * m_sampleRate;
+	m_span = min(max(m_span, 2LL), (long long)m_records[0].getCapacity());
 
-	// calculate every nth sample to be chosen and real sample rate
-	m_nSamplesSkiped = max(mp_format->nSamplesPerSec / exactSampleRate, 1);
-	m_sampleRate = mp_format->nSamplesPerSec / ((float) m_nSamplesSkiped);
+	// equivalent-time sampling can zoom in below one sample per plot point
+	double window = plotBounds.width() * 2.0 * m_sampleRate;
+	window = min(max(window, 2.0), (double)OSC_DATA_BUFFER_SIZE);
+
+	if (window != m_etsWindow) {
+		m_etsWindow = window;
+		rearmEquivalentTime();
+	}
+
+	// update plot bounds (segments keep the size they were armed with)
+	float bounds = m_span / m_sampleRate / 2;
+
+	if (m_aquisitionMode == 2) {
+		bounds = mp_segmentRecorder->getSize() / m_sampleRate / 2;
+	}
+	else if (m_aquisitionMode == 3) {
+		bounds = m_etsWindow / m_sampleRate / 2;
+	}
 
-	// update plot bounds
-	float bounds = OSC_DATA_BUFFER_SIZE / m_sampleRate / 2;
 	EMIT(onBoundsChange, -bounds, bounds);
 }
 
@@ -121,11 +245,127 @@ bool Oscilloscope::isOscEnabled() {
 void Oscilloscope::setAquisitionMode(int mode) {
 
 	m_aquisitionMode = mode;
+
+	// start a new sequence of segments
+	if (m_aquisitionMode == 2) {
+		rearmSegments();
+	}
+
+	// start a new equivalent-time reconstruction
+	if (m_aquisitionMode == 3) {
+		rearmEquivalentTime();
+
+		float bounds = m_etsWindow / m_sampleRate / 2;
+		EMIT(onBoundsChange, -bounds, bounds);
+	}
 }
 
 void Oscilloscope::setTriggerLevel(float level) {
 
 	m_triggerLevel = level;
+
+	// acquisitions of different trigger levels don't line up
+	rearmEquivalentTime();
+}
+
+void Oscilloscope::setTriggerSource(int source) {
+
+	m_triggerSource = source;
+
+	rearmEquivalentTime();
+}
+
+void Oscilloscope::setMathMode(int mode) {
+
+	m_mathMode = mode;
+}
+
+void Oscilloscope::setChannelScale(int channel, float scale) {
+
+	m_channelScale[channel] = scale;
+}
+
+void Oscilloscope::setSelectedSegment(int segment) {
+
+	m_selectedSegment = min(max(segment, 0), OSC_SEGMENT_COUNT - 1);
+
+	if (m_aquisitionMode == 2) {
+		updateSegmentPlotData();
+		EMIT(onPlotUpdate);
+	}
+}
+
+void Oscilloscope::setSegmentView(int view) {
+
+	m_segmentView = view;
+
+	if (m_aquisitionMode == 2) {
+		updateSegmentPlotData();
+		EMIT(onPlotUpdate);
+	}
+}
+
+void Oscilloscope::setPersistence(int persistence) {
+
+	m_persistence = persistence;
+
+	// start with an empty map
+	mp_persistence->clear();
+}
+
+void Oscilloscope::setSpectrumChannel(int channel) {
+
+	m_spectrumChannel = channel;
+}
+
+void Oscilloscope::setDistortionChannel(int channel) {
+
+	m_distortionChannel = channel;
+}
+
+void Oscilloscope::setMeasurementChannel(int channel) {
+
+	m_measurementChannel = channel;
+
+	// statistics of different channels don't belong together
+	mp_measurements->clearStatistics();
+}
+
+void Oscilloscope::setTransferReference(int channel) {
+
+	m_transferReference = channel;
+
+	// averages (and the delay) of different channels don't belong together
+	mp_transfer->clear();
+}
+
+void Oscilloscope::setTransferChannel(int channel) {
+
+	m_transferChannel = channel;
+
+	mp_transfer->clear();
+}
+
+void Oscilloscope::rearmSegments() {
+
+	// remove all segments, they capture the current span (limited by the preallocated size)
+	mp_segmentRecorder->arm(min(m_span, (long long)mp_segmentPool->getMaxSize()));
+	m_selectedSegment = 0;
+
+	float bounds = mp_segmentRecorder->getSize() / m_sampleRate / 2;
+	EMIT(onBoundsChange, -bounds, bounds);
+	EMIT(onSegmentCaptured, 0);
+}
+
+void Oscilloscope::rearmEquivalentTime() {
+
+	// remove all acquisitions
+	m_etsTriggerLoc.clear();
+
+	for (EquivalentTimeSampler& sampler : m_etsSamplers) {
+		sampler.setWindow(m_etsWindow);
+		sampler.clear();
+	}
 }
 
 int Oscilloscope::getAquisitionMode() {
@@ -138,6 +378,106 @@ float Oscilloscope::getTriggerLevel() {
 	return m_triggerLevel;
 }
 
+int Oscilloscope::getTriggerSource() {
+
+	return m_triggerSource;
+}
+
+int Oscilloscope::getMathMode() {
+
+	return m_mathMode;
+}
+
+float Oscilloscope::getChannelScale(int channel) {
+
+	return m_channelScale[channel];
+}
+
+int Oscilloscope::getSegmentCount() {
+
+	return mp_segmentPool->getCount();
+}
+
+int Oscilloscope::getSegmentCapacity() {
+
+	return mp_segmentPool->getCapacity();
+}
+
+int Oscilloscope::getSpectrumChannel() {
+
+	return m_spectrumChannel;
+}
+
+SpectrumAnalyzer* Oscilloscope::getSpectrumAnalyzer() {
+
+	return mp_spectrum;
+}
+
+Spectrogram* Oscilloscope::getSpectrogram() {
+
+	return mp_spectrogram;
+}
+
+int Oscilloscope::getDistortionChannel() {
+
+	return m_distortionChannel;
+}
+
+DistortionAnalyzer* Oscilloscope::getDistortionAnalyzer() {
+
+	return mp_distortion;
+}
+
+int Oscilloscope::getMeasurementChannel() {
+
+	return m_measurementChannel;
+}
+
+WaveformMeasurements* Oscilloscope::getMeasurements() {
+
+	return mp_measurements;
+}
+
+FilterStage* Oscilloscope::getFilterStage() {
+
+	return mp_filter;
+}
+
+int Oscilloscope::getTransferReference() {
+
+	return m_transferReference;
+}
+
+int Oscilloscope::getTransferChannel() {
+
+	return m_transferChannel;
+}
+
+TransferFunctionAnalyzer* Oscilloscope::getTransferAnalyzer() {
+
+	return mp_transfer;
+}
+
+int Oscilloscope::getPersistence() {
+
+	return m_persistence;
+}
+
+unsigned int* Oscilloscope::getPersistenceImage() {
+
+	return mp_persistence->getPixels();
+}
+
+int Oscilloscope::getPersistenceWidth() {
+
+	return mp_persistence->getWidth();
+}
+
+int Oscilloscope::getPersistenceHeight() {
+
+	return mp_persistence->getHeight();
+}
+
 void Oscilloscope::onTick(float deltaTime) {
 
 	if (m_enable) {
@@ -146,59 +486,138 @@ void Oscilloscope::onTick(float deltaTime) {
 		HRESULT hr;
 		DWORD flags;
 
-		unsigned int padding;
-		unsigned int availableFrames;
+		unsigned int packetSize;
+		long long nCaptured = 0;
+
+		// drain all packets captured since the last tick (a packet only holds about 10 ms)
+		while (SUCCEEDED(mp_audioCaptureClient->GetNextPacketSize(&packetSize)) && packetSize > 0) {
+
+			// create buffer
+			BYTE* p_buffer;
+			unsigned int availableFrames;
+			UINT64 qpcPosition;
 
-		// get padding size
-		hr = mp_audioClient->GetCurrentPadding(&padding);
-		assert(SUCCEEDED(hr));
+			hr = mp_audioCaptureClient->GetBuffer(&p_buffer, &availableFrames, &flags, NULL, &qpcPosition);
 
-		// calculate available space
-		availableFrames = m_bufferSize - padding;
+			if (FAILED(hr)) {
+				break;
+			}
 
-		// create buffer
-		BYTE* p_buffer;
+			// samples were lost before this packet, so the record doesn't continue the earlier samples
+			if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {
+				handleDiscontinuity();
+			}
 
-		// get all available buffer space
-		hr = mp_audioCaptureClient->GetBuffer(&p_buffer, &availableFrames, &flags, NULL, NULL);
-		assert(SUCCEEDED(hr));
+			// remember when the first frame of the packet was recorded (relates the record to the output clock)
+			if (availableFrames > 0 && !(flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR)) {
+				m_capturePosition = m_records[0].getCount();
+				m_captureTime = qpcPosition * 1e-7;
+			}
 
-		// convert to float
-		float* p_floatBuffer = (float*)p_buffer;
+			addPacket((float*)p_buffer, availableFrames);
+			nCaptured += availableFrames;
 
-		// iterate over all datapoints and copy manually, that way triggering can be implemented
-		for (int i = 0; i < availableFrames; i+= m_nSamplesSkiped) {
+			// release buffer
+			hr = mp_audioCaptureClient->ReleaseBuffer(availableFrames);
+			assert(SUCCEEDED(hr));
+		}
 
-			float value = p_floatBuffer[mp_format->nChannels * i];
-			ma_data[m_head] = value;
+		// show the latest results of the analyzers
+		mp_spectrum->update();
+		mp_spectrogram->update();
+		mp_distortion->update();
+		mp_transfer->update();
 
-			// check if trigger can be emitted (the program waits half the buffer to
-			// fill up with new data and only then emits the trigger signal)
-			handleTriggerTiming();
+		// check if trigger can be emitted (the program waits half the span to
+		// fill up with new data and only then emits the trigger signal)
+		handleTriggerTiming();
 
-			// check aquisition mode and calculate new head position for plot
-			handleAquisitionMode(value);
-			
-			// increase and possibly wrap head
-			if (++m_head == OSC_DATA_BUFFER_SIZE) {
-				m_head = 0;
-			}
+		// store all segments of which the post-trigger window was captured
+		handleSegments();
 
-			// set last value
-			m_lastValue = value;
+		// add all acquisitions of which the post-trigger window was captured
+		handleEquivalentTime();
+
+		// in rolling mode the latest span is plotted once per tick
+		if (m_aquisitionMode == 1 && nCaptured > 0) {
+
+			updatePlotData(m_records[0].getCount() - m_span);
+
+			EMIT(onTrigger, 0);
+			EMIT(onPlotUpdate);
 		}
+	}
+}
+
+void Oscilloscope::addPacket(float* pa_data, int nFrames) {
+
+	// deinterleave all channels into planar buffers (sized for a whole endpoint buffer)
+	DSP::deinterleave(pa_data, m_nChannels, nFrames, mp_channels.data());
+
+	// filter captured channels (everything after this sees the filtered signal)
+	mp_filter->process(mp_channels.data(), nFrames);
+
+	// calculate math channel
+	calculateMathChannel(nFrames);
 
-		// release buffer
-		hr = mp_audioCaptureClient->ReleaseBuffer(availableFrames);
-		assert(SUCCEEDED(hr));
+	// add all channels to their records
+	for (int c = 0; c <= m_nChannels; ++c) {
+		m_records[c].push(mp_channels[c], nFrames);
+	}
+
+	// pass the selected channel to the spectrum analyzer
+	int spectrumChannel = min(max(m_spectrumChannel, 0), m_nChannels);
+	mp_spectrum->addSamples(mp_channels[spectrumChannel], nFrames);
+	mp_spectrogram->addSamples(mp_channels[spectrumChannel], nFrames);
+
+	// same for the distortion analyzer
+	int distortionChannel = min(max(m_distortionChannel, 0), m_nChannels);
+	mp_distortion->addSamples(mp_channels[distortionChannel], nFrames);
+
+	// the transfer function analyzer takes a reference and a measured channel
+	int transferReference = min(max(m_transferReference, 0), m_nChannels);
+	int transferChannel = min(max(m_transferChannel, 0), m_nChannels);
+	mp_transfer->addSamples(mp_channels[transferReference], mp_channels[transferChannel], nFrames);
+
+	// iterate over the trigger source, that way triggering can be implemented
+	int source = min(max(m_triggerSource, 0), m_nChannels);
+	long long first = m_records[source].getCount() - nFrames;
+
+	for (int i = 0; i < nFrames; ++i) {
+
+		float value = mp_channels[source][i];
+
+		// check aquisition mode and register trigger events
+		handleAquisitionMode(value, first + i);
+
+		// set last value
+		m_lastValue = value;
 	}
 }
 
+void Oscilloscope::handleDiscontinuity() {
+
+	// pending trigger events span the gap, a trigger needs two samples of the new data
+	m_triggerLoc.clear();
+	m_lastValue = NAN;
+
+	// segments continue after the gap (the ones already stored stay valid)
+	mp_segmentRecorder->restart(m_records[0].getCount());
+
+	// acquisitions before and after the gap don't line up
+	rearmEquivalentTime();
+
+	// the timestamp of an earlier packet doesn't relate to the record anymore
+	m_capturePosition = -1;
+
+	EMIT(onDiscontinuity);
+}
+
 void Oscilloscope::onBegin() { }
 
 void Oscilloscope::onClose() { }
 
-void Oscilloscope::handleAquisitionMode(float value) {
+void Oscilloscope::handleAquisitionMode(float value, long long index) {
 
 	switch (m_aquisitionMode) {
 
@@ -207,19 +626,30 @@ void Oscilloscope::handleAquisitionMode(float value) {
 		// check if signal changed sign
 		if (m_lastValue < m_triggerLevel && value > m_triggerLevel) {
 
-			// calculate new head for plot data, so that the triggerd sample is in the center
-			int head = (m_head + OSC_DATA_BUFFER_SIZE / 2) % OSC_DATA_BUFFER_SIZE;
-
-			// add to vectors
-			m_triggerLoc.push_back(head);
+			// store record index of the triggered sample
+			m_triggerLoc.push_back(index);
 		}
 		break;
 	}
 	case 1: { // rolling
 
-		EMIT(onTrigger, m_head);
-		EMIT(onPlotUpdate);
+		// plot is updated once per tick in onTick
+		break;
+	}
+	case 2: { // segmented
 
+		// the trigger is re-armed directly after the post-trigger window of the last segment
+		mp_segmentRecorder->trigger(m_lastValue, value, m_triggerLevel, index);
+		break;
+	}
+	case 3: { // equivalent-time
+
+		// check if signal changed sign, the exact crossing is found once the samples around it are captured
+		if (m_lastValue < m_triggerLevel && value > m_triggerLevel) {
+
+			// store record index of the triggered sample
+			m_etsTriggerLoc.push_back(index);
+		}
 		break;
 	}
 	}
@@ -227,19 +657,244 @@ void Oscilloscope::handleAquisitionMode(float value) {
 
 void Oscilloscope::handleTriggerTiming() {
 
-	// check only first trigger event
-	if (m_triggerLoc.size() > 0) {
+	// find the last trigger event of which the second half of the span was captured
+	int nReady = 0;
+	while (nReady < m_triggerLoc.size() && m_triggerLoc[nReady] + m_span / 2 <= m_records[0].getCount()) {
+		++nReady;
+	}
 
-		// calculate estimaded head
-		int estimHead = (m_triggerLoc.front() + OSC_DATA_BUFFER_SIZE / 2) % OSC_DATA_BUFFER_SIZE;
-		if (estimHead == m_head) {
+	// every triggered waveform is folded into the persistence map
+	if (m_persistence) {
 
-			// emit signal
-			EMIT(onTrigger, m_triggerLoc.front());
-			EMIT(onPlotUpdate);
+		int source = min(max(m_triggerSource, 0), m_nChannels);
+		float a_min[OSC_DATA_BUFFER_SIZE / 2];
+		float a_max[OSC_DATA_BUFFER_SIZE / 2];
+
+		for (int t = 0; t < nReady; ++t) {
+
+			m_records[source].getEnvelope(m_triggerLoc[t] - m_span / 2, m_span, OSC_DATA_BUFFER_SIZE / 2, a_min, a_max);
+
+			for (int i = 0; i < OSC_DATA_BUFFER_SIZE / 2; ++i) {
+				a_min[i] *= m_channelScale[source];
+				a_max[i] *= m_channelScale[source];
+			}
+
+			mp_persistence->addWaveform(a_min, a_max);
+		}
+	}
+
+	// only the last one is plotted, all earlier ones would be overwritten within the same tick
+	if (nReady > 0) {
 
-			// remove trigger event
-			m_triggerLoc.erase(m_triggerLoc.begin());
+		// update persistence image
+		if (m_persistence) {
+			mp_persistence->render();
 		}
+
+		// calculate plot data, so that the triggerd sample is in the center
+		updatePlotData(m_triggerLoc[nReady - 1] - m_span / 2);
+
+		// emit signal
+		EMIT(onTrigger, 0);
+		EMIT(onPlotUpdate);
+
+		// remove trigger events
+		m_triggerLoc.erase(m_triggerLoc.begin(), m_triggerLoc.begin() + nReady);
+	}
+}
+
+void Oscilloscope::handleSegments() {
+
+	// store all segments of which the post-trigger window was captured
+	int nStored = mp_segmentRecorder->store(m_records, m_sampleRate);
+
+	// every segment is one acquisition of the statistics
+	int channel = min(max(m_measurementChannel, 0), m_nChannels);
+
+	for (int segment = mp_segmentPool->getCount() - nStored; segment < mp_segmentPool->getCount(); ++segment) {
+		mp_measurements->measure(mp_segmentPool->getSegmentData(segment, channel), mp_segmentRecorder->getSize(), m_sampleRate, m_channelScale[channel]);
+	}
+
+	if (nStored > 0) {
+
+		// show latest segment
+		m_selectedSegment = mp_segmentPool->getCount() - 1;
+		updateSegmentPlotData();
+
+		// emit signal
+		EMIT(onTrigger, 0);
+		EMIT(onPlotUpdate);
+		EMIT(onSegmentCaptured, mp_segmentPool->getCount());
+	}
+}
+
+void Oscilloscope::handleEquivalentTime() {
+
+	int source = min(max(m_triggerSource, 0), m_nChannels);
+	int nAdded = 0;
+
+	// the window around the trigger plus the interpolation kernel
+	int halfSize = (int)ceil(m_etsWindow / 2) + DSP_SINC_HALF_WIDTH + 1;
+	m_etsBuffer.resize(2 * halfSize + 1);
+
+	// find all acquisitions of which the post-trigger window was captured
+	int nReady = 0;
+	while (nReady < m_etsTriggerLoc.size() && m_etsTriggerLoc[nReady] + halfSize < m_records[0].getCount()) {
+		++nReady;
+	}
+
+	// high trigger rates are decimated evenly, so a tick doesn't take longer than the capture
+	int step = (nReady + OSC_ETS_MAX_TRIGGERS - 1) / OSC_ETS_MAX_TRIGGERS;
+
+	for (int i = 0; i < nReady; ++i) {
+
+		long long trigger = m_etsTriggerLoc.front();
+		long long first = trigger - halfSize;
+
+		m_etsTriggerLoc.pop_front();
+
+		// skip decimated acquisitions and those that are not in the record anymore
+		if (i % step != 0 || first < m_records[source].getFirstAvailable()) {
+			continue;
+		}
+
+		// find the sub-sample trigger time, it is different for every acquisition
+		// and places the samples on different bins of the fine time grid
+		m_records[source].copy(first, m_etsBuffer.size(), m_etsBuffer.data());
+		double crossing = DSP::findCrossing(m_etsBuffer.data(), halfSize, m_triggerLevel);
+
+		for (int c = 0; c <= m_nChannels; ++c) {
+
+			m_records[c].copy(first, m_etsBuffer.size(), m_etsBuffer.data());
+			m_etsSamplers[c].add(m_etsBuffer.data(), m_etsBuffer.size(), -crossing);
+		}
+
+		++nAdded;
+	}
+
+	if (nAdded > 0) {
+
+		int channel = min(max(m_measurementChannel, 0), m_nChannels);
+
+		// reconstruct plot data of all channels
+		for (int c = 0; c <= m_nChannels; ++c) {
+
+			float* p_data = mp_plotBuffers[c]->beginWrite();
+			m_etsSamplers[c].reconstruct(p_data, m_channelScale[c]);
+
+			// measure the reconstruction (it is already scaled and has a finer time grid)
+			if (c == channel) {
+				mp_measurements->measure(p_data, OSC_DATA_BUFFER_SIZE, m_sampleRate * OSC_DATA_BUFFER_SIZE / m_etsWindow, 1.0f);
+			}
+
+			mp_plotBuffers[c]->publish();
+		}
+
+		// emit signal
+		EMIT(onTrigger, 0);
+		EMIT(onPlotUpdate);
+	}
+}
+
+void Oscilloscope::calculateMathChannel(int nFrames) {
+
+	// A is the first and B the second channel (or the first one again for mono devices)
+	float* p_a = m_channelData[0].data();
+	float* p_b = m_channelData[min(1, m_nChannels - 1)].data();
+	float* p_math = m_channelData[m_nChannels].data();
+
+	switch (m_mathMode) {
+
+	case 1: { // A + B
+
+		for (int i = 0; i < nFrames; ++i) {
+			p_math[i] = p_a[i] + p_b[i];
+		}
+		break;
+	}
+	case 2: { // A - B
+
+		for (int i = 0; i < nFrames; ++i) {
+			p_math[i] = p_a[i] - p_b[i];
+		}
+		break;
+	}
+	default: { // off
+
+		for (int i = 0; i < nFrames; ++i) {
+			p_math[i] = 0.0f;
+		}
+		break;
+	}
+	}
+}
+
+void Oscilloscope::updatePlotData(long long first) {
+
+	for (int c = 0; c <= m_nChannels; ++c) {
+
+		float* p_data = mp_plotBuffers[c]->beginWrite();
+		float scale = m_channelScale[c];
+
+		if (m_span >= OSC_DATA_BUFFER_SIZE) {
+
+			// reduce the span to a min/max envelope with two points per column
+			float a_min[OSC_DATA_BUFFER_SIZE / 2];
+			float a_max[OSC_DATA_BUFFER_SIZE / 2];
+
+			m_records[c].getEnvelope(first, m_span, OSC_DATA_BUFFER_SIZE / 2, a_min, a_max);
+
+			for (int i = 0; i < OSC_DATA_BUFFER_SIZE / 2; ++i) {
+				p_data[2 * i] = scale * a_min[i];
+				p_data[2 * i + 1] = scale * a_max[i];
+			}
+		}
+		else {
+
+			// less samples than plot points, pick the nearest sample
+			for (int i = 0; i < OSC_DATA_BUFFER_SIZE; ++i) {
+				p_data[i] = scale * m_records[c].getSample(first + i * m_span / OSC_DATA_BUFFER_SIZE);
+			}
+		}
+
+		mp_plotBuffers[c]->publish();
+	}
+
+	// measure the plotted span of the selected channel at full rate, in place in the record (a long span
+	// is only measured around its center, where the trigger is, that way a tick doesn't scan the whole record)
+	int channel = min(max(m_measurementChannel, 0), m_nChannels);
+	long long size = min(m_span, (long long)OSC_MEASUREMENT_SIZE);
+
+	float* a_segments[2];
+	int a_sizes[2];
+
+	m_records[channel].getSegments(first + (m_span - size) / 2, size, a_segments, a_sizes);
+
+	mp_measurements->measure(a_segments, a_sizes, 2, m_sampleRate, m_channelScale[channel]);
+}
+
+void Oscilloscope::updateSegmentPlotData() {
+
+	// show either the selected segment or an overlay of all segments
+	int first = m_segmentView == 1 ? 0 : m_selectedSegment;
+	int last = m_segmentView == 1 ? mp_segmentPool->getCount() : m_selectedSegment + 1;
+
+	for (int c = 0; c <= m_nChannels; ++c) {
+
+		float* p_data = mp_plotBuffers[c]->beginWrite();
+		float scale = m_channelScale[c];
+
+		// reduce segments to a min/max envelope with two points per column
+		float a_min[OSC_DATA_BUFFER_SIZE / 2];
+		float a_max[OSC_DATA_BUFFER_SIZE / 2];
+
+		mp_segmentPool->getEnvelope(first, last, c, OSC_DATA_BUFFER_SIZE / 2, a_min, a_max);
+
+		for (int i = 0; i < OSC_DATA_BUFFER_SIZE / 2; ++i) {
+			p_data[2 * i] = scale * a_min[i];
+			p_data[2 * i + 1] = scale * a_max[i];
+		}
+
+		mp_plotBuffers[c]->publish();
 	}
 }
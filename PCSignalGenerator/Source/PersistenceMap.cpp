@@ -0,0 +1,217 @@
+#include "Gui.h"
+#include "PersistenceMap.h"
+
+#include <immintrin.h>
+#include <math.h>
+
+#define PERSISTENCE_MAX_QUEUE 1024 // maximum number of pending waveforms
+
+PersistenceMap::PersistenceMap(int width, int height, float lower, float upper, Color color) :
+	m_width(width), m_height(height), m_lower(lower), m_upper(upper), m_decay(0.995f),
+	m_weight(1.0f), m_nWaveforms(0), m_running(true) {
+
+	// allocate buffers
+	m_hits.resize(m_width * m_height, 0.0f);
+	m_pixels.resize(m_width * m_height, 0);
+
+	// create color lookup table
+	setColor(color);
+
+	// start worker
+	m_worker = std::thread(&PersistenceMap::run, this);
+}
+
+PersistenceMap::~PersistenceMap() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void PersistenceMap::addWaveform(float* pa_min, float* pa_max) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+
+		// drop waveforms if the worker can't keep up
+		if ((int)m_queue.size() >= PERSISTENCE_MAX_QUEUE * 2 * m_width) {
+			return;
+		}
+
+		m_queue.insert(m_queue.end(), pa_min, pa_min + m_width);
+		m_queue.insert(m_queue.end(), pa_max, pa_max + m_width);
+	}
+	m_condition.notify_one();
+}
+
+void PersistenceMap::accumulate(float* pa_min, float* pa_max) {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// instead of scaling all hits by the decay, the weight of new hits grows
+	m_weight /= m_decay;
+	if (m_weight > 1e20f) {
+		normalize();
+	}
+
+	float binScale = (m_height - 1) / (m_upper - m_lower);
+	__m128 weight = _mm_set1_ps(m_weight);
+
+	for (int c = 0; c < m_width; ++c) {
+
+		// calculate covered bins
+		int first = (int)floorf((pa_min[c] - m_lower) * binScale);
+		int last = (int)ceilf((pa_max[c] - m_lower) * binScale);
+
+		first = max(first, 0);
+		last = min(last, m_height - 1);
+
+		// add weight to all covered bins
+		float* p_hits = m_hits.data() + c * m_height;
+		int b = first;
+
+		for (; b + 4 <= last + 1; b += 4) {
+			_mm_storeu_ps(p_hits + b, _mm_add_ps(_mm_loadu_ps(p_hits + b), weight));
+		}
+		for (; b <= last; ++b) {
+			p_hits[b] += m_weight;
+		}
+	}
+
+	++m_nWaveforms;
+}
+
+unsigned int* PersistenceMap::render() {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// find maximum
+	float maxHits = 0.0f;
+	for (float hits : m_hits) {
+		maxHits = max(maxHits, hits);
+	}
+
+	// intensity is graded logarithmically relative to one hit of the latest waveform
+	float unit = 1.0f / m_weight;
+	float norm = maxHits > 0.0f ? 255.0f / log1pf(maxHits * unit) : 0.0f;
+
+	for (int r = 0; r < m_height; ++r) {
+
+		// first row is the highest bin
+		int bin = m_height - 1 - r;
+
+		for (int c = 0; c < m_width; ++c) {
+
+			float hits = m_hits[c * m_height + bin];
+			int level = hits > 0.0f ? min(max((int)(log1pf(hits * unit) * norm), 1), 255) : 0;
+
+			m_pixels[r * m_width + c] = ma_lut[level];
+		}
+	}
+
+	return m_pixels.data();
+}
+
+void PersistenceMap::clear() {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::fill(m_hits.begin(), m_hits.end(), 0.0f);
+	m_weight = 1.0f;
+	m_nWaveforms = 0;
+}
+
+void PersistenceMap::setDecay(float decay) {
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_decay = min(max(decay, 0.001f), 1.0f);
+}
+
+void PersistenceMap::setColor(Color color) {
+
+	for (int i = 0; i < 256; ++i) {
+
+		// single hits are faint, the most frequent ones fade to white
+		float t = i / 255.0f;
+		float alpha = i == 0 ? 0.0f : 0.15f + 0.85f * t;
+		float white = t * t;
+
+		float r = (color.r + (1.0f - color.r) * white) * alpha;
+		float g = (color.g + (1.0f - color.g) * white) * alpha;
+		float b = (color.b + (1.0f - color.b) * white) * alpha;
+
+		// store premultiplied 0xAARRGGBB
+		ma_lut[i] = ((unsigned int)(alpha * 255) << 24) | ((unsigned int)(r * 255) << 16) | ((unsigned int)(g * 255) << 8) | (unsigned int)(b * 255);
+	}
+}
+
+unsigned int* PersistenceMap::getPixels() {
+
+	return m_pixels.data();
+}
+
+int PersistenceMap::getWidth() {
+
+	return m_width;
+}
+
+int PersistenceMap::getHeight() {
+
+	return m_height;
+}
+
+long long PersistenceMap::getWaveformCount() {
+
+	return m_nWaveforms;
+}
+
+void PersistenceMap::run() {
+
+	std::vector<float> batch;
+
+	while (true) {
+
+		// wait for new waveforms
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_condition.wait(lock, [this]() { return !m_queue.empty() || !m_running; });
+
+			if (!m_running) {
+				return;
+			}
+
+			batch.swap(m_queue);
+		}
+
+		// fold all waveforms into the map
+		for (size_t i = 0; i + 2 * m_width <= batch.size(); i += 2 * m_width) {
+			accumulate(batch.data() + i, batch.data() + i + m_width);
+		}
+
+		batch.clear();
+	}
+}
+
+void PersistenceMap::normalize() {
+
+	// rescale all hits, that way the weight starts at one again
+	__m128 scale = _mm_set1_ps(1.0f / m_weight);
+
+	int size = m_hits.size();
+	int i = 0;
+
+	for (; i + 4 <= size; i += 4) {
+		_mm_storeu_ps(m_hits.data() + i, _mm_mul_ps(_mm_loadu_ps(m_hits.data() + i), scale));
+	}
+	for (; i < size; ++i) {
+		m_hits[i] /= m_weight;
+	}
+
+	m_weight = 1.0f;
+}
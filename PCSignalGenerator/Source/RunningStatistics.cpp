@@ -0,0 +1,67 @@
+#include "Gui.h"
+#include "RunningStatistics.h"
+
+#include <math.h>
+
+RunningStatistics::RunningStatistics() {
+
+	clear();
+}
+
+void RunningStatistics::add(double value) {
+
+	++m_count;
+
+	if (m_count == 1) {
+		m_min = value;
+		m_max = value;
+	}
+	else {
+		m_min = min(m_min, value);
+		m_max = max(m_max, value);
+	}
+
+	// the difference to the old and the new mean gives the increment of m2
+	double delta = value - m_mean;
+	m_mean += delta / m_count;
+	m_m2 += delta * (value - m_mean);
+}
+
+void RunningStatistics::clear() {
+
+	m_count = 0;
+	m_min = 0.0;
+	m_max = 0.0;
+	m_mean = 0.0;
+	m_m2 = 0.0;
+}
+
+long long RunningStatistics::getCount() {
+
+	return m_count;
+}
+
+double RunningStatistics::getMin() {
+
+	return m_min;
+}
+
+double RunningStatistics::getMax() {
+
+	return m_max;
+}
+
+double RunningStatistics::getMean() {
+
+	return m_mean;
+}
+
+double RunningStatistics::getStandardDeviation() {
+
+	// sample standard deviation
+	if (m_count < 2) {
+		return 0.0;
+	}
+
+	return sqrt(m_m2 / (m_count - 1));
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "Gui.h"
+#include "SegmentPool.h"
+
+#include <float.h>
+
+SegmentPool::SegmentPool(int nSegments, int nChannels, int maxSize) :
+	m_nSegments(nSegments), m_nChannels(nChannels), m_maxSize(maxSize), m_count(0) {
+
+	// allocate all segments up front
+	m_data.resize((size_t)m_nSegments * m_nChannels * m_maxSize, 0.0f);
+	m_segments.resize(m_nSegments);
+}
+
+int SegmentPool::store(long long triggerIndex, double timestamp, int size) {
+
+	if (isFull()) {
+		return -1;
+	}
+
+	// register segment
+	Segment& segment = m_segments[m_count];
+	segment.triggerIndex = triggerIndex;
+	segment.timestamp = timestamp;
+	segment.size = min(size, m_maxSize);
+
+	// return index of the segment, its data is filled with getSegmentData()
+	return m_count++;
+}
+
+void SegmentPool::clear() {
+
+	m_count = 0;
+}
+
+bool SegmentPool::isFull() {
+
+	return m_count == m_nSegments;
+}
+
+int SegmentPool::getCount() {
+
+	return m_count;
+}
+
+int SegmentPool::getCapacity() {
+
+	return m_nSegments;
+}
+
+int SegmentPool::getMaxSize() {
+
+	return m_maxSize;
+}
+
+Segment SegmentPool::getSegment(int segment) {
+
+	return m_segments[segment];
+}
+
+float* SegmentPool::getSegmentData(int segment, int channel) {
+
+	return m_data.data() + ((size_t)segment * m_nChannels + channel) * m_maxSize;
+}
+
+void SegmentPool::getEnvelope(int firstSegment, int lastSegment, int channel, int nColumns, float* pa_min, float* pa_max) {
+
+	for (int i = 0; i < nColumns; ++i) {
+		pa_min[i] = FLT_MAX;
+		pa_max[i] = -FLT_MAX;
+	}
+
+	// overlay all segments of the given range
+	for (int s = max(firstSegment, 0); s < min(lastSegment, m_count); ++s) {
+
+		float* p_data = getSegmentData(s, channel);
+		int size = m_segments[s].size;
+
+		for (int i = 0; i < nColumns; ++i) {
+
+			// calculate sample range of this column (at least one sample)
+			int begin = size * i / nColumns;
+			int end = max(size * (i + 1) / nColumns, begin + 1);
+
+			for (int j = begin; j < end; ++j) {
+				pa_min[i] = min(pa_min[i], p_data[j]);
+				pa_max[i] = max(pa_max[i], p_data[j]);
+			}
+		}
+	}
+
+	// fill columns without any segments with zero
+	for (int i = 0; i < nColumns; ++i) {
+		if (pa_min[i] > pa_max[i]) {
+			pa_min[i] = 0.0f;
+			pa_max[i] = 0.0f;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include "Gui.h"
+#include "SegmentRecorder.h"
+
+SegmentRecorder::SegmentRecorder(SegmentPool* p_pool, int size) : mp_pool(p_pool), m_rearm(0), m_origin(0) {
+
+	m_size = min(max(size, 2), mp_pool->getMaxSize());
+}
+
+void SegmentRecorder::arm(int size) {
+
+	// remove all segments
+	mp_pool->clear();
+	m_pending.clear();
+	m_rearm = 0;
+
+	// segments capture the given size (limited by the preallocated size)
+	m_size = min(max(size, 2), mp_pool->getMaxSize());
+}
+
+void SegmentRecorder::restart(long long index) {
+
+	// pending segments span a gap in the record, the stored ones stay valid
+	m_pending.clear();
+	m_rearm = index;
+}
+
+bool SegmentRecorder::trigger(float lastValue, float value, float level, long long index) {
+
+	// check if signal changed sign, the trigger is re-armed and a segment is left
+	int nSegments = mp_pool->getCount() + m_pending.size();
+
+	if (!(lastValue < level && value > level) || index < m_rearm || nSegments >= mp_pool->getCapacity()) {
+		return false;
+	}
+
+	// store record index of the triggered sample
+	m_pending.push_back(index);
+
+	// the next segment can be triggered directly after the post-trigger window of this one
+	m_rearm = index + m_size - m_size / 2;
+	return true;
+}
+
+int SegmentRecorder::store(std::vector<MinMaxPyramid>& records, float sampleRate) {
+
+	int nStored = 0;
+
+	// store all segments of which the post-trigger window was captured
+	while (m_pending.size() > 0 && m_pending.front() + m_size - m_size / 2 <= records[0].getCount()) {
+
+		long long trigger = m_pending.front();
+		m_pending.pop_front();
+
+		// timestamps are relative to the first segment
+		if (mp_pool->getCount() == 0) {
+			m_origin = trigger;
+		}
+
+		int segment = mp_pool->store(trigger, (trigger - m_origin) / (double)sampleRate, m_size);
+
+		if (segment < 0) {
+			break;
+		}
+
+		// copy pre- and post-trigger window of all channels
+		for (int c = 0; c < (int)records.size(); ++c) {
+			records[c].copy(trigger - m_size / 2, m_size, mp_pool->getSegmentData(segment, c));
+		}
+
+		++nStored;
+	}
+
+	return nStored;
+}
+
+int SegmentRecorder::getSize() {
+
+	return m_size;
+}
+
+int SegmentRecorder::getPendingCount() {
+
+	return m_pending.size();
+}
+
+long long SegmentRecorder::getRearmIndex() {
+
+	return m_rearm;
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Gui.h"
 #include "SignalGenerator.h"
 #include "Common/Reflection/Internal.h"
+#include "DSPUtils.h"
 
 #include <numbers>
 #include <assert.h>
@@ -11,8 +12,10 @@ const CLSID CLSID_MMDeviceEnumerator = __uuidof(MMDeviceEnumerator);
 const IID IID_IMMDeviceEnumerator = __uuidof(IMMDeviceEnumerator);
 const IID IID_IAudioClient = __uuidof(IAudioClient);
 const IID IID_IAudioRenderClient = __uuidof(IAudioRenderClient);
+const IID IID_IAudioClock = __uuidof(IAudioClock);
 
-SignalGenerator::SignalGenerator() : m_output(false), m_phase(0.0f) {
+SignalGenerator::SignalGenerator() : m_output(false), m_phase(0.0f), m_writePosition(0), m_clockCorrection(1.0), m_sweepStart(20.0f), m_sweepStop(20000.0f),
+	m_sweepDuration(1.0f), m_sweepPosition(0), m_markerStart(0), m_plotBuffer(SIGGEN_PLOT_SIZE) {
 
 	// add members to reflection
 	ADD_FIELD(int, m_waveformType);
@@ -61,10 +64,21 @@ SignalGenerator::SignalGenerator() : m_output(false), m_phase(0.0f) {
 	hr = mp_audioClient->GetService(IID_IAudioRenderClient, (void**)&mp_audioRenderClient);
 	assert(SUCCEEDED(hr));
 
+	// create clock (position of the stream, that way output and capture can be related)
+	hr = mp_audioClient->GetService(IID_IAudioClock, (void**)&mp_audioClock);
+	assert(SUCCEEDED(hr));
+
+	hr = mp_audioClock->GetFrequency(&m_clockFrequency);
+	assert(SUCCEEDED(hr));
+
 	// get buffer size
 	hr = mp_audioClient->GetBufferSize(&m_bufferSize);
 	assert(SUCCEEDED(hr));
 
+	// create marker
+	m_marker.resize((1 << SIGGEN_MARKER_ORDER) - 1);
+	DSP::createMLS(SIGGEN_MARKER_ORDER, m_marker.data());
+
 	// create buffer
 	byte* p_buffer;
 
@@ -85,6 +99,7 @@ SignalGenerator::~SignalGenerator() {
 	mp_audioClient->Stop();
 
 	mp_audioRenderClient->Release();
+	mp_audioClock->Release();
 	mp_audioClient->Release();
 	mp_audioDevice->Release();
 
@@ -110,6 +125,8 @@ void SignalGenerator::enableOutput(int output) {
 void SignalGenerator::setWaveformType(int waveformType) {
 
 	m_waveformType = waveformType;
+	m_sweepPosition = 0;
+	m_markerStart = m_writePosition;
 	calculatePlotWaveform();
 }
 
@@ -130,14 +147,24 @@ void SignalGenerator::setDutyCycle(int dutyCycle) {
 	calculatePlotWaveform();
 }
 
-float* SignalGenerator::getPlotData() {
+void SignalGenerator::setSweep(float start, float stop, float duration) {
 
-	return ma_plotData;
+	m_sweepStart = start;
+	m_sweepStop = stop;
+	m_sweepDuration = duration;
+
+	// restart the sweep
+	m_sweepPosition = 0;
 }
 
-int SignalGenerator::getPlotDataSize() {
+void SignalGenerator::setClockCorrection(double ratio) {
 
-	return SIGGEN_PLOT_SIZE;
+	m_clockCorrection = ratio;
+}
+
+DataBuffer* SignalGenerator::getPlotBuffer() {
+
+	return &m_plotBuffer;
 }
 
 bool SignalGenerator::isOutputEnabled() {
@@ -165,6 +192,59 @@ int SignalGenerator::getDutyCycle() {
 	return m_dutyCycle;
 }
 
+float SignalGenerator::getLatency() {
+
+	// the whole buffer is filled on every tick, so a new setting takes about a buffer to be played
+	return m_bufferSize / (float)mp_format->nSamplesPerSec;
+}
+
+float SignalGenerator::getSampleRate() {
+
+	return mp_format->nSamplesPerSec;
+}
+
+double SignalGenerator::getClockCorrection() {
+
+	return m_clockCorrection;
+}
+
+float* SignalGenerator::getMarker() {
+
+	return m_marker.data();
+}
+
+int SignalGenerator::getMarkerSize() {
+
+	return m_marker.size();
+}
+
+int SignalGenerator::getMarkerPeriod() {
+
+	return (int)(SIGGEN_MARKER_PERIOD * mp_format->nSamplesPerSec);
+}
+
+long long SignalGenerator::getMarkerStart() {
+
+	return m_markerStart;
+}
+
+bool SignalGenerator::getPlaybackPosition(double& position, double& time) {
+
+	UINT64 devicePosition;
+	UINT64 qpcPosition;
+
+	// sample being played and the performance counter time at which it was (in 100 ns units)
+	HRESULT hr = mp_audioClock->GetPosition(&devicePosition, &qpcPosition);
+
+	if (FAILED(hr) || m_clockFrequency == 0) {
+		return false;
+	}
+
+	position = devicePosition * (double)mp_format->nSamplesPerSec / m_clockFrequency;
+	time = qpcPosition * 1e-7;
+	return true;
+}
+
 
 void SignalGenerator::onTick(float deltaTime) {
 
@@ -196,6 +276,9 @@ void SignalGenerator::onTick(float deltaTime) {
 		// write buffer
 		hr = mp_audioRenderClient->ReleaseBuffer(availableFrames, 0);
 		assert(SUCCEEDED(hr));
+
+		// refill before the buffer runs empty (short buffers last less than a tick)
+		requestWakeup(0.5f * getLatency());
 	}
 }
 
@@ -212,8 +295,8 @@ void SignalGenerator::fillWaveformBuffer(byte* p_buffer, unsigned int nSamples)
 	// cast to float
 	float* p_floatBuffer = (float*)p_buffer;
 
-	// calculate proportion of one sample
-	float proportionSample = m_frequency / mp_format->nSamplesPerSec;
+	// calculate proportion of one sample (corrected, so that the frequency is exact in the capture clock)
+	float proportionSample = m_frequency * m_clockCorrection / mp_format->nSamplesPerSec;
 
 	switch (m_waveformType) {
 	case 0: { // sine waveform
@@ -291,7 +374,47 @@ void SignalGenerator::fillWaveformBuffer(byte* p_buffer, unsigned int nSamples)
 
 		break;
 	}
+	case 4: { // exponential sine sweep
+
+		for (int i = 0; i < nSamples; ++i) {
+
+			// calculate value (silence after the sweep ended)
+			double time = (m_sweepPosition + i) * m_clockCorrection / mp_format->nSamplesPerSec;
+			float value = 0.0f;
+
+			if (time < m_sweepDuration) {
+				double phase = DSP::sweepPhase(time, m_sweepStart, m_sweepStop, m_sweepDuration);
+				value = m_amplitude * DSP::sweepFade(time, m_sweepDuration) * sin(2 * std::numbers::pi * (phase - floor(phase)));
+			}
+
+			for (int c = 0; c < mp_format->nChannels; ++c) {
+				p_floatBuffer[mp_format->nChannels * i + c] = value;
+			}
+		}
+
+		m_sweepPosition += nSamples;
+		break;
+	}
+	case 5: { // markers (silence between them)
+
+		int period = getMarkerPeriod();
+
+		for (int i = 0; i < nSamples; ++i) {
+
+			// the markers are not corrected, they measure the clocks themselves
+			int offset = (m_writePosition + i - m_markerStart) % period;
+			float value = offset < m_marker.size() ? m_amplitude * m_marker[offset] : 0.0f;
+
+			for (int c = 0; c < mp_format->nChannels; ++c) {
+				p_floatBuffer[mp_format->nChannels * i + c] = value;
+			}
+		}
+
+		break;
 	}
+	}
+
+	m_writePosition += nSamples;
 
 	// calculate new phase
 	m_phase += proportionSample * nSamples;
@@ -300,6 +423,8 @@ void SignalGenerator::fillWaveformBuffer(byte* p_buffer, unsigned int nSamples)
 
 void SignalGenerator::calculatePlotWaveform() {
 
+	float* p_plotData = m_plotBuffer.beginWrite();
+
 	switch (m_waveformType) {
 
 	case 0: { // sine waveform
@@ -307,7 +432,7 @@ void SignalGenerator::calculatePlotWaveform() {
 		for (int i = 0; i < SIGGEN_PLOT_SIZE; ++i) {
 
 			float time = i / ((float)SIGGEN_PLOT_SIZE);
-			ma_plotData[i] = m_amplitude * sin(2 * std::numbers::pi * time);
+			p_plotData[i] = m_amplitude * sin(2 * std::numbers::pi * time);
 		}
 		break;
 	}
@@ -316,7 +441,7 @@ void SignalGenerator::calculatePlotWaveform() {
 		for (int i = 0; i < SIGGEN_PLOT_SIZE; ++i) {
 
 			float time = i / ((float)SIGGEN_PLOT_SIZE);
-			ma_plotData[i] = time < m_dutyCycle / 100.0f ? m_amplitude : -m_amplitude;
+			p_plotData[i] = time < m_dutyCycle / 100.0f ? m_amplitude : -m_amplitude;
 		}
 		break;
 	}
@@ -328,15 +453,15 @@ void SignalGenerator::calculatePlotWaveform() {
 
 			if (time < 0.25f) {
 
-				ma_plotData[i] = time * m_amplitude / 0.25f;
+				p_plotData[i] = time * m_amplitude / 0.25f;
 			}
 			else if (time < 0.75f) {
 
-				ma_plotData[i] = m_amplitude * (2 - time / 0.25f);
+				p_plotData[i] = m_amplitude * (2 - time / 0.25f);
 			}
 			else {
 
-				ma_plotData[i] = m_amplitude * (time / 0.25f - 4);
+				p_plotData[i] = m_amplitude * (time / 0.25f - 4);
 			}
 		}
 		break;
@@ -346,11 +471,31 @@ void SignalGenerator::calculatePlotWaveform() {
 		for (int i = 0; i < SIGGEN_PLOT_SIZE; ++i) {
 
 			float time = i / ((float)SIGGEN_PLOT_SIZE);
-			ma_plotData[i] = m_amplitude * (2 * time - 1);
+			p_plotData[i] = m_amplitude * (2 * time - 1);
 		}
 		break;
 	}
+	case 4: { // exponential sine sweep
+
+		// the real sweep is far too dense to plot, a sweep of three octaves shows its shape
+		for (int i = 0; i < SIGGEN_PLOT_SIZE; ++i) {
+
+			float time = i / ((float)SIGGEN_PLOT_SIZE);
+			p_plotData[i] = m_amplitude * sin(2 * std::numbers::pi * DSP::sweepPhase(time, 2.0, 16.0, 1.0));
+		}
+		break;
 	}
+	case 5: { // markers
+
+		// the start of the sequence
+		for (int i = 0; i < SIGGEN_PLOT_SIZE; ++i) {
+			p_plotData[i] = m_amplitude * m_marker[i];
+		}
+		break;
+	}
+	}
+
+	m_plotBuffer.publish();
 
 	// emit signal to update plot
 	EMIT(onPlotUpdate);
@@ -0,0 +1,276 @@
+#include "Gui.h"
+#include "Spectrogram.h"
+#include "Common/ImageUtils.h"
+
+#include <math.h>
+
+#define SPECTROGRAM_MAX_INPUT 8 // maximum number of frames waiting in the input
+
+// anchors of the color maps (from the lowest to the highest level)
+static const float heatMap[5][3] = { {0.0f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.3f}, {0.9f, 0.2f, 0.0f}, {1.0f, 0.8f, 0.0f}, {1.0f, 1.0f, 1.0f} };
+static const float blueGreenYellowMap[5][3] = { {0.27f, 0.0f, 0.33f}, {0.23f, 0.32f, 0.55f}, {0.13f, 0.57f, 0.55f}, {0.37f, 0.79f, 0.38f}, {0.99f, 0.91f, 0.14f} };
+static const float grayMap[5][3] = { {0.0f, 0.0f, 0.0f}, {0.25f, 0.25f, 0.25f}, {0.5f, 0.5f, 0.5f}, {0.75f, 0.75f, 0.75f}, {1.0f, 1.0f, 1.0f} };
+
+Spectrogram::Spectrogram(float sampleRate, int width, int height, int size) : m_sampleRate(sampleRate), m_width(width), m_height(height), m_size(size),
+	m_nColumns(0), m_nPlotColumns(0), m_colorMap(0), m_running(true) {
+
+	// frames overlap by 75%
+	m_hop = max(m_size / 4, 1);
+
+	m_window.resize(m_size);
+	m_windowSum = DSP::createWindow(DSP::WindowType::Hann, m_size, m_window.data());
+
+	m_frame.resize(m_size);
+	m_bins.resize(m_size / 2 + 1);
+
+	// distribute the bins over the rows (every row shows the loudest of its bins)
+	int nBins = m_size / 2 + 1;
+	m_rowBins.resize(m_height + 1);
+
+	for (int i = 0; i <= m_height; ++i) {
+		m_rowBins[i] = min((int)((long long)i * nBins / m_height), nBins);
+	}
+
+	m_levels.resize(m_width * m_height, 0);
+	m_pixels.resize(m_width * m_height, 0);
+
+	// create color lookup table
+	setColorMap(m_colorMap);
+
+	// start worker
+	m_worker = std::thread(&Spectrogram::run, this);
+}
+
+Spectrogram::~Spectrogram() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void Spectrogram::addSamples(float* pa_data, int size) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_input.insert(m_input.end(), pa_data, pa_data + size);
+
+		// drop the oldest samples if the worker can't keep up
+		int maxInput = SPECTROGRAM_MAX_INPUT * m_size;
+		if (m_input.size() > maxInput) {
+			m_input.erase(m_input.begin(), m_input.end() - maxInput);
+		}
+	}
+	m_condition.notify_one();
+}
+
+bool Spectrogram::update() {
+
+	long long first;
+	long long last;
+
+	// color only the columns added since the last update
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		last = m_nColumns;
+		if (last == m_nPlotColumns) {
+			return false;
+		}
+
+		// columns that were overwritten in the meantime are skipped
+		first = max(m_nPlotColumns, last - m_width);
+
+		for (long long i = first; i < last; ++i) {
+			colorColumn(i % m_width);
+		}
+	}
+
+	m_nPlotColumns = last;
+
+	EMIT(onColumnsUpdate, (int)(first % m_width), (int)(last - first));
+	return true;
+}
+
+void Spectrogram::clear() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_input.clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::fill(m_levels.begin(), m_levels.end(), 0);
+		m_nColumns = 0;
+	}
+
+	std::fill(m_pixels.begin(), m_pixels.end(), 0);
+	m_nPlotColumns = 0;
+
+	EMIT(onColumnsUpdate, 0, m_width);
+}
+
+bool Spectrogram::savePNG(std::wstring path) {
+
+	// unroll the ring, so that the oldest column is on the left
+	std::vector<unsigned int> image(m_width * m_height);
+	int offset = getOffset();
+
+	for (int r = 0; r < m_height; ++r) {
+
+		unsigned int* p_src = m_pixels.data() + r * m_width;
+		unsigned int* p_dst = image.data() + r * m_width;
+
+		std::copy(p_src + offset, p_src + m_width, p_dst);
+		std::copy(p_src, p_src + offset, p_dst + m_width - offset);
+	}
+
+	return writePNG(path, image.data(), m_width, m_height);
+}
+
+unsigned int* Spectrogram::getPixels() {
+
+	return m_pixels.data();
+}
+
+int Spectrogram::getWidth() {
+
+	return m_width;
+}
+
+int Spectrogram::getHeight() {
+
+	return m_height;
+}
+
+int Spectrogram::getOffset() {
+
+	// the next column is written over the oldest one
+	return m_nPlotColumns % m_width;
+}
+
+float Spectrogram::getDuration() {
+
+	return m_width * m_hop / m_sampleRate;
+}
+
+float Spectrogram::getSampleRate() {
+
+	return m_sampleRate;
+}
+
+int Spectrogram::getColorMap() {
+
+	return m_colorMap;
+}
+
+void Spectrogram::setColorMap(int colorMap) {
+
+	const float(*p_anchors)[3] = colorMap == 1 ? blueGreenYellowMap : colorMap == 2 ? grayMap : heatMap;
+	m_colorMap = colorMap;
+
+	for (int i = 0; i < 256; ++i) {
+
+		// interpolate between the two nearest anchors
+		float t = i / 255.0f * 4.0f;
+		int a = min((int)t, 3);
+		float f = t - a;
+
+		float r = p_anchors[a][0] + (p_anchors[a + 1][0] - p_anchors[a][0]) * f;
+		float g = p_anchors[a][1] + (p_anchors[a + 1][1] - p_anchors[a][1]) * f;
+		float b = p_anchors[a][2] + (p_anchors[a + 1][2] - p_anchors[a][2]) * f;
+
+		// store opaque 0xAARRGGBB
+		ma_lut[i] = 0xFF000000 | ((unsigned int)(r * 255) << 16) | ((unsigned int)(g * 255) << 8) | (unsigned int)(b * 255);
+	}
+
+	// recolor all columns written so far
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (long long i = max(m_nPlotColumns - m_width, 0LL); i < m_nPlotColumns; ++i) {
+			colorColumn(i % m_width);
+		}
+	}
+
+	EMIT(onColumnsUpdate, 0, m_width);
+}
+
+void Spectrogram::run() {
+
+	std::unique_lock<std::mutex> lock(m_inputMutex);
+
+	while (true) {
+
+		// wait for a complete frame
+		m_condition.wait(lock, [this] { return !m_running || m_input.size() >= m_size; });
+
+		if (!m_running) {
+			return;
+		}
+
+		// take the frame and advance by the hop size
+		m_frame.assign(m_input.begin(), m_input.begin() + m_size);
+		m_input.erase(m_input.begin(), m_input.begin() + m_hop);
+
+		// transform without holding the lock, that way the capture path is never blocked
+		lock.unlock();
+		analyzeFrame();
+		lock.lock();
+	}
+}
+
+void Spectrogram::analyzeFrame() {
+
+	// apply window and transform
+	for (int n = 0; n < m_size; ++n) {
+		m_frame[n] *= m_window[n];
+	}
+
+	FFT::getPlan(m_size).transform(m_frame.data(), m_bins.data());
+
+	// scale, so that a full scale sine reads 0 dB (in power)
+	float scale = 2.0f / m_windowSum;
+	float power = scale * scale;
+	float levelScale = 255.0f / (SPECTROGRAM_MAX_DB - SPECTROGRAM_MIN_DB);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	unsigned char* p_column = m_levels.data() + (m_nColumns % m_width) * m_height;
+
+	for (int i = 0; i < m_height; ++i) {
+
+		// loudest bin of the row (rows without an own bin show their neighbour)
+		int first = min(m_rowBins[i], (int)m_bins.size() - 1);
+		int last = max(m_rowBins[i + 1], first + 1);
+
+		float maxPower = 0.0f;
+		for (int k = first; k < last; ++k) {
+			maxPower = max(maxPower, std::norm(m_bins[k]));
+		}
+
+		float dB = 10.0f * log10f(maxPower * power + 1e-30f);
+		int level = (int)((dB - SPECTROGRAM_MIN_DB) * levelScale);
+
+		// first row is the highest frequency
+		p_column[m_height - 1 - i] = (unsigned char)min(max(level, 0), 255);
+	}
+
+	++m_nColumns;
+}
+
+void Spectrogram::colorColumn(int column) {
+
+	unsigned char* p_column = m_levels.data() + column * m_height;
+
+	for (int r = 0; r < m_height; ++r) {
+		m_pixels[r * m_width + column] = ma_lut[p_column[r]];
+	}
+}
\ No newline at end of file
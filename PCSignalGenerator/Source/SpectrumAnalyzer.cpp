@@ -0,0 +1,271 @@
+#include "Gui.h"
+#include "SpectrumAnalyzer.h"
+
+#include <math.h>
+
+#define SPECTRUM_MAX_INPUT 4 // maximum number of frames waiting in the input
+
+SpectrumAnalyzer::SpectrumAnalyzer(float sampleRate, int size) : m_sampleRate(sampleRate), m_size(size), m_windowType(DSP::WindowType::Hann),
+	m_overlap(0.5f), m_averaging(0), m_nAverages(8), m_windowSum(1.0f), m_count(0), m_updated(false), m_reset(true), m_running(true) {
+
+	m_result.resize(m_size / 2 + 1, SPECTRUM_MIN_DB);
+	m_plotData.resize(m_size / 2 + 1, SPECTRUM_MIN_DB);
+	m_frequencies.resize(m_size / 2 + 1);
+
+	for (int k = 0; k <= m_size / 2; ++k) {
+		m_frequencies[k] = k * m_sampleRate / m_size;
+	}
+
+	// start worker
+	m_worker = std::thread(&SpectrumAnalyzer::run, this);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void SpectrumAnalyzer::addSamples(float* pa_data, int size) {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_input.insert(m_input.end(), pa_data, pa_data + size);
+
+		// drop the oldest samples if the worker can't keep up
+		int maxInput = SPECTRUM_MAX_INPUT * m_size;
+		if ((int)m_input.size() > maxInput) {
+			m_input.erase(m_input.begin(), m_input.end() - maxInput);
+		}
+	}
+	m_condition.notify_one();
+}
+
+bool SpectrumAnalyzer::update() {
+
+	// copy the latest result (the plot data is read while painting)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_updated) {
+			return false;
+		}
+
+		m_plotData = m_result;
+		m_updated = false;
+	}
+
+	// frequencies only change with the size
+	if (m_frequencies.size() != m_plotData.size()) {
+
+		int nBins = m_plotData.size();
+		m_frequencies.resize(nBins);
+
+		for (int k = 0; k < nBins; ++k) {
+			m_frequencies[k] = k * m_sampleRate / (2 * (nBins - 1));
+		}
+	}
+
+	EMIT(onPlotUpdate);
+	return true;
+}
+
+float* SpectrumAnalyzer::getPlotData() {
+
+	return m_plotData.data();
+}
+
+float* SpectrumAnalyzer::getFrequencyData() {
+
+	return m_frequencies.data();
+}
+
+int SpectrumAnalyzer::getPlotDataSize() {
+
+	return m_plotData.size();
+}
+
+float SpectrumAnalyzer::getSampleRate() {
+
+	return m_sampleRate;
+}
+
+int SpectrumAnalyzer::getSize() {
+
+	return m_size;
+}
+
+int SpectrumAnalyzer::getWindowType() {
+
+	return m_windowType;
+}
+
+int SpectrumAnalyzer::getOverlap() {
+
+	return (int)roundf(m_overlap * 100.0f);
+}
+
+int SpectrumAnalyzer::getAveraging() {
+
+	return m_averaging;
+}
+
+void SpectrumAnalyzer::setSize(int size) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_size = size;
+	m_input.clear();
+	m_reset = true;
+}
+
+void SpectrumAnalyzer::setWindowType(int type) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_windowType = (DSP::WindowType)type;
+	m_reset = true;
+}
+
+void SpectrumAnalyzer::setOverlap(int overlap) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	// overlap is given in percent
+	m_overlap = min(max(overlap, 0), 95) / 100.0f;
+}
+
+void SpectrumAnalyzer::setAveraging(int averaging) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_averaging = averaging;
+	m_reset = true;
+}
+
+void SpectrumAnalyzer::setAverageCount(int nAverages) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_nAverages = max(nAverages, 1);
+}
+
+void SpectrumAnalyzer::run() {
+
+	std::unique_lock<std::mutex> lock(m_inputMutex);
+
+	while (true) {
+
+		// wait for a complete frame
+		m_condition.wait(lock, [this] { return !m_running || m_reset || (int)m_input.size() >= m_size; });
+
+		if (!m_running) {
+			return;
+		}
+
+		if (m_reset) {
+			reset();
+		}
+
+		if ((int)m_input.size() < m_size) {
+			continue;
+		}
+
+		// take the frame and advance by the hop size (the rest is shared with the next frame)
+		m_frame.assign(m_input.begin(), m_input.begin() + m_size);
+
+		int hop = max((int)(m_size * (1.0f - m_overlap)), 1);
+		m_input.erase(m_input.begin(), m_input.begin() + hop);
+
+		// transform without holding the lock, that way the capture path is never blocked
+		int averaging = m_averaging;
+		int nAverages = m_nAverages;
+
+		lock.unlock();
+		analyzeFrame(averaging, nAverages);
+		lock.lock();
+	}
+}
+
+void SpectrumAnalyzer::reset() {
+
+	// rebuild all buffers for the current settings (called with the input locked)
+	m_window.resize(m_size);
+	m_windowSum = DSP::createWindow(m_windowType, m_size, m_window.data());
+
+	m_frame.resize(m_size);
+	m_bins.resize(m_size / 2 + 1);
+	m_average.assign(m_size / 2 + 1, 0.0f);
+	m_count = 0;
+
+	m_reset = false;
+}
+
+void SpectrumAnalyzer::analyzeFrame(int averaging, int nAverages) {
+
+	int size = m_frame.size();
+	int nBins = size / 2 + 1;
+
+	// apply window and transform
+	for (int n = 0; n < size; ++n) {
+		m_frame[n] *= m_window[n];
+	}
+
+	FFT::getPlan(size).transform(m_frame.data(), m_bins.data());
+
+	// scale, so that a full scale sine reads 0 dB (independent of window and size)
+	float scale = 2.0f / m_windowSum;
+	float weight = 1.0f / min(m_count + 1, nAverages);
+
+	for (int k = 0; k < nBins; ++k) {
+
+		float magnitude = std::abs(m_bins[k]) * scale;
+
+		switch (averaging) {
+
+		case 1: { // linear
+
+			m_average[k] += (magnitude - m_average[k]) * weight;
+			break;
+		}
+		case 2: { // rms
+
+			m_average[k] += (magnitude * magnitude - m_average[k]) * weight;
+			break;
+		}
+		case 3: { // peak hold
+
+			m_average[k] = m_count == 0 ? magnitude : max(m_average[k], magnitude);
+			break;
+		}
+		default: { // off
+
+			m_average[k] = magnitude;
+			break;
+		}
+		}
+	}
+
+	++m_count;
+
+	// publish result in dB (all bins, the plot series reduces them to its columns)
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_result.resize(nBins);
+
+	for (int k = 0; k < nBins; ++k) {
+
+		// rms averaging holds power
+		float dB = averaging == 2 ? 10.0f * log10f(m_average[k]) : 20.0f * log10f(m_average[k]);
+		m_result[k] = max(dB, SPECTRUM_MIN_DB);
+	}
+
+	m_updated = true;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "Gui.h"
+#include "SweepAnalysis.h"
+#include "DSPUtils.h"
+#include "Convolver.h"
+#include "FFT.h"
+
+#include <bit>
+#include <numbers>
+#include <string.h>
+#include <math.h>
+
+void SweepAnalysis::analyze(ImpulseResponseJob& job, ImpulseResponseResult& result) {
+
+	float sampleRate = job.sampleRate;
+	float start = job.startFrequency;
+	float stop = job.stopFrequency;
+
+	// deconvolve both channels with the same inverse filter
+	int kernelSize = (int)(job.duration * sampleRate);
+
+	std::vector<float> inverse(kernelSize);
+	DSP::createInverseSweep(start, stop, job.duration, sampleRate, inverse.data());
+
+	Convolver convolver(inverse.data(), kernelSize);
+
+	std::vector<float> response(convolver.getOutputSize(job.response.size()));
+	convolver.convolve(job.response.data(), job.response.size(), response.data());
+
+	std::vector<float> reference;
+	if (job.reference.size() > 0) {
+
+		reference.resize(convolver.getOutputSize(job.reference.size()));
+		convolver.convolve(job.reference.data(), job.reference.size(), reference.data());
+	}
+
+	// the linear impulse is the largest peak after the full overlap of sweep and inverse filter
+	// (both channels are recorded together, so the reference peak marks zero delay)
+	std::vector<float>& timing = reference.size() > 0 ? reference : response;
+	int zero = kernelSize - 1;
+
+	for (int i = kernelSize - 1; i < (int)timing.size(); ++i) {
+
+		if (fabsf(timing[i]) > fabsf(timing[zero])) {
+			zero = i;
+		}
+	}
+
+	// harmonic n appears L ln(n) before the linear impulse
+	double L = job.duration / log(stop / start) * sampleRate;
+
+	// the impulse rings before its peak down to the start frequency, cutting that off loses the low frequencies
+	// (at most half of the shortest harmonic window)
+	int preSize = (int)min(IMPRESP_PRE_PERIODS * sampleRate / (double)start, L * log(IMPRESP_HARMONICS / (IMPRESP_HARMONICS - 1.0)) / 2.0);
+	int tailSize = min((int)(IMPRESP_TAIL_TIME * sampleRate), (int)response.size() - zero);
+
+	// excitation frequencies
+	for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+		result.frequencies[j] = start * powf(stop / start, j / (float)(IMPRESP_PLOT_SIZE - 1));
+	}
+
+	// level of the input of the device under test (the generator amplitude if there is no reference)
+	float referenceLevels[IMPRESP_PLOT_SIZE];
+	float referenceGain = max(job.amplitude, 1e-6f);
+
+	if (reference.size() > 0) {
+
+		std::vector<float> window(preSize + tailSize);
+		extract(reference, zero - preSize, window.size(), preSize, window.data());
+		calculateLevels(window.data(), window.size(), 1, sampleRate, result.frequencies, referenceLevels);
+
+		// the impulse is scaled by the gain in the center of the sweep
+		referenceGain = max(powf(10.0f, referenceLevels[IMPRESP_PLOT_SIZE / 2] / 20.0f), 1e-6f);
+	}
+	else {
+
+		for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+			referenceLevels[j] = 20.0f * log10f(referenceGain);
+		}
+	}
+
+	// linear impulse response
+	result.time.resize(preSize + tailSize);
+	result.impulse.resize(preSize + tailSize);
+
+	for (int i = 0; i < (int)result.impulse.size(); ++i) {
+
+		int index = zero - preSize + i;
+
+		result.time[i] = (i - preSize) / sampleRate;
+		result.impulse[i] = index >= 0 && index < (int)response.size() ? response[index] / referenceGain : 0.0f;
+	}
+
+	// cut out every harmonic up to the next one and calculate its level over the excitation frequency
+	for (int n = 1; n <= IMPRESP_HARMONICS; ++n) {
+
+		int begin = zero - (int)round(L * log(n)) - preSize;
+		int size = n == 1 ? preSize + tailSize : (int)(L * log(n / (n - 1.0)));
+
+		std::vector<float> window(max(size, 2));
+		extract(response, begin, size, preSize, window.data());
+		calculateLevels(window.data(), window.size(), n, sampleRate, result.frequencies, result.levels[n - 1]);
+
+		for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+			result.levels[n - 1][j] = max(result.levels[n - 1][j] - referenceLevels[j], IMPRESP_MIN_DB);
+		}
+	}
+}
+
+void SweepAnalysis::extract(std::vector<float>& impulse, int begin, int size, int fadeIn, float* pa_dst) {
+
+	// samples outside of the deconvolved signal are zero
+	for (int i = 0; i < size; ++i) {
+
+		int index = begin + i;
+		pa_dst[i] = index >= 0 && index < (int)impulse.size() ? impulse[index] : 0.0f;
+	}
+
+	// fade in over the pre ringing and out over the last eighth, that way the cut doesn't leak
+	int fadeOut = size / 8;
+
+	for (int i = 0; i < fadeIn && i < size; ++i) {
+		pa_dst[i] *= 0.5f - 0.5f * cosf(std::numbers::pi * i / fadeIn);
+	}
+	for (int i = 0; i < fadeOut; ++i) {
+		pa_dst[size - 1 - i] *= 0.5f - 0.5f * cosf(std::numbers::pi * i / fadeOut);
+	}
+}
+
+void SweepAnalysis::calculateLevels(float* pa_impulse, int size, int harmonic, float sampleRate, float* pa_frequencies, float* pa_dst) {
+
+	// zero padded spectrum of the impulse
+	int fftSize = std::bit_ceil((unsigned int)max(size, 2));
+	FFT& fft = FFT::getPlan(fftSize);
+
+	std::vector<float> data(fftSize, 0.0f);
+	std::vector<std::complex<float>> spectrum(fft.getBinCount());
+
+	memcpy(data.data(), pa_impulse, size * sizeof(float));
+	fft.transform(data.data(), spectrum.data());
+
+	for (int j = 0; j < IMPRESP_PLOT_SIZE; ++j) {
+
+		// harmonic n of the excitation frequency f lies at n * f
+		float position = harmonic * pa_frequencies[j] * fftSize / sampleRate;
+		int k = (int)position;
+
+		if (k + 1 >= (int)spectrum.size()) {
+			pa_dst[j] = IMPRESP_MIN_DB;
+			continue;
+		}
+
+		float t = position - k;
+		float magnitude = std::abs(spectrum[k]) + t * (std::abs(spectrum[k + 1]) - std::abs(spectrum[k]));
+
+		pa_dst[j] = 20.0f * log10f(max(magnitude, 1e-9f));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,410 @@
+#include "Gui.h"
+#include "TransferFunctionAnalyzer.h"
+#include "DSPUtils.h"
+#include "FFT.h"
+
+#include <numbers>
+#include <math.h>
+
+#define TRANSFER_MAX_INPUT 4 // maximum number of frames waiting in the input
+
+TransferFunctionAnalyzer::TransferFunctionAnalyzer(float sampleRate, int size) : m_sampleRate(sampleRate), m_size(size), m_enable(false), m_estimator(0),
+	m_nAverages(16), m_delay(0.0), m_shift(0), m_delayValid(false), m_delayAge(0), m_bestCoherence(0.0f), m_coherenceDropped(false), m_count(0),
+	m_delayResult(0.0), m_updated(false), m_latestDelay(0.0), m_reset(true), m_running(true) {
+
+	int nBins = m_size / 2 + 1;
+
+	m_gainData.resize(nBins, TRANSFER_MIN_DB);
+	m_phaseData.resize(nBins, 0.0f);
+	m_coherenceData.resize(nBins, TRANSFER_MIN_DB);
+	m_frequencies.resize(nBins);
+
+	for (int k = 0; k < nBins; ++k) {
+		m_frequencies[k] = k * m_sampleRate / m_size;
+	}
+
+	// start worker
+	m_worker = std::thread(&TransferFunctionAnalyzer::run, this);
+}
+
+TransferFunctionAnalyzer::~TransferFunctionAnalyzer() {
+
+	// stop worker
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_running = false;
+	}
+	m_condition.notify_one();
+
+	m_worker.join();
+}
+
+void TransferFunctionAnalyzer::addSamples(float* pa_reference, float* pa_measurement, int size) {
+
+	if (!m_enable) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_referenceInput.insert(m_referenceInput.end(), pa_reference, pa_reference + size);
+		m_measurementInput.insert(m_measurementInput.end(), pa_measurement, pa_measurement + size);
+
+		// drop the oldest samples if the worker can't keep up (of both channels, that way they stay aligned)
+		int maxInput = TRANSFER_MAX_INPUT * m_size;
+		if ((int)m_referenceInput.size() > maxInput) {
+			m_referenceInput.erase(m_referenceInput.begin(), m_referenceInput.end() - maxInput);
+			m_measurementInput.erase(m_measurementInput.begin(), m_measurementInput.end() - maxInput);
+		}
+	}
+	m_condition.notify_one();
+}
+
+bool TransferFunctionAnalyzer::update() {
+
+	// copy the latest result (the plot data is read while painting)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_updated) {
+			return false;
+		}
+
+		m_gainData = m_gainResult;
+		m_phaseData = m_phaseResult;
+		m_coherenceData = m_coherenceResult;
+		m_latestDelay = m_delayResult;
+		m_updated = false;
+	}
+
+	EMIT(onPlotUpdate);
+	return true;
+}
+
+float* TransferFunctionAnalyzer::getFrequencyData() {
+
+	return m_frequencies.data();
+}
+
+float* TransferFunctionAnalyzer::getGainData() {
+
+	return m_gainData.data();
+}
+
+float* TransferFunctionAnalyzer::getPhaseData() {
+
+	return m_phaseData.data();
+}
+
+float* TransferFunctionAnalyzer::getCoherenceData() {
+
+	return m_coherenceData.data();
+}
+
+int TransferFunctionAnalyzer::getPlotDataSize() {
+
+	return m_gainData.size();
+}
+
+float TransferFunctionAnalyzer::getDelay() {
+
+	return m_latestDelay / m_sampleRate;
+}
+
+bool TransferFunctionAnalyzer::isEnabled() {
+
+	return m_enable;
+}
+
+int TransferFunctionAnalyzer::getEstimator() {
+
+	return m_estimator;
+}
+
+int TransferFunctionAnalyzer::getAverageCount() {
+
+	return m_nAverages;
+}
+
+void TransferFunctionAnalyzer::enableAnalysis(int enable) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_enable = enable;
+
+	// start with a new average and delay
+	m_referenceInput.clear();
+	m_measurementInput.clear();
+	m_reset = true;
+}
+
+void TransferFunctionAnalyzer::setEstimator(int estimator) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_estimator = estimator;
+}
+
+void TransferFunctionAnalyzer::setAverageCount(int nAverages) {
+
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+
+	m_nAverages = max(nAverages, 1);
+}
+
+void TransferFunctionAnalyzer::clear() {
+
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+
+		m_referenceInput.clear();
+		m_measurementInput.clear();
+		m_reset = true;
+	}
+	m_condition.notify_one();
+}
+
+double TransferFunctionAnalyzer::estimateDelay(float* pa_reference, float* pa_measurement, int size) {
+
+	// zero padding to twice the size makes the circular correlation linear
+	int fftSize = 2 * size;
+	FFT& fft = FFT::getPlan(fftSize);
+
+	std::vector<float> buffer(fftSize, 0.0f);
+	std::vector<std::complex<float>> reference(fft.getBinCount());
+	std::vector<std::complex<float>> measurement(fft.getBinCount());
+
+	std::copy(pa_reference, pa_reference + size, buffer.begin());
+	fft.transform(buffer.data(), reference.data());
+
+	std::copy(pa_measurement, pa_measurement + size, buffer.begin());
+	fft.transform(buffer.data(), measurement.data());
+
+	// cross spectrum with phase transform (only the phase is kept, which gives a sharp
+	// peak for band limited or colored excitation)
+	for (int k = 0; k < (int)reference.size(); ++k) {
+
+		std::complex<float> cross = std::conj(reference[k]) * measurement[k];
+		reference[k] = cross / (std::abs(cross) + 1e-20f);
+	}
+
+	fft.inverse(reference.data(), buffer.data());
+
+	// largest correlation within half a frame (negative lags are at the end)
+	int maxLag = size / 2;
+	int peak = 0;
+
+	for (int lag = -maxLag; lag <= maxLag; ++lag) {
+		if (buffer[(lag + fftSize) % fftSize] > buffer[(peak + fftSize) % fftSize]) {
+			peak = lag;
+		}
+	}
+
+	// parabolic interpolation of the peak
+	float left = buffer[(peak - 1 + fftSize) % fftSize];
+	float center = buffer[(peak + fftSize) % fftSize];
+	float right = buffer[(peak + 1 + fftSize) % fftSize];
+
+	double denominator = left - 2.0 * center + right;
+	double offset = denominator < 0.0 ? 0.5 * (left - right) / denominator : 0.0;
+
+	return peak + offset;
+}
+
+void TransferFunctionAnalyzer::run() {
+
+	std::unique_lock<std::mutex> lock(m_inputMutex);
+
+	while (true) {
+
+		// wait for a complete (aligned) frame
+		m_condition.wait(lock, [this] { return !m_running || m_reset || (int)m_referenceInput.size() >= m_size + abs(m_shift); });
+
+		if (!m_running) {
+			return;
+		}
+
+		if (m_reset) {
+			reset();
+		}
+
+		if ((int)m_referenceInput.size() < m_size + abs(m_shift)) {
+			continue;
+		}
+
+		// the delay is measured on the first frame and again after a while or if the coherence dropped
+		if (!m_delayValid || m_delayAge >= TRANSFER_DELAY_INTERVAL || m_coherenceDropped) {
+
+			m_referenceFrame.assign(m_referenceInput.begin(), m_referenceInput.begin() + m_size);
+			m_measurementFrame.assign(m_measurementInput.begin(), m_measurementInput.begin() + m_size);
+
+			lock.unlock();
+			double delay = estimateDelay(m_referenceFrame.data(), m_measurementFrame.data(), m_size);
+			lock.lock();
+
+			int shift = (int)round(delay);
+
+			// averages of frames aligned by another delay don't belong together
+			if (!m_delayValid || shift != m_shift) {
+
+				int nBins = m_size / 2 + 1;
+
+				m_gxx.assign(nBins, 0.0);
+				m_gyy.assign(nBins, 0.0);
+				m_gxy.assign(nBins, 0.0);
+				m_count = 0;
+
+				m_delay = delay;
+				m_shift = shift;
+			}
+
+			m_delayValid = true;
+			m_delayAge = 0;
+			m_bestCoherence = 0.0f;
+			m_coherenceDropped = false;
+			continue;
+		}
+
+		// take the frames with the measured channel shifted by the delay
+		int referenceFirst = max(-m_shift, 0);
+		int measurementFirst = max(m_shift, 0);
+
+		m_referenceFrame.assign(m_referenceInput.begin() + referenceFirst, m_referenceInput.begin() + referenceFirst + m_size);
+		m_measurementFrame.assign(m_measurementInput.begin() + measurementFirst, m_measurementInput.begin() + measurementFirst + m_size);
+
+		// advance by half a frame
+		int hop = m_size / 2;
+		m_referenceInput.erase(m_referenceInput.begin(), m_referenceInput.begin() + hop);
+		m_measurementInput.erase(m_measurementInput.begin(), m_measurementInput.begin() + hop);
+
+		// transform without holding the lock, that way the capture path is never blocked
+		int estimator = m_estimator;
+		int nAverages = m_nAverages;
+
+		lock.unlock();
+		analyzeFrame(estimator, nAverages);
+		lock.lock();
+
+		++m_delayAge;
+	}
+}
+
+void TransferFunctionAnalyzer::reset() {
+
+	// rebuild all buffers (called with the input locked)
+	int nBins = m_size / 2 + 1;
+
+	m_window.resize(m_size);
+	DSP::createWindow(DSP::WindowType::Hann, m_size, m_window.data());
+
+	m_referenceFrame.resize(m_size);
+	m_measurementFrame.resize(m_size);
+	m_referenceBins.resize(nBins);
+	m_measurementBins.resize(nBins);
+
+	m_gxx.assign(nBins, 0.0);
+	m_gyy.assign(nBins, 0.0);
+	m_gxy.assign(nBins, 0.0);
+	m_count = 0;
+
+	m_delay = 0.0;
+	m_shift = 0;
+	m_delayValid = false;
+	m_delayAge = 0;
+	m_bestCoherence = 0.0f;
+	m_coherenceDropped = false;
+
+	m_reset = false;
+}
+
+void TransferFunctionAnalyzer::analyzeFrame(int estimator, int nAverages) {
+
+	int nBins = m_size / 2 + 1;
+
+	// apply window and transform both channels
+	for (int n = 0; n < m_size; ++n) {
+		m_referenceFrame[n] *= m_window[n];
+		m_measurementFrame[n] *= m_window[n];
+	}
+
+	FFT& fft = FFT::getPlan(m_size);
+	fft.transform(m_referenceFrame.data(), m_referenceBins.data());
+	fft.transform(m_measurementFrame.data(), m_measurementBins.data());
+
+	// average auto and cross spectra
+	double weight = 1.0 / min(m_count + 1, nAverages);
+
+	for (int k = 0; k < nBins; ++k) {
+
+		std::complex<double> x = m_referenceBins[k];
+		std::complex<double> y = m_measurementBins[k];
+
+		m_gxx[k] += (std::norm(x) - m_gxx[k]) * weight;
+		m_gyy[k] += (std::norm(y) - m_gyy[k]) * weight;
+		m_gxy[k] += (std::conj(x) * y - m_gxy[k]) * weight;
+	}
+
+	++m_count;
+
+	// publish result
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_gainResult.resize(nBins);
+	m_phaseResult.resize(nBins);
+	m_coherenceResult.resize(nBins);
+
+	// the frames are aligned by the integer delay, the remaining fraction is the slope of
+	// the cross spectrum phase (least squares fit through zero, weighted by the magnitude)
+	double sumPhase = 0.0;
+	double sumSquares = 0.0;
+
+	for (int k = 1; k < nBins; ++k) {
+
+		double weight = std::abs(m_gxy[k]);
+		sumPhase += weight * k * std::arg(m_gxy[k]);
+		sumSquares += weight * k * k;
+	}
+
+	double fraction = sumSquares > 0.0 ? -sumPhase / sumSquares * m_size / (2.0 * std::numbers::pi) : 0.0;
+	m_delay = m_shift + fraction;
+
+	double sumCoherence = 0.0;
+	int nCoherence = 0;
+
+	for (int k = 0; k < nBins; ++k) {
+
+		double cross = std::abs(m_gxy[k]);
+		double gain = estimator == 1 ? m_gyy[k] / cross : cross / m_gxx[k];
+		double coherence = cross * cross / (m_gxx[k] * m_gyy[k]);
+
+		double phase = std::arg(m_gxy[k]) + 2.0 * std::numbers::pi * k * fraction / m_size;
+		phase = remainder(phase, 2.0 * std::numbers::pi);
+
+		// empty bins give nan (or infinity), they are shown at the limit
+		float gainDB = (float)(20.0 * log10(gain));
+		float coherenceDB = (float)(10.0 * log10(coherence));
+
+		m_gainResult[k] = isfinite(gainDB) ? max(gainDB, TRANSFER_MIN_DB) : TRANSFER_MIN_DB;
+		m_phaseResult[k] = phase * 180.0 / std::numbers::pi;
+		m_coherenceResult[k] = isfinite(coherenceDB) ? max(coherenceDB, TRANSFER_MIN_DB) : TRANSFER_MIN_DB;
+
+		if (isfinite(coherence)) {
+			sumCoherence += coherence;
+			++nCoherence;
+		}
+	}
+
+	// a changed delay misaligns the frames, which shows as a drop of the coherence
+	// (only once the average settled, a single frame always has full coherence)
+	if (m_count >= nAverages && nCoherence > 0) {
+
+		float meanCoherence = (float)(sumCoherence / nCoherence);
+
+		m_bestCoherence = max(m_bestCoherence, meanCoherence);
+		m_coherenceDropped = meanCoherence < TRANSFER_DELAY_COHERENCE * m_bestCoherence;
+	}
+
+	m_delayResult = m_delay;
+	m_updated = true;
+}
\ No newline at end of file
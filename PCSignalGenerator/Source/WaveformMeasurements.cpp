@@ -0,0 +1,221 @@
+#include "Gui.h"
+#include "WaveformMeasurements.h"
+#include "DSPUtils.h"
+
+#include <math.h>
+#include <float.h>
+
+WaveformMeasurements::WaveformMeasurements() : m_result{ } { }
+
+void WaveformMeasurements::measure(float* pa_src, int size, float sampleRate, float scale) {
+
+	measure(&pa_src, &size, 1, sampleRate, scale);
+}
+
+void WaveformMeasurements::measure(float** pa_segments, int* pa_sizes, int nSegments, float sampleRate, float scale) {
+
+	analyze(pa_segments, pa_sizes, nSegments, sampleRate, m_result);
+
+	// amplitudes follow the channel scale
+	m_result.values[Measurement::PeakToPeak] *= fabsf(scale);
+	m_result.values[Measurement::RMS] *= fabsf(scale);
+	m_result.values[Measurement::Mean] *= scale;
+
+	// add all valid quantities to the statistics
+	for (int m = 0; m < MEASUREMENT_COUNT; ++m) {
+		if (m_result.valid[m]) {
+			ma_statistics[m].add(m_result.values[m]);
+		}
+	}
+
+	EMIT(onResultUpdate);
+}
+
+void WaveformMeasurements::clearStatistics() {
+
+	for (int m = 0; m < MEASUREMENT_COUNT; ++m) {
+		ma_statistics[m].clear();
+	}
+
+	EMIT(onResultUpdate);
+}
+
+MeasurementResult WaveformMeasurements::getResult() {
+
+	return m_result;
+}
+
+RunningStatistics* WaveformMeasurements::getStatistics(int measurement) {
+
+	return &ma_statistics[measurement];
+}
+
+void WaveformMeasurements::analyze(float* pa_src, int size, float sampleRate, MeasurementResult& result) {
+
+	analyze(&pa_src, &size, 1, sampleRate, result);
+}
+
+void WaveformMeasurements::analyze(float** pa_segments, int* pa_sizes, int nSegments, float sampleRate, MeasurementResult& result) {
+
+	result = { };
+
+	int size = 0;
+	for (int s = 0; s < nSegments; ++s) {
+		size += pa_sizes[s];
+	}
+
+	if (size < 2) {
+		return;
+	}
+
+	// amplitudes (single pass over every segment)
+	float minValue = FLT_MAX, maxValue = -FLT_MAX;
+	double sum = 0.0, sumSquares = 0.0;
+
+	for (int s = 0; s < nSegments; ++s) {
+
+		if (pa_sizes[s] == 0) {
+			continue;
+		}
+
+		float segmentMin, segmentMax;
+		double segmentSum, segmentSumSquares;
+
+		DSP::reduce(pa_segments[s], pa_sizes[s], segmentMin, segmentMax, segmentSum, segmentSumSquares);
+
+		minValue = min(minValue, segmentMin);
+		maxValue = max(maxValue, segmentMax);
+		sum += segmentSum;
+		sumSquares += segmentSumSquares;
+	}
+
+	result.values[Measurement::PeakToPeak] = maxValue - minValue;
+	result.values[Measurement::RMS] = sqrt(sumSquares / size);
+	result.values[Measurement::Mean] = sum / size;
+
+	result.valid[Measurement::PeakToPeak] = true;
+	result.valid[Measurement::RMS] = true;
+	result.valid[Measurement::Mean] = true;
+
+	// a constant signal has no edges
+	float range = maxValue - minValue;
+
+	if (range <= 0.0f) {
+		return;
+	}
+
+	// the reference levels are only known after the reduction, so the edges need a second pass
+	float low = minValue + MEASUREMENT_LOW_LEVEL * range;
+	float mid = minValue + 0.5f * range;
+	float high = minValue + MEASUREMENT_HIGH_LEVEL * range;
+
+	// the state only changes after the low or high level was crossed (-1 until the first one)
+	int state = -1;
+
+	// latest crossings (in samples, interpolated between two samples)
+	double lowUp = 0.0, midUp = 0.0;
+	double highDown = 0.0, midDown = 0.0;
+
+	int nRising = 0, nRise = 0, nFall = 0;
+	double firstRising = 0.0, lastRising = 0.0, lastFalling = -1.0;
+	double highTime = 0.0, riseTime = 0.0, fallTime = 0.0;
+
+	// the segments are walked as one waveform (x0 is the sample before x1)
+	float x0 = 0.0f;
+	int i = 0;
+
+	for (int s = 0; s < nSegments; ++s) {
+		for (int j = 0; j < pa_sizes[s]; ++j, ++i) {
+
+			float x1 = pa_segments[s][j];
+
+			if (i == 0) {
+				state = x1 <= low ? 0 : x1 >= high ? 1 : -1;
+			}
+			else if (x1 > x0) {
+
+				// upward crossings
+				if (x0 < low && x1 >= low) {
+					lowUp = i - 1 + (low - x0) / (x1 - x0);
+				}
+				if (x0 < mid && x1 >= mid) {
+					midUp = i - 1 + (mid - x0) / (x1 - x0);
+				}
+
+				// a complete rising edge (the signal went below the low level before)
+				if (x0 < high && x1 >= high) {
+
+					if (state == 0) {
+
+						riseTime += i - 1 + (high - x0) / (x1 - x0) - lowUp;
+						++nRise;
+
+						// the signal was high between the last rising and the last falling edge
+						if (nRising > 0 && lastFalling > lastRising) {
+							highTime += lastFalling - lastRising;
+						}
+
+						if (nRising == 0) {
+							firstRising = midUp;
+						}
+
+						lastRising = midUp;
+						++nRising;
+					}
+
+					state = 1;
+				}
+			}
+			else if (x1 < x0) {
+
+				// downward crossings
+				if (x0 > high && x1 <= high) {
+					highDown = i - 1 + (x0 - high) / (x0 - x1);
+				}
+				if (x0 > mid && x1 <= mid) {
+					midDown = i - 1 + (x0 - mid) / (x0 - x1);
+				}
+
+				// a complete falling edge (the signal went above the high level before)
+				if (x0 > low && x1 <= low) {
+
+					if (state == 1) {
+
+						fallTime += i - 1 + (x0 - low) / (x0 - x1) - highDown;
+						++nFall;
+
+						lastFalling = midDown;
+					}
+
+					state = 0;
+				}
+			}
+
+			x0 = x1;
+		}
+	}
+
+	// period from the rising edges (averaged over all complete periods)
+	if (nRising >= 2) {
+
+		double period = (lastRising - firstRising) / (nRising - 1);
+
+		result.values[Measurement::Frequency] = sampleRate / period;
+		result.values[Measurement::Period] = period / sampleRate;
+		result.values[Measurement::DutyCycle] = 100.0 * highTime / (lastRising - firstRising);
+
+		result.valid[Measurement::Frequency] = true;
+		result.valid[Measurement::Period] = true;
+		result.valid[Measurement::DutyCycle] = true;
+	}
+
+	if (nRise > 0) {
+		result.values[Measurement::RiseTime] = riseTime / nRise / sampleRate;
+		result.valid[Measurement::RiseTime] = true;
+	}
+
+	if (nFall > 0) {
+		result.values[Measurement::FallTime] = fallTime / nFall / sampleRate;
+		result.valid[Measurement::FallTime] = true;
+	}
+}
\ No newline at end of file